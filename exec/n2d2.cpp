@@ -224,7 +224,14 @@ public:
         stopValid =   opts.parse("-stop-valid", 0U, "max. number of successive lower score "
                                                    "validation");
         test =        opts.parse("-test", "perform testing");
-        fuse =        opts.parse("-fuse", "fuse BatchNorm with Conv for test and export");
+        fuse =        opts.parse("-fuse", "fuse BatchNorm with Conv for test and export"
+                                          " (and ElemWise Sum with Conv for test),"
+                                          " and symmetric Padding with Conv/Pool");
+        inPlace =     opts.parse("-inplace", "compute ElemWise Sum in place of an "
+                                             "input with no other consumer");
+        memPlan =     opts.parse("-mem-plan", "share the outputs memory between "
+                                              "the cells, according to their "
+                                              "lifetime (test only)");
         bench =       opts.parse("-bench", "learning speed benchmarking");
         learnStdp =   opts.parse("-learn-stdp", 0U, "number of STDP learning steps");
         presentTime =   opts.parse("-present-time", 1.0, "presentation time in Us");
@@ -308,6 +315,8 @@ public:
     unsigned int stopValid;
     bool test;
     bool fuse;
+    bool inPlace;
+    bool memPlan;
     bool bench;
     unsigned int learnStdp;
     double presentTime;
@@ -364,6 +373,27 @@ void test(const Options& opt, std::shared_ptr<DeepNet>& deepNet, bool afterCalib
             sp->readStimulusBatch(Database::Test, opt.testId);
         else
             sp->readBatch(Database::Test, idx);
+
+        if (afterCalibration && opt.nbBits > 0) {
+            // The quantized network expects integer stimuli, scaled and
+            // truncated as in StimuliProviderExport
+            const bool unsignedData = DeepNetExport::mEnvDataUnsigned;
+            const double maxValue = std::pow(2, (unsignedData)
+                                    ? opt.nbBits : opt.nbBits - 1) - 1;
+            const double minValue = (unsignedData) ? 0.0 : -maxValue - 1;
+
+            StimuliProvider::TensorData_T& data = sp->getData();
+
+            for (unsigned int index = 0; index < data.size(); ++index) {
+                data(index) = (Float_T)Utils::clamp<double>(
+                    CellExport::getIntApprox(maxValue * data(index),
+                                             CellExport::Truncate),
+                    minValue, maxValue);
+            }
+
+            data.synchronizeHToD();
+        }
+
         endTimeSp = std::chrono::high_resolution_clock::now();
 
         deepNet->test(Database::Test, &timings);
@@ -1740,8 +1770,15 @@ int main(int argc, char* argv[]) try
     Network net(opt.seed);
     std::shared_ptr<DeepNet> deepNet
         = DeepNetGenerator::generate(net, opt.iniConfig);
+
+    if (opt.fuse)
+        deepNet->fusePaddingWithConvPool();
+
     deepNet->initialize();
 
+    if (opt.inPlace)
+        deepNet->setElemWiseInPlace(opt.learn == 0 && opt.learnStdp == 0);
+
     if (opt.genConfig) {
         deepNet->saveNetworkParameters();
         std::exit(0);
@@ -1837,8 +1874,10 @@ int main(int argc, char* argv[]) try
                 deepNet->importNetworkFreeParameters("weights");
         }
  
-        if (opt.fuse)
+        if (opt.fuse) {
             deepNet->fuseBatchNormWithConv();
+            deepNet->fuseElemWiseWithConv();
+        }
     }
     else if (opt.nbBits > 0) {
         // afterCalibration means that we are trying to simulate export result.
@@ -1882,6 +1921,23 @@ int main(int argc, char* argv[]) try
         }
     }
 
+    // Conv cells with the same DataLayout exchange their outputs in this
+    // layout. The outputs of all the cells must be NCHW for learning and for
+    // the outputs log.
+    if (opt.learn == 0 && opt.learnStdp == 0 && opt.logOutputs == 0)
+        deepNet->keepConvDataLayouts();
+
+    if (opt.memPlan) {
+        // The outputs of all the cells must be kept for learning and for
+        // the outputs log
+        if (opt.learn == 0 && opt.learnStdp == 0 && opt.logOutputs == 0)
+            deepNet->planInferenceMemory();
+        else {
+            std::cout << Utils::cwarning << "-mem-plan is ignored with -learn,"
+                " -learn-stdp or -log-outputs" << Utils::cdef << std::endl;
+        }
+    }
+
     try
     {
         std::shared_ptr<Cell_Frame_Top> cellFrame = deepNet->getTargetCell<Cell_Frame_Top>();
@@ -21,6 +21,8 @@
 #ifndef N2D2_ACTIVATION_SCALING_H
 #define N2D2_ACTIVATION_SCALING_H
 
+#include <cmath>
+#include <cstdint>
 #include <iosfwd>
 #include <vector>
 
@@ -36,6 +38,19 @@
 namespace N2D2 {
 
 class AbstractScaling {
+protected:
+    /// The integer scalings are applied on int64_t, to the data rounded to the
+    /// nearest integer, which is exact for the integer-valued data of a
+    /// quantized network.
+    template<typename T>
+    static std::int64_t toInteger(T value) {
+        return static_cast<std::int64_t>(std::round(static_cast<double>(value)));
+    }
+
+    /// Rounding constant added before a right shift of @p shift bits
+    static std::int64_t half(std::size_t shift) {
+        return (shift > 0) ? (std::int64_t(1) << (shift - 1)) : 0;
+    }
 };
 
 /**
@@ -124,7 +139,8 @@ private:
  * const std::size_t HALF = 1 << (mNbFractionalBits - 1);
  * return (data * mScalingPerOutput[o] + HALF) >> mNbFractionalBits;
  * 
- * TODO Implement scaling and improve documentation.
+ * The right shift is arithmetic (rounding toward -infinity), as in the C
+ * export. The data is rounded to the nearest integer first.
  */
 class FixedPointScaling: public AbstractScaling {
 public:
@@ -140,6 +156,26 @@ public:
         return mNbFractionalBits;
     }
 
+    template<typename T>
+    void propagate(Tensor<T>& data) const {
+        const std::int64_t halfValue = half(mNbFractionalBits);
+
+        std::size_t index = 0;
+        for (std::size_t batch = 0; batch < data.dimB(); batch++) {
+            for(std::size_t ch = 0; ch < data.dimZ(); ch++) {
+                const std::int64_t scaling = mScalingPerOutput[ch];
+
+                for(std::size_t y = 0; y < data.dimY(); y++) {
+                    for(std::size_t x = 0; x < data.dimX(); x++) {
+                        data(index) = (T) ((toInteger(data(index))*scaling 
+                                            + halfValue) >> mNbFractionalBits);
+                        index++;
+                    }
+                }
+            }
+        }
+    }
+
 private:
     std::size_t mNbFractionalBits;
     std::vector<std::int32_t> mScalingPerOutput;
@@ -152,7 +188,8 @@ private:
  * const std::size_t HALF = 1 << (mScalingPerOutput[o] - 1);
  * return (data + HALF) >> mScalingPerOutput[o];
  * 
- * TODO Implement scaling and improve documentation.
+ * HALF is 0 for a shift of 0. The data is rounded to the nearest integer
+ * first.
  */
 class SingleShiftScaling: public AbstractScaling {
 public:
@@ -162,6 +199,25 @@ public:
         return mScalingPerOutput;
     }
 
+    template<typename T>
+    void propagate(Tensor<T>& data) const {
+        std::size_t index = 0;
+        for (std::size_t batch = 0; batch < data.dimB(); batch++) {
+            for(std::size_t ch = 0; ch < data.dimZ(); ch++) {
+                const std::size_t shift = mScalingPerOutput[ch];
+                const std::int64_t halfValue = half(shift);
+
+                for(std::size_t y = 0; y < data.dimY(); y++) {
+                    for(std::size_t x = 0; x < data.dimX(); x++) {
+                        data(index) = (T) ((toInteger(data(index)) + halfValue)
+                                                >> shift);
+                        index++;
+                    }
+                }
+            }
+        }
+    }
+
 private:
     std::vector<unsigned char> mScalingPerOutput;
 };
@@ -172,7 +228,8 @@ private:
  * const std::size_t HALF = 1 << (mScalingPerOutput[o].second - 1);
  * return (data + (data << mScalingPerOutput[o].first) + HALF) >> mScalingPerOutput[o].second;
  * 
- * TODO Implement scaling and improve documentation.
+ * which approximates data * (1 + 2^first) / 2^second. The data is rounded to
+ * the nearest integer first.
  */
 class DoubleShiftScaling: public AbstractScaling {
 public:
@@ -183,6 +240,30 @@ public:
         return mScalingPerOutput;
     }
 
+    template<typename T>
+    void propagate(Tensor<T>& data) const {
+        std::size_t index = 0;
+        for (std::size_t batch = 0; batch < data.dimB(); batch++) {
+            for(std::size_t ch = 0; ch < data.dimZ(); ch++) {
+                // data << first is computed as a multiplication, which is
+                // also defined for negative data
+                const std::int64_t factor 
+                    = std::int64_t(1) << mScalingPerOutput[ch].first;
+                const std::size_t shift = mScalingPerOutput[ch].second;
+                const std::int64_t halfValue = half(shift);
+
+                for(std::size_t y = 0; y < data.dimY(); y++) {
+                    for(std::size_t x = 0; x < data.dimX(); x++) {
+                        const std::int64_t value = toInteger(data(index));
+                        data(index) = (T) ((value + value*factor + halfValue)
+                                                >> shift);
+                        index++;
+                    }
+                }
+            }
+        }
+    }
+
 private:
     std::vector<std::pair<unsigned char, unsigned char>> mScalingPerOutput;
 };
@@ -271,6 +352,15 @@ inline void ActivationScaling::propagate(Tensor<T>& data) const {
         case ActivationScalingMode::FLOAT_MULT:
             static_cast<FloatingPointScaling&>(*mScaling).propagate(data);
             break;
+        case ActivationScalingMode::FIXED_MULT:
+            static_cast<FixedPointScaling&>(*mScaling).propagate(data);
+            break;
+        case ActivationScalingMode::SINGLE_SHIFT:
+            static_cast<SingleShiftScaling&>(*mScaling).propagate(data);
+            break;
+        case ActivationScalingMode::DOUBLE_SHIFT:
+            static_cast<DoubleShiftScaling&>(*mScaling).propagate(data);
+            break;
         default:
             throw std::runtime_error("Unsupported scaling propagation.");
     }
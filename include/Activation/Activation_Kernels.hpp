@@ -21,7 +21,16 @@
 #ifndef N2D2_ACTIVATION_KERNELS_H
 #define N2D2_ACTIVATION_KERNELS_H
 
+#ifndef WIN32
+#include <fenv.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
 #include "Activation/Activation.hpp"
+#include "third_party/half.hpp"
+#include "utils/Utils.hpp"
 
 namespace N2D2 {
 void rangeAveraging(double minVal,
@@ -34,6 +43,138 @@ void rangeAveraging(double minVal,
                     double EMA_Alpha);
 
 double log2Round(double value, double rate = 1.0, double power = 0.0);
+
+/**
+ * In-place activation kernels of the *Activation_Frame classes, on a
+ * contiguous array of @p size elements.
+ *
+ * The templates are the reference (scalar) implementations. The float
+ * overloads are dispatched at runtime to a SIMD implementation according to
+ * CpuFeatures::getInstructionSet(), see utils/SimdMath.hpp for the accuracy
+ * of the vectorized math functions. The half_float::half overloads convert
+ * the data in bulk to float (see utils/HalfConversion.hpp), apply the float
+ * kernel and round the result back to half.
+*/
+
+/// data = tanh(alpha * data)
+template <class T>
+void tanhActivation(T* data, std::size_t size, T alpha);
+void tanhActivation(float* data, std::size_t size, float alpha);
+void tanhActivation(half_float::half* data,
+                    std::size_t size,
+                    half_float::half alpha);
+
+/// data = 1 / (1 + exp(-data))
+template <class T>
+void logisticActivation(T* data, std::size_t size);
+void logisticActivation(float* data, std::size_t size);
+void logisticActivation(half_float::half* data, std::size_t size);
+
+/// data = log(1 + exp(data))
+template <class T>
+void softplusActivation(T* data, std::size_t size);
+void softplusActivation(float* data, std::size_t size);
+void softplusActivation(half_float::half* data, std::size_t size);
+
+/// data = (data > 0) ? data : leakSlope * data, clipped to @p clipping if
+/// @p clipping > 0
+template <class T>
+void rectifierActivation(T* data, std::size_t size, T leakSlope, T clipping);
+void rectifierActivation(float* data,
+                         std::size_t size,
+                         float leakSlope,
+                         float clipping);
+void rectifierActivation(half_float::half* data,
+                         std::size_t size,
+                         half_float::half leakSlope,
+                         half_float::half clipping);
+
+/// data = clamp(data, -threshold, threshold)
+template <class T>
+void saturationActivation(T* data, std::size_t size, T threshold);
+void saturationActivation(float* data, std::size_t size, float threshold);
+void saturationActivation(half_float::half* data,
+                          std::size_t size,
+                          half_float::half threshold);
+}
+
+template <class T>
+void N2D2::tanhActivation(T* data, std::size_t size, T alpha)
+{
+    if (alpha != T(1.0)) {
+#pragma omp parallel for if (size > 1024)
+        for (int index = 0; index < (int)size; ++index)
+            data[index] = std::tanh(alpha * data[index]);
+    } else {
+#pragma omp parallel for if (size > 1024)
+        for (int index = 0; index < (int)size; ++index)
+            data[index] = std::tanh(data[index]);
+    }
+}
+
+template <class T>
+void N2D2::logisticActivation(T* data, std::size_t size)
+{
+#pragma omp parallel for if (size > 1024)
+    for (int index = 0; index < (int)size; ++index) {
+#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
+        // Disabling of FE_OVERFLOW must be INSIDE THE LOOP, because else it
+        // only applies to the main thread when using OpenMP
+        const int excepts = fegetexcept();
+        fedisableexcept(FE_OVERFLOW);
+#endif
+
+        data[index] = 1.0f / (1.0f + std::exp(-data[index]));
+
+#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
+        feenableexcept(excepts);
+#endif
+    }
+}
+
+template <class T>
+void N2D2::softplusActivation(T* data, std::size_t size)
+{
+    // log(1 + exp(x)) = max(x, 0) + log(1 + exp(-|x|)), which neither
+    // overflows nor loses precision for large |x|
+#pragma omp parallel for if (size > 1024)
+    for (int index = 0; index < (int)size; ++index) {
+        const T x = data[index];
+        const T absX = (x > 0) ? x : -x;
+
+        data[index] = std::max<T>(x, T(0.0f)) + std::log1p(std::exp(-absX));
+    }
+}
+
+template <class T>
+void N2D2::rectifierActivation(T* data,
+                               std::size_t size,
+                               T leakSlope,
+                               T clipping)
+{
+    if (clipping > T(0.0)) {
+#pragma omp parallel for if (size > 1024)
+        for (int index = 0; index < (int)size; ++index) {
+            data[index] = (data[index] > 0)
+                ? std::min<T>(data[index], clipping)
+                : leakSlope * data[index];
+        }
+    } else {
+#pragma omp parallel for if (size > 1024)
+        for (int index = 0; index < (int)size; ++index) {
+            data[index] = (data[index] > 0)
+                ? data[index]
+                : leakSlope * data[index];
+        }
+    }
+}
+
+template <class T>
+void N2D2::saturationActivation(T* data, std::size_t size, T threshold)
+{
+#pragma omp parallel for if (size > 1024)
+    for (int index = 0; index < (int)size; ++index)
+        data[index] = Utils::clamp<T>(data[index], -threshold, threshold);
 }
 
 #endif // N2D2_ACTIVATION_KERNELS_H
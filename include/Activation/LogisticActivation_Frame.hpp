@@ -21,10 +21,7 @@
 #ifndef N2D2_LOGISTICACTIVATION_FRAME_H
 #define N2D2_LOGISTICACTIVATION_FRAME_H
 
-#ifndef WIN32
-#include <fenv.h>
-#endif
-
+#include "Activation/Activation_Kernels.hpp"
 #include "Activation/LogisticActivation.hpp"
 #include "containers/Tensor.hpp"
 #include "Solver/SGDSolver_Kernels.hpp"
@@ -66,19 +63,7 @@ void N2D2::LogisticActivation_Frame<T>::propagate(BaseTensor& baseData,
 
     mScaling.propagate(data);
 
-#pragma omp parallel for if (data.size() > 1024)
-    for (int index = 0; index < (int)data.size(); ++index){
-#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
-        const int excepts = fegetexcept();
-        fedisableexcept(FE_OVERFLOW);
-#endif
-
-        data(index) = 1.0f / (1.0f + std::exp(-data(index)));
-
-#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
-        feenableexcept(excepts);
-#endif
-    }
+    logisticActivation(&data(0), data.size());
 
     if (mQuantizationLevels > 0) {
         ++mNbSteps;
@@ -60,21 +60,8 @@ void N2D2::RectifierActivation_Frame<T>::propagate(BaseTensor& baseData,
 
     mScaling.propagate(data);
 
-    if (mClipping > 0.0) {
-#pragma omp parallel for if (data.size() > 1024)
-        for (int index = 0; index < (int)data.size(); ++index) {
-            data(index) = (data(index) > 0)
-                ? std::min<T>(data(index), (T)mClipping)
-                : (T)mLeakSlope * data(index);
-        }
-    } else {
-#pragma omp parallel for if (data.size() > 1024)
-        for (int index = 0; index < (int)data.size(); ++index) {
-            data(index) = (data(index) > 0)
-                ? data(index)
-                : (T)mLeakSlope * data(index);
-        }
-    }
+    rectifierActivation(&data(0), data.size(), (T)mLeakSlope,
+                        (mClipping > 0.0) ? (T)mClipping : T(0.0));
 
     if (mQuantizationLevels > 0) {
         if (!inference) {
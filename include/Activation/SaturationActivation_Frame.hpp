@@ -60,12 +60,7 @@ void N2D2::SaturationActivation_Frame<T>::propagate(BaseTensor& baseData,
 
     mScaling.propagate(data);
 
-    const T threshold(mThreshold);
-
-#pragma omp parallel for if (data.size() > 1024)
-    for (int index = 0; index < (int)data.size(); ++index)
-        data(index) = Utils::clamp<T>(data(index),
-                                         -threshold, threshold);
+    saturationActivation(&data(0), data.size(), T(mThreshold));
 
     if (mQuantizationLevels > 0) {
         if (!inference) {
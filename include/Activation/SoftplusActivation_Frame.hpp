@@ -21,10 +21,7 @@
 #ifndef N2D2_SOFTPLUSACTIVATION_FRAME_H
 #define N2D2_SOFTPLUSACTIVATION_FRAME_H
 
-#ifndef WIN32
-#include <fenv.h>
-#endif
-
+#include "Activation/Activation_Kernels.hpp"
 #include "Activation/SoftplusActivation.hpp"
 #include "containers/Tensor.hpp"
 
@@ -54,21 +51,7 @@ void N2D2::SoftplusActivation_Frame<T>::propagate(BaseTensor& baseData,
 
     mScaling.propagate(data);
 
-#pragma omp parallel for if (data.size() > 1024)
-    for (int index = 0; index < (int)data.size(); ++index) {
-#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
-        // Disabling of FE_OVERFLOW must be INSIDE THE LOOP, because else it
-        // only applies to the main thread when using OpenMP
-        const int excepts = fegetexcept();
-        fedisableexcept(FE_OVERFLOW);
-#endif
-
-        data(index) = std::log(1.0f + std::exp(data(index)));
-
-#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
-        feenableexcept(excepts);
-#endif
-    }
+    softplusActivation(&data(0), data.size());
 
     if (mQuantizationLevels > 0) {
         throw std::runtime_error("SoftplusActivation_Frame::propagate: "
@@ -51,17 +51,7 @@ void N2D2::TanhActivation_Frame<T>::propagate(BaseTensor& baseData,
 
     mScaling.propagate(data);
 
-    if (mAlpha != 1.0) {
-        const T alpha(mAlpha);
-
-#pragma omp parallel for if (data.size() > 1024)
-        for (int index = 0; index < (int)data.size(); ++index)
-            data(index) = std::tanh(alpha * data(index));
-    } else {
-#pragma omp parallel for if (data.size() > 1024)
-        for (int index = 0; index < (int)data.size(); ++index)
-            data(index) = std::tanh(data(index));
-    }
+    tanhActivation(&data(0), data.size(), T(mAlpha));
 
     if (mQuantizationLevels > 0) {
         ++mNbSteps;
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "AnchorCell.hpp"
+#include "AnchorCell_Frame_Kernels.hpp"
 #include "DeepNet.hpp"
 #include "Cell_Frame.hpp"
 
@@ -76,6 +77,9 @@ protected:
     std::vector<AnchorCell_Frame_Kernels::Anchor> mAnchors;
     std::vector<std::vector<AnchorCell_Frame_Kernels::BBox_T> > mGT;
     std::vector<std::vector<std::vector< AnchorCell_Frame_Kernels::BBox_T> > > mGTClass;
+    // Spatial index of mGT and mGTClass, for the anchors/GT matching
+    std::vector<AnchorCell_Frame_Kernels::BBoxGrid> mGTGrid;
+    std::vector<std::vector<AnchorCell_Frame_Kernels::BBoxGrid> > mGTClassGrid;
     Tensor<int> mArgMaxIoU;
     std::vector<Float_T> mMaxIoU;
     std::vector<std::vector<Float_T> > mMaxIoUClass;
@@ -0,0 +1,85 @@
+/*
+    (C) Copyright 2013 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_ANCHORCELL_FRAME_KERNELS_H
+#define N2D2_ANCHORCELL_FRAME_KERNELS_H
+
+#include <vector>
+
+#include "AnchorCell_Frame_Kernels_struct.hpp"
+
+namespace N2D2 {
+namespace AnchorCell_Frame_Kernels {
+    /**
+     * Uniform grid index over a set of boxes (the ground truth ROIs of an
+     * image), to find the boxes overlapping a query box without scanning the
+     * whole set.
+     * Each box is registered in every cell it covers. The box indexes of cell
+     * i are mIndexes[mCellsStart[i]] to mIndexes[mCellsStart[i + 1] - 1].
+    */
+    class BBoxGrid {
+    public:
+        BBoxGrid();
+        void build(const std::vector<BBox_T>& boxes);
+
+        /// Return the index of the box of @p boxes (the set the index was
+        /// built for) with the highest IoU with @p bb, or -1 if no box
+        /// overlaps @p bb. The result is the same as with a linear scan: in
+        /// case of tie, the lowest index is returned.
+        int argMaxIoU(const std::vector<BBox_T>& boxes,
+                      const BBox_T& bb,
+                      float& maxIoU) const;
+
+    private:
+        inline unsigned int cellX(float x) const;
+        inline unsigned int cellY(float y) const;
+
+        // Maximum number of cells in each dimension
+        static const unsigned int MaxCells = 32;
+
+        float mX0;
+        float mY0;
+        float mInvCellWidth;
+        float mInvCellHeight;
+        unsigned int mNbCellsX;
+        unsigned int mNbCellsY;
+        std::vector<unsigned int> mCellsStart;
+        std::vector<unsigned int> mIndexes;
+    };
+}
+}
+
+unsigned int N2D2::AnchorCell_Frame_Kernels::BBoxGrid::cellX(float x) const
+{
+    const float cell = (x - mX0) * mInvCellWidth;
+    return (!(cell > 0.0f)) ? 0
+        : (cell >= mNbCellsX - 1) ? mNbCellsX - 1
+        : (unsigned int)cell;
+}
+
+unsigned int N2D2::AnchorCell_Frame_Kernels::BBoxGrid::cellY(float y) const
+{
+    const float cell = (y - mY0) * mInvCellHeight;
+    return (!(cell > 0.0f)) ? 0
+        : (cell >= mNbCellsY - 1) ? mNbCellsY - 1
+        : (unsigned int)cell;
+}
+
+#endif // N2D2_ANCHORCELL_FRAME_KERNELS_H
@@ -167,6 +167,8 @@ protected:
     Tensor<ParamT> mDiffSavedVariance;
     Tensor<ParamT> mSavedMean;
     Tensor<ParamT> mSavedVariance;
+    // 1 / sqrt(mSavedVariance + mEpsilon), reused by backPropagate()
+    Tensor<ParamT> mSavedInvStd;
 
 private:
     static Registrar<BatchNormCell> mRegistrar;
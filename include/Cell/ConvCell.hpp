@@ -181,6 +181,52 @@ public:
     };
     virtual void setBiases(const std::shared_ptr<BaseTensor>&
                            /*biases*/) {};
+    /**
+     * Fuse an element-wise Sum cell, which takes the outputs of this cell as
+     * one of its inputs, in the output epilogue of this cell (inference only).
+     * The outputs of this cell become
+     * activation(sum_k(weights[k] * inputs[k] + shifts[k])), where a NULL
+     * inputs[k] stands for the outputs of this cell after its own activation.
+     *
+     * @return false if the cell model or the activations do not support it
+    */
+    virtual bool fuseElemWiseSum(const std::vector<BaseTensor*>& /*inputs*/,
+                                 const std::vector<Float_T>& /*weights*/,
+                                 const std::vector<Float_T>& /*shifts*/,
+                                 const std::shared_ptr<Activation>&
+                                    /*activation*/)
+    {
+        return false;
+    };
+    /**
+     * Fuse a zero padding of the inputs, of @p paddingX columns on the left
+     * and on the right and @p paddingY rows on the top and on the bottom, in
+     * the padding of this cell. The caller must then replace the inputs of
+     * this cell by the unpadded ones.
+     *
+     * @return false if the cell model does not support it
+    */
+    virtual bool fusePadding(int /*paddingX*/, int /*paddingY*/)
+    {
+        return false;
+    };
+    /// Return the memory layout in which the cell accepts all its inputs in
+    /// inference, without conversion
+    virtual TensorLayout::Layout getDataLayout() const
+    {
+        return TensorLayout::NCHW;
+    };
+    /**
+     * Keep the outputs in getDataLayout() in inference, instead of the NCHW
+     * layout. The caller must ensure that the outputs are only read by cells
+     * accepting this layout.
+     *
+     * @return false if the cell model does not support it
+    */
+    virtual bool keepOutputsLayout(bool /*keep*/)
+    {
+        return false;
+    };
     virtual void exportFreeParameters(const std::string& fileName) const;
     virtual void importFreeParameters(const std::string& fileName,
                                       bool ignoreNotExists = false);
@@ -223,7 +269,7 @@ protected:
     // Stride for the convolution
     const std::vector<unsigned int> mStrideDims;
     // Padding for the convolution
-    const std::vector<int> mPaddingDims;
+    std::vector<int> mPaddingDims;
     // Dilation for the convolution
     const std::vector<unsigned int> mDilationDims;
 
@@ -35,6 +35,7 @@ public:
     using Cell_Frame<T>::mOutputs;
     using Cell_Frame<T>::mDiffInputs;
     using Cell_Frame<T>::mDiffOutputs;
+    using Cell_Frame<T>::mActivation;
 
     ConvCell_Frame(const DeepNet& deepNet, const std::string& name,
                    const std::vector<unsigned int>& kernelDims,
@@ -118,6 +119,18 @@ public:
                                      " invalid type");
         }
     }
+    bool fuseElemWiseSum(const std::vector<BaseTensor*>& inputs,
+                         const std::vector<Float_T>& weights,
+                         const std::vector<Float_T>& shifts,
+                         const std::shared_ptr<Activation>& activation);
+    bool fusePadding(int paddingX, int paddingY);
+    TensorLayout::Layout getDataLayout() const
+    {
+        // The fused element-wise sum only reads NCHW inputs
+        return (mSumInputs.empty()) ? (TensorLayout::Layout)mDataLayout
+                                    : TensorLayout::NCHW;
+    };
+    bool keepOutputsLayout(bool keep);
     void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
     void saveFreeParameters(const std::string& fileName) const;
     void loadFreeParameters(const std::string& fileName,
@@ -134,6 +147,10 @@ protected:
         channel -= mSharedSynapses.getTensorDataOffset(channel);
 
         sharedSynapses[output][channel] = tensor_cast<T>(value);
+        invalidateWinogradFilters();
+        invalidateSparseFilters();
+        invalidateInt8Filters();
+        invalidateLayoutFilters();
     }
     inline void setBias(unsigned int output, const BaseTensor& value)
     {
@@ -143,6 +160,37 @@ protected:
         (*mBias)(output) = tensor_cast<T>(value)(0);
     };
 
+    const Tensor<T>& getWinogradFilters(unsigned int k,
+                                        unsigned int offset,
+                                        bool backward);
+    void invalidateWinogradFilters();
+    /// Return the filters of input @p k in the CSR format, or NULL if their
+    /// sparsity is below mSparsityThreshold
+    const Sparse::CsrMatrix<T>* getSparseFilters(unsigned int k,
+                                                 unsigned int offset);
+    void invalidateSparseFilters();
+    /// Return the filters of input @p k converted to 8 bits integers, or NULL
+    /// if the weights are not integers in [-128, 127]
+    const std::vector<std::int8_t>* getInt8Filters(unsigned int k,
+                                                   unsigned int offset);
+    void invalidateInt8Filters();
+    /// Return the filters of input @p k packed for mDataLayout
+    const Tensor<T>& getLayoutFilters(unsigned int k);
+    void invalidateLayoutFilters();
+    /// Return the layout of the outputs: mDataLayout if they are kept in this
+    /// layout (see keepOutputsLayout()), NCHW otherwise
+    TensorLayout::Layout getOutputsLayout(bool inference) const;
+
+    /// Convolution algorithm
+    Parameter<ConvCell_Frame_Kernels::Algorithm> mAlgorithm;
+    /// Memory layout of the inputs and kernels for the forward convolution
+    Parameter<TensorLayout::Layout> mDataLayout;
+    /// Minimum fraction of zero weights to use the sparse kernels
+    Parameter<double> mSparsityThreshold;
+    /// In inference, use the integer kernels when the weights and the inputs
+    /// are 8 bits integers (set by DeepNetQuantization for nbBits <= 8)
+    Parameter<bool> mQuantizedInference;
+
     // Internal
     std::vector<std::shared_ptr<Solver> > mWeightsSolvers;
     Interface<T> mSharedSynapses;
@@ -152,6 +200,34 @@ protected:
     Interface<T> mDiffSharedSynapses;
     Tensor<T> mDiffBias;
     ConvCell_Frame_Kernels::Descriptor mConvDesc;
+    // Algorithm actually used, resolved from mAlgorithm in initialize()
+    ConvCell_Frame_Kernels::Algorithm mConvAlgorithm;
+    // Number of groups of the mapping of each input (0 if not grouped)
+    std::vector<size_t> mNbGroups;
+    // Cached Winograd transformed filters, for forward and backward data
+    unsigned int mWinogradTileSize;
+    std::vector<Tensor<T> > mWinogradFilters;
+    std::vector<Tensor<T> > mWinogradDiffFilters;
+    std::vector<bool> mWinogradFiltersValid;
+    std::vector<bool> mWinogradDiffFiltersValid;
+    // Inputs and kernels converted to mDataLayout
+    Tensor<T> mLayoutInputs;
+    std::vector<Tensor<T> > mLayoutFilters;
+    std::vector<bool> mLayoutFiltersValid;
+    // Outputs kept in mDataLayout in inference (see keepOutputsLayout())
+    bool mKeepOutputsLayout;
+    // Compressed filters, whose pattern is kept during the updates
+    std::vector<Sparse::CsrMatrix<T> > mSparseFilters;
+    std::vector<bool> mSparseFiltersValid;
+    // Filters converted to 8 bits integers (empty if not integer)
+    std::vector<std::vector<std::int8_t> > mInt8Filters;
+    std::vector<bool> mInt8FiltersValid;
+    // Element-wise sum fused in the output epilogue (see fuseElemWiseSum())
+    std::vector<BaseTensor*> mSumInputs;
+    std::vector<T> mSumWeights;
+    std::vector<T> mSumShifts;
+    ConvCell_Frame_Kernels::EpilogueActivation mEpilogueActivation;
+    ConvCell_Frame_Kernels::EpilogueActivation mSumActivation;
 
 private:
     static Registrar<ConvCell> mRegistrar;
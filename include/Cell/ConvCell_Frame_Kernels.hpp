@@ -21,16 +21,41 @@
 #ifndef N2D2_CONVCELL_FRAME_KERNELS_H
 #define N2D2_CONVCELL_FRAME_KERNELS_H
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include "containers/Tensor.hpp"
+#include "containers/TensorLayout.hpp"
+#include "utils/Sparse.hpp"
+#include "utils/Utils.hpp"
 
 namespace N2D2 {
 
+class Activation;
+
 namespace ConvCell_Frame_Kernels {
+    enum Algorithm {
+        // Winograd for 3x3 stride-1 convolutions, Im2Col for dilated
+        // convolutions and Direct otherwise
+        Auto,
+        // Direct convolution loops
+        Direct,
+        // Lowering of the input patches in a column buffer (im2col),
+        // followed by a matrix multiplication (GEMM)
+        Im2Col,
+        // Winograd minimal filtering F(2x2,3x3) or F(4x4,3x3), for 3x3
+        // stride-1 convolutions only (backwardFilter uses Direct)
+        Winograd
+    };
+
+    // Make the generic enum stream operators of Utils.hpp reachable by ADL
+    using ::operator<<;
+    using ::operator>>;
+
     struct Descriptor {
         const std::vector<unsigned int> subSample;
         const std::vector<unsigned int> stride;
-        const std::vector<int> padding;
+        std::vector<int> padding;
         const std::vector<unsigned int> dilation;
 
         Descriptor(const std::vector<unsigned int>& subSample_,
@@ -54,12 +79,62 @@ namespace ConvCell_Frame_Kernels {
                  const T* beta,
                  Tensor<T>& outputs,
                  const Tensor<bool>& maps = Tensor<bool>());
+    /// The outputs may be in any layout (see BaseTensor::getLayout()), without
+    /// padding channel
     template <class T>
     void forwardBias(const T* alpha,
                      const Tensor<T>& bias,
                      const T* beta,
                      Tensor<T>& outputs);
 
+    /// Piecewise linear activation, applied in the output epilogue:
+    /// - rectifier: (x > 0) ? min(x, clipping) : leakSlope * x, the clipping
+    ///   being disabled if <= 0;
+    /// - otherwise: clamp(x, -clipping, clipping), the clipping being
+    ///   disabled if 0.
+    struct EpilogueActivation {
+        bool rectifier;
+        double leakSlope;
+        double clipping;
+
+        EpilogueActivation()
+            : rectifier(false),
+              leakSlope(0.0),
+              clipping(0.0)
+        {
+        }
+    };
+
+    /// Return true and set @p epilogueActivation if @p activation (possibly
+    /// NULL) can be applied in the output epilogue, i.e. if it is a Linear,
+    /// Rectifier or Saturation activation without scaling nor quantization
+    bool getEpilogueActivation(const std::shared_ptr<Activation>& activation,
+                               EpilogueActivation& epilogueActivation);
+
+    /**
+     * Fused output epilogue, computing in a single pass over the outputs:
+     * y = activation(outputs + bias)
+     * outputs = sumActivation(sum_k(sumWeights[k] * x_k + sumShifts[k]))
+     * with x_k = y if sumInputs[k] is NULL and x_k = sumInputs[k] otherwise.
+     *
+     * @param bias          Bias per output (NULL if no bias)
+     * @param activation    Activation of the convolution
+     * @param sumInputs     Inputs of the element-wise sum (NULL for y)
+     * @param sumWeights    Weight of each input of the sum
+     * @param sumShifts     Shift of each input of the sum
+     * @param sumActivation Activation applied after the sum
+     * @param outputs       Result of the convolution, replaced by the result
+     *                      of the epilogue
+    */
+    template <class T>
+    void forwardEpilogue(const Tensor<T>* bias,
+                         const EpilogueActivation& activation,
+                         const std::vector<const Tensor<T>*>& sumInputs,
+                         const std::vector<T>& sumWeights,
+                         const std::vector<T>& sumShifts,
+                         const EpilogueActivation& sumActivation,
+                         Tensor<T>& outputs);
+
     // Backward
     template <class T>
     void backwardData(const T* alpha,
@@ -82,7 +157,196 @@ namespace ConvCell_Frame_Kernels {
                       const Tensor<T>& diffInputs,
                       const T* beta,
                       Tensor<T>& diffBias);
+
+    // Grouped (and depthwise) convolution, with nbGroups block-diagonal
+    // groups of channels and outputs, as detected by Cell::getNbGroups()
+    template <class T>
+    void forwardGrouped(const T* alpha,
+                        const Tensor<T>& inputs,
+                        const Tensor<T>& sharedSynapses,
+                        const Descriptor& desc,
+                        const T* beta,
+                        Tensor<T>& outputs,
+                        unsigned int nbGroups);
+    template <class T>
+    void backwardDataGrouped(const T* alpha,
+                             const Tensor<T>& sharedSynapses,
+                             const Tensor<T>& diffInputs,
+                             const Descriptor& desc,
+                             const T* beta,
+                             Tensor<T>& diffOutputs,
+                             unsigned int nbGroups);
+    template <class T>
+    void backwardFilterGrouped(const T* alpha,
+                               const Tensor<T>& inputs,
+                               const Tensor<T>& diffInputs,
+                               const Descriptor& desc,
+                               const T* beta,
+                               Tensor<T>& diffSharedSynapses,
+                               unsigned int nbGroups);
+
+    // Im2Col algorithm
+    template <class T>
+    void im2col(const Tensor<T>& inputs,
+                unsigned int batchPos,
+                unsigned int kernelWidth,
+                unsigned int kernelHeight,
+                const Descriptor& desc,
+                unsigned int oxSize,
+                unsigned int oySize,
+                T* col);
+    template <class T>
+    void col2im(const T* col,
+                unsigned int kernelWidth,
+                unsigned int kernelHeight,
+                const Descriptor& desc,
+                unsigned int oxSize,
+                unsigned int oySize,
+                const T* beta,
+                Tensor<T>& outputs,
+                unsigned int batchPos);
+    template <class T>
+    void forwardIm2Col(const T* alpha,
+                       const Tensor<T>& inputs,
+                       const Tensor<T>& sharedSynapses,
+                       const Descriptor& desc,
+                       const T* beta,
+                       Tensor<T>& outputs,
+                       const Tensor<bool>& maps = Tensor<bool>());
+    template <class T>
+    void backwardDataIm2Col(const T* alpha,
+                            const Tensor<T>& sharedSynapses,
+                            const Tensor<T>& diffInputs,
+                            const Descriptor& desc,
+                            const T* beta,
+                            Tensor<T>& diffOutputs,
+                            const Tensor<bool>& maps = Tensor<bool>());
+    template <class T>
+    void backwardFilterIm2Col(const T* alpha,
+                              const Tensor<T>& inputs,
+                              const Tensor<T>& diffInputs,
+                              const Descriptor& desc,
+                              const T* beta,
+                              Tensor<T>& diffSharedSynapses,
+                              const Tensor<bool>& maps = Tensor<bool>());
+
+    // Sparse kernels (im2col followed by a sparse by dense product)
+    /// Compress the kernels, with the unmapped channels set to 0, in a
+    /// nbOutputs x (nbChannels * kernelHeight * kernelWidth) CSR matrix
+    template <class T>
+    void compressFilters(const Tensor<T>& sharedSynapses,
+                         Sparse::CsrMatrix<T>& filters,
+                         const Tensor<bool>& maps = Tensor<bool>());
+    template <class T>
+    void forwardSparse(const T* alpha,
+                       const Tensor<T>& inputs,
+                       const Sparse::CsrMatrix<T>& filters,
+                       unsigned int kernelWidth,
+                       unsigned int kernelHeight,
+                       const Descriptor& desc,
+                       const T* beta,
+                       Tensor<T>& outputs);
+
+    // Integer kernels (8 bits operands and 32 bits accumulators), for the
+    // inference of quantized networks
+    /// Convert the kernels, with the unmapped channels set to 0, to a
+    /// nbOutputs x (nbChannels * kernelHeight * kernelWidth) matrix.
+    /// Return false (and clear @p filters) if a weight is not an integer in
+    /// [-128, 127].
+    template <class T>
+    bool quantizeFilters(const Tensor<T>& sharedSynapses,
+                         std::vector<std::int8_t>& filters,
+                         const Tensor<bool>& maps = Tensor<bool>());
+    /// Convolution with filters converted by quantizeFilters(). The
+    /// weighted sums are accumulated in int32_t. Return false, without modifying @p outputs,
+    /// if the inputs are not integers in [0, 255] or [-128, 127].
+    template <class T>
+    bool forwardInt8(const Tensor<T>& inputs,
+                     const std::vector<std::int8_t>& filters,
+                     unsigned int kernelWidth,
+                     unsigned int kernelHeight,
+                     const Descriptor& desc,
+                     const T* beta,
+                     Tensor<T>& outputs);
+
+    // Winograd algorithm
+    bool isWinogradCompatible(unsigned int kernelWidth,
+                              unsigned int kernelHeight,
+                              const Descriptor& desc);
+    /// Compute the transformed filters U = G.g.G^T for the output tile size
+    /// @p tileSize (2 or 4). If @p backward is true, the filters are
+    /// transformed for backwardDataWinograd() (flipped kernels, with the
+    /// inputs and outputs swapped).
+    template <class T>
+    void winogradFilters(unsigned int tileSize,
+                         const Tensor<T>& sharedSynapses,
+                         bool backward,
+                         Tensor<T>& filters,
+                         const Tensor<bool>& maps = Tensor<bool>());
+    template <class T>
+    void forwardWinograd(const T* alpha,
+                         const Tensor<T>& inputs,
+                         const Tensor<T>& filters,
+                         const Descriptor& desc,
+                         const T* beta,
+                         Tensor<T>& outputs);
+    template <class T>
+    void backwardDataWinograd(const T* alpha,
+                              const Tensor<T>& filters,
+                              const Tensor<T>& diffInputs,
+                              const Descriptor& desc,
+                              const T* beta,
+                              Tensor<T>& diffOutputs);
+
+    // Forward convolution with the inputs in the NHWC or NCHWc layouts
+    /// Reorder the {X, Y, C, O} kernels for forwardLayout(): {C, X, Y, O} for
+    /// NHWC and {o, c, X, Y, C/c, O/o} for NCHWc, with c = o = the number of
+    /// channels per block.
+    template <class T>
+    void packFilters(const Tensor<T>& sharedSynapses,
+                     TensorLayout::Layout layout,
+                     Tensor<T>& filters);
+    /// Convolution of @p inputs in @p layout with filters packed with
+    /// packFilters(). The outputs are written in @p layout if it is their
+    /// getLayout() (without padding channel), in the NCHW layout otherwise.
+    /// The whole mapping must be connected and sub-sampling is not supported.
+    template <class T>
+    void forwardLayout(const T* alpha,
+                       const Tensor<T>& inputs,
+                       const Tensor<T>& filters,
+                       TensorLayout::Layout layout,
+                       const Descriptor& desc,
+                       const T* beta,
+                       Tensor<T>& outputs);
+
+    // In half precision, the direct convolutions convert their operands in
+    // bulk to float and accumulate in float (see utils/HalfConversion.hpp)
+    template <>
+    void forward<half_float::half>(const half_float::half* alpha,
+                                   const Tensor<half_float::half>& inputs,
+                                   const Tensor<half_float::half>&
+                                   sharedSynapses,
+                                   const Descriptor& desc,
+                                   const half_float::half* beta,
+                                   Tensor<half_float::half>& outputs,
+                                   const Tensor<bool>& maps);
+    template <>
+    void forwardGrouped<half_float::half>(const half_float::half* alpha,
+                                          const Tensor<half_float::half>&
+                                          inputs,
+                                          const Tensor<half_float::half>&
+                                          sharedSynapses,
+                                          const Descriptor& desc,
+                                          const half_float::half* beta,
+                                          Tensor<half_float::half>& outputs,
+                                          unsigned int nbGroups);
 }
 }
 
+namespace {
+template <>
+const char* const EnumStrings<N2D2::ConvCell_Frame_Kernels::Algorithm>::data[]
+    = {"Auto", "Direct", "Im2Col", "Winograd"};
+}
+
 #endif // N2D2_CONVCELL_FRAME_KERNELS_H
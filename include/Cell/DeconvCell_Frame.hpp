@@ -141,6 +141,11 @@ protected:
     Interface<T,-1> mDiffSharedSynapses;
     Tensor<T> mDiffBias;
     ConvCell_Frame_Kernels::Descriptor mConvDesc;
+    // Algorithm actually used, resolved from mAlgorithm in initialize()
+    ConvCell_Frame_Kernels::Algorithm mConvAlgorithm;
+
+    /// Convolution algorithm
+    Parameter<ConvCell_Frame_Kernels::Algorithm> mAlgorithm;
 
 private:
     static Registrar<DeconvCell> mRegistrar;
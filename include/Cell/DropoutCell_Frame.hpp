@@ -56,7 +56,11 @@ public:
     virtual ~DropoutCell_Frame();
 
 protected:
-    Tensor<char> mMask;
+    // The mask is not stored: its words are generated on the fly in
+    // propagate() and backPropagate() from the seed and the step with the
+    // counter-based Philox generator
+    unsigned long long mSeed;
+    unsigned long long mStep;
 
 private:
     static Registrar<DropoutCell> mRegistrar;
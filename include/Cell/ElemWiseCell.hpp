@@ -85,6 +85,23 @@ public:
         return mShifts;
     };
 
+    /**
+     * Compute the Sum in place of the outputs of input @p input, which must
+     * have no other consumer. When its weight is 1, the diff. inputs of the
+     * cell are also shared with the diff. outputs of this input.
+     * The cell outputs (getOutputs()) and diff. inputs (getDiffInputs())
+     * then alias these tensors, and the cell own tensors are released.
+     *
+     * @return false if the cell model or the operation does not support it
+    */
+    virtual bool setInPlace(unsigned int /*input*/)
+    {
+        return false;
+    };
+    virtual bool isInPlace() const
+    {
+        return false;
+    };
     void getStats(Stats& stats) const;
     std::vector<unsigned int> getReceptiveField(
                                 const std::vector<unsigned int>& outputField
@@ -57,6 +57,29 @@ public:
     }
 
     virtual void initialize();
+    virtual bool setInPlace(unsigned int input);
+    virtual bool isInPlace() const
+    {
+        return (mInPlaceInput >= 0);
+    };
+    virtual BaseTensor& getOutputs()
+    {
+        return (mInPlaceInput >= 0) ? mInputs[mInPlaceInput] : mOutputs;
+    }
+    virtual const BaseTensor& getOutputs() const
+    {
+        return (mInPlaceInput >= 0) ? mInputs[mInPlaceInput] : mOutputs;
+    }
+    virtual BaseTensor& getDiffInputs()
+    {
+        return (mSharedDiffInputs) ? mDiffOutputs[mInPlaceInput]
+                                   : mDiffInputs;
+    }
+    virtual const BaseTensor& getDiffInputs() const
+    {
+        return (mSharedDiffInputs) ? mDiffOutputs[mInPlaceInput]
+                                   : mDiffInputs;
+    }
     virtual void propagate(bool inference = false);
     virtual void backPropagate();
     virtual void update();
@@ -66,6 +89,10 @@ public:
 protected:
     Tensor<Float_T> mInterTerm;
     Tensor<unsigned int> mArgMax;
+    // Input whose outputs are overwritten by the Sum (-1 if none)
+    int mInPlaceInput;
+    // Diff. inputs shared with the diff. outputs of mInPlaceInput
+    bool mSharedDiffInputs;
 
 private:
     static Registrar<ElemWiseCell> mRegistrar;
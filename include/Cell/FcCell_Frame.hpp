@@ -21,10 +21,13 @@
 #ifndef N2D2_FCCELL_FRAME_H
 #define N2D2_FCCELL_FRAME_H
 
+#include <cstdint>
+
 #include "Activation/TanhActivation_Frame.hpp"
 #include "Cell_Frame.hpp"
 #include "DeepNet.hpp"
 #include "FcCell.hpp"
+#include "utils/Sparse.hpp"
 
 namespace N2D2 {
 template <class T>
@@ -79,13 +82,39 @@ protected:
                           const BaseTensor& value)
     {
         mSynapses(0, 0, channel, output) = tensor_cast<T>(value)(0);
+        mSparseSynapsesValid.assign(mSparseSynapsesValid.size(), false);
+        mInt8SynapsesValid.assign(mInt8SynapsesValid.size(), false);
     };
     inline void setBias(unsigned int output, const BaseTensor& value)
     {
         mBias(output) = tensor_cast<T>(value)(0);
     };
 
+    /// Return the synapses of input @p k, with the dropped connections set
+    /// to 0
+    const Tensor<T>& getDropConnectSynapses(unsigned int k);
+    /// Return the synapses of input @p k in the CSR format, or NULL if their
+    /// sparsity is below mSparsityThreshold
+    const Sparse::CsrMatrix<T>* getSparseSynapses(unsigned int k);
+    /// Return the synapses of input @p k converted to 8 bits integers, or
+    /// NULL if they are not integers in [-128, 127]
+    const std::vector<std::int8_t>* getInt8Synapses(unsigned int k);
+    /// outputs = input * synapses^T + beta * outputs, with the input
+    /// converted to TI (std::int8_t or std::uint8_t) and 32 bits
+    /// accumulators. Return false, without modifying @p outputs, if the input
+    /// values are not representable in TI.
+    template <class TI>
+    bool propagateInt8(const Tensor<T>& input,
+                       const std::vector<std::int8_t>& synapses,
+                       T beta,
+                       Tensor<T>& outputs);
+
     Parameter<double> mDropConnect;
+    /// Minimum fraction of zero weights to use the sparse kernels
+    Parameter<double> mSparsityThreshold;
+    /// In inference, use the integer kernels when the weights and the inputs
+    /// are 8 bits integers (set by DeepNetQuantization for nbBits <= 8)
+    Parameter<bool> mQuantizedInference;
 
     // Internal
     std::vector<std::shared_ptr<Solver> > mWeightsSolvers;
@@ -95,7 +124,15 @@ protected:
     Tensor<T> mDiffBias;
 
     Interface<bool> mDropConnectMask;
+    Tensor<T> mDropConnectSynapses;
+    Tensor<T> mDropConnectGradient;
     bool mLockRandom;
+    // Compressed synapses, whose pattern is kept during the updates
+    std::vector<Sparse::CsrMatrix<T> > mSparseSynapses;
+    std::vector<bool> mSparseSynapsesValid;
+    // Synapses converted to 8 bits integers (empty if not integer)
+    std::vector<std::vector<std::int8_t> > mInt8Synapses;
+    std::vector<bool> mInt8SynapsesValid;
 
 private:
     static Registrar<FcCell> mRegistrar;
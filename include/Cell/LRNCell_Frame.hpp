@@ -45,15 +45,16 @@ public:
     virtual void propagate(bool inference = false);
     virtual void backPropagate();
     virtual void update();
-    void checkGradient(double /*epsilon */ = 1.0e-4,
-                       double /*maxError */ = 1.0e-6) {};
+    void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
     virtual ~LRNCell_Frame() {};
 
 protected:
-    T normAccrossChannel(T input, T xAcc, T alpha, T beta, T k);
-    // mInputsBackProp (ix, iy, channel, batchPos)
-    // list of the output node(s) to backpropagate from] (for Max pooling)
-    Tensor<std::vector<unsigned int> > mInputsBackProp;
+    // Number of spatial positions processed together along the channels
+    static const unsigned int BlockSize = 256;
+
+    // k + alpha * sum(x^2) over the channels window, for each output,
+    // saved for backPropagate()
+    Tensor<T> mScale;
 
 private:
     static Registrar<LRNCell> mRegistrar;
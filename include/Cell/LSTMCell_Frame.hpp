@@ -0,0 +1,497 @@
+/*
+    (C) Copyright 2018 CEA LIST. All Rights Reserved.
+    Contributor(s): Thibault ALLENET (thibault.allenet@cea.fr)
+                    Olivier BICHLER (olivier.bichler@cea.fr)
+                    David BRIAND (david.briand@cea.fr)
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_LSTMCELL_FRAME_H
+#define N2D2_LSTMCELL_FRAME_H
+
+#include "Cell_Frame.hpp"
+#include "DeepNet.hpp"
+#include "LSTMCell.hpp"
+#include "Solver/SGDSolver_Frame.hpp"
+
+namespace N2D2 {
+/**
+ * CPU implementation of LSTMCell, with the same semantics as the cuDNN LSTM
+ * of LSTMCell_Frame_CUDA.
+ *
+ * All the parameters are stored in a single flat tensor, in the same layout
+ * as LSTMCell_Frame_CUDA, so that the same weights files can be used by
+ * both models. For each (layer, direction), the four previous layer gate
+ * matrices are contiguous and form a single (4 x hiddenSize) x inputDim
+ * row-major matrix, as are the four recurrent gate matrices. The input
+ * projection of all the time steps is therefore computed with one GEMM, and
+ * the recurrent projection with one GEMM per time step.
+*/
+template <class T>
+class LSTMCell_Frame : public virtual LSTMCell, public Cell_Frame<T> {
+public:
+    using Cell_Frame<T>::mInputs;
+    using Cell_Frame<T>::mOutputs;
+    using Cell_Frame<T>::mDiffInputs;
+    using Cell_Frame<T>::mDiffOutputs;
+    using Cell_Frame<T>::addInput;
+
+    LSTMCell_Frame(const DeepNet& deepNet, const std::string& name,
+                   unsigned int seqLength,
+                   unsigned int batchSize,
+                   unsigned int inputDim,
+                   unsigned int numberLayers,
+                   unsigned int hiddenSize,
+                   unsigned int algo,
+                   unsigned int nbOutputs,
+                   unsigned int bidirectional,
+                   unsigned int inputMode,
+                   float dropout,
+                   bool singleBackpropFeeding);
+    static std::shared_ptr<LSTMCell>
+    create(Network& /*net*/, const DeepNet& deepNet,
+           const std::string& name,
+           unsigned int seqLength,
+           unsigned int batchSize,
+           unsigned int inputDim,
+           unsigned int numberLayers,
+           unsigned int hiddenSize,
+           unsigned int algo,
+           unsigned int nbOutputs,
+           unsigned int bidirectional,
+           unsigned int inputMode,
+           float dropout,
+           bool singleBackpropFeeding)
+    {
+        return std::make_shared<LSTMCell_Frame>(deepNet, name,
+                                                seqLength,
+                                                batchSize,
+                                                inputDim,
+                                                numberLayers,
+                                                hiddenSize,
+                                                algo,
+                                                nbOutputs,
+                                                bidirectional,
+                                                inputMode,
+                                                dropout,
+                                                singleBackpropFeeding);
+    }
+
+    virtual void initialize();
+    virtual void propagate(bool inference = false);
+    virtual void backPropagate();
+    virtual void update();
+    virtual void addInput(Cell* cell,
+                          const Tensor<bool>& mapping = Tensor<bool>());
+    virtual void addInput(StimuliProvider& sp,
+                          unsigned int x0,
+                          unsigned int y0,
+                          unsigned int width,
+                          unsigned int height,
+                          const Tensor<bool>& mapping);
+    void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
+
+    inline std::shared_ptr<Tensor<T> > getmhx()
+    {
+        return mhx;
+    };
+    inline std::shared_ptr<Tensor<T> > getmDiffhy()
+    {
+        return mDiffhy;
+    };
+    inline std::shared_ptr<Tensor<T> > getmcx()
+    {
+        return mcx;
+    };
+    inline std::shared_ptr<Tensor<T> > getmDiffcy()
+    {
+        return mDiffcy;
+    };
+    void setWeights(const std::shared_ptr<Tensor<T> >& weights)
+    {
+        mWeights = weights;
+    };
+    inline std::shared_ptr<Tensor<T> > getWeights()
+    {
+        return mWeights;
+    };
+    inline void setBoolContinousBatch(bool val)
+    {
+        mContinousBatch = val;
+    };
+
+    void getWeightPLIG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(bidir, 0, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void getWeightPLFG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(bidir, 1, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void getWeightPLCG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(bidir, 2, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void getWeightPLOG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(bidir, 3, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void getWeightPLIG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir + biDirScale, 0, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void getWeightPLFG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir + biDirScale, 1, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void getWeightPLCG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir + biDirScale, 2, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void getWeightPLOG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir + biDirScale, 3, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void getWeightRIG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir, 4, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void getWeightRFG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir, 5, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void getWeightRCG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir, 6, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void getWeightROG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value) const
+    {
+        getWeight(getWeightPosition(nlbidir, 7, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void getBiasPLIG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 0, hiddenidx), value);
+    };
+    void getBiasPLFG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 1, hiddenidx), value);
+    };
+    void getBiasPLCG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 2, hiddenidx), value);
+    };
+    void getBiasPLOG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 3, hiddenidx), value);
+    };
+    void getBiasRIG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 4, hiddenidx), value);
+    };
+    void getBiasRFG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 5, hiddenidx), value);
+    };
+    void getBiasRCG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 6, hiddenidx), value);
+    };
+    void getBiasROG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value) const
+    {
+        getWeight(getBiasPosition(nlbidir, 7, hiddenidx), value);
+    };
+
+    virtual ~LSTMCell_Frame() {};
+
+protected:
+    // Same layout as LSTMCell_Frame_CUDA::getStartPosition(). layer is the
+    // pseudo-layer index (layer * biDirScale + direction), gate 0 to 3 are
+    // the previous layer gates and 4 to 7 the recurrent gates
+    unsigned int getStartPosition(unsigned int layer,
+                                  unsigned int gate,
+                                  bool weight) const;
+    unsigned int getWeightPosition(unsigned int layer,
+                                   unsigned int gate,
+                                   unsigned int channel,
+                                   unsigned int output,
+                                   unsigned int nbChannels) const;
+    unsigned int getBiasPosition(unsigned int layer,
+                                 unsigned int gate,
+                                 unsigned int output) const;
+    void getWeight(unsigned int pos, BaseTensor& value) const;
+    void setWeight(unsigned int pos, BaseTensor& value);
+
+    void setWeightPLIG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value)
+    {
+        setWeight(getWeightPosition(bidir, 0, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void setWeightPLFG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value)
+    {
+        setWeight(getWeightPosition(bidir, 1, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void setWeightPLCG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value)
+    {
+        setWeight(getWeightPosition(bidir, 2, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void setWeightPLOG_1stLayer(unsigned int inputidx,
+                                unsigned int hiddenidx,
+                                unsigned int bidir,
+                                BaseTensor& value)
+    {
+        setWeight(getWeightPosition(bidir, 3, inputidx, hiddenidx,
+                                    mInputDim), value);
+    };
+    void setWeightPLIG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir + biDirScale, 0, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void setWeightPLFG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir + biDirScale, 1, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void setWeightPLCG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir + biDirScale, 2, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void setWeightPLOG(unsigned int channelhiddenidx,
+                       unsigned int outputhiddenidx,
+                       unsigned int nlbidir,
+                       BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir + biDirScale, 3, channelhiddenidx,
+                                    outputhiddenidx,
+                                    mHiddenSize * biDirScale), value);
+    };
+    void setWeightRIG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir, 4, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void setWeightRFG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir, 5, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void setWeightRCG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir, 6, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void setWeightROG(unsigned int channelhiddenidx,
+                      unsigned int outputhiddenidx,
+                      unsigned int nlbidir,
+                      BaseTensor& value)
+    {
+        setWeight(getWeightPosition(nlbidir, 7, channelhiddenidx,
+                                    outputhiddenidx, mHiddenSize), value);
+    };
+    void setBiasPLIG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 0, hiddenidx), value);
+    };
+    void setBiasPLFG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 1, hiddenidx), value);
+    };
+    void setBiasPLCG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 2, hiddenidx), value);
+    };
+    void setBiasPLOG(unsigned int hiddenidx,
+                     unsigned int nlbidir,
+                     BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 3, hiddenidx), value);
+    };
+    void setBiasRIG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 4, hiddenidx), value);
+    };
+    void setBiasRFG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 5, hiddenidx), value);
+    };
+    void setBiasRCG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 6, hiddenidx), value);
+    };
+    void setBiasROG(unsigned int hiddenidx,
+                    unsigned int nlbidir,
+                    BaseTensor& value)
+    {
+        setWeight(getBiasPosition(nlbidir, 7, hiddenidx), value);
+    };
+
+    std::shared_ptr<Tensor<T> > mWeights;
+    Tensor<T> mDiffWeights;
+
+    std::shared_ptr<Tensor<T> > mhx;
+    Tensor<T> mDiffhx;
+    Tensor<T> mhy;
+    std::shared_ptr<Tensor<T> > mDiffhy;
+    std::shared_ptr<Tensor<T> > mcx;
+    Tensor<T> mDiffcx;
+    Tensor<T> mcy;
+    std::shared_ptr<Tensor<T> > mDiffcy;
+
+    // Outputs of each layer, {1, hiddenSize * biDirScale, batchSize,
+    // seqLength}. The last one is the cell output
+    std::vector<Tensor<T> > mLayerOutputs;
+    // Inputs of the layers > 0, after dropout
+    std::vector<Tensor<T> > mLayerInputs;
+    // Dropout masks of the layers > 0
+    std::vector<Tensor<bool> > mDropoutMasks;
+    // Activated gates (input, forget, cell, output) and cell states of each
+    // pseudo-layer, for all the time steps, saved for backPropagate()
+    std::vector<Tensor<T> > mGates;
+    std::vector<Tensor<T> > mCells;
+
+    mutable bool mContinousBatch;
+    unsigned int biDirScale = (mBidirectional ? 2 : 1);
+
+private:
+    void propagateLayer(unsigned int layer,
+                        const T* input,
+                        unsigned int inputDim,
+                        T* output);
+    void backPropagateLayer(unsigned int layer,
+                            const T* input,
+                            unsigned int inputDim,
+                            const T* diffOutput,
+                            T* diffInput,
+                            bool accumulate);
+
+    static Registrar<LSTMCell> mRegistrar;
+};
+}
+
+#endif // N2D2_LSTMCELL_FRAME_H
@@ -111,6 +111,17 @@ public:
     {
         return NULL;
     };
+    /**
+     * Fuse a zero padding of the inputs in the padding of this cell (see
+     * ConvCell::fusePadding()). Only possible when the padding is counted in
+     * the pooling, as for the average pooling.
+     *
+     * @return false if the cell model or the pooling do not support it
+    */
+    virtual bool fusePadding(int /*paddingX*/, int /*paddingY*/)
+    {
+        return false;
+    };
     virtual ~PoolCell() {};
 
 protected:
@@ -121,7 +132,7 @@ protected:
     // Stride for the pooling
     const std::vector<unsigned int> mStrideDims;
     // Padding for the pooling
-    const std::vector<unsigned int> mPaddingDims;
+    std::vector<unsigned int> mPaddingDims;
     // Pooling type
     const Pooling mPooling;
 };
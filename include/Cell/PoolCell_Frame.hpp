@@ -75,13 +75,20 @@ public:
     Interface<PoolCell_Frame_Kernels::ArgMax>* getArgMax()
     {
         initialize();   // Make sure mArgMax is populated
+        mArgMaxShared = true;
         return &mArgMax;
     };
+    bool fusePadding(int paddingX, int paddingY);
     virtual ~PoolCell_Frame();
 
 protected:
     PoolCell_Frame_Kernels::Descriptor mPoolDesc;
     Interface<PoolCell_Frame_Kernels::ArgMax> mArgMax;
+    // The max. inputs are only recorded in inference if mArgMax is used by
+    // another cell (see getArgMax())
+    bool mArgMaxShared;
+    // Specialized kernels, selected at initialize()
+    PoolCell_Frame_Kernels::Specialization mSpecialization;
 
 private:
     static Registrar<PoolCell> mRegistrar;
@@ -21,11 +21,33 @@
 #ifndef N2D2_POOLCELL_FRAME_KERNELS_H
 #define N2D2_POOLCELL_FRAME_KERNELS_H
 
+#include <vector>
+
 #include "PoolCell_Frame_Kernels_struct.hpp"
 
 namespace N2D2 {
 namespace PoolCell_Frame_Kernels {
+    // Pooling geometries with a specialized forward implementation, for a
+    // one-to-one mapping between the input channels and the outputs
+    enum Specialization {
+        Generic,
+        // 2x2 pooling with a stride of 2
+        Pool2x2Stride2,
+        // 3x3 pooling with a stride of 2
+        Pool3x3Stride2,
+        // Pooling of the whole input map, without padding
+        Global
+    };
+
+    /// Return the specialized implementation for pooling inputs of
+    /// @p inputsDims to outputs of @p outputsDims with @p desc, or Generic.
+    Specialization getSpecialization(const Descriptor& desc,
+                                     const std::vector<size_t>& inputsDims,
+                                     const std::vector<size_t>& outputsDims);
+
     // Forward
+    // A specialization other than Generic requires a one-to-one mapping:
+    // @p maps is ignored.
     template <class T>
     void forwardAverage(const T* alpha,
                         const Tensor<T>& inputs,
@@ -33,8 +55,12 @@ namespace PoolCell_Frame_Kernels {
                         const T* beta,
                         Tensor<T>& outputs,
                         bool countIncludePadding = true,
-                        const Tensor<bool>& maps = Tensor<bool>());
+                        const Tensor<bool>& maps = Tensor<bool>(),
+                        Specialization specialization = Generic);
 
+    // The index of the max. input is recorded in @p argMax, unless it is
+    // empty. With @p useArgMax, the max. input is not searched, but read
+    // from @p argMax.
     template <class T>
     void forwardMax(const T* alpha,
                     const Tensor<T>& inputs,
@@ -43,7 +69,8 @@ namespace PoolCell_Frame_Kernels {
                     Tensor<T>& outputs,
                     Tensor<ArgMax>& argMax,
                     bool useArgMax = false,
-                    const Tensor<bool>& maps = Tensor<bool>());
+                    const Tensor<bool>& maps = Tensor<bool>(),
+                    Specialization specialization = Generic);
 
     // Backward
     template <class T>
@@ -54,6 +81,7 @@ namespace PoolCell_Frame_Kernels {
                          Tensor<T>& diffOutputs,
                          bool countIncludePadding = true,
                          const Tensor<bool>& maps = Tensor<bool>());
+    // Scatter of the gradient to the max. inputs recorded by forwardMax()
     template <class T>
     void backwardMax(const T* alpha,
                      const Tensor<T>& diffInputs,
@@ -62,6 +90,20 @@ namespace PoolCell_Frame_Kernels {
                      Tensor<T>& diffOutputs,
                      const Tensor<ArgMax>& argMax,
                      const Tensor<bool>& maps = Tensor<bool>());
+
+    // In half precision, the average pooling converts its operands in bulk
+    // to float and accumulates in float (see utils/HalfConversion.hpp). The
+    // max pooling is exact.
+    template <>
+    void forwardAverage<half_float::half>(const half_float::half* alpha,
+                                          const Tensor<half_float::half>&
+                                          inputs,
+                                          const Descriptor& desc,
+                                          const half_float::half* beta,
+                                          Tensor<half_float::half>& outputs,
+                                          bool countIncludePadding,
+                                          const Tensor<bool>& maps,
+                                          Specialization specialization);
 }
 }
 
@@ -26,6 +26,7 @@
 
 #include "Cell.hpp"
 #include "utils/Registrar.hpp"
+#include "utils/Utils.hpp"
 
 namespace N2D2 {
 
@@ -33,6 +34,12 @@ class DeepNet;
 
 class ProposalCell : public virtual Cell {
 public:
+    enum NMSMethod {
+        Greedy,
+        SoftLinear,  // Soft-NMS, linear score decay
+        SoftGaussian // Soft-NMS, gaussian score decay
+    };
+
     typedef std::function
         <std::shared_ptr<ProposalCell>(const DeepNet& deepNet, const std::string&,
                                         StimuliProvider&,
@@ -115,6 +122,10 @@ protected:
     Parameter<double> mNMS_IoU_Threshold;
     Parameter<double> mScoreThreshold;
     Parameter<bool> mKeepMax;
+    /// Non-Maximum Suppression method
+    Parameter<NMSMethod> mNMS_Method;
+    /// Gaussian decay parameter of Soft-NMS (SoftGaussian method)
+    Parameter<double> mNMS_SoftSigma;
     StimuliProvider& mStimuliProvider;
 
     unsigned int mNbProposals;
@@ -133,4 +144,10 @@ protected:
 };
 }
 
+namespace {
+template <>
+const char* const EnumStrings<N2D2::ProposalCell::NMSMethod>::data[]
+    = {"Greedy", "SoftLinear", "SoftGaussian"};
+}
+
 #endif // N2D2_PROPOSALCELL_H
@@ -38,7 +38,8 @@ public:
         Max,
         Average,
         Bilinear,   // Compatible with OpenCV resize() [INTER_LINEAR] function
-        BilinearTF  // Compatible with TensorFlow crop_and_resize() function
+        BilinearTF, // Compatible with TensorFlow crop_and_resize() function
+        ROIAlign    // Average of bilinear samples in each bin (Mask R-CNN)
     };
 
     typedef std::function
@@ -92,6 +93,9 @@ protected:
 
     Parameter<bool> mFlip;
     Parameter<bool> mIgnorePad;
+    /// Number of bilinear samples per bin and per dimension for the ROIAlign
+    /// pooling (0 = adaptive, ceil(ROI size / outputs size))
+    Parameter<unsigned int> mSamplingRatio;
 
     StimuliProvider& mStimuliProvider;
     // Pooling type
@@ -103,7 +107,7 @@ protected:
 namespace {
 template <>
 const char* const EnumStrings<N2D2::ROIPoolingCell::ROIPooling>::data[]
-    = {"Max", "Average", "Bilinear", "BilinearTF"};
+    = {"Max", "Average", "Bilinear", "BilinearTF", "ROIAlign"};
 }
 
 #endif // N2D2_ROIPOOLINGCELL_H
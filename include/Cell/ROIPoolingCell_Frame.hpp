@@ -62,7 +62,39 @@ public:
     virtual ~ROIPoolingCell_Frame();
 
 protected:
+    /// Bilinear interpolation sample along one dimension
+    struct BilinearSample {
+        unsigned int low;
+        unsigned int high;
+        Float_T lowWeight;
+        Float_T highWeight;
+    };
+
+    /// Geometry of a ROI, computed once and shared by all the channels
+    struct ROIBins {
+        unsigned int inputBatch;
+        // Max and Average pooling: input range [min, max[ of each output
+        std::vector<unsigned int> xMin;
+        std::vector<unsigned int> xMax;
+        std::vector<unsigned int> yMin;
+        std::vector<unsigned int> yMax;
+        // Bilinear and ROIAlign pooling: gridX (resp. gridY) consecutive
+        // samples for each output, weighted by 1/gridX (resp. 1/gridY)
+        unsigned int gridX;
+        unsigned int gridY;
+        std::vector<BilinearSample> xSamples;
+        std::vector<BilinearSample> ySamples;
+    };
+
+    void computeROIBins(unsigned int k);
+    void computeROIAlignSample(Float_T s,
+                               unsigned int size,
+                               Float_T scale,
+                               BilinearSample& sample) const;
+
     Interface<PoolCell_Frame_Kernels::ArgMax> mArgMax;
+    // ROIs geometry for each input (except the proposals)
+    std::vector<std::vector<ROIBins> > mROIBins;
 
 private:
     static Registrar<ROIPoolingCell> mRegistrar;
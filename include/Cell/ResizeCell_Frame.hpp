@@ -37,6 +37,12 @@ public:
                                 const int in_size,
                                 const float scale,
                                 ResizeCell_Frame_Kernels::PreComputed* interpolation);
+    void LinearInterpolation(const int out_size,
+                             const int in_size,
+                             ResizeCell_Frame_Kernels::PreComputed* interpolation);
+    void NearestNeighborInterpolation(const int out_size,
+                                      const int in_size,
+                                      ResizeCell_Frame_Kernels::PreComputed* interpolation);
 
     ResizeCell_Frame(const DeepNet& deepNet, const std::string& name,
                          unsigned int outputsWidth,
@@ -64,17 +70,36 @@ public:
     virtual ~ResizeCell_Frame() {};
 
 protected:
-    void propagateBilinearTF(bool inference);
-    void backPropagateBilinearTF();
-
-    void propagateNearestNeighbor(bool inference);
-    void backPropagateNearestNeighbor();
-
-    void nearestNeighbor(const Tensor<Float_T>& inputs, Tensor<Float_T>& outputs);
+    // Separable gather: interpolate the rows (x) then the columns (y) of
+    // every (channel, batch) plane of inputs, starting at the given channel
+    // offsets
+    void interpolate(const Tensor<Float_T>& inputs,
+                     unsigned int inputOffset,
+                     const std::vector<ResizeCell_Frame_Kernels::PreComputed>&
+                        xStride,
+                     const std::vector<ResizeCell_Frame_Kernels::PreComputed>&
+                        yStride,
+                     Float_T beta,
+                     Tensor<Float_T>& outputs,
+                     unsigned int outputOffset);
+    // Separable scatter-add, transpose of interpolate()
+    void interpolateBackward(const Tensor<Float_T>& diffInputs,
+                     unsigned int diffInputOffset,
+                     const std::vector<ResizeCell_Frame_Kernels::PreComputed>&
+                        xStride,
+                     const std::vector<ResizeCell_Frame_Kernels::PreComputed>&
+                        yStride,
+                     Float_T beta,
+                     Tensor<Float_T>& diffOutputs);
 
 protected:
+    // Per output row/column source indexes and weights, computed in
+    // initialize()
     std::vector<ResizeCell_Frame_Kernels::PreComputed> mYStride;
     std::vector<ResizeCell_Frame_Kernels::PreComputed> mXStride;
+    // NearestNeighbor backward resizes the gradient to the input size
+    std::vector<ResizeCell_Frame_Kernels::PreComputed> mDiffYStride;
+    std::vector<ResizeCell_Frame_Kernels::PreComputed> mDiffXStride;
     Float_T mScaleX;
     Float_T mScaleY;
 
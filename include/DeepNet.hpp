@@ -79,7 +79,12 @@ public:
     void spikeCodingCompare(const std::string& dirName, unsigned int idx) const;
 
     void fuseBatchNormWithConv();
+    void fuseElemWiseWithConv();
+    void fusePaddingWithConvPool();
+    void setElemWiseInPlace(bool inference = false);
     void removeDropout();
+    void keepConvDataLayouts();
+    void planInferenceMemory();
 
     // Setters
     void setDatabase(const std::shared_ptr<Database>& database)
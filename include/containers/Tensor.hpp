@@ -65,6 +65,16 @@
 namespace N2D2 {
 template <class T> class Tensor;
 
+namespace TensorLayout {
+    /// Memory layouts of the data, see containers/TensorLayout.hpp
+    enum Layout {
+        NCHW,
+        NHWC,
+        NCHW8c,
+        NCHW16c
+    };
+}
+
 /**
  * BaseDataTensor is a simple polymorphic wrapper around std::vector
  * Its purpose is to be able to store a pointer to any type of std::vector.
@@ -245,6 +255,17 @@ public:
     {
         (*mValid) = false;
     };
+    /// Memory layout of the data. The dimensions remain {X, Y, Z, B} whatever
+    /// the layout. Only the ConvCell_Frame inference kernels produce or accept
+    /// data in another layout than NCHW (see ConvCell::keepOutputsLayout()).
+    TensorLayout::Layout getLayout() const
+    {
+        return (*mLayout);
+    };
+    void setLayout(TensorLayout::Layout layout)
+    {
+        (*mLayout) = layout;
+    };
     virtual const std::type_info* getType() const = 0;
 #ifdef CUDA
     virtual BaseTensor* newCuda() const = 0;
@@ -256,9 +277,13 @@ protected:
                const std::shared_ptr<bool>& valid
                     = std::make_shared<bool>(false),
                size_t size = 0,
-               size_t sizeM1 = 0)
+               size_t sizeM1 = 0,
+               const std::shared_ptr<TensorLayout::Layout>& layout
+                    = std::make_shared<TensorLayout::Layout>(
+                                                        TensorLayout::NCHW))
         : mDims(dims),
           mValid(valid),
+          mLayout(layout),
           mSize(size),
           mSizeM1(sizeM1) {}
     size_t computeSize()
@@ -296,6 +321,7 @@ protected:
 protected:
     std::vector<size_t> mDims;
     const std::shared_ptr<bool> mValid;
+    const std::shared_ptr<TensorLayout::Layout> mLayout;
 
     // Cached data
     size_t mSize;
@@ -370,6 +396,16 @@ public:
     virtual void save(std::ostream& stream) const;
     virtual void load(std::istream& stream);
     void swap(Tensor<T>& tensor);
+    /**
+     * Use the data of @p storage, starting at @p offset, instead of the
+     * tensor own data, which is released. The dimensions are unchanged and
+     * the content is undefined. As the tensor object itself is not replaced,
+     * every object referring to it uses the new data.
+     * The storage is shared: resize(), reserve() and clear() on the bound
+     * tensor ignore @p offset and act on the whole storage (only an assert
+     * guards against it, in debug builds).
+    */
+    void bindData(const Tensor<T>& storage, size_t offset = 0);
     Tensor<T> clone() const;
     // Return type should be "reference" (not T&), in order to ensure it works
     // for std::vector<bool>, which is a special case...
@@ -423,7 +459,8 @@ protected:
              const std::shared_ptr<bool>& valid,
              size_t dataOffset,
              size_t size,
-             size_t sizeM1);
+             size_t sizeM1,
+             const std::shared_ptr<TensorLayout::Layout>& layout);
     
 
     template <class CV_T, class U,
@@ -458,8 +495,8 @@ protected:
     template <class U> friend class Tensor;
 
 protected:
-    const std::shared_ptr<DataTensor<T> > mData;
-    const size_t mDataOffset;
+    std::shared_ptr<DataTensor<T> > mData;
+    size_t mDataOffset;
 };
 
 template <class T>
@@ -512,7 +549,8 @@ tensor_cast(const BaseTensor& base)
         base.mValid,
         0,
         base.mSize,
-        base.mSizeM1);
+        base.mSizeM1,
+        base.mLayout);
 }
 
 template <class T>
@@ -552,7 +590,8 @@ Tensor<T> tensor_cast_nocopy(const BaseTensor& base)
         base.mValid,
         0,
         base.mSize,
-        base.mSizeM1);
+        base.mSizeM1,
+        base.mLayout);
 }
 } // End namespace N2D2
 
@@ -0,0 +1,92 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_TENSORLAYOUT_H
+#define N2D2_TENSORLAYOUT_H
+
+#include <vector>
+
+#include "containers/Tensor.hpp"
+#include "utils/Utils.hpp"
+
+namespace N2D2 {
+/**
+ * Memory layouts for the CPU kernels.
+ *
+ * A Tensor is always stored in the X, Y, Z, B order (X being the fastest
+ * varying dimension), which corresponds to the NCHW layout. A tensor in another
+ * layout is stored as a Tensor with permuted and/or blocked dimensions:
+ * - NHWC: {Z, X, Y, B};
+ * - NCHW8c and NCHW16c: {c, X, Y, ceil(Z / c), B}, with c = 8 or 16 channels
+ *   per block, the channels of the last block being zero-padded.
+*/
+namespace TensorLayout {
+    // The Layout enum is defined in containers/Tensor.hpp, as the layout of
+    // the data of a tensor (BaseTensor::getLayout())
+
+    // Generic enum stream operators, see Utils.hpp
+    using ::operator<<;
+    using ::operator>>;
+
+    /// Return the number of channels per block (1 for NCHW and NHWC)
+    unsigned int blockSize(Layout layout);
+
+    /// Return the dimensions of a {X, Y, Z, B} tensor in @p layout
+    std::vector<size_t> dims(const std::vector<size_t>& dims, Layout layout);
+
+    /**
+     * Convert a {X, Y, Z, B} tensor to @p layout
+     *
+     * @param tensor        Tensor in the NCHW layout
+     * @param layout        Destination layout
+     * @param dst           Destination tensor, resized if necessary
+    */
+    template <class T>
+    void toLayout(const Tensor<T>& tensor, Layout layout, Tensor<T>& dst);
+
+    /**
+     * Convert a tensor in @p layout back to the NCHW layout
+     *
+     * @param tensor        Tensor in @p layout
+     * @param layout        Source layout
+     * @param dst           Destination tensor, with {X, Y, Z, B} dimensions
+    */
+    template <class T>
+    void fromLayout(const Tensor<T>& tensor, Layout layout, Tensor<T>& dst);
+
+    /**
+     * Return a tensor sharing the data of @p tensor, with the dimensions of
+     * these data in tensor.getLayout(). The tensor must have no padding
+     * channel in this layout.
+     *
+     * @param tensor        {X, Y, Z, B} tensor, with its data in any layout
+    */
+    template <class T>
+    Tensor<T> view(const Tensor<T>& tensor);
+}
+}
+
+namespace {
+template <>
+const char* const EnumStrings<N2D2::TensorLayout::Layout>::data[]
+    = {"NCHW", "NHWC", "NCHW8c", "NCHW16c"};
+}
+
+#endif // N2D2_TENSORLAYOUT_H
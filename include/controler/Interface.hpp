@@ -239,6 +239,17 @@ protected:
 */
     }
 
+    /// Size of the stacking dimension of @p tensor (0 if it has not this
+    /// dimension, for example if it is empty)
+    static size_t stackingSize(const tensor_type& tensor)
+    {
+        const int stackingDim = (STACKING_DIM >= 0)
+            ? STACKING_DIM : (int)tensor.nbDims() + STACKING_DIM;
+
+        return (stackingDim >= 0 && stackingDim < (int)tensor.nbDims())
+            ? tensor.dims()[stackingDim] : 0;
+    }
+
     std::vector<bool> mMatchingDim;
     std::vector<tensor_type*> mData;
     std::vector<size_t> mDataRefs;
@@ -539,19 +550,63 @@ void N2D2::Interface<T, STACKING_DIM>::replace(unsigned int t,
                                                tensor_type* tensor,
                                                size_t refs)
 {
-    if (!std::equal(tensor->dims().begin(),
-                     tensor->dims().end(), mData.at(t)->dims().begin()))
-    {
+    // The non-stacking dimensions may change, as long as they still match the
+    // other tensors. An empty tensor (for example unused diff. outputs) may
+    // be replaced by a tensor with a different stacking size: the data
+    // offsets are then rebuilt.
+    const unsigned int stackingDim = (STACKING_DIM >= 0)
+        ? STACKING_DIM : tensor->nbDims() + STACKING_DIM;
+    const size_t stackingSize = this->stackingSize(*tensor);
+    bool validDims = (mData.at(t)->empty()
+        || (tensor->nbDims() == mData[t]->nbDims()
+            && stackingSize == this->stackingSize(*mData[t])));
+
+    for (unsigned int k = 0; validDims && k < mData.size(); ++k) {
+        if (k == t || mData[k]->empty())
+            continue;
+
+        if (tensor->nbDims() != mData[k]->nbDims()) {
+            validDims = false;
+            break;
+        }
+
+        for (unsigned int dim = 0; dim < tensor->nbDims(); ++dim) {
+            if (dim != stackingDim
+                && dim < mMatchingDim.size() && mMatchingDim[dim]
+                && tensor->dims()[dim] != mData[k]->dims()[dim])
+            {
+                validDims = false;
+            }
+        }
+    }
+
+    if (!validDims) {
         throw std::runtime_error("Interface::replace(): the new tensor must "
-                                 "have the same dimensions as the replaced "
-                                 "one.");
+                                 "have the same stacking dimension as the "
+                                 "replaced one and match the other tensors.");
     }
 
+    const bool rebuildOffsets = (stackingSize != this->stackingSize(*mData[t]));
+
     if (mDataRefs[t] == 0)
         delete mData[t];
 
     mData[t] = tensor;
     mDataRefs[t] = refs;
+
+    if (rebuildOffsets) {
+        mDataOffset.clear();
+
+        for (size_t k = 0; k < mData.size(); ++k) {
+            const size_t indexOffset = mDataOffset.size();
+
+            for (size_t index = 0, size = this->stackingSize(*mData[k]);
+                 index < size; ++index)
+            {
+                mDataOffset.push_back(std::make_pair(k, indexOffset));
+            }
+        }
+    }
 }
 
 template <class T, int STACKING_DIM>
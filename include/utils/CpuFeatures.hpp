@@ -0,0 +1,94 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_CPUFEATURES_H
+#define N2D2_CPUFEATURES_H
+
+#include <cstddef>
+
+#include "utils/Utils.hpp"
+
+namespace N2D2 {
+/**
+ * Runtime detection of the SIMD instruction sets, used to dispatch the CPU
+ * kernels to their most efficient implementation.
+ *
+ * The CPU (CPUID) and OS (XCR0) support is detected once, at the first call.
+ * The kernels query the instruction set to use at each call, so that it can
+ * be lowered with setMaxInstructionSet(), for testing or benchmarking.
+*/
+namespace CpuFeatures {
+    enum InstructionSet {
+        Scalar,
+        SSE4,
+        AVX2,
+        AVX512
+    };
+
+    // Generic enum stream operators, see Utils.hpp
+    using ::operator<<;
+    using ::operator>>;
+
+    /// Return the highest instruction set supported by both the CPU and the
+    /// OS. Always Scalar if N2D2 was not compiled with the SIMD kernels.
+    InstructionSet detect();
+
+    /// Return the instruction set to be used by the dispatched kernels
+    InstructionSet getInstructionSet();
+
+    /// Limit the instruction set used by the dispatched kernels. The
+    /// effective instruction set is never higher than detect().
+    void setMaxInstructionSet(InstructionSet instructionSet);
+
+    /**
+     * Select the implementation of a kernel for the current instruction set.
+     * A NULL implementation is not available, in which case the one for the
+     * next lower instruction set is selected.
+     *
+     * @param scalar        Fallback implementation, always available
+     * @param sse4          SSE4.1 implementation (or NULL)
+     * @param avx2          AVX2 + FMA + F16C implementation (or NULL)
+     * @param avx512        AVX-512F implementation (or NULL)
+     * @return Selected implementation
+    */
+    template <class Func>
+    Func select(Func scalar, Func sse4, Func avx2, Func avx512)
+    {
+        const InstructionSet instructionSet = getInstructionSet();
+
+        if (instructionSet >= AVX512 && avx512 != NULL)
+            return avx512;
+        else if (instructionSet >= AVX2 && avx2 != NULL)
+            return avx2;
+        else if (instructionSet >= SSE4 && sse4 != NULL)
+            return sse4;
+        else
+            return scalar;
+    }
+}
+}
+
+namespace {
+template <>
+const char* const EnumStrings<N2D2::CpuFeatures::InstructionSet>::data[]
+    = {"Scalar", "SSE4", "AVX2", "AVX512"};
+}
+
+#endif // N2D2_CPUFEATURES_H
@@ -0,0 +1,150 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_GEMM_H
+#define N2D2_GEMM_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "third_party/half.hpp"
+
+namespace N2D2 {
+namespace Gemm {
+    enum Transpose {
+        NoTrans,
+        Trans
+    };
+
+    /**
+     * General matrix multiplication on row-major matrices:
+     * C = alpha * op(A) * op(B) + beta * C
+     * with op(A) a M x K matrix, op(B) a K x N matrix and C a M x N matrix.
+     *
+     * A and B are packed in cache-sized blocks and the product is computed
+     * with a register-blocked micro-kernel, in parallel with OpenMP over
+     * independent tiles of C. Each element of C is always accumulated in the
+     * same order, so that the result does not depend on the number of
+     * threads.
+     *
+     * @param transA        If Trans, A is stored as a K x M matrix
+     * @param transB        If Trans, B is stored as a N x K matrix
+     * @param M             Number of rows of op(A) and C
+     * @param N             Number of columns of op(B) and C
+     * @param K             Number of columns of op(A) and rows of op(B)
+     * @param alpha         Scaling factor for op(A) * op(B)
+     * @param A             Pointer to the first element of A
+     * @param lda           Leading dimension (row stride) of A
+     * @param B             Pointer to the first element of B
+     * @param ldb           Leading dimension (row stride) of B
+     * @param beta          Scaling factor for C. If 0, C is not read and may
+     *                      be uninitialized
+     * @param C             Pointer to the first element of C
+     * @param ldc           Leading dimension (row stride) of C
+    */
+    template <class T>
+    void gemm(Transpose transA,
+              Transpose transB,
+              std::size_t M,
+              std::size_t N,
+              std::size_t K,
+              const T& alpha,
+              const T* A,
+              std::size_t lda,
+              const T* B,
+              std::size_t ldb,
+              const T& beta,
+              T* C,
+              std::size_t ldc);
+
+    /// The half precision operands are converted in bulk to float (see
+    /// HalfConversion) and the product is computed and accumulated in float
+    template <>
+    void gemm<half_float::half>(Transpose transA,
+                                Transpose transB,
+                                std::size_t M,
+                                std::size_t N,
+                                std::size_t K,
+                                const half_float::half& alpha,
+                                const half_float::half* A,
+                                std::size_t lda,
+                                const half_float::half* B,
+                                std::size_t ldb,
+                                const half_float::half& beta,
+                                half_float::half* C,
+                                std::size_t ldc);
+
+    /**
+     * Integer matrix multiplication on row-major matrices, with 8 bits
+     * operands and 32 bits accumulators:
+     * C = op(A) * op(B) + (accumulate ? C : 0)
+     *
+     * The blocking is the same as gemm(). The result is exact, as long as the
+     * sums fit in an int32_t.
+     *
+     * @tparam TA           std::int8_t or std::uint8_t
+     * @tparam TB           std::int8_t or std::uint8_t (one of TA and TB
+     *                      must be std::int8_t)
+     * @param accumulate    If false, C is not read and may be uninitialized
+    */
+    template <class TA, class TB>
+    void gemmInt8(Transpose transA,
+                  Transpose transB,
+                  std::size_t M,
+                  std::size_t N,
+                  std::size_t K,
+                  const TA* A,
+                  std::size_t lda,
+                  const TB* B,
+                  std::size_t ldb,
+                  bool accumulate,
+                  std::int32_t* C,
+                  std::size_t ldc);
+
+    /**
+     * Convert @p size values to the integer type TI, for gemmInt8().
+     *
+     * @return false if a value is not an integer representable in TI, in
+     *         which case @p dst is partially written
+    */
+    template <class TI, class T>
+    bool toInteger(std::size_t size, const T* src, TI* dst)
+    {
+        for (std::size_t i = 0; i < size; ++i) {
+            const double value = static_cast<double>(src[i]);
+
+            if (!(value >= std::numeric_limits<TI>::min()
+                  && value <= std::numeric_limits<TI>::max())
+                || value != std::floor(value))
+            {
+                return false;
+            }
+
+            dst[i] = static_cast<TI>(value);
+        }
+
+        return true;
+    }
+}
+}
+
+#endif // N2D2_GEMM_H
@@ -0,0 +1,67 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#ifndef N2D2_HALFCONVERSION_H
+#define N2D2_HALFCONVERSION_H
+
+#include <cstddef>
+
+#include "third_party/half.hpp"
+
+namespace N2D2 {
+/**
+ * Bulk conversions between half_float::half and float.
+ *
+ * The half precision kernels store their data in 16 bits, but compute in
+ * float: the operands are converted in bulk, which avoids the per-operation
+ * float round-trip of the software half arithmetic.
+ *
+ * The conversions use the F16C instructions when available (AVX2 instruction
+ * set, see CpuFeatures) and bit manipulations otherwise. Both give the same
+ * results: float to half rounds to nearest even (unlike the half_float::half
+ * constructor, which truncates), with overflow to infinity.
+*/
+namespace HalfConversion {
+    /// dst[i] = src[i], exact
+    void toFloat(const half_float::half* src, std::size_t size, float* dst);
+
+    /// dst[i] = src[i], rounded to nearest even
+    void fromFloat(const float* src, std::size_t size, half_float::half* dst);
+
+    /// Convert a @p rows x @p cols block with a row stride (leading
+    /// dimension) of @p ldSrc to a contiguous float array
+    void toFloat(const half_float::half* src,
+                 std::size_t rows,
+                 std::size_t cols,
+                 std::size_t ldSrc,
+                 float* dst);
+
+    /// Convert a contiguous @p rows x @p cols float array to a block with a
+    /// row stride of @p ldDst
+    void fromFloat(const float* src,
+                   std::size_t rows,
+                   std::size_t cols,
+                   half_float::half* dst,
+                   std::size_t ldDst);
+}
+}
+
+#endif // N2D2_HALFCONVERSION_H
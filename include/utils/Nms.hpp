@@ -0,0 +1,106 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_NMS_H
+#define N2D2_NMS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace N2D2 {
+namespace Nms {
+    enum SoftMethod {
+        Linear,
+        Gaussian
+    };
+
+    /**
+     * Bounding boxes in a structure of arrays layout, so that the IoU of a box
+     * against a block of candidates can be vectorized.
+    */
+    struct Boxes {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> w;
+        std::vector<float> h;
+
+        void reserve(std::size_t size)
+        {
+            x.reserve(size);
+            y.reserve(size);
+            w.reserve(size);
+            h.reserve(size);
+        }
+        void push_back(float x_, float y_, float w_, float h_)
+        {
+            x.push_back(x_);
+            y.push_back(y_);
+            w.push_back(w_);
+            h.push_back(h_);
+        }
+        std::size_t size() const
+        {
+            return x.size();
+        }
+    };
+
+    /**
+     * Greedy Non-Maximum Suppression.
+     * The boxes must be sorted by decreasing priority (score). A box is
+     *suppressed if its IoU with a previously kept box is above the threshold.
+     * The suppressed boxes are flagged in a bitmask, by blocks of 64
+     *candidates, and fully suppressed blocks are skipped.
+     *
+     * @param boxes         Boxes sorted by decreasing priority
+     * @param threshold     IoU threshold
+     * @param maxKeep       Maximum number of boxes to keep (0 = no limit)
+     * @return Indexes of the kept boxes, in priority order
+    */
+    std::vector<unsigned int> nms(const Boxes& boxes,
+                                  double threshold,
+                                  unsigned int maxKeep = 0);
+
+    /**
+     * Soft-NMS (N. Bodla et al., "Soft-NMS - Improving Object Detection With
+     *One Line of Code", ICCV 2017).
+     * Instead of being suppressed, the boxes overlapping a kept box have their
+     *score decayed: by (1 - IoU) when the IoU is above the threshold (Linear),
+     *or by exp(-IoU^2 / sigma) (Gaussian). The boxes do not need to be sorted.
+     *
+     * @param boxes         Boxes
+     * @param scores        Scores of the boxes, decayed in place
+     * @param method        Score decay method
+     * @param threshold     IoU threshold (Linear method)
+     * @param sigma         Gaussian decay parameter (Gaussian method)
+     * @param scoreThreshold Boxes with a (decayed) score below are discarded
+     * @param maxKeep       Maximum number of boxes to keep (0 = no limit)
+     * @return Indexes of the kept boxes, by decreasing decayed score
+    */
+    std::vector<unsigned int> softNms(const Boxes& boxes,
+                                      std::vector<float>& scores,
+                                      SoftMethod method,
+                                      double threshold,
+                                      double sigma,
+                                      double scoreThreshold,
+                                      unsigned int maxKeep = 0);
+}
+}
+
+#endif // N2D2_NMS_H
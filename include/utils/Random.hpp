@@ -25,6 +25,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <stdexcept>
+#include <vector>
 
 #define MT_RAND_MAX 0xFFFFFFFF
 
@@ -105,6 +106,55 @@ namespace Random {
      * @return 1 with probability p and 0 with probability 1-p
     */
     bool randBernoulli(double p = 0.5);
+
+    /**
+     * Counter-based Philox4x32-10 pseudorandom number generator.
+     * The output only depends on the (counter, key) pair and not on an
+     *internal state, so that any part of a random sequence can be generated
+     *independently and in parallel. The state of the Mersenne Twister
+     *generator is not modified.
+     *
+     * @param counter       128-bit counter
+     * @param key           64-bit key
+     * @param output        Four uniformly distributed 32-bit integers
+    */
+    void philox(const unsigned int counter[4],
+                const unsigned int key[2],
+                unsigned int output[4]);
+
+    /**
+     * Generates 32 bit-packed Bernoulli random numbers with the Philox
+     *generator. Bit i of the result is the element (32 * word + i) of the
+     *Bernoulli sequence defined by the seed and the stream.
+     *
+     * @param seed          Seed of the sequence (Philox key)
+     * @param stream        Sub-sequence index (for example a step number)
+     * @param word          Index of the 32-bit word in the sequence
+     * @param p             Probability for a bit to be 1
+     * @return Bernoulli random bits
+    */
+    unsigned int randBernoulliWord(unsigned long long seed,
+                                   unsigned long long stream,
+                                   unsigned long long word,
+                                   double p = 0.5);
+
+    /**
+     * Generates a bit-packed Bernoulli mask of size elements, in parallel.
+     * Element n is bit (n % 32) of mask[n / 32], which is the same as
+     *randBernoulliWord(seed, stream, n / 32, p). The unused bits of the last
+     *word are set to 0.
+     *
+     * @param seed          Seed of the sequence (Philox key)
+     * @param stream        Sub-sequence index (for example a step number)
+     * @param p             Probability for a bit to be 1
+     * @param size          Number of elements in the mask
+     * @param mask          Bit-packed mask, resized to (size + 31) / 32 words
+    */
+    void randBernoulliMask(unsigned long long seed,
+                           unsigned long long stream,
+                           double p,
+                           size_t size,
+                           std::vector<unsigned int>& mask);
 }
 }
 
@@ -0,0 +1,86 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_REDUCTION_H
+#define N2D2_REDUCTION_H
+
+#include <algorithm>
+#include <vector>
+
+namespace N2D2 {
+/**
+ * Helpers for the deterministic parallel reductions of the CPU kernels.
+ *
+ * When a reduction has fewer independent accumulators than MIN_WORK_ITEMS,
+ * its reduction dimension is split in chunks that are computed in parallel.
+ * The partitioning only depends on the problem size and not on the number of
+ * threads, and the partial results are summed in a fixed order, so that the
+ * results do not depend on the number of threads.
+*/
+namespace Reduction {
+    /// Minimum number of independent work items of a reduction
+    const unsigned int MIN_WORK_ITEMS = 256;
+
+    /// Return the number of rows of each chunk of a reduction over
+    /// @p nbRows rows, with @p nbItems independent accumulators
+    inline unsigned int chunkSize(unsigned int nbItems, unsigned int nbRows)
+    {
+        if (nbItems == 0 || nbItems >= MIN_WORK_ITEMS)
+            return std::max(nbRows, 1U);
+
+        const unsigned int nbChunks = std::min(nbRows,
+            (MIN_WORK_ITEMS + nbItems - 1) / nbItems);
+
+        return (nbChunks > 1) ? (nbRows + nbChunks - 1) / nbChunks
+                              : std::max(nbRows, 1U);
+    }
+
+    /// Sum @p nbPartials consecutive partial results of @p partialSize
+    /// elements, pairwise in a fixed binary tree order.
+    /// The result is stored in the first partial result.
+    template <class T>
+    void treeReduce(std::vector<T>& partials,
+                    unsigned int nbPartials,
+                    unsigned int partialSize)
+    {
+        for (unsigned int stride = 1; stride < nbPartials; stride *= 2) {
+            const unsigned int nbPairs = (nbPartials - stride + 2 * stride - 1)
+                                         / (2 * stride);
+            const unsigned int size = nbPairs * partialSize;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 4096)
+#else
+#pragma omp parallel for if (nbPairs > 1 && size > 4096)
+#endif
+            for (int pair = 0; pair < (int)nbPairs; ++pair) {
+                for (unsigned int index = 0; index < partialSize; ++index) {
+                    const unsigned int dst = 2 * stride * pair;
+
+                    partials[dst * partialSize + index]
+                        += partials[(dst + stride) * partialSize + index];
+                }
+            }
+        }
+    }
+}
+}
+
+#endif // N2D2_REDUCTION_H
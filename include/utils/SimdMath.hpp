@@ -0,0 +1,310 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_SIMDMATH_H
+#define N2D2_SIMDMATH_H
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * Portable SIMD building blocks for the CPU kernels.
+ *
+ * The max. errors of the math functions are given against the correctly
+ * rounded result, measured over their range. They are the same for
+ * every vector width.
+ *
+ * The kernels are written once, as templates on the vector width W (in
+ * floats), with the GCC vector extensions. They are instantiated for each
+ * instruction set with N2D2_SIMD_KERNEL() and the implementation is selected
+ * at runtime with CpuFeatures::select():
+ *
+ *     template <std::size_t W>
+ *     N2D2_SIMD_INLINE void myKernel(float* data, std::size_t size) {...}
+ *
+ *     N2D2_SIMD_KERNEL(myKernel, (float* data, std::size_t size),
+ *                      (data, size))
+ *
+ *     CpuFeatures::select(&myKernelScalar, N2D2_SIMD_KERNELS(myKernel))
+ *
+ * Everything called from a kernel must be inlined (N2D2_SIMD_INLINE), so that
+ * it is compiled for the instruction set of the kernel.
+ *
+ * Without GCC >= 9 on x86, N2D2_SIMD is not defined and the kernels list is
+ * empty (only the scalar implementation is available).
+*/
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9                 \
+    && (defined(__x86_64__) || defined(__i386__))
+#define N2D2_SIMD
+
+#define N2D2_SIMD_INLINE inline __attribute__((always_inline))
+#define N2D2_SIMD_TARGET_SSE4 __attribute__((target("sse4.1")))
+#define N2D2_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define N2D2_SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+
+#define N2D2_SIMD_KERNEL(name, params, args)                                   \
+    N2D2_SIMD_TARGET_SSE4 void name##_SSE4 params { name<4> args; }           \
+    N2D2_SIMD_TARGET_AVX2 void name##_AVX2 params { name<8> args; }           \
+    N2D2_SIMD_TARGET_AVX512 void name##_AVX512 params { name<16> args; }
+
+#define N2D2_SIMD_KERNELS(name) &name##_SSE4, &name##_AVX2, &name##_AVX512
+#else
+#define N2D2_SIMD_KERNEL(name, params, args)
+#define N2D2_SIMD_KERNELS(name) NULL, NULL, NULL
+#endif
+
+#ifdef N2D2_SIMD
+// Vectors are only passed by value between inlined functions: the ABI is
+// irrelevant.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace N2D2 {
+namespace Simd {
+    template <std::size_t W> struct Vec {
+        typedef float Float __attribute__((vector_size(W * sizeof(float))));
+        typedef int Int __attribute__((vector_size(W * sizeof(int))));
+    };
+
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float load(const float* data)
+    {
+        typename Vec<W>::Float x;
+        std::memcpy(&x, data, sizeof(x));
+        return x;
+    }
+
+    template <std::size_t W>
+    N2D2_SIMD_INLINE void store(float* data, typename Vec<W>::Float x)
+    {
+        std::memcpy(data, &x, sizeof(x));
+    }
+
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float
+    min(typename Vec<W>::Float x, typename Vec<W>::Float y)
+    {
+        return (x < y) ? x : y;
+    }
+
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float
+    max(typename Vec<W>::Float x, typename Vec<W>::Float y)
+    {
+        return (x > y) ? x : y;
+    }
+
+    /// Round toward -infinity, for |x| < 2^31
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float floor(typename Vec<W>::Float x)
+    {
+        typedef typename Vec<W>::Float Float;
+        typedef typename Vec<W>::Int Int;
+
+        const Float t = __builtin_convertvector(__builtin_convertvector(x, Int),
+                                                Float);
+        return (t > x) ? t - 1.0f : t;
+    }
+
+    /**
+     * Exponential, Cephes expf() algorithm: exp(x) = 2^n * exp(r), with
+     * |r| <= ln(2)/2 and a degree 7 polynomial for exp(r).
+     * Max. error: 1 ULP for x in [-87.3, 88.3]. The result is 0 below
+     * ln(FLT_MIN) (no denormals) and saturates to 2.4e38 above 88.37 (no
+     * overflow).
+    */
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float exp(typename Vec<W>::Float x)
+    {
+        typedef typename Vec<W>::Float Float;
+        typedef typename Vec<W>::Int Int;
+
+        const float expHi = 88.3762626647949f;
+        const float expLo = -87.3365447505531f; // ln(FLT_MIN)
+
+        Float xc = (x > expHi) ? expHi : x;
+        xc = (xc < expLo) ? expLo : xc;
+
+        const Float n = floor<W>(xc * 1.44269504088896341f + 0.5f);
+        Float r = xc - n * 0.693359375f;
+        r = r + n * 2.12194440e-4f;
+
+        Float p = r * 1.9875691500e-4f + 1.3981999507e-3f;
+        p = p * r + 8.3334519073e-3f;
+        p = p * r + 4.1665795894e-2f;
+        p = p * r + 1.6666665459e-1f;
+        p = p * r + 5.0000001201e-1f;
+        p = p * (r * r) + r + 1.0f;
+
+        // 2^n, built from the exponent bits
+        const Int pow2n = (__builtin_convertvector(n, Int) + 127) << 23;
+        const Float result = p * (Float)pow2n;
+
+        return (Float)((Int)result & (x >= expLo));
+    }
+
+    /**
+     * Natural logarithm for x normal and > 0, Cephes logf() algorithm:
+     * log(x) = e * ln(2) + log(1 + m), with sqrt(1/2) <= 1 + m < sqrt(2)
+     * and a degree 9 polynomial for log(1 + m).
+     * Max. error: 1 ULP.
+    */
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float log(typename Vec<W>::Float x)
+    {
+        typedef typename Vec<W>::Float Float;
+        typedef typename Vec<W>::Int Int;
+
+        const Int ix = (Int)x;
+        const Float e = __builtin_convertvector(((ix >> 23) & 0xff) - 126,
+                                                Float);
+        // Mantissa in [0.5, 1[
+        const Float m = (Float)((ix & 0x007fffff) | 0x3f000000);
+        const Int small = (m < 0.707106781186547524f);
+
+        const Float ef = (small) ? e - 1.0f : e;
+        const Float f = (small) ? m + m - 1.0f : m - 1.0f;
+        const Float z = f * f;
+
+        Float y = f * 7.0376836292e-2f - 1.1514610310e-1f;
+        y = y * f + 1.1676998740e-1f;
+        y = y * f - 1.2420140846e-1f;
+        y = y * f + 1.4249322787e-1f;
+        y = y * f - 1.6668057665e-1f;
+        y = y * f + 2.0000714765e-1f;
+        y = y * f - 2.4999993993e-1f;
+        y = y * f + 3.3333331174e-1f;
+        y = y * f * z;
+
+        y = y - ef * 2.12194440e-4f;
+        y = y - 0.5f * z;
+        return f + y + ef * 0.693359375f;
+    }
+
+    /**
+     * log(1 + x) for x >= 0, accurate for small x (Goldberg's method: the
+     * rounding error of 1 + x is compensated).
+     * Max. error: 2 ULP.
+    */
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float log1p(typename Vec<W>::Float x)
+    {
+        typedef typename Vec<W>::Float Float;
+        typedef typename Vec<W>::Int Int;
+
+        const Float u = 1.0f + x;
+        const Float d = u - 1.0f;
+        const Int exact = (d == 0.0f);
+        // Avoid 0/0 (trapped FE_INVALID) in the discarded lanes
+        const Float ratio = x / ((exact) ? d + 1.0f : d);
+
+        return (exact) ? x : log<W>(u) * ratio;
+    }
+
+    /**
+     * Hyperbolic tangent:
+     * - |x| < 0.625: odd polynomial of degree 9 (Cephes tanhf());
+     * - otherwise: sign(x) * (1 - 2 / (exp(2|x|) + 1)).
+     * Max. error: 1 ULP.
+    */
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float tanh(typename Vec<W>::Float x)
+    {
+        typedef typename Vec<W>::Float Float;
+        typedef typename Vec<W>::Int Int;
+
+        const Int negative = (x < 0.0f);
+        const Float ax = (negative) ? -x : x;
+
+        // |x| >= 0.625
+        const Float large = 1.0f - 2.0f / (exp<W>(ax + ax) + 1.0f);
+
+        // |x| < 0.625
+        const Float z = x * x;
+        Float p = z * -5.70498872745e-3f + 2.06390887954e-2f;
+        p = p * z - 5.37397155531e-2f;
+        p = p * z + 1.33314422036e-1f;
+        p = p * z - 3.33332819422e-1f;
+        const Float small = p * z * ax + ax;
+
+        const Float result = (ax < 0.625f) ? small : large;
+        return (negative) ? -result : result;
+    }
+
+    /**
+     * Logistic function: 1 / (1 + exp(-x)).
+     * Max. error: 2 ULP for x >= -87.3. The result saturates to 4.2e-39
+     * below -88.37.
+    */
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float logistic(typename Vec<W>::Float x)
+    {
+        return 1.0f / (1.0f + exp<W>(-x));
+    }
+
+    /**
+     * Softplus function, computed as max(x, 0) + log(1 + exp(-|x|)), which
+     * neither overflows nor loses precision for large |x|.
+     * Max. error: 3 ULP for x >= -87.3. The result is 0 below -87.3.
+    */
+    template <std::size_t W>
+    N2D2_SIMD_INLINE typename Vec<W>::Float softplus(typename Vec<W>::Float x)
+    {
+        typedef typename Vec<W>::Float Float;
+
+        const Float ax = (x < 0.0f) ? -x : x;
+        const Float px = (x > 0.0f) ? x : 0.0f;
+
+        return px + log1p<W>(exp<W>(-ax));
+    }
+
+    /**
+     * Apply in-place the element-wise operation @p op to @p data. The last
+     * incomplete vector is processed through a zero-padded temporary, so that
+     * every element goes through the same computation.
+     *
+     * @param data          Data to transform
+     * @param size          Number of elements
+     * @param op            Functor, with an inlined member template
+     *                      Vec<W>::Float apply<W>(Vec<W>::Float)
+    */
+    template <std::size_t W, class Op>
+    N2D2_SIMD_INLINE void transform(float* data, std::size_t size,
+                                    const Op& op)
+    {
+        std::size_t i = 0;
+
+        for (; i + W <= size; i += W)
+            store<W>(data + i, op.template apply<W>(load<W>(data + i)));
+
+        if (i < size) {
+            float tail[W] = {0.0f};
+            std::memcpy(tail, data + i, (size - i) * sizeof(float));
+            store<W>(tail, op.template apply<W>(load<W>(tail)));
+            std::memcpy(data + i, tail, (size - i) * sizeof(float));
+        }
+    }
+}
+}
+
+#pragma GCC diagnostic pop
+#endif // N2D2_SIMD
+
+#endif // N2D2_SIMDMATH_H
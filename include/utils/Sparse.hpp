@@ -0,0 +1,164 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#ifndef N2D2_SPARSE_H
+#define N2D2_SPARSE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace N2D2 {
+namespace Sparse {
+    /**
+     * Sparse matrix in the Compressed Sparse Row (CSR) format.
+     * The non-zero elements of row i are values[rowPtr[i]] to
+     * values[rowPtr[i + 1] - 1], in increasing order of column, their column
+     * being stored in colIndices.
+    */
+    template <class T>
+    struct CsrMatrix {
+        std::size_t rows;
+        std::size_t cols;
+        std::vector<std::size_t> rowPtr;
+        std::vector<unsigned int> colIndices;
+        std::vector<T> values;
+
+        CsrMatrix()
+            : rows(0),
+              cols(0)
+        {
+        }
+
+        /// Return true if the matrix has no pattern
+        bool empty() const
+        {
+            return rowPtr.empty();
+        }
+
+        /// Number of stored (non-zero) elements
+        std::size_t nnz() const
+        {
+            return values.size();
+        }
+
+        /// Fraction of zero elements, in [0, 1]
+        double sparsity() const
+        {
+            return (rows * cols > 0)
+                ? 1.0 - values.size() / (double)(rows * cols) : 0.0;
+        }
+
+        void clear()
+        {
+            rows = 0;
+            cols = 0;
+            rowPtr.clear();
+            colIndices.clear();
+            values.clear();
+        }
+    };
+
+    /**
+     * Compress the row-major dense matrix A[rows x cols]: its non-zero
+     * elements define the pattern of @p csr.
+    */
+    template <class T>
+    void compress(std::size_t rows,
+                  std::size_t cols,
+                  const T* A,
+                  std::size_t lda,
+                  CsrMatrix<T>& csr);
+
+    /// Update the values of @p csr from A, keeping the pattern unchanged
+    template <class T>
+    void gather(const T* A, std::size_t lda, CsrMatrix<T>& csr);
+
+    /// Set to 0 the elements of A that are outside the pattern of @p csr
+    template <class T>
+    void applyPattern(const CsrMatrix<T>& csr, T* A, std::size_t lda);
+
+    /**
+     * Sparse by dense matrix multiplication:
+     * C = alpha * A * B + beta * C
+     * with A a sparse M x K matrix, B a K x N matrix and C a M x N matrix.
+     *
+     * The products are computed in parallel over the rows of C and are
+     * always accumulated in the same order.
+     *
+     * @param A             Sparse matrix
+     * @param N             Number of columns of B and C
+     * @param alpha         Scaling factor for A * B
+     * @param B             Pointer to the first element of B
+     * @param ldb           Leading dimension (row stride) of B
+     * @param beta          Scaling factor for C. If 0, C is not read
+     * @param C             Pointer to the first element of C
+     * @param ldc           Leading dimension (row stride) of C
+    */
+    template <class T>
+    void sparseDense(const CsrMatrix<T>& A,
+                     std::size_t N,
+                     const T& alpha,
+                     const T* B,
+                     std::size_t ldb,
+                     const T& beta,
+                     T* C,
+                     std::size_t ldc);
+
+    /**
+     * Dense by transposed sparse matrix multiplication:
+     * C = alpha * B * A^T + beta * C
+     * with A a sparse M x K matrix, B a N x K matrix and C a N x M matrix.
+     * This is the fully-connected forward pass, with the weights in A.
+     *
+     * Same parameters as sparseDense().
+    */
+    template <class T>
+    void denseSparseTrans(const CsrMatrix<T>& A,
+                          std::size_t N,
+                          const T& alpha,
+                          const T* B,
+                          std::size_t ldb,
+                          const T& beta,
+                          T* C,
+                          std::size_t ldc);
+
+    /**
+     * Dense by sparse matrix multiplication:
+     * C = alpha * B * A + beta * C
+     * with A a sparse M x K matrix, B a N x M matrix and C a N x K matrix.
+     * This is the fully-connected backward pass for the data, with the
+     * weights in A.
+     *
+     * Same parameters as sparseDense().
+    */
+    template <class T>
+    void denseSparse(const CsrMatrix<T>& A,
+                     std::size_t N,
+                     const T& alpha,
+                     const T* B,
+                     std::size_t ldb,
+                     const T& beta,
+                     T* C,
+                     std::size_t ldc);
+}
+}
+
+#endif // N2D2_SPARSE_H
@@ -18,7 +18,147 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include <vector>
+
 #include "Activation/Activation_Kernels.hpp"
+#include "utils/CpuFeatures.hpp"
+#include "utils/HalfConversion.hpp"
+#include "utils/SimdMath.hpp"
+
+#ifdef N2D2_SIMD
+// The operators below only pass vectors by value between inlined functions:
+// the ABI is irrelevant (see utils/SimdMath.hpp)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace {
+#ifdef N2D2_SIMD
+    // Number of elements processed by each OpenMP iteration
+    const std::size_t SIMD_CHUNK_SIZE = 4096;
+
+    struct TanhOp {
+        float alpha;
+
+        template <std::size_t W>
+        N2D2_SIMD_INLINE typename N2D2::Simd::Vec<W>::Float
+        apply(typename N2D2::Simd::Vec<W>::Float x) const
+        {
+            return N2D2::Simd::tanh<W>(alpha * x);
+        }
+    };
+
+    struct LogisticOp {
+        template <std::size_t W>
+        N2D2_SIMD_INLINE typename N2D2::Simd::Vec<W>::Float
+        apply(typename N2D2::Simd::Vec<W>::Float x) const
+        {
+            return N2D2::Simd::logistic<W>(x);
+        }
+    };
+
+    struct SoftplusOp {
+        template <std::size_t W>
+        N2D2_SIMD_INLINE typename N2D2::Simd::Vec<W>::Float
+        apply(typename N2D2::Simd::Vec<W>::Float x) const
+        {
+            return N2D2::Simd::softplus<W>(x);
+        }
+    };
+
+    struct RectifierOp {
+        float leakSlope;
+        float clipping;
+
+        template <std::size_t W>
+        N2D2_SIMD_INLINE typename N2D2::Simd::Vec<W>::Float
+        apply(typename N2D2::Simd::Vec<W>::Float x) const
+        {
+            typename N2D2::Simd::Vec<W>::Float positive = x;
+
+            if (clipping > 0.0f)
+                positive = (x > clipping) ? clipping : x;
+
+            return (x > 0.0f) ? positive : leakSlope * x;
+        }
+    };
+
+    struct SaturationOp {
+        float threshold;
+
+        template <std::size_t W>
+        N2D2_SIMD_INLINE typename N2D2::Simd::Vec<W>::Float
+        apply(typename N2D2::Simd::Vec<W>::Float x) const
+        {
+            const typename N2D2::Simd::Vec<W>::Float y
+                = (x > threshold) ? threshold : x;
+            return (y < -threshold) ? -threshold : y;
+        }
+    };
+
+    template <std::size_t W, class Op>
+    N2D2_SIMD_INLINE void activationKernel(float* data,
+                                           std::size_t size,
+                                           const Op& op)
+    {
+        N2D2::Simd::transform<W>(data, size, op);
+    }
+
+    N2D2_SIMD_KERNEL(activationKernel,
+        (float* data, std::size_t size, const TanhOp& op), (data, size, op))
+    N2D2_SIMD_KERNEL(activationKernel,
+        (float* data, std::size_t size, const LogisticOp& op), (data, size, op))
+    N2D2_SIMD_KERNEL(activationKernel,
+        (float* data, std::size_t size, const SoftplusOp& op), (data, size, op))
+    N2D2_SIMD_KERNEL(activationKernel,
+        (float* data, std::size_t size, const RectifierOp& op), (data, size, op))
+    N2D2_SIMD_KERNEL(activationKernel,
+        (float* data, std::size_t size, const SaturationOp& op),
+        (data, size, op))
+
+    /// Run the SIMD implementation of @p op selected for the current
+    /// instruction set, in parallel over chunks of SIMD_CHUNK_SIZE elements.
+    /// Return false if only the scalar implementation is available.
+    template <class Op>
+    bool dispatchActivation(float* data, std::size_t size, const Op& op)
+    {
+        typedef void (*Kernel)(float*, std::size_t, const Op&);
+
+        const Kernel kernel = N2D2::CpuFeatures::select<Kernel>(
+            NULL, N2D2_SIMD_KERNELS(activationKernel));
+
+        if (kernel == NULL)
+            return false;
+
+        const int nbChunks
+            = (int)((size + SIMD_CHUNK_SIZE - 1) / SIMD_CHUNK_SIZE);
+
+#pragma omp parallel for if (nbChunks > 1)
+        for (int chunk = 0; chunk < nbChunks; ++chunk) {
+            const std::size_t offset = chunk * SIMD_CHUNK_SIZE;
+
+            (*kernel)(data + offset,
+                      std::min(SIMD_CHUNK_SIZE, size - offset),
+                      op);
+        }
+
+        return true;
+    }
+#endif
+
+    /// Apply the float kernel @p func to half precision data, through a
+    /// float buffer
+    template <class Func>
+    void halfActivation(half_float::half* data, std::size_t size, Func func)
+    {
+        if (size == 0)
+            return;
+
+        std::vector<float> buffer(size);
+        N2D2::HalfConversion::toFloat(data, size, &buffer[0]);
+        func(&buffer[0], size);
+        N2D2::HalfConversion::fromFloat(&buffer[0], size, data);
+    }
+}
 
 void N2D2::rangeAveraging(double minVal,
                           double maxVal,
@@ -78,3 +218,107 @@ double N2D2::log2Round(double value, double rate, double power)
 
     return sign * std::pow(2.0, (1.0 - corr) * log2Value + corr * log2Target);
 }
+
+void N2D2::tanhActivation(float* data, std::size_t size, float alpha)
+{
+#ifdef N2D2_SIMD
+    const TanhOp op = {alpha};
+
+    if (dispatchActivation(data, size, op))
+        return;
+#endif
+
+    tanhActivation<float>(data, size, alpha);
+}
+
+void N2D2::logisticActivation(float* data, std::size_t size)
+{
+#ifdef N2D2_SIMD
+    if (dispatchActivation(data, size, LogisticOp()))
+        return;
+#endif
+
+    logisticActivation<float>(data, size);
+}
+
+void N2D2::softplusActivation(float* data, std::size_t size)
+{
+#ifdef N2D2_SIMD
+    if (dispatchActivation(data, size, SoftplusOp()))
+        return;
+#endif
+
+    softplusActivation<float>(data, size);
+}
+
+void N2D2::rectifierActivation(float* data,
+                               std::size_t size,
+                               float leakSlope,
+                               float clipping)
+{
+#ifdef N2D2_SIMD
+    const RectifierOp op = {leakSlope, clipping};
+
+    if (dispatchActivation(data, size, op))
+        return;
+#endif
+
+    rectifierActivation<float>(data, size, leakSlope, clipping);
+}
+
+void N2D2::saturationActivation(float* data,
+                                std::size_t size,
+                                float threshold)
+{
+#ifdef N2D2_SIMD
+    const SaturationOp op = {threshold};
+
+    if (dispatchActivation(data, size, op))
+        return;
+#endif
+
+    saturationActivation<float>(data, size, threshold);
+}
+
+void N2D2::tanhActivation(half_float::half* data,
+                          std::size_t size,
+                          half_float::half alpha)
+{
+    halfActivation(data, size, [alpha](float* buffer, std::size_t n) {
+        tanhActivation(buffer, n, (float)alpha);
+    });
+}
+
+void N2D2::logisticActivation(half_float::half* data, std::size_t size)
+{
+    halfActivation(data, size, [](float* buffer, std::size_t n) {
+        logisticActivation(buffer, n);
+    });
+}
+
+void N2D2::softplusActivation(half_float::half* data, std::size_t size)
+{
+    halfActivation(data, size, [](float* buffer, std::size_t n) {
+        softplusActivation(buffer, n);
+    });
+}
+
+void N2D2::rectifierActivation(half_float::half* data,
+                               std::size_t size,
+                               half_float::half leakSlope,
+                               half_float::half clipping)
+{
+    halfActivation(data, size,
+        [leakSlope, clipping](float* buffer, std::size_t n) {
+            rectifierActivation(buffer, n, (float)leakSlope, (float)clipping);
+        });
+}
+
+void N2D2::saturationActivation(half_float::half* data,
+                                std::size_t size,
+                                half_float::half threshold)
+{
+    halfActivation(data, size, [threshold](float* buffer, std::size_t n) {
+        saturationActivation(buffer, n, (float)threshold);
+    });
+}
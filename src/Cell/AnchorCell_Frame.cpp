@@ -176,6 +176,7 @@ void N2D2::AnchorCell_Frame::initialize()
     }
 
     mGT.resize(mOutputs.dimB());
+    mGTGrid.resize(mOutputs.dimB());
     mArgMaxIoU.resize({mOutputsDims[0],
                       mOutputsDims[1],
                       mAnchors.size(),
@@ -184,8 +185,11 @@ void N2D2::AnchorCell_Frame::initialize()
     {
 
         mGTClass.resize(mOutputs.dimB());
-        for(unsigned int b = 0; b <mOutputs.dimB(); ++b )
+        mGTClassGrid.resize(mOutputs.dimB());
+        for(unsigned int b = 0; b <mOutputs.dimB(); ++b ) {
             mGTClass[b].resize(mNbClass);
+            mGTClassGrid[b].resize(mNbClass);
+        }
     }
 }
 
@@ -259,18 +263,21 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
                 }
             }
             //std::cout << std::endl;
+
+            for (int c = 0; c < mNbClass; ++c)
+                mGTClassGrid[batchPos][c].build(GT[c]);
         }
 
 
-        mMaxIoUClass.resize(mOutputs.dimB());
-        for(unsigned int b = 0; b < mOutputs.dimB(); ++b)
-            mMaxIoUClass[b].assign(mNbClass, 0.0);
-    //    const unsigned int size = mOutputs.dimB() * nbAnchors;
-    //#if defined(_OPENMP) && _OPENMP >= 200805
-    //#pragma omp parallel for collapse(2) if (size > 16)
-    //#else
-    //#pragma omp parallel for if (mOutputs.dimB() > 4 && size > 16)
-    //#endif
+        const unsigned int size = mOutputs.dimB() * nbAnchors;
+        // Max. IoU for each anchor, reduced per class after the loop
+        std::vector<Float_T> maxIoUs(size, 0.0);
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (mOutputs.dimB() > 4 && size > 16)
+#endif
 
         for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos) {
                /* // DEBUG
@@ -391,38 +398,10 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
                                 : AnchorCell_Frame_Kernels::BBox_T
                                     (xa0, ya0, wa, ha);
 
-                            Float_T maxIoU = 0.0;
-                            int argMaxIoU = -1;
-                            //std::cout << "Class: " << k/(nbAnchors/mNbClass);
+                            Float_T maxIoU;
+                            const int argMaxIoU = mGTClassGrid[batchPos][classIdx]
+                                .argMaxIoU(GT[classIdx], bb, maxIoU);
 
-                            for (unsigned int l = 0, nbLabels = GT[classIdx].size();
-                                l < nbLabels; ++l)
-                            {
-                                // Ground Truth box coordinates
-                                const AnchorCell_Frame_Kernels::BBox_T& gt = GT[classIdx][l];
-
-                                const Float_T interLeft = std::max(gt.x, bb.x);
-                                const Float_T interRight = std::min(gt.x + gt.w,
-                                                                    bb.x + bb.w);
-                                const Float_T interTop = std::max(gt.y, bb.y);
-                                const Float_T interBottom = std::min(gt.y + gt.h,
-                                                                    bb.y + bb.h);
-                                if (interLeft < interRight
-                                    && interTop < interBottom)
-                                {
-                                    const Float_T interArea
-                                        = (interRight - interLeft)
-                                            * (interBottom - interTop);
-                                    const Float_T unionArea = gt.w * gt.h
-                                        + bb.w * bb.h - interArea;
-                                    const Float_T IoU = interArea / unionArea;
-
-                                    if (IoU > maxIoU) {
-                                        maxIoU = IoU;
-                                        argMaxIoU = l;
-                                    }
-                                }
-                            }
                             //Rescale Bounding Box if Feature MAP size is different than stimuli size
                             xbb *=  xOutputRatio;
                             wbb *=  xOutputRatio;
@@ -436,7 +415,8 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
                             mOutputs(xa, ya, k + 4 * nbAnchors, batchPos) = hbb;
                             mOutputs(xa, ya, k + 5 * nbAnchors, batchPos) = maxIoU;
                             mArgMaxIoU(xa, ya, k, batchPos) = argMaxIoU;
-                            mMaxIoUClass[batchPos][classIdx] = std::max(mMaxIoUClass[batchPos][classIdx], maxIoU);
+                            maxIoUs[k + batchPos * nbAnchors]
+                                = std::max(maxIoUs[k + batchPos * nbAnchors], maxIoU);
 
 /*
                         //}
@@ -585,6 +565,19 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
             }
             */
         }
+
+        mMaxIoUClass.resize(mOutputs.dimB());
+
+        for (unsigned int b = 0; b < mOutputs.dimB(); ++b) {
+            mMaxIoUClass[b].assign(mNbClass, 0.0);
+
+            for (unsigned int k = 0; k < nbAnchors; ++k) {
+                const int classIdx = k/(nbAnchors/mNbClass);
+
+                mMaxIoUClass[b][classIdx] = std::max(mMaxIoUClass[b][classIdx],
+                                                maxIoUs[k + b * nbAnchors]);
+            }
+        }
     }
     else
     {
@@ -619,11 +612,19 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
                                                         labelRect.width,
                                                         labelRect.height);
             }
-        }
 
+            mGTGrid[batchPos].build(GT);
+        }
 
-        mMaxIoU.assign(mOutputs.dimB(), 0.0);
+        const unsigned int size = mOutputs.dimB() * nbAnchors;
+        // Max. IoU for each anchor, reduced per batch position after the loop
+        std::vector<Float_T> maxIoUs(size, 0.0);
 
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (mOutputs.dimB() > 4 && size > 16)
+#endif
         for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos) {
             for (unsigned int k = 0; k < nbAnchors; ++k) {
                 const std::vector<AnchorCell_Frame_Kernels::BBox_T>& GT
@@ -714,38 +715,9 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
                                 : AnchorCell_Frame_Kernels::BBox_T
                                     (xa0, ya0, wa, ha);
 
-                            Float_T maxIoU = 0.0;
-                            int argMaxIoU = -1;
-
-                            for (unsigned int l = 0, nbLabels = GT.size();
-                                l < nbLabels; ++l)
-                            {
-                                // Ground Truth box coordinates
-                                const AnchorCell_Frame_Kernels::BBox_T& gt = GT[l];
-
-                                const Float_T interLeft = std::max(gt.x, bb.x);
-                                const Float_T interRight = std::min(gt.x + gt.w,
-                                                                    bb.x + bb.w);
-                                const Float_T interTop = std::max(gt.y, bb.y);
-                                const Float_T interBottom = std::min(gt.y + gt.h,
-                                                                    bb.y + bb.h);
-
-                                if (interLeft < interRight
-                                    && interTop < interBottom)
-                                {
-                                    const Float_T interArea
-                                        = (interRight - interLeft)
-                                            * (interBottom - interTop);
-                                    const Float_T unionArea = gt.w * gt.h
-                                        + bb.w * bb.h - interArea;
-                                    const Float_T IoU = interArea / unionArea;
-
-                                    if (IoU > maxIoU) {
-                                        maxIoU = IoU;
-                                        argMaxIoU = l;
-                                    }
-                                }
-                            }
+                            Float_T maxIoU;
+                            const int argMaxIoU = mGTGrid[batchPos]
+                                .argMaxIoU(GT, bb, maxIoU);
 
                             //Rescale Bounding Box if Feature MAP size is different than stimuli size
                             xbb *=  xOutputRatio;
@@ -760,7 +732,8 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
                             mOutputs(xa, ya, k + 4 * nbAnchors, batchPos) = hbb;
                             mOutputs(xa, ya, k + 5 * nbAnchors, batchPos) = maxIoU;
                             mArgMaxIoU(xa, ya, k, batchPos) = argMaxIoU;
-                            mMaxIoU[batchPos] = std::max(mMaxIoU[batchPos], maxIoU);
+                            maxIoUs[k + batchPos * nbAnchors]
+                                = std::max(maxIoUs[k + batchPos * nbAnchors], maxIoU);
 
                         }
                         else {
@@ -776,6 +749,13 @@ void N2D2::AnchorCell_Frame::propagate(bool inference)
                 }
             }
         }
+
+        mMaxIoU.assign(mOutputs.dimB(), 0.0);
+
+        for (unsigned int b = 0; b < mOutputs.dimB(); ++b) {
+            for (unsigned int k = 0; k < nbAnchors; ++k)
+                mMaxIoU[b] = std::max(mMaxIoU[b], maxIoUs[k + b * nbAnchors]);
+        }
     }
 
     Cell_Frame<Float_T>::propagate(inference);
@@ -965,16 +945,15 @@ void N2D2::AnchorCell_Frame::backPropagate()
     else
     {
 
+        const unsigned int size = mDiffInputs.dimB() * mNbClass;
+
+        // Positive and negative anchors for each (batchPos, cls)
+        std::vector<std::vector<Tensor<int>::Index> > positive(size);
+        std::vector< std::vector<std::pair< Tensor<int>::Index, Float_T> > >
+            negative(size);
+
 #pragma omp parallel for if (mDiffInputs.dimB() > 4)
         for (int batchPos = 0; batchPos < (int)mDiffInputs.dimB(); ++batchPos) {
-            std::vector<std::vector<Tensor<int>::Index> > positive(mNbClass,
-                                                                    std::vector<Tensor<int>::Index>(0));
-            std::vector< std::vector<std::pair< Tensor<int>::Index, Float_T> > > negative(mNbClass,
-                                                                                        std::vector<std::pair< Tensor<int>::Index,
-                                                                                        Float_T>>(0));
-            positive.resize(mNbClass);
-            negative.resize(mNbClass);
-
             for (unsigned int k = 0; k < nbAnchors; ++k) {
 
                 const int classIdx = k/(nbAnchors/mNbClass);
@@ -987,11 +966,13 @@ void N2D2::AnchorCell_Frame::backPropagate()
 
                         if (IoU >= mPositiveIoU && (mArgMaxIoU(xa, ya, k, batchPos) > -1))
                         {
-                            positive[classIdx].push_back(Tensor<int>::Index(xa, ya, k, batchPos));
+                            positive[classIdx + batchPos * mNbClass].push_back(
+                                Tensor<int>::Index(xa, ya, k, batchPos));
                         }
                         else if((mArgMaxIoU(xa, ya, k, batchPos) == -1))
                         {
-                            negative[classIdx].push_back(std::make_pair(Tensor<int>::Index(xa, ya, k, batchPos), conf));
+                            negative[classIdx + batchPos * mNbClass].push_back(
+                                std::make_pair(Tensor<int>::Index(xa, ya, k, batchPos), conf));
                         }
 
                         diffOutputsCls(xa, ya, k, batchPos) = 0.0;
@@ -1011,26 +992,41 @@ void N2D2::AnchorCell_Frame::backPropagate()
                 }
             }
 
-            if(mAnchorsStats.empty())
-                mAnchorsStats.resize(mNbClass, 0);
-            
-            for(int cls = 0; cls < mNbClass; ++cls)
-            {
-                const int nbNegative = (negative[cls].size() > positive[cls].size()*mNegativeRatioSSD) ?
-                                        positive[cls].size()*mNegativeRatioSSD
-                                        : negative[cls].size();
+        }
 
-                const int nbPositive = positive[cls].size();
+        if(mAnchorsStats.empty())
+            mAnchorsStats.resize(mNbClass, 0);
 
-                std::partial_sort(negative[cls].begin(),
-                                negative[cls].begin() + nbNegative,
-                                negative[cls].end(),
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 4)
+#else
+#pragma omp parallel for if (mDiffInputs.dimB() > 4)
+#endif
+        for (int batchPos = 0; batchPos < (int)mDiffInputs.dimB(); ++batchPos) {
+            for(int cls = 0; cls < mNbClass; ++cls)
+            {
+                std::vector<Tensor<int>::Index>& positiveCls
+                    = positive[cls + batchPos * mNbClass];
+                std::vector<std::pair< Tensor<int>::Index, Float_T> >&
+                    negativeCls = negative[cls + batchPos * mNbClass];
+
+                const int nbNegative = (negativeCls.size() > positiveCls.size()*mNegativeRatioSSD) ?
+                                        positiveCls.size()*mNegativeRatioSSD
+                                        : negativeCls.size();
+
+                const int nbPositive = positiveCls.size();
+
+                // Hard negative mining: only the set of the nbNegative
+                // highest confidence negatives matters, not their order
+                std::nth_element(negativeCls.begin(),
+                                negativeCls.begin() + nbNegative,
+                                negativeCls.end(),
                                 Utils::PairSecondPred<Tensor<int>::Index,
                                     Float_T, std::greater<Float_T> >());
 
                 for(int neg = 0; neg < nbNegative; ++ neg)
                 {
-                    Tensor<int>::Index& anchorIndex = negative[cls][neg].first;
+                    Tensor<int>::Index& anchorIndex = negativeCls[neg].first;
 
                     const unsigned int xa = anchorIndex[0];
                     const unsigned int ya = anchorIndex[1];
@@ -1042,7 +1038,7 @@ void N2D2::AnchorCell_Frame::backPropagate()
 
                 for(int pos = 0; pos < nbPositive; ++ pos)
                 {
-                    Tensor<int>::Index& anchorIndex = positive[cls][pos];
+                    Tensor<int>::Index& anchorIndex = positiveCls[pos];
 
                     const unsigned int xa = anchorIndex[0];
                     const unsigned int ya = anchorIndex[1];
@@ -1110,6 +1106,7 @@ void N2D2::AnchorCell_Frame::backPropagate()
 
                 }
 
+#pragma omp atomic
                 mAnchorsStats[cls] += nbPositive;
             }
         }
@@ -0,0 +1,173 @@
+/*
+    (C) Copyright 2013 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "Cell/AnchorCell_Frame_Kernels.hpp"
+
+N2D2::AnchorCell_Frame_Kernels::BBoxGrid::BBoxGrid()
+    : mX0(0.0f),
+      mY0(0.0f),
+      mInvCellWidth(0.0f),
+      mInvCellHeight(0.0f),
+      mNbCellsX(0),
+      mNbCellsY(0)
+{
+    // ctor
+}
+
+void N2D2::AnchorCell_Frame_Kernels::BBoxGrid::build(
+    const std::vector<BBox_T>& boxes)
+{
+    mCellsStart.clear();
+    mIndexes.clear();
+
+    if (boxes.empty()) {
+        mNbCellsX = 0;
+        mNbCellsY = 0;
+        return;
+    }
+
+    // Extent of the boxes
+    float x0 = boxes[0].x;
+    float y0 = boxes[0].y;
+    float x1 = boxes[0].x + boxes[0].w;
+    float y1 = boxes[0].y + boxes[0].h;
+
+    for (unsigned int l = 1, size = boxes.size(); l < size; ++l) {
+        x0 = std::min(x0, boxes[l].x);
+        y0 = std::min(y0, boxes[l].y);
+        x1 = std::max(x1, boxes[l].x + boxes[l].w);
+        y1 = std::max(y1, boxes[l].y + boxes[l].h);
+    }
+
+    // About one box per cell
+    const unsigned int nbCells = std::max(1U, std::min(MaxCells,
+        (unsigned int)std::ceil(std::sqrt((double)boxes.size()))));
+
+    mX0 = x0;
+    mY0 = y0;
+    mNbCellsX = nbCells;
+    mNbCellsY = nbCells;
+    mInvCellWidth = (x1 > x0) ? nbCells / (x1 - x0) : 0.0f;
+    mInvCellHeight = (y1 > y0) ? nbCells / (y1 - y0) : 0.0f;
+
+    // Count the boxes in each cell
+    mCellsStart.assign(mNbCellsX * mNbCellsY + 1, 0);
+
+    for (unsigned int l = 0, size = boxes.size(); l < size; ++l) {
+        const BBox_T& box = boxes[l];
+
+        // A box with a negative size cannot overlap any box
+        if (!(box.w >= 0.0f && box.h >= 0.0f))
+            continue;
+
+        for (unsigned int cy = cellY(box.y); cy <= cellY(box.y + box.h); ++cy) {
+            for (unsigned int cx = cellX(box.x); cx <= cellX(box.x + box.w);
+                ++cx)
+            {
+                ++mCellsStart[cx + cy * mNbCellsX + 1];
+            }
+        }
+    }
+
+    for (unsigned int i = 1, size = mCellsStart.size(); i < size; ++i)
+        mCellsStart[i] += mCellsStart[i - 1];
+
+    // Fill the cells, in increasing box index order
+    mIndexes.resize(mCellsStart.back());
+    std::vector<unsigned int> cellsEnd(mCellsStart.begin(),
+                                       mCellsStart.end() - 1);
+
+    for (unsigned int l = 0, size = boxes.size(); l < size; ++l) {
+        const BBox_T& box = boxes[l];
+
+        // A box with a negative size cannot overlap any box
+        if (!(box.w >= 0.0f && box.h >= 0.0f))
+            continue;
+
+        for (unsigned int cy = cellY(box.y); cy <= cellY(box.y + box.h); ++cy) {
+            for (unsigned int cx = cellX(box.x); cx <= cellX(box.x + box.w);
+                ++cx)
+            {
+                mIndexes[cellsEnd[cx + cy * mNbCellsX]++] = l;
+            }
+        }
+    }
+}
+
+int N2D2::AnchorCell_Frame_Kernels::BBoxGrid::argMaxIoU(
+    const std::vector<BBox_T>& boxes,
+    const BBox_T& bb,
+    float& maxIoU) const
+{
+    maxIoU = 0.0f;
+    int argMax = -1;
+
+    if (mCellsStart.empty())
+        return argMax;
+
+    const unsigned int cx0 = cellX(bb.x);
+    const unsigned int cy0 = cellY(bb.y);
+    const unsigned int cx1 = cellX(bb.x + bb.w);
+    const unsigned int cy1 = cellY(bb.y + bb.h);
+
+    for (unsigned int cy = cy0; cy <= cy1; ++cy) {
+        for (unsigned int cx = cx0; cx <= cx1; ++cx) {
+            const unsigned int cell = cx + cy * mNbCellsX;
+
+            for (unsigned int i = mCellsStart[cell];
+                i < mCellsStart[cell + 1]; ++i)
+            {
+                const unsigned int l = mIndexes[i];
+                const BBox_T& gt = boxes[l];
+
+                // A box registered in several cells is only tested in the
+                // cell containing the top-left corner of the intersection
+                if (std::max(cellX(gt.x), cx0) != cx
+                    || std::max(cellY(gt.y), cy0) != cy)
+                {
+                    continue;
+                }
+
+                const float interLeft = std::max(gt.x, bb.x);
+                const float interRight = std::min(gt.x + gt.w, bb.x + bb.w);
+                const float interTop = std::max(gt.y, bb.y);
+                const float interBottom = std::min(gt.y + gt.h, bb.y + bb.h);
+
+                if (interLeft < interRight && interTop < interBottom) {
+                    const float interArea = (interRight - interLeft)
+                                                * (interBottom - interTop);
+                    const float unionArea = gt.w * gt.h + bb.w * bb.h
+                                                - interArea;
+                    const float IoU = interArea / unionArea;
+
+                    if (IoU > maxIoU || (IoU == maxIoU && (int)l < argMax)) {
+                        maxIoU = IoU;
+                        argMax = l;
+                    }
+                }
+            }
+        }
+    }
+
+    return argMax;
+}
@@ -18,11 +18,113 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include <algorithm>
+#include <vector>
+
 #include "Cell/BatchNormCell_Frame.hpp"
 #include "DeepNet.hpp"
 #include "GradientCheck.hpp"
 #include "Solver/SGDSolver_Frame.hpp"
 #include "third_party/half.hpp"
+#include "utils/Reduction.hpp"
+
+namespace {
+    // Number of contiguous elements of a map reduced at once (in cache)
+    const unsigned int BLOCK_SIZE = 1024;
+
+    /// Partition of the data of a channel, nbBatch maps of mapSize elements,
+    /// in tiles of blocks (see Reduction::chunkSize()). With fewer channels
+    /// than Reduction::MIN_WORK_ITEMS, the tiles are reduced in parallel.
+    struct Tiling {
+        Tiling(unsigned int mapSize, unsigned int nbBatch,
+               unsigned int nbChannels)
+            : mapSize(mapSize),
+              nbBlocksPerMap(std::max(1U, (mapSize + BLOCK_SIZE - 1)
+                                          / BLOCK_SIZE)),
+              nbBlocks(nbBatch * nbBlocksPerMap)
+        {
+            tileSize = N2D2::Reduction::chunkSize(nbChannels, nbBlocks);
+            nbTiles = std::max(1U, (nbBlocks + tileSize - 1) / tileSize);
+        }
+
+        /// Batch position, offset in the map and size of a block
+        void block(unsigned int index,
+                   unsigned int& batchPos,
+                   unsigned int& offset,
+                   unsigned int& size) const
+        {
+            batchPos = index / nbBlocksPerMap;
+            offset = (index % nbBlocksPerMap) * BLOCK_SIZE;
+            size = std::min(BLOCK_SIZE, mapSize - offset);
+        }
+
+        unsigned int mapSize;
+        unsigned int nbBlocksPerMap;
+        unsigned int nbBlocks;
+        unsigned int tileSize;
+        unsigned int nbTiles;
+    };
+
+    /// Number of values, mean and sum of the squared deviations from the mean
+    template <class T>
+    struct Moments {
+        std::size_t count;
+        T mean;
+        T m2;
+    };
+
+    /// Moments of a block, computed in two passes over the block (in cache)
+    template <class T, class ParamT>
+    Moments<ParamT> blockMoments(const T* data, unsigned int size)
+    {
+        Moments<ParamT> moments = {size, ParamT(0.0), ParamT(0.0)};
+
+        if (size == 0)
+            return moments;
+
+        ParamT sum(0.0);
+
+        for (unsigned int i = 0; i < size; ++i)
+            sum += (ParamT)data[i];
+
+        moments.mean = sum / (ParamT)size;
+
+        for (unsigned int i = 0; i < size; ++i) {
+            const ParamT zeroed = (ParamT)data[i] - moments.mean;
+            moments.m2 += zeroed * zeroed;
+        }
+
+        return moments;
+    }
+
+    /// Merge the moments of two disjoint sets of values (Chan et al.
+    /// parallel algorithm), which is stable for large counts
+    template <class ParamT>
+    void mergeMoments(Moments<ParamT>& moments, const Moments<ParamT>& other)
+    {
+        if (other.count == 0)
+            return;
+
+        const std::size_t count = moments.count + other.count;
+        const ParamT delta = other.mean - moments.mean;
+        const ParamT ratio = (ParamT)other.count / (ParamT)count;
+
+        moments.mean += delta * ratio;
+        moments.m2 += other.m2 + delta * delta * (ParamT)moments.count * ratio;
+        moments.count = count;
+    }
+
+    /// Sums of the backward pass of a channel
+    template <class ParamT>
+    struct GradientSums {
+        // sum(diffInputs)
+        ParamT diff;
+        // sum(diffInputs * (inputs - mean))
+        ParamT diffZeroed;
+        // sum(inputs - mean)
+        ParamT zeroed;
+    };
+}
 
 template <>
 N2D2::Registrar<N2D2::BatchNormCell>
@@ -133,6 +235,7 @@ void N2D2::BatchNormCell_Frame<T>::initialize()
 
     mSavedMean.resize(requiredDims);
     mSavedVariance.resize(requiredDims);
+    mSavedInvStd.resize(requiredDims);
 
     mDiffScale.resize(requiredDims);
     mDiffBias.resize(requiredDims);
@@ -160,95 +263,105 @@ void N2D2::BatchNormCell_Frame<T>::propagate(bool inference)
 
     for (unsigned int k = 0, kSize = mInputs.size(); k < kSize; ++k) {
         const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
-        const unsigned int size = mInputs.dimB() * input.dimZ();
+        const unsigned int mapSize = input.dimX() * input.dimY();
+
+        // outputs = inputs * scale + shift, per channel
+        std::vector<ParamT> scale(input.dimZ());
+        std::vector<ParamT> shift(input.dimZ());
 
         if (inference) {
+            for (unsigned int channel = 0; channel < input.dimZ(); ++channel) {
+                const unsigned int output = outputOffset + channel;
+                const ParamT invStd = ParamT(1.0)
+                    / std::sqrt((*mVariance)(output) + ParamT(mEpsilon));
+
+                scale[channel] = (*mScale)(output) * invStd;
+                shift[channel] = (*mBias)(output)
+                                 - (*mMean)(output) * scale[channel];
+            }
+        } else {
+            // Single pass over the inputs: the moments of each block are
+            // computed in cache and merged, in parallel over the channels and
+            // the tiles
+            const Tiling tiling(mapSize, input.dimB(), input.dimZ());
+            const unsigned int nbTiles = tiling.nbTiles;
+            const unsigned int nbWorkItems = input.dimZ() * nbTiles;
+            std::vector<Moments<ParamT> > partials(nbWorkItems);
+
 #if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (size > 16)
+#pragma omp parallel for collapse(2) schedule(static) \
+    if (nbWorkItems > 1 && input.size() > 4096)
 #else
-#pragma omp parallel for if (mInputs.dimB() > 4 && size > 16)
+#pragma omp parallel for schedule(static) \
+    if (input.dimZ() > 1 && input.size() > 4096)
 #endif
-            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                for (unsigned int channel = 0; channel < input.dimZ();
-                    ++channel)
-                {
-                    const unsigned int output = outputOffset + channel;
-                    const T var(std::sqrt( T((*mVariance)(output))
-                                                  + T(mEpsilon)));
-
-                    for (unsigned int oy = 0; oy < input.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < input.dimX(); ++ox) {
-                            const T normalized
-                                = (input(ox, oy, channel, batchPos)
-                                   - T((*mMean)(output)) )  / var;
-                            mOutputs(ox, oy, output, batchPos)
-                                = T((*mScale)(output)) * normalized
-                                    + T((*mBias)(output));
-                        }
+            for (int channel = 0; channel < (int)input.dimZ(); ++channel) {
+                for (unsigned int tile = 0; tile < nbTiles; ++tile) {
+                    Moments<ParamT> moments = {0, ParamT(0.0), ParamT(0.0)};
+                    const unsigned int blockEnd = std::min(tiling.nbBlocks,
+                        (tile + 1) * tiling.tileSize);
+
+                    for (unsigned int block = tile * tiling.tileSize;
+                        block < blockEnd; ++block)
+                    {
+                        unsigned int batchPos, offset, size;
+                        tiling.block(block, batchPos, offset, size);
+
+                        mergeMoments(moments, blockMoments<T, ParamT>(
+                            &input(0, 0, channel, batchPos) + offset, size));
                     }
+
+                    partials[channel * nbTiles + tile] = moments;
                 }
             }
-        } else {
-            const unsigned int size = input.dimX() * input.dimY()
-                                      * mInputs.dimB();
 
-#pragma omp parallel for if (input.dimZ() > 16)
-            for (int channel = 0; channel < (int)input.dimZ(); ++channel) {
+            for (unsigned int channel = 0; channel < input.dimZ(); ++channel) {
                 const unsigned int output = outputOffset + channel;
-                ParamT sum(0.0);
-
-                for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                    for (unsigned int oy = 0; oy < input.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < input.dimX(); ++ox)
-                            sum += input(ox, oy, channel, batchPos);
-                    }
-                }
+                Moments<ParamT> moments = partials[channel * nbTiles];
 
-                mSavedMean(output) = sum / (ParamT)size;
+                for (unsigned int tile = 1; tile < nbTiles; ++tile)
+                    mergeMoments(moments, partials[channel * nbTiles + tile]);
 
-                sum = 0.0;
-
-                for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                    for (unsigned int oy = 0; oy < input.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < input.dimX(); ++ox) {
-                            const T zeroed = input(ox, oy, channel, batchPos)
-                                                   - ((T)mSavedMean(output));
-                            sum += (ParamT) (zeroed * zeroed);
-                        }
-                    }
-                }
-
-                mSavedVariance(output) = sum / (ParamT)size;
+                mSavedMean(output) = moments.mean;
+                mSavedVariance(output) = (moments.count > 0)
+                    ? moments.m2 / (ParamT)moments.count : ParamT(0.0);
+                mSavedInvStd(output) = ParamT(1.0)
+                    / std::sqrt(mSavedVariance(output) + ParamT(mEpsilon));
 
                 (*mMean)(output) = mSavedMean(output) * mMovingAverageMomentum
                                 + (*mMean)(output) * (1.0 - mMovingAverageMomentum);
                 (*mVariance)(output) = mSavedVariance(output) * mMovingAverageMomentum
                                     + (*mVariance)(output) * (1.0 - mMovingAverageMomentum);
+
+                scale[channel] = (*mScale)(output) * mSavedInvStd(output);
+                shift[channel] = (*mBias)(output)
+                                 - mSavedMean(output) * scale[channel];
             }
 
+            ++mNbPropagate;
+        }
+
+        // Normalization, scale and shift, fused in a single write
+        const unsigned int size = mInputs.dimB() * input.dimZ();
+
 #if defined(_OPENMP) && _OPENMP >= 200805
 #pragma omp parallel for collapse(2) if (size > 16)
 #else
 #pragma omp parallel for if (mInputs.dimB() > 4 && size > 16)
 #endif
-            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                for (unsigned int channel = 0; channel < input.dimZ(); ++channel) {
-                    const unsigned int output = outputOffset + channel;
-                    const T var(std::sqrt( (T)mSavedVariance(output) + mEpsilon));
-
-                    for (unsigned int oy = 0; oy < input.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < input.dimX(); ++ox) {
-                            const T normalized
-                                = (input(ox, oy, channel, batchPos)
-                                   - ( (T) mSavedMean(output)) ) / var;
-                            mOutputs(ox, oy, output, batchPos)
-                                = (T) (*mScale)(output) * normalized + (T) (*mBias)(output);
-                        }
-                    }
+        for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
+            for (unsigned int channel = 0; channel < input.dimZ(); ++channel) {
+                const unsigned int output = outputOffset + channel;
+                const T* inputMap = &input(0, 0, channel, batchPos);
+                T* outputMap = &mOutputs(0, 0, output, batchPos);
+                const ParamT channelScale = scale[channel];
+                const ParamT channelShift = shift[channel];
+
+                for (unsigned int index = 0; index < mapSize; ++index) {
+                    outputMap[index] = (T)((ParamT)inputMap[index]
+                                           * channelScale + channelShift);
                 }
             }
-
-            ++mNbPropagate;
         }
 
         outputOffset += input.dimZ();
@@ -263,61 +376,104 @@ void N2D2::BatchNormCell_Frame<T>::backPropagate()
 {
     Cell_Frame<T>::backPropagate();
 
-    const T betaScale = (mScaleSolver->isNewIteration()) ? T(0.0) : T(1.0);
-    const T betaBias = (mBiasSolver->isNewIteration()) ? T(0.0) : T(1.0);
+    const ParamT betaScale = (mScaleSolver->isNewIteration())
+        ? ParamT(0.0) : ParamT(1.0);
+    const ParamT betaBias = (mBiasSolver->isNewIteration())
+        ? ParamT(0.0) : ParamT(1.0);
     unsigned int outputOffset = 0;
 
     for (unsigned int k = 0, kSize = mInputs.size(); k < kSize; ++k) {
         const Tensor<T>& input = tensor_cast_nocopy<T>(mInputs[k]);
-        const unsigned int size = input.dimX() * input.dimY() * mInputs.dimB();
+        const unsigned int mapSize = input.dimX() * input.dimY();
+        const ParamT size = (ParamT)(mapSize * mInputs.dimB());
+
+        // Single pass over the inputs and diff. inputs, with the same
+        // partitioning as the forward pass
+        const Tiling tiling(mapSize, input.dimB(), input.dimZ());
+        const unsigned int nbTiles = tiling.nbTiles;
+        const unsigned int nbWorkItems = input.dimZ() * nbTiles;
+        std::vector<GradientSums<ParamT> > partials(nbWorkItems);
 
-#pragma omp parallel for if (input.dimZ() > 16)
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) schedule(static) \
+    if (nbWorkItems > 1 && input.size() > 4096)
+#else
+#pragma omp parallel for schedule(static) \
+    if (input.dimZ() > 1 && input.size() > 4096)
+#endif
         for (int channel = 0; channel < (int)input.dimZ(); ++channel) {
-            const unsigned int output = outputOffset + channel;
-            const T var(std::sqrt((T) mSavedVariance(output) + mEpsilon));
+            for (unsigned int tile = 0; tile < nbTiles; ++tile) {
+                const unsigned int output = outputOffset + channel;
+                const ParamT mean = mSavedMean(output);
+                GradientSums<ParamT> sums
+                    = {ParamT(0.0), ParamT(0.0), ParamT(0.0)};
+                const unsigned int blockEnd = std::min(tiling.nbBlocks,
+                    (tile + 1) * tiling.tileSize);
+
+                for (unsigned int block = tile * tiling.tileSize;
+                    block < blockEnd; ++block)
+                {
+                    unsigned int batchPos, offset, blockSize;
+                    tiling.block(block, batchPos, offset, blockSize);
 
-            ParamT sumScale(0.0);
-            ParamT sumBias(0.0);
-            ParamT sumMean1(0.0);
-            ParamT sumMean2(0.0);
-            ParamT sumVariance(0.0);
+                    const T* inputMap = &input(0, 0, channel, batchPos)
+                                        + offset;
+                    const T* diffInputMap = &mDiffInputs(0, 0, output,
+                                                         batchPos) + offset;
 
-            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                for (unsigned int oy = 0; oy < input.dimY(); ++oy) {
-                    for (unsigned int ox = 0; ox < input.dimX(); ++ox) {
-                        const T normalized((input(ox, oy, channel, batchPos)
-                               - (T)mSavedMean(output)) / var);
-                        const T diffNormalized(
-                            mDiffInputs(ox, oy, output, batchPos)
-                              * (T)(*mScale)(output));
-
-                        sumScale += (ParamT) (mDiffInputs(ox, oy, output, batchPos)
-                                    * normalized);
-                        sumBias += (ParamT) (mDiffInputs(ox, oy, output, batchPos));
-
-                        sumMean1 += (ParamT)diffNormalized;
-                        sumMean2 += (ParamT) (-2.0 * (input(ox, oy, channel, batchPos)
-                                            - mSavedMean(output)));
-                        sumVariance += (ParamT) (diffNormalized
-                                       * (input(ox, oy, channel, batchPos)
-                                          - mSavedMean(output)) );
+                    for (unsigned int index = 0; index < blockSize; ++index) {
+                        const ParamT zeroed = (ParamT)inputMap[index] - mean;
+                        const ParamT diff = (ParamT)diffInputMap[index];
+
+                        sums.diff += diff;
+                        sums.diffZeroed += diff * zeroed;
+                        sums.zeroed += zeroed;
                     }
                 }
+
+                partials[channel * nbTiles + tile] = sums;
             }
+        }
+
+        // diffOutputs = diffInputs * diffScale + inputs * inputScale + shift
+        std::vector<ParamT> diffScale(input.dimZ());
+        std::vector<ParamT> inputScale(input.dimZ());
+        std::vector<ParamT> shift(input.dimZ());
 
-            mDiffSavedVariance(output)
-                = sumVariance * (-1.0 / 2.0)
-                  * std::pow(mSavedVariance(output) + mEpsilon, -3.0 / 2.0);
-            mDiffSavedMean(output) = sumMean1 * (-1.0 / (ParamT)var)
-                                     + mDiffSavedVariance(output) * sumMean2
-                                       / (ParamT)size;
+        for (unsigned int channel = 0; channel < input.dimZ(); ++channel) {
+            const unsigned int output = outputOffset + channel;
+            const ParamT invStd = mSavedInvStd(output);
+            GradientSums<ParamT> sums = partials[channel * nbTiles];
+
+            for (unsigned int tile = 1; tile < nbTiles; ++tile) {
+                const GradientSums<ParamT>& partial
+                    = partials[channel * nbTiles + tile];
+
+                sums.diff += partial.diff;
+                sums.diffZeroed += partial.diffZeroed;
+                sums.zeroed += partial.zeroed;
+            }
 
-            mDiffScale(output) = sumScale + betaScale * mDiffScale(output);
-            mDiffBias(output) = sumBias + betaBias * mDiffBias(output);
+            mDiffSavedVariance(output) = (*mScale)(output) * sums.diffZeroed
+                * ParamT(-1.0 / 2.0) * invStd * invStd * invStd;
+            mDiffSavedMean(output) = -(*mScale)(output) * sums.diff * invStd
+                + mDiffSavedVariance(output) * ParamT(-2.0) * sums.zeroed
+                  / size;
+
+            mDiffScale(output) = sums.diffZeroed * invStd
+                                 + betaScale * mDiffScale(output);
+            mDiffBias(output) = sums.diff + betaBias * mDiffBias(output);
+
+            diffScale[channel] = (*mScale)(output) * invStd;
+            inputScale[channel] = ParamT(2.0) * mDiffSavedVariance(output)
+                                  / size;
+            shift[channel] = (mDiffSavedMean(output) - ParamT(2.0)
+                              * mDiffSavedVariance(output) * mSavedMean(output))
+                             / size;
         }
 
         if (!mDiffOutputs.empty()) {
-            const unsigned int size = mInputs.dimB() * getNbOutputs();
+            const unsigned int size = mInputs.dimB() * input.dimZ();
             const bool isValid = mDiffOutputs[k].isValid();
             Tensor<T> diffOutput = (isValid)
                 ? tensor_cast<T>(mDiffOutputs[k])
@@ -333,23 +489,20 @@ void N2D2::BatchNormCell_Frame<T>::backPropagate()
                     ++channel)
                 {
                     const unsigned int output = outputOffset + channel;
-                    const T var(std::sqrt( (T)mSavedVariance(output) + mEpsilon));
-
-                    for (unsigned int oy = 0; oy < input.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < input.dimX(); ++ox) {
-                            const T diffNormalized(
-                                mDiffInputs(ox, oy, output, batchPos)
-                                  * (T)(*mScale)(output));
-                            const T gradient( diffNormalized / var
-                                  + (T)mDiffSavedVariance(output) * 2.0
-                                    * (input(ox, oy, channel, batchPos)
-                                       -(T) mSavedMean(output)) / (T)size
-                                  + (T)mDiffSavedMean(output) / (T)size);
-
-                            diffOutput(ox, oy, channel, batchPos)
-                                = (gradient
-                                + isValid * diffOutput(ox, oy, channel, batchPos));
-                        }
+                    const T* inputMap = &input(0, 0, channel, batchPos);
+                    const T* diffInputMap = &mDiffInputs(0, 0, output,
+                                                         batchPos);
+                    T* diffOutputMap = &diffOutput(0, 0, channel, batchPos);
+
+                    for (unsigned int index = 0; index < mapSize; ++index) {
+                        const ParamT gradient
+                            = (ParamT)diffInputMap[index] * diffScale[channel]
+                              + (ParamT)inputMap[index] * inputScale[channel]
+                              + shift[channel];
+
+                        diffOutputMap[index] = (isValid)
+                            ? (T)(gradient + (ParamT)diffOutputMap[index])
+                            : (T)gradient;
                     }
                 }
             }
@@ -64,9 +64,16 @@ N2D2::ConvCell_Frame<T>::ConvCell_Frame(const DeepNet& deepNet, const std::strin
       Cell_Frame<T>(deepNet, name, nbOutputs, activation),
       // IMPORTANT: Do not change the value of the parameters here! Use
       // setParameter() or loadParameters().
+      mAlgorithm(this, "Algorithm", ConvCell_Frame_Kernels::Auto),
+      mDataLayout(this, "DataLayout", TensorLayout::NCHW),
+      mSparsityThreshold(this, "SparsityThreshold", 0.7),
+      mQuantizedInference(this, "QuantizedInference", false),
       mBias(std::make_shared<Tensor<T> >()),
       mDiffBias({1, 1, getNbOutputs(), 1}),
-      mConvDesc(subSampleDims, strideDims, paddingDims, dilationDims)
+      mConvDesc(subSampleDims, strideDims, paddingDims, dilationDims),
+      mConvAlgorithm(ConvCell_Frame_Kernels::Direct),
+      mWinogradTileSize(2),
+      mKeepOutputsLayout(false)
 {
     // ctor
     if (kernelDims.size() != 2) {
@@ -98,13 +105,6 @@ N2D2::ConvCell_Frame<T>::ConvCell_Frame(const DeepNet& deepNet, const std::strin
                                 " dimensions of the kernel.");
     }
 
-    if (std::count(dilationDims.begin(), dilationDims.end(), 1U)
-        != (int)dilationDims.size())
-    {
-        throw std::domain_error("ConvCell_Frame: dilation != 1 is currently not"
-                                " supported.");
-    }
-
     mWeightsFiller = std::make_shared<NormalFiller<T> >(0.0, 0.05);
     mBiasFiller = std::make_shared<NormalFiller<T> >(0.0, 0.05);
     mWeightsSolver = std::make_shared<SGDSolver_Frame<T> >();
@@ -114,6 +114,67 @@ N2D2::ConvCell_Frame<T>::ConvCell_Frame(const DeepNet& deepNet, const std::strin
 template <class T>
 void N2D2::ConvCell_Frame<T>::initialize()
 {
+    const bool dilation
+        = (std::count(mDilationDims.begin(), mDilationDims.end(), 1U)
+            != (int)mDilationDims.size());
+    const bool winograd = ConvCell_Frame_Kernels::isWinogradCompatible(
+        mKernelDims[0], mKernelDims[1], mConvDesc);
+
+    // Detect grouped (block-diagonal) and depthwise (diagonal) mappings,
+    // for which the direct algorithm only processes the connected channels
+    mNbGroups.clear();
+    bool grouped = false;
+
+    for (unsigned int k = 0, offset = 0, size = mInputs.size(); k < size;
+        ++k)
+    {
+        mNbGroups.push_back(getNbGroups(mMapping.rows(offset,
+                                                      mInputs[k].dimZ())));
+        grouped = grouped || (mNbGroups.back() > 1);
+        offset += mInputs[k].dimZ();
+    }
+
+    if (mAlgorithm == ConvCell_Frame_Kernels::Auto) {
+        mConvAlgorithm = (winograd && !grouped)
+            ? ConvCell_Frame_Kernels::Winograd
+            : (dilation) ? ConvCell_Frame_Kernels::Im2Col
+            : ConvCell_Frame_Kernels::Direct;
+    }
+    else
+        mConvAlgorithm = mAlgorithm;
+
+    if (mConvAlgorithm == ConvCell_Frame_Kernels::Direct && dilation) {
+        throw std::domain_error("ConvCell_Frame: dilation != 1 is only"
+                                " supported with the Im2Col algorithm.");
+    }
+
+    if (mConvAlgorithm == ConvCell_Frame_Kernels::Winograd && !winograd) {
+        throw std::domain_error("ConvCell_Frame: the Winograd algorithm is"
+                                " only supported for 3x3 kernels with unit"
+                                " stride, sub-sampling and dilation and a"
+                                " padding <= 2.");
+    }
+
+    if (mDataLayout != TensorLayout::NCHW) {
+        if (mConvDesc.subSample[0] != 1 || mConvDesc.subSample[1] != 1) {
+            throw std::domain_error("ConvCell_Frame: sub-sampling is not"
+                                    " supported with DataLayout != NCHW.");
+        }
+
+        if (std::count(mNbGroups.begin(), mNbGroups.end(), 1U)
+            != (int)mNbGroups.size())
+        {
+            throw std::domain_error("ConvCell_Frame: only a full mapping is"
+                                    " supported with DataLayout != NCHW.");
+        }
+    }
+
+    // F(4x4,3x3) requires 2.25 times less multiplications than F(2x2,3x3)
+    // but is less accurate, which is not acceptable in half precision
+    mWinogradTileSize = (!std::is_same<T, half_float::half>::value
+                         && getOutputsWidth() >= 8 && getOutputsHeight() >= 8)
+        ? 4 : 2;
+
     if (!mNoBias) {
         if (mBias->empty()) {
             mBias->resize({1, 1, getNbOutputs(), 1});
@@ -171,6 +232,19 @@ void N2D2::ConvCell_Frame<T>::initialize()
 
         mDiffSharedSynapses.push_back(new Tensor<T>(kernelDims), 0);
     }
+
+    mWinogradFilters.resize(mInputs.size());
+    mWinogradDiffFilters.resize(mInputs.size());
+    invalidateWinogradFilters();
+
+    mSparseFilters.resize(mInputs.size());
+    invalidateSparseFilters();
+
+    mInt8Filters.resize(mInputs.size());
+    invalidateInt8Filters();
+
+    mLayoutFilters.resize(mInputs.size());
+    invalidateLayoutFilters();
 }
 
 template <class T>
@@ -209,6 +283,8 @@ template <class T>
 void N2D2::ConvCell_Frame<T>::propagate(bool inference)
 {
     mInputs.synchronizeDBasedToH();
+    // Set before the kernels, which write the outputs in their layout
+    mOutputs.setLayout(getOutputsLayout(inference));
 
     const T alpha = T(1.0);
     T beta = T(0.0);
@@ -220,18 +296,135 @@ void N2D2::ConvCell_Frame<T>::propagate(bool inference)
             beta = 1.0;
 
         const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
+        // Outputs of a previous Conv kept in their layout (see
+        // keepOutputsLayout()), which only forwardLayout() accepts
+        const bool layoutInput = (input.getLayout() != TensorLayout::NCHW);
+
+        if (layoutInput && input.getLayout() != mDataLayout) {
+            std::stringstream errorStr;
+            errorStr << "ConvCell_Frame<T>::propagate(): in cell " << mName
+                << ", input #" << k << " is in the " << input.getLayout()
+                << " layout, but DataLayout is "
+                << (TensorLayout::Layout)mDataLayout;
+
+            throw std::runtime_error(errorStr.str());
+        }
+
+        const std::vector<std::int8_t>* int8Filters
+            = (mQuantizedInference && inference && !layoutInput)
+                ? getInt8Filters(k, offset) : NULL;
+
+        if (int8Filters != NULL
+            && ConvCell_Frame_Kernels::forwardInt8<T>(input,
+                                                      *int8Filters,
+                                                      mKernelDims[0],
+                                                      mKernelDims[1],
+                                                      mConvDesc,
+                                                      &beta,
+                                                      mOutputs))
+        {
+            offset += mInputs[k].dimZ();
+            continue;
+        }
+
+        const Sparse::CsrMatrix<T>* sparseFilters
+            = (mDataLayout == TensorLayout::NCHW)
+                ? getSparseFilters(k, offset) : NULL;
 
-        ConvCell_Frame_Kernels::forward<T>(&alpha,
+        if (sparseFilters != NULL) {
+            ConvCell_Frame_Kernels::forwardSparse<T>(&alpha,
+                                        input,
+                                        *sparseFilters,
+                                        mKernelDims[0],
+                                        mKernelDims[1],
+                                        mConvDesc,
+                                        &beta,
+                                        mOutputs);
+        }
+        else if (mDataLayout != TensorLayout::NCHW) {
+            // Only convert the inputs which are not already in the layout
+            if (!layoutInput)
+                TensorLayout::toLayout(input, mDataLayout, mLayoutInputs);
+
+            ConvCell_Frame_Kernels::forwardLayout<T>(&alpha,
+                                        (layoutInput)
+                                            ? TensorLayout::view(input)
+                                            : mLayoutInputs,
+                                        getLayoutFilters(k),
+                                        mDataLayout,
+                                        mConvDesc,
+                                        &beta,
+                                        mOutputs);
+        }
+        else if (mConvAlgorithm == ConvCell_Frame_Kernels::Winograd) {
+            ConvCell_Frame_Kernels::forwardWinograd<T>(&alpha,
+                                        input,
+                                        getWinogradFilters(k, offset, false),
+                                        mConvDesc,
+                                        &beta,
+                                        mOutputs);
+        }
+        else if (mConvAlgorithm == ConvCell_Frame_Kernels::Im2Col) {
+            ConvCell_Frame_Kernels::forwardIm2Col<T>(&alpha,
+                                        input,
+                                        mSharedSynapses[k],
+                                        mConvDesc,
+                                        &beta,
+                                        mOutputs,
+                                        mMapping.rows(offset, mInputs[k].dimZ()));
+        }
+        else if (mNbGroups[k] > 1) {
+            ConvCell_Frame_Kernels::forwardGrouped<T>(&alpha,
+                                        input,
+                                        mSharedSynapses[k],
+                                        mConvDesc,
+                                        &beta,
+                                        mOutputs,
+                                        mNbGroups[k]);
+        }
+        else {
+            ConvCell_Frame_Kernels::forward<T>(&alpha,
                                         input,
                                         mSharedSynapses[k],
                                         mConvDesc,
                                         &beta,
                                         mOutputs,
                                         mMapping.rows(offset, mInputs[k].dimZ()));
+        }
 
         offset += mInputs[k].dimZ();
     }
 
+    if (!mSumInputs.empty()) {
+        // Fused bias, activation and element-wise sum
+        std::vector<Tensor<T> > sumTensors;
+        sumTensors.reserve(mSumInputs.size());
+        std::vector<const Tensor<T>*> sumInputs;
+
+        for (std::vector<BaseTensor*>::const_iterator it = mSumInputs.begin(),
+            itEnd = mSumInputs.end(); it != itEnd; ++it)
+        {
+            if ((*it) != NULL) {
+                (*it)->synchronizeDBasedToH();
+                sumTensors.push_back(tensor_cast<T>(*(*it)));
+                sumInputs.push_back(&sumTensors.back());
+            }
+            else
+                sumInputs.push_back(NULL);
+        }
+
+        ConvCell_Frame_Kernels::forwardEpilogue<T>((mNoBias) ? NULL
+                                                             : &(*mBias),
+                                                   mEpilogueActivation,
+                                                   sumInputs,
+                                                   mSumWeights,
+                                                   mSumShifts,
+                                                   mSumActivation,
+                                                   mOutputs);
+        mDiffInputs.clearValid();
+        return;
+    }
+
     if (!mNoBias)
         ConvCell_Frame_Kernels::forwardBias<T>(&alpha, (*mBias), &alpha, mOutputs);
 
@@ -242,6 +435,12 @@ void N2D2::ConvCell_Frame<T>::propagate(bool inference)
 template <class T>
 void N2D2::ConvCell_Frame<T>::backPropagate()
 {
+    if (!mSumInputs.empty()) {
+        throw std::runtime_error("ConvCell_Frame<T>::backPropagate(): cell "
+                                 "\"" + mName + "\" has a fused element-wise "
+                                 "sum and is inference only");
+    }
+
     Cell_Frame<T>::backPropagate();
 
     const T alpha = T(1.0);
@@ -254,7 +453,8 @@ void N2D2::ConvCell_Frame<T>::backPropagate()
 
         const Tensor<T>& input = tensor_cast_nocopy<T>(mInputs[k]);
 
-        ConvCell_Frame_Kernels::backwardFilter<T>(&alpha,
+        if (mConvAlgorithm == ConvCell_Frame_Kernels::Im2Col) {
+            ConvCell_Frame_Kernels::backwardFilterIm2Col<T>(&alpha,
                                                input,
                                                mDiffInputs,
                                                mConvDesc,
@@ -262,6 +462,26 @@ void N2D2::ConvCell_Frame<T>::backPropagate()
                                                mDiffSharedSynapses[k],
                                                mMapping.rows(offset,
                                                           mInputs[k].dimZ()));
+        }
+        else if (mNbGroups[k] > 1) {
+            ConvCell_Frame_Kernels::backwardFilterGrouped<T>(&alpha,
+                                               input,
+                                               mDiffInputs,
+                                               mConvDesc,
+                                               &beta,
+                                               mDiffSharedSynapses[k],
+                                               mNbGroups[k]);
+        }
+        else {
+            ConvCell_Frame_Kernels::backwardFilter<T>(&alpha,
+                                               input,
+                                               mDiffInputs,
+                                               mConvDesc,
+                                               &beta,
+                                               mDiffSharedSynapses[k],
+                                               mMapping.rows(offset,
+                                                          mInputs[k].dimZ()));
+        }
 
         offset += mInputs[k].dimZ();
     }
@@ -283,7 +503,17 @@ void N2D2::ConvCell_Frame<T>::backPropagate()
                 ? tensor_cast<T>(mDiffOutputs[k])
                 : tensor_cast_nocopy<T>(mDiffOutputs[k]);
 
-            ConvCell_Frame_Kernels::backwardData<T>(&alpha,
+            if (mConvAlgorithm == ConvCell_Frame_Kernels::Winograd) {
+                ConvCell_Frame_Kernels::backwardDataWinograd<T>(&alpha,
+                                                 getWinogradFilters(k, offset,
+                                                                    true),
+                                                 mDiffInputs,
+                                                 mConvDesc,
+                                                 &beta,
+                                                 diffOutput);
+            }
+            else if (mConvAlgorithm == ConvCell_Frame_Kernels::Im2Col) {
+                ConvCell_Frame_Kernels::backwardDataIm2Col<T>(&alpha,
                                                  mSharedSynapses[k],
                                                  mDiffInputs,
                                                  mConvDesc,
@@ -291,6 +521,26 @@ void N2D2::ConvCell_Frame<T>::backPropagate()
                                                  diffOutput,
                                                  mMapping.rows(offset,
                                                             mInputs[k].dimZ()));
+            }
+            else if (mNbGroups[k] > 1) {
+                ConvCell_Frame_Kernels::backwardDataGrouped<T>(&alpha,
+                                                 mSharedSynapses[k],
+                                                 mDiffInputs,
+                                                 mConvDesc,
+                                                 &beta,
+                                                 diffOutput,
+                                                 mNbGroups[k]);
+            }
+            else {
+                ConvCell_Frame_Kernels::backwardData<T>(&alpha,
+                                                 mSharedSynapses[k],
+                                                 mDiffInputs,
+                                                 mConvDesc,
+                                                 &beta,
+                                                 diffOutput,
+                                                 mMapping.rows(offset,
+                                                            mInputs[k].dimZ()));
+            }
 
             offset += mInputs[k].dimZ();
 
@@ -305,12 +555,151 @@ void N2D2::ConvCell_Frame<T>::backPropagate()
 template <class T>
 void N2D2::ConvCell_Frame<T>::update()
 {
-    for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k)
+    for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k) {
         mWeightsSolvers[k]->update(
             mSharedSynapses[k], mDiffSharedSynapses[k], mInputs.dimB());
 
+        if (mSparseFiltersValid[k] && !mSparseFilters[k].empty()
+            && mExtSharedSynapses.find(k) == mExtSharedSynapses.end())
+        {
+            // Keep the sparsity pattern: the pruned weights stay at 0
+            Tensor<T>& sharedSynapses = mSharedSynapses[k];
+            const unsigned int kernelsSize = sharedSynapses.size()
+                                             / sharedSynapses.dimB();
+
+            Sparse::applyPattern(mSparseFilters[k], &sharedSynapses(0),
+                                 kernelsSize);
+            Sparse::gather(&sharedSynapses(0), kernelsSize,
+                           mSparseFilters[k]);
+        }
+    }
+
     if (!mNoBias)
         mBiasSolver->update(*mBias, mDiffBias, mInputs.dimB());
+
+    invalidateWinogradFilters();
+    invalidateInt8Filters();
+    invalidateLayoutFilters();
+}
+
+template <class T>
+const N2D2::Tensor<T>&
+N2D2::ConvCell_Frame<T>::getWinogradFilters(unsigned int k,
+                                            unsigned int offset,
+                                            bool backward)
+{
+    std::vector<Tensor<T> >& filters = (backward) ? mWinogradDiffFilters
+                                                  : mWinogradFilters;
+    std::vector<bool>& valid = (backward) ? mWinogradDiffFiltersValid
+                                          : mWinogradFiltersValid;
+
+    // External shared weights may be updated by another cell
+    if (!valid[k] || mExtSharedSynapses.find(k) != mExtSharedSynapses.end()) {
+        ConvCell_Frame_Kernels::winogradFilters<T>(mWinogradTileSize,
+                                        mSharedSynapses[k],
+                                        backward,
+                                        filters[k],
+                                        mMapping.rows(offset,
+                                                      mInputs[k].dimZ()));
+        valid[k] = true;
+    }
+
+    return filters[k];
+}
+
+template <class T>
+void N2D2::ConvCell_Frame<T>::invalidateWinogradFilters()
+{
+    mWinogradFiltersValid.assign(mWinogradFilters.size(), false);
+    mWinogradDiffFiltersValid.assign(mWinogradDiffFilters.size(), false);
+}
+
+template <class T>
+const N2D2::Sparse::CsrMatrix<T>*
+N2D2::ConvCell_Frame<T>::getSparseFilters(unsigned int k, unsigned int offset)
+{
+    // The sparsity pattern is detected once, when the weights are set.
+    // External shared weights may be updated by another cell.
+    if (!mSparseFiltersValid[k]
+        || mExtSharedSynapses.find(k) != mExtSharedSynapses.end())
+    {
+        ConvCell_Frame_Kernels::compressFilters<T>(mSharedSynapses[k],
+                                        mSparseFilters[k],
+                                        mMapping.rows(offset,
+                                                      mInputs[k].dimZ()));
+
+        if (mSparseFilters[k].sparsity() < mSparsityThreshold)
+            mSparseFilters[k].clear();
+
+        mSparseFiltersValid[k] = true;
+    }
+
+    return (!mSparseFilters[k].empty()) ? &mSparseFilters[k] : NULL;
+}
+
+template <class T>
+void N2D2::ConvCell_Frame<T>::invalidateSparseFilters()
+{
+    mSparseFiltersValid.assign(mSparseFilters.size(), false);
+}
+
+template <class T>
+const std::vector<std::int8_t>*
+N2D2::ConvCell_Frame<T>::getInt8Filters(unsigned int k, unsigned int offset)
+{
+    if (!mInt8FiltersValid[k]
+        || mExtSharedSynapses.find(k) != mExtSharedSynapses.end())
+    {
+        ConvCell_Frame_Kernels::quantizeFilters<T>(mSharedSynapses[k],
+                                        mInt8Filters[k],
+                                        mMapping.rows(offset,
+                                                      mInputs[k].dimZ()));
+        mInt8FiltersValid[k] = true;
+    }
+
+    return (!mInt8Filters[k].empty()) ? &mInt8Filters[k] : NULL;
+}
+
+template <class T>
+void N2D2::ConvCell_Frame<T>::invalidateInt8Filters()
+{
+    mInt8FiltersValid.assign(mInt8Filters.size(), false);
+}
+
+template <class T>
+const N2D2::Tensor<T>&
+N2D2::ConvCell_Frame<T>::getLayoutFilters(unsigned int k)
+{
+    if (!mLayoutFiltersValid[k]
+        || mExtSharedSynapses.find(k) != mExtSharedSynapses.end())
+    {
+        ConvCell_Frame_Kernels::packFilters(mSharedSynapses[k],
+                                            mDataLayout,
+                                            mLayoutFilters[k]);
+        mLayoutFiltersValid[k] = true;
+    }
+
+    return mLayoutFilters[k];
+}
+
+template <class T>
+void N2D2::ConvCell_Frame<T>::invalidateLayoutFilters()
+{
+    mLayoutFiltersValid.assign(mLayoutFilters.size(), false);
+}
+
+template <class T>
+N2D2::TensorLayout::Layout
+N2D2::ConvCell_Frame<T>::getOutputsLayout(bool inference) const
+{
+    // The integer kernels, the fused element-wise sum and the activation
+    // scaling only produce NCHW outputs
+    const bool nchw = (!inference || !mKeepOutputsLayout
+        || mQuantizedInference || !mSumInputs.empty()
+        || (mActivation && mActivation->getActivationScaling().getMode()
+                                            != ActivationScalingMode::NONE));
+
+    return (nchw) ? TensorLayout::NCHW : (TensorLayout::Layout)mDataLayout;
 }
 
 template <class T>
@@ -328,15 +717,107 @@ void N2D2::ConvCell_Frame<T>::setWeights(unsigned int k,
     mExtSharedSynapses[k] = std::make_pair(weightsInterface, offset);
 }
 
+template <class T>
+bool N2D2::ConvCell_Frame<T>::fuseElemWiseSum(
+    const std::vector<BaseTensor*>& inputs,
+    const std::vector<Float_T>& weights,
+    const std::vector<Float_T>& shifts,
+    const std::shared_ptr<Activation>& activation)
+{
+    ConvCell_Frame_Kernels::EpilogueActivation epilogueActivation;
+    ConvCell_Frame_Kernels::EpilogueActivation sumActivation;
+
+    if (inputs.empty()
+        || weights.size() != inputs.size()
+        || shifts.size() != inputs.size()
+        || !mSumInputs.empty()
+        || !ConvCell_Frame_Kernels::getEpilogueActivation(
+                this->mActivation, epilogueActivation)
+        || !ConvCell_Frame_Kernels::getEpilogueActivation(
+                activation, sumActivation))
+    {
+        return false;
+    }
+
+    mSumInputs = inputs;
+    mSumWeights.assign(weights.begin(), weights.end());
+    mSumShifts.assign(shifts.begin(), shifts.end());
+    mEpilogueActivation = epilogueActivation;
+    mSumActivation = sumActivation;
+    return true;
+}
+
+template <class T>
+bool N2D2::ConvCell_Frame<T>::fusePadding(int paddingX, int paddingY)
+{
+    if (paddingX < 0 || paddingY < 0 || mInputsDims.size() < 2)
+        return false;
+
+    ConvCell_Frame_Kernels::Descriptor convDesc(mConvDesc);
+    convDesc.padding[0] += paddingX;
+    convDesc.padding[1] += paddingY;
+
+    const bool winograd = ConvCell_Frame_Kernels::isWinogradCompatible(
+        mKernelDims[0], mKernelDims[1], convDesc);
+
+    if (mAlgorithm == ConvCell_Frame_Kernels::Winograd && !winograd)
+        return false;
+
+    mPaddingDims[0] += paddingX;
+    mPaddingDims[1] += paddingY;
+    mConvDesc.padding = convDesc.padding;
+    mInputsDims[0] -= 2 * paddingX;
+    mInputsDims[1] -= 2 * paddingY;
+
+    // If already initialized, the Winograd algorithm may no longer apply
+    if (mConvAlgorithm == ConvCell_Frame_Kernels::Winograd && !winograd)
+        mConvAlgorithm = ConvCell_Frame_Kernels::Direct;
+
+    return true;
+}
+
+template <class T>
+bool N2D2::ConvCell_Frame<T>::keepOutputsLayout(bool keep)
+{
+    // Without padding channel, the outputs keep their size in the layout
+    if (keep && (mDataLayout == TensorLayout::NCHW
+                 || getNbOutputs() % TensorLayout::blockSize(mDataLayout) != 0))
+    {
+        return false;
+    }
+
+    mKeepOutputsLayout = keep;
+
+    if (keep && getOutputsLayout(true) == TensorLayout::NCHW) {
+        mKeepOutputsLayout = false;
+        return false;
+    }
+
+    return true;
+}
+
 template <class T>
 void N2D2::ConvCell_Frame<T>::checkGradient(double epsilon, double maxError)
 {
     GradientCheck<T> gc(epsilon, maxError);
+    // The weights are modified in place by the gradient check
     gc.initialize(mInputs,
                   mOutputs,
                   mDiffInputs,
-                  std::bind(&ConvCell_Frame<T>::propagate, this, false),
-                  std::bind(&ConvCell_Frame<T>::backPropagate, this));
+                  [this](bool /*inference*/) {
+                      invalidateWinogradFilters();
+                      invalidateSparseFilters();
+                      invalidateInt8Filters();
+                      invalidateLayoutFilters();
+                      propagate(false);
+                  },
+                  [this]() {
+                      invalidateWinogradFilters();
+                      invalidateSparseFilters();
+                      invalidateInt8Filters();
+                      invalidateLayoutFilters();
+                      backPropagate();
+                  });
 
     for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k) {
         std::stringstream name;
@@ -401,6 +882,11 @@ void N2D2::ConvCell_Frame<T>::loadFreeParameters(const std::string& fileName,
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k)
         mSharedSynapses[k].load(syn);
 
+    invalidateWinogradFilters();
+    invalidateSparseFilters();
+    invalidateInt8Filters();
+    invalidateLayoutFilters();
+
     if (!mNoBias)
         mBias->load(syn);
 
@@ -18,11 +18,140 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include "Activation/Activation.hpp"
 #include "Cell/ConvCell_Frame_Kernels.hpp"
 #include "containers/Tensor.hpp"
 #include "third_party/half.hpp"
+#include "utils/Gemm.hpp"
+#include "utils/HalfConversion.hpp"
+#include "utils/Reduction.hpp"
 #include "utils/Utils.hpp"
 
+namespace {
+    /// Float copy of a half precision tensor
+    N2D2::Tensor<float> toFloatTensor(const N2D2::Tensor<half_float::half>&
+                                      data)
+    {
+        N2D2::Tensor<float> floatData(data.dims());
+
+        if (!data.empty())
+            N2D2::HalfConversion::toFloat(&data(0), data.size(),
+                                          &floatData(0));
+
+        return floatData;
+    }
+
+    /// Round @p floatData back to the half precision tensor @p data
+    void fromFloatTensor(const N2D2::Tensor<float>& floatData,
+                         N2D2::Tensor<half_float::half>& data)
+    {
+        if (!data.empty())
+            N2D2::HalfConversion::fromFloat(&floatData(0), data.size(),
+                                            &data(0));
+    }
+
+    /// Compute the gradient of the kernel weight (sx, sy, channel, output)
+    /// over the rows [rowBegin, rowEnd[, with row = batchPos * oySize + oy.
+    template <class T>
+    T filterGradient(const N2D2::Tensor<T>& inputs,
+                     const N2D2::Tensor<T>& diffInputs,
+                     const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                     unsigned int oxSize,
+                     unsigned int oySize,
+                     unsigned int output,
+                     unsigned int channel,
+                     unsigned int sx,
+                     unsigned int sy,
+                     unsigned int rowBegin,
+                     unsigned int rowEnd)
+    {
+        const bool noSubSample = (desc.subSample[0] == 1
+                                  && desc.subSample[1] == 1);
+        const unsigned int oxMin = (unsigned int)std::max(
+            (int)std::ceil((desc.padding[0] - (int)sx)
+                           / (double)desc.stride[0]),
+            0);
+        const unsigned int oyMin = (unsigned int)std::max(
+            (int)std::ceil((desc.padding[1] - (int)sy)
+                           / (double)desc.stride[1]),
+            0);
+        const unsigned int oxMax = std::min(
+            (unsigned int)std::ceil((inputs.dimX() + desc.padding[0]
+                                     - sx) / (double)desc.stride[0]),
+            oxSize);
+        const unsigned int oyMax = std::min(
+            (unsigned int)std::ceil((inputs.dimY() + desc.padding[1]
+                                     - sy) / (double)desc.stride[1]),
+            oySize);
+
+        T gradient(0.0);
+
+        for (unsigned int row = rowBegin; row < rowEnd; ++row) {
+            const unsigned int batchPos = row / oySize;
+            const unsigned int oy = row % oySize;
+
+            if (oy < oyMin || oy >= oyMax)
+                continue;
+
+            const unsigned int iy = (int)(oy * desc.stride[1] + sy)
+                                    - desc.padding[1];
+
+            for (unsigned int ox = oxMin; ox < oxMax; ++ox) {
+                const unsigned int ix = (int)(ox * desc.stride[0] + sx)
+                                        - desc.padding[0];
+
+                if (noSubSample) {
+                    gradient += inputs(ix, iy, channel, batchPos)
+                                * diffInputs(ox, oy, output, batchPos);
+                }
+                else {
+                    gradient += inputs(ix, iy, channel, batchPos)
+                                * diffInputs(ox / desc.subSample[0],
+                                             oy / desc.subSample[1],
+                                             output,
+                                             batchPos);
+                }
+            }
+        }
+
+        return gradient;
+    }
+
+    /// EpilogueActivation, in the precision of the kernel and with the same
+    /// operations as the Rectifier, Linear and Saturation activation frames
+    template <class T>
+    struct EpilogueActivationOp {
+        bool rectifier;
+        bool clip;
+        T leakSlope;
+        T clipping;
+
+        explicit EpilogueActivationOp(
+            const N2D2::ConvCell_Frame_Kernels::EpilogueActivation& activation)
+            : rectifier(activation.rectifier),
+              clip((activation.rectifier) ? (activation.clipping > 0.0)
+                                          : (activation.clipping != 0.0)),
+              leakSlope(activation.leakSlope),
+              clipping(activation.clipping)
+        {
+        }
+
+        inline T operator()(T value) const
+        {
+            if (rectifier) {
+                return (value > 0)
+                    ? ((clip) ? std::min<T>(value, clipping) : value)
+                    : leakSlope * value;
+            }
+            else {
+                return (clip) ? N2D2::Utils::clamp<T>(value,
+                                                      -clipping, clipping)
+                              : value;
+            }
+        }
+    };
+}
+
 template <class T>
 void N2D2::ConvCell_Frame_Kernels::forward(const T* alpha,
                                            const Tensor<T>& inputs,
@@ -122,7 +251,7 @@ void N2D2::ConvCell_Frame_Kernels::forward(const T* alpha,
                     }
 
                     if (subSample) {
-#pragma omp critical(ConvCell_Frame_Kernels__forward)
+                        // Each output map is computed by a single thread
                         outputs(ox / desc.subSample[0],
                                 oy / desc.subSample[1],
                                 output,
@@ -143,6 +272,31 @@ void N2D2::ConvCell_Frame_Kernels::forwardBias(const T* alpha,
                                                const T* beta,
                                                Tensor<T>& outputs)
 {
+    if (outputs.getLayout() != TensorLayout::NCHW) {
+        // Outputs kept in the NHWC or NCHWc layout, seen as blocks of c
+        // contiguous channels (c = Z for NHWC)
+        const unsigned int c = (outputs.getLayout() == TensorLayout::NHWC)
+            ? outputs.dimZ() : TensorLayout::blockSize(outputs.getLayout());
+        const unsigned int blockStride = outputs.dimX() * outputs.dimY();
+        const unsigned int nbChannelBlocks = outputs.dimZ() / c;
+        const unsigned int nbBlocks = outputs.size() / c;
+
+#pragma omp parallel for if (nbBlocks > 16)
+        for (int block = 0; block < (int)nbBlocks; ++block) {
+            const unsigned int channel
+                = c * ((block / blockStride) % nbChannelBlocks);
+            typename Tensor<T>::iterator itOutput = outputs.begin()
+                                                    + block * c;
+
+            for (unsigned int i = 0; i < c; ++i, ++itOutput) {
+                (*itOutput) = (*alpha) * bias(channel + i)
+                              + (*beta) * (*itOutput);
+            }
+        }
+
+        return;
+    }
+
     const unsigned int size = outputs.dimB() * outputs.dimZ();
 
 #if defined(_OPENMP) && _OPENMP >= 200805
@@ -162,6 +316,102 @@ void N2D2::ConvCell_Frame_Kernels::forwardBias(const T* alpha,
     }
 }
 
+bool N2D2::ConvCell_Frame_Kernels::getEpilogueActivation(
+    const std::shared_ptr<Activation>& activation,
+    EpilogueActivation& epilogueActivation)
+{
+    epilogueActivation = EpilogueActivation();
+
+    if (!activation)
+        return true;
+
+    if (activation->getParameter<unsigned int>("QuantizationLevels") > 0
+        || activation->getActivationScaling().getMode()
+            != ActivationScalingMode::NONE)
+    {
+        return false;
+    }
+
+    const std::string type = activation->getType();
+
+    if (type == "Linear")
+        epilogueActivation.clipping = activation->getParameter<double>("Clipping");
+    else if (type == "Rectifier") {
+        epilogueActivation.rectifier = true;
+        epilogueActivation.leakSlope
+            = activation->getParameter<double>("LeakSlope");
+        epilogueActivation.clipping
+            = activation->getParameter<double>("Clipping");
+    }
+    else if (type == "Saturation") {
+        epilogueActivation.clipping
+            = activation->getParameter<double>("Threshold");
+
+        // A 0 threshold cannot be expressed as a clipping
+        if (epilogueActivation.clipping == 0.0)
+            return false;
+    }
+    else
+        return false;
+
+    return true;
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::forwardEpilogue(
+    const Tensor<T>* bias,
+    const EpilogueActivation& activation,
+    const std::vector<const Tensor<T>*>& sumInputs,
+    const std::vector<T>& sumWeights,
+    const std::vector<T>& sumShifts,
+    const EpilogueActivation& sumActivation,
+    Tensor<T>& outputs)
+{
+    const unsigned int nbInputs = sumInputs.size();
+    const unsigned int oxySize = outputs.dimX() * outputs.dimY();
+    const unsigned int size = outputs.dimB() * outputs.dimZ();
+
+    const EpilogueActivationOp<T> activationOp(activation);
+    const EpilogueActivationOp<T> sumActivationOp(sumActivation);
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (outputs.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)outputs.dimB(); ++batchPos) {
+        for (unsigned int output = 0; output < outputs.dimZ(); ++output) {
+            const unsigned int offset
+                = oxySize * (output + outputs.dimZ() * batchPos);
+            const T biasValue = (bias != NULL) ? (*bias)(output) : T(0.0);
+
+            for (unsigned int oxy = 0; oxy < oxySize; ++oxy) {
+                const unsigned int index = offset + oxy;
+
+                T value = outputs(index);
+
+                if (bias != NULL)
+                    value = biasValue + value;
+
+                value = activationOp(value);
+
+                // Same order of evaluation as ElemWiseCell_Frame
+                T sum = sumWeights[0] * ((sumInputs[0] != NULL)
+                            ? (*sumInputs[0])(index) : value)
+                        + sumShifts[0];
+
+                for (unsigned int k = 1; k < nbInputs; ++k) {
+                    sum += sumWeights[k] * ((sumInputs[k] != NULL)
+                                ? (*sumInputs[k])(index) : value)
+                           + sumShifts[k];
+                }
+
+                outputs(index) = sumActivationOp(sum);
+            }
+        }
+    }
+}
+
 template <class T>
 void N2D2::ConvCell_Frame_Kernels::backwardData(const T* alpha,
                                                 const Tensor
@@ -333,76 +583,73 @@ void N2D2::ConvCell_Frame_Kernels::backwardFilter(const T* alpha,
         = (unsigned int)((inputs.dimY() + 2 * desc.padding[1]
                           - diffSharedSynapses.dimY() + desc.stride[1])
                          / (double)desc.stride[1]);
-    const bool noSubSample = (desc.subSample[0] == 1 && desc.subSample[1] == 1);
+    const unsigned int nbRows = inputs.dimB() * oySize;
+    const unsigned int chunkSize = Reduction::chunkSize(diffInputs.dimZ() * inputs.dimZ(), nbRows);
+    const unsigned int nbChunks = std::max(1U,
+        (nbRows + chunkSize - 1) / chunkSize);
+    const unsigned int kernelSize = diffSharedSynapses.dimX()
+                                    * diffSharedSynapses.dimY();
+    const unsigned int partialSize = diffSharedSynapses.size();
 
-    const unsigned int size = diffInputs.dimZ() * inputs.dimZ();
+    // Per-chunk partial gradients, summed with a deterministic tree reduction
+    std::vector<T> partials(nbChunks * partialSize);
+    const unsigned int size = nbChunks * diffInputs.dimZ() * inputs.dimZ();
 
 #if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (size > 16)
+#pragma omp parallel for collapse(3) if (size > 16)
 #else
-#pragma omp parallel for if (diffInputs.dimZ() > 4 && size > 16)
+#pragma omp parallel for if (nbChunks > 4 && size > 16)
 #endif
+    for (int chunk = 0; chunk < (int)nbChunks; ++chunk) {
+        for (unsigned int output = 0; output < diffInputs.dimZ(); ++output) {
+            for (unsigned int channel = 0; channel < inputs.dimZ();
+                 ++channel)
+            {
+                if (!maps.empty() && !maps(output, channel))
+                    continue;
+
+                const unsigned int rowBegin = chunk * chunkSize;
+                const unsigned int rowEnd = std::min(rowBegin + chunkSize,
+                                                     nbRows);
+                T* partial = &partials[chunk * partialSize
+                    + (channel + inputs.dimZ() * output) * kernelSize];
+
+                for (unsigned int sy = 0; sy < diffSharedSynapses.dimY();
+                     ++sy)
+                {
+                    for (unsigned int sx = 0; sx < diffSharedSynapses.dimX();
+                         ++sx)
+                    {
+                        partial[sx + sy * diffSharedSynapses.dimX()]
+                            = filterGradient(inputs, diffInputs, desc,
+                                             oxSize, oySize, output, channel,
+                                             sx, sy, rowBegin, rowEnd);
+                    }
+                }
+            }
+        }
+    }
+
+    Reduction::treeReduce(partials, nbChunks, partialSize);
+
+    T* diffKernels = &diffSharedSynapses(0);
+
+#pragma omp parallel for if (diffInputs.dimZ() > 16)
     for (int output = 0; output < (int)diffInputs.dimZ(); ++output) {
-        for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel) {
+        for (unsigned int channel = 0; channel < inputs.dimZ();
+             ++channel)
+        {
             if (!maps.empty() && !maps(output, channel))
                 continue;
 
-            for (unsigned int sy = 0; sy < diffSharedSynapses.dimY(); ++sy) {
-                for (unsigned int sx = 0; sx < diffSharedSynapses.dimX();
-                     ++sx) {
-                    const unsigned int oxMin = (unsigned int)std::max(
-                        (int)std::ceil((desc.padding[0] - (int)sx)
-                                       / (double)desc.stride[0]),
-                        0);
-                    const unsigned int oyMin = (unsigned int)std::max(
-                        (int)std::ceil((desc.padding[1] - (int)sy)
-                                       / (double)desc.stride[1]),
-                        0);
-                    const unsigned int oxMax = std::min(
-                        (unsigned int)std::ceil((inputs.dimX() + desc.padding[0]
-                                                 - sx) / (double)desc.stride[0]),
-                        oxSize);
-                    const unsigned int oyMax = std::min(
-                        (unsigned int)std::ceil((inputs.dimY() + desc.padding[1]
-                                                 - sy) / (double)desc.stride[1]),
-                        oySize);
-
-                    T gradient(0.0);
-
-                    for (unsigned int batchPos = 0; batchPos < inputs.dimB();
-                         ++batchPos) {
-                        for (unsigned int oy = oyMin; oy < oyMax; ++oy) {
-                            for (unsigned int ox = oxMin; ox < oxMax; ++ox) {
-                                const unsigned int ix
-                                    = (int)(ox * desc.stride[0] + sx)
-                                      - desc.padding[0];
-                                const unsigned int iy
-                                    = (int)(oy * desc.stride[1] + sy)
-                                      - desc.padding[1];
-
-                                if (noSubSample) {
-                                    gradient += inputs(ix, iy, channel, batchPos)
-                                                * diffInputs(ox,
-                                                            oy,
-                                                            output,
-                                                            batchPos);
-                                }
-                                else {
-                                    gradient += inputs(ix, iy, channel, batchPos)
-                                                * diffInputs(ox / desc.subSample[0],
-                                                            oy / desc.subSample[1],
-                                                            output,
-                                                            batchPos);
-                                }
-                            }
-                        }
-                    }
+            const unsigned int offset = (channel + inputs.dimZ() * output)
+                                        * kernelSize;
 
-                    diffSharedSynapses(sx, sy, channel, output)
-                        = (*alpha) * gradient
-                          + (*beta)
-                            * diffSharedSynapses(sx, sy, channel, output);
-                }
+            for (unsigned int index = offset; index < offset + kernelSize;
+                 ++index)
+            {
+                diffKernels[index] = (*alpha) * partials[index]
+                                     + (*beta) * diffKernels[index];
             }
         }
     }
@@ -415,133 +662,2101 @@ void N2D2::ConvCell_Frame_Kernels::backwardBias(const T* alpha,
                                                 const T* beta,
                                                 Tensor<T>& diffBias)
 {
-#pragma omp parallel for if (diffBias.dimZ() > 16)
-    for (int output = 0; output < (int)diffBias.dimZ(); ++output) {
-        T sum(0.0);
+    const unsigned int nbRows = diffInputs.dimB() * diffInputs.dimY();
+    const unsigned int chunkSize = Reduction::chunkSize(diffBias.dimZ(), nbRows);
+    const unsigned int nbChunks = std::max(1U,
+        (nbRows + chunkSize - 1) / chunkSize);
+    const unsigned int size = nbChunks * diffBias.dimZ();
+
+    // Per-chunk partial sums, summed with a deterministic tree reduction
+    std::vector<T> partials(size);
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (nbChunks > 4 && size > 16)
+#endif
+    for (int chunk = 0; chunk < (int)nbChunks; ++chunk) {
+        for (unsigned int output = 0; output < diffBias.dimZ(); ++output) {
+            const unsigned int rowBegin = chunk * chunkSize;
+            const unsigned int rowEnd = std::min(rowBegin + chunkSize, nbRows);
+            T sum(0.0);
+
+            for (unsigned int row = rowBegin; row < rowEnd; ++row) {
+                const unsigned int batchPos = row / diffInputs.dimY();
+                const unsigned int oy = row % diffInputs.dimY();
 
-        for (unsigned int batchPos = 0; batchPos < diffInputs.dimB();
-             ++batchPos) {
-            for (unsigned int oy = 0; oy < diffInputs.dimY(); ++oy) {
                 for (unsigned int ox = 0; ox < diffInputs.dimX(); ++ox)
                     sum += diffInputs(ox, oy, output, batchPos);
             }
+
+            partials[chunk * diffBias.dimZ() + output] = sum;
         }
+    }
+
+    Reduction::treeReduce(partials, nbChunks, diffBias.dimZ());
 
-        diffBias(output) = (*alpha) * sum + (*beta) * diffBias(output);
+    for (unsigned int output = 0; output < diffBias.dimZ(); ++output) {
+        diffBias(output) = (*alpha) * partials[output]
+                           + (*beta) * diffBias(output);
     }
 }
 
-namespace N2D2 {
-    template void ConvCell_Frame_Kernels::forward<half_float::half>(const half_float::half* alpha,
-                                           const Tensor<half_float::half>& inputs,
-                                           const Tensor
-                                           <half_float::half>& sharedSynapses,
-                                           const Descriptor& desc,
-                                           const half_float::half* beta,
-                                           Tensor<half_float::half>& outputs,
-                                           const Tensor<bool>& maps);
-    template void ConvCell_Frame_Kernels::forward<float>(const float* alpha,
-                                           const Tensor<float>& inputs,
-                                           const Tensor
-                                           <float>& sharedSynapses,
-                                           const Descriptor& desc,
-                                           const float* beta,
-                                           Tensor<float>& outputs,
-                                           const Tensor<bool>& maps);
-    template void ConvCell_Frame_Kernels::forward<double>(const double* alpha,
-                                           const Tensor<double>& inputs,
-                                           const Tensor
-                                           <double>& sharedSynapses,
-                                           const Descriptor& desc,
-                                           const double* beta,
-                                           Tensor<double>& outputs,
-                                           const Tensor<bool>& maps);
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::forwardGrouped(const T* alpha,
+                                                  const Tensor<T>& inputs,
+                                                  const Tensor
+                                                  <T>& sharedSynapses,
+                                                  const Descriptor& desc,
+                                                  const T* beta,
+                                                  Tensor<T>& outputs,
+                                                  unsigned int nbGroups)
+{
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.padding[0]
+                          - sharedSynapses.dimX() + desc.stride[0])
+                         / (double)desc.stride[0]);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.padding[1]
+                          - sharedSynapses.dimY() + desc.stride[1])
+                         / (double)desc.stride[1]);
+    const bool subSample = (desc.subSample[0] > 1 || desc.subSample[1] > 1);
+    const unsigned int nbChannelsPerGroup = inputs.dimZ() / nbGroups;
+    const unsigned int nbOutputsPerGroup = outputs.dimZ() / nbGroups;
 
-    template void ConvCell_Frame_Kernels::forwardBias<half_float::half>(const half_float::half* alpha,
-                                               const Tensor<half_float::half>& bias,
-                                               const half_float::half* beta,
-                                               Tensor<half_float::half>& outputs);
-    template void ConvCell_Frame_Kernels::forwardBias<float>(const float* alpha,
-                                               const Tensor<float>& bias,
-                                               const float* beta,
-                                               Tensor<float>& outputs);
-    template void ConvCell_Frame_Kernels::forwardBias<double>(const double* alpha,
-                                               const Tensor<double>& bias,
-                                               const double* beta,
-                                               Tensor<double>& outputs);
+    if (subSample) {
+        for (unsigned int index = 0; index < outputs.size(); ++index)
+            outputs(index) *= (*beta);
+    }
 
-    template void ConvCell_Frame_Kernels::backwardData<half_float::half>(const half_float::half* alpha,
-                                                const Tensor
-                                                <half_float::half>& sharedSynapses,
-                                                const Tensor
-                                                <half_float::half>& diffInputs,
-                                                const Descriptor& desc,
-                                                const half_float::half* beta,
-                                                Tensor<half_float::half>& diffOutputs,
-                                                const Tensor<bool>& maps);
-    template void ConvCell_Frame_Kernels::backwardData<float>(const float* alpha,
-                                                const Tensor
-                                                <float>& sharedSynapses,
-                                                const Tensor
-                                                <float>& diffInputs,
-                                                const Descriptor& desc,
-                                                const float* beta,
-                                                Tensor<float>& diffOutputs,
-                                                const Tensor<bool>& maps);
-    template void ConvCell_Frame_Kernels::backwardData<double>(const double* alpha,
-                                                const Tensor
-                                                <double>& sharedSynapses,
-                                                const Tensor
-                                                <double>& diffInputs,
-                                                const Descriptor& desc,
-                                                const double* beta,
-                                                Tensor<double>& diffOutputs,
-                                                const Tensor<bool>& maps);
+    const unsigned int size = inputs.dimB() * outputs.dimZ();
 
-    template void ConvCell_Frame_Kernels::backwardFilter<half_float::half>(const half_float::half* alpha,
-                                                  const Tensor
-                                                  <half_float::half>& inputs,
-                                                  const Tensor
-                                                  <half_float::half>& diffInputs,
-                                                  const Descriptor& desc,
-                                                  const half_float::half* beta,
-                                                  Tensor
-                                                  <half_float::half>& diffSharedSynapses,
-                                                  const Tensor<bool>& maps);
-    template void ConvCell_Frame_Kernels::backwardFilter<float>(const float* alpha,
-                                                  const Tensor
-                                                  <float>& inputs,
-                                                  const Tensor
-                                                  <float>& diffInputs,
-                                                  const Descriptor& desc,
-                                                  const float* beta,
-                                                  Tensor
-                                                  <float>& diffSharedSynapses,
-                                                  const Tensor<bool>& maps);
-    template void ConvCell_Frame_Kernels::backwardFilter<double>(const double* alpha,
-                                                  const Tensor
-                                                  <double>& inputs,
-                                                  const Tensor
-                                                  <double>& diffInputs,
-                                                  const Descriptor& desc,
-                                                  const double* beta,
-                                                  Tensor
-                                                  <double>& diffSharedSynapses,
-                                                  const Tensor<bool>& maps);
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (inputs.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)inputs.dimB(); ++batchPos) {
+        for (unsigned int output = 0; output < outputs.dimZ(); ++output) {
+            // Only the channels of the output group are connected
+            const unsigned int channelMin
+                = (output / nbOutputsPerGroup) * nbChannelsPerGroup;
+            const unsigned int channelMax = channelMin + nbChannelsPerGroup;
 
-    template void ConvCell_Frame_Kernels::backwardBias<half_float::half>(const half_float::half* alpha,
-                                                const Tensor
-                                                <half_float::half>& diffInputs,
-                                                const half_float::half* beta,
-                                                Tensor<half_float::half>& diffBias);
-    template void ConvCell_Frame_Kernels::backwardBias<float>(const float* alpha,
-                                                const Tensor
-                                                <float>& diffInputs,
-                                                const float* beta,
-                                                Tensor<float>& diffBias);
-    template void ConvCell_Frame_Kernels::backwardBias<double>(const double* alpha,
-                                                const Tensor
-                                                <double>& diffInputs,
-                                                const double* beta,
-                                                Tensor<double>& diffBias);
+            for (unsigned int oy = 0; oy < oySize; ++oy) {
+                for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                    const unsigned int sxMin = (unsigned int)std::max(
+                        desc.padding[0] - (int)(ox * desc.stride[0]), 0);
+                    const unsigned int syMin = (unsigned int)std::max(
+                        desc.padding[1] - (int)(oy * desc.stride[1]), 0);
+                    const unsigned int sxMax = Utils::clamp
+                        <int>(inputs.dimX() + desc.padding[0] - ox * desc.stride[0],
+                              0,
+                              sharedSynapses.dimX());
+                    const unsigned int syMax = Utils::clamp
+                        <int>(inputs.dimY() + desc.padding[1] - oy * desc.stride[1],
+                              0,
+                              sharedSynapses.dimY());
+
+                    const int ix = (int)(ox * desc.stride[0]) - desc.padding[0];
+                    const int iy = (int)(oy * desc.stride[1]) - desc.padding[1];
+
+                    // For each output, compute the weighted sum
+                    T weightedSum(0.0);
+
+                    for (unsigned int channel = channelMin;
+                         channel < channelMax; ++channel)
+                    {
+                        for (unsigned int sy = syMin; sy < syMax; ++sy) {
+                            for (unsigned int sx = sxMin; sx < sxMax; ++sx) {
+                                weightedSum += sharedSynapses(
+                                                   sx, sy, channel, output)
+                                               * inputs(ix + sx,
+                                                        iy + sy,
+                                                        channel,
+                                                        batchPos);
+                            }
+                        }
+                    }
+
+                    if (subSample) {
+                        // Each output map is computed by a single thread
+                        outputs(ox / desc.subSample[0],
+                                oy / desc.subSample[1],
+                                output,
+                                batchPos) += (*alpha) * weightedSum;
+                    } else
+                        outputs(ox, oy, output, batchPos)
+                            = (*alpha) * weightedSum
+                              + (*beta) * outputs(ox, oy, output, batchPos);
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::backwardDataGrouped(const T* alpha,
+                                                       const Tensor
+                                                       <T>& sharedSynapses,
+                                                       const Tensor
+                                                       <T>& diffInputs,
+                                                       const Descriptor& desc,
+                                                       const T* beta,
+                                                       Tensor<T>& diffOutputs,
+                                                       unsigned int nbGroups)
+{
+    const unsigned int oxStride
+        = desc.stride[0] * (unsigned int)((diffOutputs.dimX() + 2 * desc.padding[0]
+                                         - sharedSynapses.dimX() + desc.stride[0])
+                                        / (double)desc.stride[0]);
+    const unsigned int oyStride
+        = desc.stride[1] * (unsigned int)((diffOutputs.dimY() + 2 * desc.padding[1]
+                                         - sharedSynapses.dimY() + desc.stride[1])
+                                        / (double)desc.stride[1]);
+    const unsigned int nbChannelsPerGroup = diffOutputs.dimZ() / nbGroups;
+    const unsigned int nbOutputsPerGroup = diffInputs.dimZ() / nbGroups;
+
+    const unsigned int size = diffOutputs.dimB() * diffOutputs.dimZ();
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (diffOutputs.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)diffOutputs.dimB(); ++batchPos) {
+        for (unsigned int channel = 0; channel < diffOutputs.dimZ();
+             ++channel) {
+            // Only the outputs of the channel group are connected
+            const unsigned int outputMin
+                = (channel / nbChannelsPerGroup) * nbOutputsPerGroup;
+            const unsigned int outputMax = outputMin + nbOutputsPerGroup;
+
+            for (unsigned int iy = 0; iy < diffOutputs.dimY(); ++iy) {
+                for (unsigned int ix = 0; ix < diffOutputs.dimX(); ++ix) {
+                    const unsigned int ixPad = ix + desc.padding[0];
+                    const unsigned int iyPad = iy + desc.padding[1];
+                    const unsigned int sxMin = ixPad % desc.stride[0]
+                        + std::max<int>(ixPad - (ixPad % desc.stride[0])
+                            - oxStride + desc.stride[0], 0);
+                    const unsigned int syMin = iyPad % desc.stride[1]
+                        + std::max<int>(iyPad - (iyPad % desc.stride[1])
+                            - oyStride + desc.stride[1], 0);
+                    const unsigned int sxMax
+                        = std::min<unsigned int>(sharedSynapses.dimX(), ixPad + 1);
+                    const unsigned int syMax
+                        = std::min<unsigned int>(sharedSynapses.dimY(), iyPad + 1);
+
+                    T gradient(0.0);
+
+                    for (unsigned int output = outputMin; output < outputMax;
+                         ++output)
+                    {
+                        for (unsigned int sy = syMin; sy < syMax;
+                             sy += desc.stride[1])
+                        {
+                            for (unsigned int sx = sxMin; sx < sxMax;
+                                 sx += desc.stride[0])
+                            {
+                                // Output node coordinates
+                                const unsigned int ox
+                                    = (ixPad - sx) / desc.stride[0];
+                                const unsigned int oy
+                                    = (iyPad - sy) / desc.stride[1];
+
+                                gradient
+                                    += sharedSynapses(sx, sy, channel, output)
+                                        * diffInputs(ox / desc.subSample[0],
+                                                     oy / desc.subSample[1],
+                                                     output,
+                                                     batchPos);
+                            }
+                        }
+                    }
+
+                    diffOutputs(ix, iy, channel, batchPos)
+                        = (*alpha) * gradient
+                          + (*beta) * diffOutputs(ix, iy, channel, batchPos);
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::backwardFilterGrouped(const T* alpha,
+                                                         const Tensor
+                                                         <T>& inputs,
+                                                         const Tensor
+                                                         <T>& diffInputs,
+                                                         const Descriptor& desc,
+                                                         const T* beta,
+                                                         Tensor
+                                                         <T>& diffSharedSynapses,
+                                                         unsigned int nbGroups)
+{
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.padding[0]
+                          - diffSharedSynapses.dimX() + desc.stride[0])
+                         / (double)desc.stride[0]);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.padding[1]
+                          - diffSharedSynapses.dimY() + desc.stride[1])
+                         / (double)desc.stride[1]);
+    const unsigned int nbChannelsPerGroup = inputs.dimZ() / nbGroups;
+    const unsigned int nbOutputsPerGroup = diffInputs.dimZ() / nbGroups;
+
+    // Only iterate over the connected (output, channel) pairs
+    const unsigned int nbRows = inputs.dimB() * oySize;
+    const unsigned int chunkSize = Reduction::chunkSize(diffInputs.dimZ() * nbChannelsPerGroup, nbRows);
+    const unsigned int nbChunks = std::max(1U,
+        (nbRows + chunkSize - 1) / chunkSize);
+    const unsigned int kernelSize = diffSharedSynapses.dimX()
+                                    * diffSharedSynapses.dimY();
+    const unsigned int partialSize = diffSharedSynapses.size();
+
+    // Per-chunk partial gradients, summed with a deterministic tree reduction
+    std::vector<T> partials(nbChunks * partialSize);
+    const unsigned int size = nbChunks * diffInputs.dimZ() * nbChannelsPerGroup;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(3) if (size > 16)
+#else
+#pragma omp parallel for if (nbChunks > 4 && size > 16)
+#endif
+    for (int chunk = 0; chunk < (int)nbChunks; ++chunk) {
+        for (unsigned int output = 0; output < diffInputs.dimZ(); ++output) {
+            for (unsigned int groupChannel = 0; groupChannel < nbChannelsPerGroup;
+                 ++groupChannel)
+            {
+                const unsigned int channel
+                    = (output / nbOutputsPerGroup) * nbChannelsPerGroup
+                        + groupChannel;
+
+                const unsigned int rowBegin = chunk * chunkSize;
+                const unsigned int rowEnd = std::min(rowBegin + chunkSize,
+                                                     nbRows);
+                T* partial = &partials[chunk * partialSize
+                    + (channel + inputs.dimZ() * output) * kernelSize];
+
+                for (unsigned int sy = 0; sy < diffSharedSynapses.dimY();
+                     ++sy)
+                {
+                    for (unsigned int sx = 0; sx < diffSharedSynapses.dimX();
+                         ++sx)
+                    {
+                        partial[sx + sy * diffSharedSynapses.dimX()]
+                            = filterGradient(inputs, diffInputs, desc,
+                                             oxSize, oySize, output, channel,
+                                             sx, sy, rowBegin, rowEnd);
+                    }
+                }
+            }
+        }
+    }
+
+    Reduction::treeReduce(partials, nbChunks, partialSize);
+
+    T* diffKernels = &diffSharedSynapses(0);
+
+#pragma omp parallel for if (diffInputs.dimZ() > 16)
+    for (int output = 0; output < (int)diffInputs.dimZ(); ++output) {
+        for (unsigned int groupChannel = 0; groupChannel < nbChannelsPerGroup;
+             ++groupChannel)
+        {
+            const unsigned int channel
+                = (output / nbOutputsPerGroup) * nbChannelsPerGroup
+                    + groupChannel;
+
+            const unsigned int offset = (channel + inputs.dimZ() * output)
+                                        * kernelSize;
+
+            for (unsigned int index = offset; index < offset + kernelSize;
+                 ++index)
+            {
+                diffKernels[index] = (*alpha) * partials[index]
+                                     + (*beta) * diffKernels[index];
+            }
+        }
+    }
+}
+
+namespace {
+    /// Return the kernels as a nbOutputs x (kernelWidth x kernelHeight x
+    /// nbChannels) row-major matrix, with the kernels of the channels that are
+    /// not connected in maps set to 0.
+    template <class T>
+    const T* mappedKernels(const N2D2::Tensor<T>& sharedSynapses,
+                           const N2D2::Tensor<bool>& maps,
+                           std::vector<T>& buffer)
+    {
+        const T* kernels = &sharedSynapses(0);
+
+        if (maps.empty()
+            || std::find(maps.begin(), maps.end(), false) == maps.end())
+        {
+            return kernels;
+        }
+
+        const unsigned int kernelSize = sharedSynapses.dimX()
+                                        * sharedSynapses.dimY();
+        buffer.assign(kernels, kernels + sharedSynapses.size());
+
+        for (unsigned int output = 0; output < sharedSynapses.dimB();
+             ++output)
+        {
+            for (unsigned int channel = 0; channel < sharedSynapses.dimZ();
+                 ++channel)
+            {
+                if (!maps(output, channel)) {
+                    const unsigned int offset = kernelSize
+                        * (channel + sharedSynapses.dimZ() * output);
+
+                    std::fill(buffer.begin() + offset,
+                              buffer.begin() + offset + kernelSize, T(0.0));
+                }
+            }
+        }
+
+        return &buffer[0];
+    }
+
+    /// Return the gradient of the outputs for batchPos as a nbOutputs x
+    /// (oxSize x oySize) row-major matrix, replicating the values of the
+    /// sub-sampled outputs if needed.
+    template <class T>
+    const T* upSampledDiffInputs(const N2D2::Tensor<T>& diffInputs,
+                                 unsigned int batchPos,
+                                 const N2D2::ConvCell_Frame_Kernels
+                                    ::Descriptor& desc,
+                                 unsigned int oxSize,
+                                 unsigned int oySize,
+                                 std::vector<T>& buffer)
+    {
+        if (desc.subSample[0] == 1 && desc.subSample[1] == 1)
+            return &diffInputs(0, 0, 0, batchPos);
+
+        const unsigned int colSize = oxSize * oySize;
+        buffer.resize(diffInputs.dimZ() * colSize);
+
+#pragma omp parallel for if (diffInputs.dimZ() > 16)
+        for (int output = 0; output < (int)diffInputs.dimZ(); ++output) {
+            for (unsigned int oy = 0; oy < oySize; ++oy) {
+                for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                    buffer[output * colSize + ox + oy * oxSize]
+                        = diffInputs(ox / desc.subSample[0],
+                                     oy / desc.subSample[1],
+                                     output,
+                                     batchPos);
+                }
+            }
+        }
+
+        return &buffer[0];
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::im2col(const Tensor<T>& inputs,
+                                          unsigned int batchPos,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          T* col)
+{
+    const unsigned int kernelSize = kernelWidth * kernelHeight;
+    const unsigned int colSize = oxSize * oySize;
+    const int size = kernelSize * inputs.dimZ();
+    const int dimX = inputs.dimX();
+    const int dimY = inputs.dimY();
+
+#pragma omp parallel for if (size > 16 && size * colSize > 65536)
+    for (int k = 0; k < size; ++k) {
+        const unsigned int channel = k / kernelSize;
+        const unsigned int sy = (k % kernelSize) / kernelWidth;
+        const unsigned int sx = k % kernelWidth;
+
+        const int x0 = (int)(sx * desc.dilation[0]) - desc.padding[0];
+        const int y0 = (int)(sy * desc.dilation[1]) - desc.padding[1];
+        const T* inputData = &inputs(0, 0, channel, batchPos);
+        T* colData = col + k * colSize;
+
+        for (unsigned int oy = 0; oy < oySize; ++oy) {
+            const int iy = y0 + (int)(oy * desc.stride[1]);
+            T* colRow = colData + oy * oxSize;
+
+            if (iy < 0 || iy >= dimY) {
+                std::fill(colRow, colRow + oxSize, T(0.0));
+                continue;
+            }
+
+            const T* inputRow = inputData + iy * dimX;
+
+            for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                const int ix = x0 + (int)(ox * desc.stride[0]);
+
+                colRow[ox] = (ix >= 0 && ix < dimX) ? inputRow[ix] : T(0.0);
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::col2im(const T* col,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          const T* beta,
+                                          Tensor<T>& outputs,
+                                          unsigned int batchPos)
+{
+    const unsigned int kernelSize = kernelWidth * kernelHeight;
+    const unsigned int colSize = oxSize * oySize;
+    const int dimX = outputs.dimX();
+    const int dimY = outputs.dimY();
+
+    // Each channel is accumulated by a single thread, in a fixed order
+#pragma omp parallel for if (outputs.dimZ() > 4)
+    for (int channel = 0; channel < (int)outputs.dimZ(); ++channel) {
+        T* outputData = &outputs(0, 0, channel, batchPos);
+
+        if ((*beta) == T(0.0))
+            std::fill(outputData, outputData + dimX * dimY, T(0.0));
+        else if ((*beta) != T(1.0)) {
+            for (int index = 0; index < dimX * dimY; ++index)
+                outputData[index] *= (*beta);
+        }
+
+        for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+            for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                const int x0 = (int)(sx * desc.dilation[0]) - desc.padding[0];
+                const int y0 = (int)(sy * desc.dilation[1]) - desc.padding[1];
+                const T* colData = col
+                    + (sx + kernelWidth * sy + kernelSize * channel) * colSize;
+
+                for (unsigned int oy = 0; oy < oySize; ++oy) {
+                    const int iy = y0 + (int)(oy * desc.stride[1]);
+
+                    if (iy < 0 || iy >= dimY)
+                        continue;
+
+                    const T* colRow = colData + oy * oxSize;
+                    T* outputRow = outputData + iy * dimX;
+
+                    for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                        const int ix = x0 + (int)(ox * desc.stride[0]);
+
+                        if (ix >= 0 && ix < dimX)
+                            outputRow[ix] += colRow[ox];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::forwardIm2Col(const T* alpha,
+                                                 const Tensor<T>& inputs,
+                                                 const Tensor
+                                                 <T>& sharedSynapses,
+                                                 const Descriptor& desc,
+                                                 const T* beta,
+                                                 Tensor<T>& outputs,
+                                                 const Tensor<bool>& maps)
+{
+    const unsigned int kernelExtentX
+        = desc.dilation[0] * (sharedSynapses.dimX() - 1) + 1;
+    const unsigned int kernelExtentY
+        = desc.dilation[1] * (sharedSynapses.dimY() - 1) + 1;
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.padding[0]
+                          - kernelExtentX + desc.stride[0])
+                         / (double)desc.stride[0]);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.padding[1]
+                          - kernelExtentY + desc.stride[1])
+                         / (double)desc.stride[1]);
+    const bool subSample = (desc.subSample[0] > 1 || desc.subSample[1] > 1);
+
+    // GEMM dimensions: outputs[M x N] = kernels[M x K] * col[K x N]
+    const unsigned int M = outputs.dimZ();
+    const unsigned int N = oxSize * oySize;
+    const unsigned int K = sharedSynapses.dimX() * sharedSynapses.dimY()
+                           * inputs.dimZ();
+
+    std::vector<T> kernelsBuffer;
+    const T* kernels = mappedKernels(sharedSynapses, maps, kernelsBuffer);
+
+    std::vector<T> col(K * N);
+    std::vector<T> weightedSums((subSample) ? M * N : 0);
+
+    if (subSample) {
+        for (unsigned int index = 0; index < outputs.size(); ++index)
+            outputs(index) *= (*beta);
+    }
+
+    for (unsigned int batchPos = 0; batchPos < inputs.dimB(); ++batchPos) {
+        im2col(inputs, batchPos, sharedSynapses.dimX(), sharedSynapses.dimY(),
+               desc, oxSize, oySize, &col[0]);
+
+        if (!subSample) {
+            Gemm::gemm(Gemm::NoTrans, Gemm::NoTrans, M, N, K,
+                       *alpha, kernels, K, &col[0], N,
+                       *beta, &outputs(0, 0, 0, batchPos), N);
+            continue;
+        }
+
+        Gemm::gemm(Gemm::NoTrans, Gemm::NoTrans, M, N, K,
+                   *alpha, kernels, K, &col[0], N,
+                   T(0.0), &weightedSums[0], N);
+
+#pragma omp parallel for if (M > 4)
+        for (int output = 0; output < (int)M; ++output) {
+            for (unsigned int oy = 0; oy < oySize; ++oy) {
+                for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                    outputs(ox / desc.subSample[0],
+                            oy / desc.subSample[1],
+                            output,
+                            batchPos)
+                        += weightedSums[output * N + ox + oy * oxSize];
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::backwardDataIm2Col(const T* alpha,
+                                                      const Tensor
+                                                      <T>& sharedSynapses,
+                                                      const Tensor
+                                                      <T>& diffInputs,
+                                                      const Descriptor& desc,
+                                                      const T* beta,
+                                                      Tensor<T>& diffOutputs,
+                                                      const Tensor<bool>& maps)
+{
+    const unsigned int kernelExtentX
+        = desc.dilation[0] * (sharedSynapses.dimX() - 1) + 1;
+    const unsigned int kernelExtentY
+        = desc.dilation[1] * (sharedSynapses.dimY() - 1) + 1;
+    const unsigned int oxSize
+        = (unsigned int)((diffOutputs.dimX() + 2 * desc.padding[0]
+                          - kernelExtentX + desc.stride[0])
+                         / (double)desc.stride[0]);
+    const unsigned int oySize
+        = (unsigned int)((diffOutputs.dimY() + 2 * desc.padding[1]
+                          - kernelExtentY + desc.stride[1])
+                         / (double)desc.stride[1]);
+
+    // GEMM dimensions: col[K x N] = kernels^T[K x M] * diffInputs[M x N]
+    const unsigned int M = diffInputs.dimZ();
+    const unsigned int N = oxSize * oySize;
+    const unsigned int K = sharedSynapses.dimX() * sharedSynapses.dimY()
+                           * diffOutputs.dimZ();
+
+    std::vector<T> kernelsBuffer;
+    const T* kernels = mappedKernels(sharedSynapses, maps, kernelsBuffer);
+
+    std::vector<T> col(K * N);
+    std::vector<T> diffInputsBuffer;
+
+    for (unsigned int batchPos = 0; batchPos < diffOutputs.dimB();
+         ++batchPos)
+    {
+        const T* diffInput = upSampledDiffInputs(diffInputs, batchPos, desc,
+                                                 oxSize, oySize,
+                                                 diffInputsBuffer);
+
+        Gemm::gemm(Gemm::Trans, Gemm::NoTrans, K, N, M,
+                   *alpha, kernels, K, diffInput, N,
+                   T(0.0), &col[0], N);
+
+        col2im(&col[0], sharedSynapses.dimX(), sharedSynapses.dimY(),
+               desc, oxSize, oySize, beta, diffOutputs, batchPos);
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::backwardFilterIm2Col(const T* alpha,
+                                                        const Tensor
+                                                        <T>& inputs,
+                                                        const Tensor
+                                                        <T>& diffInputs,
+                                                        const Descriptor& desc,
+                                                        const T* beta,
+                                                        Tensor
+                                                        <T>& diffSharedSynapses,
+                                                        const Tensor
+                                                        <bool>& maps)
+{
+    const unsigned int kernelExtentX
+        = desc.dilation[0] * (diffSharedSynapses.dimX() - 1) + 1;
+    const unsigned int kernelExtentY
+        = desc.dilation[1] * (diffSharedSynapses.dimY() - 1) + 1;
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.padding[0]
+                          - kernelExtentX + desc.stride[0])
+                         / (double)desc.stride[0]);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.padding[1]
+                          - kernelExtentY + desc.stride[1])
+                         / (double)desc.stride[1]);
+
+    // GEMM dimensions: gradient[M x K] += diffInputs[M x N] * col^T[N x K]
+    const unsigned int M = diffInputs.dimZ();
+    const unsigned int N = oxSize * oySize;
+    const unsigned int K = diffSharedSynapses.dimX()
+                           * diffSharedSynapses.dimY() * inputs.dimZ();
+    const unsigned int kernelSize = diffSharedSynapses.dimX()
+                                    * diffSharedSynapses.dimY();
+
+    std::vector<T> col(K * N);
+    std::vector<T> diffInputsBuffer;
+    std::vector<T> gradient(M * K, T(0.0));
+
+    for (unsigned int batchPos = 0; batchPos < inputs.dimB(); ++batchPos) {
+        im2col(inputs, batchPos, diffSharedSynapses.dimX(),
+               diffSharedSynapses.dimY(), desc, oxSize, oySize, &col[0]);
+
+        const T* diffInput = upSampledDiffInputs(diffInputs, batchPos, desc,
+                                                 oxSize, oySize,
+                                                 diffInputsBuffer);
+
+        Gemm::gemm(Gemm::NoTrans, Gemm::Trans, M, K, N,
+                   T(1.0), diffInput, N, &col[0], N,
+                   (batchPos > 0) ? T(1.0) : T(0.0), &gradient[0], K);
+    }
+
+    T* diffKernels = &diffSharedSynapses(0);
+
+#pragma omp parallel for if (M > 16)
+    for (int output = 0; output < (int)M; ++output) {
+        for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel) {
+            if (!maps.empty() && !maps(output, channel))
+                continue;
+
+            const unsigned int offset = output * K + channel * kernelSize;
+
+            for (unsigned int index = offset; index < offset + kernelSize;
+                 ++index)
+            {
+                diffKernels[index] = (*alpha) * gradient[index]
+                                     + (*beta) * diffKernels[index];
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::compressFilters(
+    const Tensor<T>& sharedSynapses,
+    Sparse::CsrMatrix<T>& filters,
+    const Tensor<bool>& maps)
+{
+    const unsigned int K = sharedSynapses.dimX() * sharedSynapses.dimY()
+                           * sharedSynapses.dimZ();
+
+    std::vector<T> kernelsBuffer;
+    const T* kernels = mappedKernels(sharedSynapses, maps, kernelsBuffer);
+
+    Sparse::compress(sharedSynapses.dimB(), K, kernels, K, filters);
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::forwardSparse(const T* alpha,
+                                                 const Tensor<T>& inputs,
+                                                 const Sparse::CsrMatrix
+                                                 <T>& filters,
+                                                 unsigned int kernelWidth,
+                                                 unsigned int kernelHeight,
+                                                 const Descriptor& desc,
+                                                 const T* beta,
+                                                 Tensor<T>& outputs)
+{
+    const unsigned int kernelExtentX
+        = desc.dilation[0] * (kernelWidth - 1) + 1;
+    const unsigned int kernelExtentY
+        = desc.dilation[1] * (kernelHeight - 1) + 1;
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.padding[0]
+                          - kernelExtentX + desc.stride[0])
+                         / (double)desc.stride[0]);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.padding[1]
+                          - kernelExtentY + desc.stride[1])
+                         / (double)desc.stride[1]);
+    const bool subSample = (desc.subSample[0] > 1 || desc.subSample[1] > 1);
+
+    // outputs[M x N] = filters[M x K] * col[K x N], with M = outputs.dimZ(),
+    // N = oxSize * oySize and K = filters.cols
+    const unsigned int M = outputs.dimZ();
+    const unsigned int N = oxSize * oySize;
+
+    std::vector<T> col(filters.cols * N);
+    std::vector<T> weightedSums((subSample) ? M * N : 0);
+
+    if (subSample) {
+        for (unsigned int index = 0; index < outputs.size(); ++index)
+            outputs(index) *= (*beta);
+    }
+
+    for (unsigned int batchPos = 0; batchPos < inputs.dimB(); ++batchPos) {
+        im2col(inputs, batchPos, kernelWidth, kernelHeight,
+               desc, oxSize, oySize, &col[0]);
+
+        if (!subSample) {
+            Sparse::sparseDense(filters, N, *alpha, &col[0], N,
+                                *beta, &outputs(0, 0, 0, batchPos), N);
+            continue;
+        }
+
+        Sparse::sparseDense(filters, N, *alpha, &col[0], N,
+                            T(0.0), &weightedSums[0], N);
+
+#pragma omp parallel for if (M > 4)
+        for (int output = 0; output < (int)M; ++output) {
+            for (unsigned int oy = 0; oy < oySize; ++oy) {
+                for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                    outputs(ox / desc.subSample[0],
+                            oy / desc.subSample[1],
+                            output,
+                            batchPos)
+                        += weightedSums[output * N + ox + oy * oxSize];
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+bool N2D2::ConvCell_Frame_Kernels::quantizeFilters(
+    const Tensor<T>& sharedSynapses,
+    std::vector<std::int8_t>& filters,
+    const Tensor<bool>& maps)
+{
+    std::vector<T> kernelsBuffer;
+    const T* kernels = mappedKernels(sharedSynapses, maps, kernelsBuffer);
+
+    filters.resize(sharedSynapses.size());
+
+    if (!Gemm::toInteger(filters.size(), kernels, &filters[0])) {
+        filters.clear();
+        return false;
+    }
+
+    return true;
+}
+
+namespace {
+    /// forwardInt8() with the inputs converted to TI
+    template <class TI, class T>
+    void forwardInt8Inputs(const N2D2::Tensor<TI>& inputs,
+                           const std::vector<std::int8_t>& filters,
+                           unsigned int kernelWidth,
+                           unsigned int kernelHeight,
+                           const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                           unsigned int oxSize,
+                           unsigned int oySize,
+                           const T* beta,
+                           N2D2::Tensor<T>& outputs)
+    {
+        const bool subSample = (desc.subSample[0] > 1
+                                || desc.subSample[1] > 1);
+
+        // outputs[M x N] = filters[M x K] * col[K x N]
+        const unsigned int M = outputs.dimZ();
+        const unsigned int N = oxSize * oySize;
+        const unsigned int K = filters.size() / M;
+
+        std::vector<TI> col(K * N);
+        std::vector<std::int32_t> weightedSums(M * N);
+
+        if (subSample) {
+            for (unsigned int index = 0; index < outputs.size(); ++index)
+                outputs(index) *= (*beta);
+        }
+
+        for (unsigned int batchPos = 0; batchPos < inputs.dimB(); ++batchPos)
+        {
+            N2D2::ConvCell_Frame_Kernels::im2col(inputs, batchPos,
+                                                 kernelWidth, kernelHeight,
+                                                 desc, oxSize, oySize,
+                                                 &col[0]);
+            N2D2::Gemm::gemmInt8(N2D2::Gemm::NoTrans, N2D2::Gemm::NoTrans,
+                                 M, N, K, &filters[0], K, &col[0], N, false,
+                                 &weightedSums[0], N);
+
+#pragma omp parallel for if (M > 4)
+            for (int output = 0; output < (int)M; ++output) {
+                for (unsigned int oy = 0; oy < oySize; ++oy) {
+                    for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                        const T weightedSum
+                            = T(weightedSums[output * N + ox + oy * oxSize]);
+
+                        if (subSample) {
+                            outputs(ox / desc.subSample[0],
+                                    oy / desc.subSample[1],
+                                    output,
+                                    batchPos) += weightedSum;
+                        }
+                        else {
+                            T& value = outputs(ox, oy, output, batchPos);
+                            value = ((*beta) != T(0.0))
+                                ? (*beta) * value + weightedSum
+                                : weightedSum;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+bool N2D2::ConvCell_Frame_Kernels::forwardInt8(
+    const Tensor<T>& inputs,
+    const std::vector<std::int8_t>& filters,
+    unsigned int kernelWidth,
+    unsigned int kernelHeight,
+    const Descriptor& desc,
+    const T* beta,
+    Tensor<T>& outputs)
+{
+    const unsigned int kernelExtentX
+        = desc.dilation[0] * (kernelWidth - 1) + 1;
+    const unsigned int kernelExtentY
+        = desc.dilation[1] * (kernelHeight - 1) + 1;
+    const unsigned int oxSize
+        = (unsigned int)((inputs.dimX() + 2 * desc.padding[0]
+                          - kernelExtentX + desc.stride[0])
+                         / (double)desc.stride[0]);
+    const unsigned int oySize
+        = (unsigned int)((inputs.dimY() + 2 * desc.padding[1]
+                          - kernelExtentY + desc.stride[1])
+                         / (double)desc.stride[1]);
+
+    // Unsigned inputs (after a ReLU for example) use the full 8 bits range
+    Tensor<std::uint8_t> unsignedInputs(inputs.dims());
+
+    if (Gemm::toInteger(inputs.size(), &inputs(0), &unsignedInputs(0))) {
+        forwardInt8Inputs(unsignedInputs, filters, kernelWidth, kernelHeight,
+                          desc, oxSize, oySize, beta, outputs);
+        return true;
+    }
+
+    Tensor<std::int8_t> signedInputs(inputs.dims());
+
+    if (Gemm::toInteger(inputs.size(), &inputs(0), &signedInputs(0))) {
+        forwardInt8Inputs(signedInputs, filters, kernelWidth, kernelHeight,
+                          desc, oxSize, oySize, beta, outputs);
+        return true;
+    }
+
+    return false;
+}
+
+namespace {
+    // Winograd F(2x2,3x3) transformation matrices
+    const double winogradBt2[4 * 4] = {
+        1.0,  0.0, -1.0,  0.0,
+        0.0,  1.0,  1.0,  0.0,
+        0.0, -1.0,  1.0,  0.0,
+        0.0,  1.0,  0.0, -1.0
+    };
+    const double winogradG2[4 * 3] = {
+        1.0,  0.0, 0.0,
+        0.5,  0.5, 0.5,
+        0.5, -0.5, 0.5,
+        0.0,  0.0, 1.0
+    };
+    const double winogradAt2[2 * 4] = {
+        1.0, 1.0,  1.0,  0.0,
+        0.0, 1.0, -1.0, -1.0
+    };
+
+    // Winograd F(4x4,3x3) transformation matrices
+    const double winogradBt4[6 * 6] = {
+        4.0,  0.0, -5.0,  0.0, 1.0, 0.0,
+        0.0, -4.0, -4.0,  1.0, 1.0, 0.0,
+        0.0,  4.0, -4.0, -1.0, 1.0, 0.0,
+        0.0, -2.0, -1.0,  2.0, 1.0, 0.0,
+        0.0,  2.0, -1.0, -2.0, 1.0, 0.0,
+        0.0,  4.0,  0.0, -5.0, 0.0, 1.0
+    };
+    const double winogradG4[6 * 3] = {
+        1.0 / 4.0,   0.0,         0.0,
+        -1.0 / 6.0,  -1.0 / 6.0,  -1.0 / 6.0,
+        -1.0 / 6.0,  1.0 / 6.0,   -1.0 / 6.0,
+        1.0 / 24.0,  1.0 / 12.0,  1.0 / 6.0,
+        1.0 / 24.0,  -1.0 / 12.0, 1.0 / 6.0,
+        0.0,         0.0,         1.0
+    };
+    const double winogradAt4[4 * 6] = {
+        1.0, 1.0,  1.0, 1.0,  1.0, 0.0,
+        0.0, 1.0, -1.0, 2.0, -2.0, 0.0,
+        0.0, 1.0,  1.0, 4.0,  4.0, 0.0,
+        0.0, 1.0, -1.0, 8.0, -8.0, 1.0
+    };
+
+    const unsigned int WINOGRAD_MAX_TILE = 6;
+
+    /// Transformation matrices for F(m x m, 3x3), with tile size a = m + 2:
+    /// Bt is a x a, G is a x 3 and At is m x a (row-major).
+    struct WinogradMatrices {
+        unsigned int m;
+        unsigned int a;
+        const double* Bt;
+        const double* G;
+        const double* At;
+    };
+
+    WinogradMatrices winogradMatrices(unsigned int tileSize)
+    {
+        if (tileSize == 2) {
+            const WinogradMatrices matrices
+                = {2, 4, winogradBt2, winogradG2, winogradAt2};
+            return matrices;
+        }
+        else if (tileSize == 4) {
+            const WinogradMatrices matrices
+                = {4, 6, winogradBt4, winogradG4, winogradAt4};
+            return matrices;
+        }
+        else {
+            throw std::domain_error("ConvCell_Frame_Kernels: Winograd output"
+                                    " tile size must be 2 or 4.");
+        }
+    }
+
+    /// 3x3 stride-1 convolution of the zero-padded inputs with the Winograd
+    /// transformed filters, computing the whole outputs tensor.
+    /// For each batch position, the input tiles are transformed
+    /// (V = B^T.d.B), then multiplied with the filters for each of the a x a
+    /// transformed positions (M = U.V, a GEMM over the channels) and
+    /// transformed back (Y = A^T.M.A).
+    template <class T>
+    void winogradConvolution(const T* alpha,
+                             const N2D2::Tensor<T>& inputs,
+                             const N2D2::Tensor<T>& filters,
+                             int paddingX,
+                             int paddingY,
+                             const T* beta,
+                             N2D2::Tensor<T>& outputs)
+    {
+        const WinogradMatrices mat = winogradMatrices(
+            (filters.dimZ() == 4 * 4) ? 2 : 4);
+        const unsigned int m = mat.m;
+        const unsigned int a = mat.a;
+        const unsigned int nbChannels = inputs.dimZ();
+        const unsigned int nbOutputs = outputs.dimZ();
+
+        if (filters.dimX() != nbChannels || filters.dimY() != nbOutputs
+            || filters.dimZ() != a * a)
+        {
+            throw std::runtime_error("ConvCell_Frame_Kernels: Winograd"
+                                     " filters dimensions mismatch.");
+        }
+
+        T Bt[WINOGRAD_MAX_TILE * WINOGRAD_MAX_TILE];
+        T At[WINOGRAD_MAX_TILE * WINOGRAD_MAX_TILE];
+
+        for (unsigned int i = 0; i < a * a; ++i)
+            Bt[i] = T(mat.Bt[i]);
+
+        for (unsigned int i = 0; i < m * a; ++i)
+            At[i] = T(mat.At[i]);
+
+        const unsigned int tilesX = (outputs.dimX() + m - 1) / m;
+        const unsigned int tilesY = (outputs.dimY() + m - 1) / m;
+        const unsigned int nbTiles = tilesX * tilesY;
+        const int dimX = inputs.dimX();
+        const int dimY = inputs.dimY();
+
+        std::vector<T> V(a * a * nbChannels * nbTiles);
+        std::vector<T> M(a * a * nbOutputs * nbTiles);
+
+        for (unsigned int batchPos = 0; batchPos < inputs.dimB(); ++batchPos)
+        {
+            // Input transform: V = B^T.d.B
+            const int inputSize = nbChannels * nbTiles;
+
+#pragma omp parallel for if (inputSize > 16)
+            for (int index = 0; index < inputSize; ++index) {
+                const unsigned int channel = index / nbTiles;
+                const unsigned int tile = index % nbTiles;
+                const int x0 = (int)((tile % tilesX) * m) - paddingX;
+                const int y0 = (int)((tile / tilesX) * m) - paddingY;
+                const T* inputData = &inputs(0, 0, channel, batchPos);
+
+                T d[WINOGRAD_MAX_TILE][WINOGRAD_MAX_TILE];
+                T tmp[WINOGRAD_MAX_TILE][WINOGRAD_MAX_TILE];
+
+                for (unsigned int y = 0; y < a; ++y) {
+                    const int iy = y0 + (int)y;
+
+                    for (unsigned int x = 0; x < a; ++x) {
+                        const int ix = x0 + (int)x;
+
+                        d[y][x] = (ix >= 0 && ix < dimX && iy >= 0
+                                   && iy < dimY)
+                            ? inputData[ix + iy * dimX] : T(0.0);
+                    }
+                }
+
+                for (unsigned int i = 0; i < a; ++i) {
+                    for (unsigned int j = 0; j < a; ++j) {
+                        T sum(0.0);
+
+                        for (unsigned int k = 0; k < a; ++k) {
+                            if (Bt[i * a + k] != T(0.0))
+                                sum += Bt[i * a + k] * d[k][j];
+                        }
+
+                        tmp[i][j] = sum;
+                    }
+                }
+
+                for (unsigned int i = 0; i < a; ++i) {
+                    for (unsigned int j = 0; j < a; ++j) {
+                        T sum(0.0);
+
+                        for (unsigned int k = 0; k < a; ++k) {
+                            if (Bt[j * a + k] != T(0.0))
+                                sum += tmp[i][k] * Bt[j * a + k];
+                        }
+
+                        V[((i * a + j) * nbChannels + channel) * nbTiles
+                          + tile] = sum;
+                    }
+                }
+            }
+
+            // Element-wise products, summed over the channels: one GEMM per
+            // transformed position
+            for (unsigned int xi = 0; xi < a * a; ++xi) {
+                N2D2::Gemm::gemm(N2D2::Gemm::NoTrans, N2D2::Gemm::NoTrans,
+                                 nbOutputs, nbTiles, nbChannels,
+                                 T(1.0), &filters(0, 0, xi), nbChannels,
+                                 &V[xi * nbChannels * nbTiles], nbTiles,
+                                 T(0.0), &M[xi * nbOutputs * nbTiles],
+                                 nbTiles);
+            }
+
+            // Output transform: Y = A^T.M.A
+            const int outputSize = nbOutputs * nbTiles;
+
+#pragma omp parallel for if (outputSize > 16)
+            for (int index = 0; index < outputSize; ++index) {
+                const unsigned int output = index / nbTiles;
+                const unsigned int tile = index % nbTiles;
+                const unsigned int ox0 = (tile % tilesX) * m;
+                const unsigned int oy0 = (tile / tilesX) * m;
+
+                T tmp[WINOGRAD_MAX_TILE][WINOGRAD_MAX_TILE];
+
+                for (unsigned int i = 0; i < m; ++i) {
+                    for (unsigned int j = 0; j < a; ++j) {
+                        T sum(0.0);
+
+                        for (unsigned int k = 0; k < a; ++k) {
+                            if (At[i * a + k] != T(0.0)) {
+                                sum += At[i * a + k]
+                                    * M[((k * a + j) * nbOutputs + output)
+                                        * nbTiles + tile];
+                            }
+                        }
+
+                        tmp[i][j] = sum;
+                    }
+                }
+
+                for (unsigned int i = 0; i < m && oy0 + i < outputs.dimY();
+                     ++i)
+                {
+                    for (unsigned int j = 0; j < m && ox0 + j < outputs.dimX();
+                         ++j)
+                    {
+                        T sum(0.0);
+
+                        for (unsigned int k = 0; k < a; ++k) {
+                            if (At[j * a + k] != T(0.0))
+                                sum += tmp[i][k] * At[j * a + k];
+                        }
+
+                        T& value = outputs(ox0 + j, oy0 + i, output, batchPos);
+                        value = (*beta != T(0.0))
+                            ? (*alpha) * sum + (*beta) * value
+                            : (*alpha) * sum;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool N2D2::ConvCell_Frame_Kernels::isWinogradCompatible(
+    unsigned int kernelWidth,
+    unsigned int kernelHeight,
+    const Descriptor& desc)
+{
+    if (kernelWidth != 3 || kernelHeight != 3)
+        return false;
+
+    for (unsigned int dim = 0; dim < 2; ++dim) {
+        if (desc.subSample[dim] != 1 || desc.stride[dim] != 1
+            || desc.dilation[dim] != 1
+            || desc.padding[dim] < 0 || desc.padding[dim] > 2)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::winogradFilters(unsigned int tileSize,
+                                                   const Tensor
+                                                   <T>& sharedSynapses,
+                                                   bool backward,
+                                                   Tensor<T>& filters,
+                                                   const Tensor<bool>& maps)
+{
+    if (sharedSynapses.dimX() != 3 || sharedSynapses.dimY() != 3) {
+        throw std::domain_error("ConvCell_Frame_Kernels::winogradFilters():"
+                                " only 3x3 kernels are supported.");
+    }
+
+    const WinogradMatrices mat = winogradMatrices(tileSize);
+    const unsigned int a = mat.a;
+    const unsigned int nbChannels = sharedSynapses.dimZ();
+    const unsigned int nbOutputs = sharedSynapses.dimB();
+
+    if (backward)
+        filters.resize({nbOutputs, nbChannels, a * a});
+    else
+        filters.resize({nbChannels, nbOutputs, a * a});
+
+    const int size = nbOutputs * nbChannels;
+
+#pragma omp parallel for if (size > 16)
+    for (int index = 0; index < size; ++index) {
+        const unsigned int output = index / nbChannels;
+        const unsigned int channel = index % nbChannels;
+        const bool connected = (maps.empty() || maps(output, channel));
+
+        // U = G.g.G^T, computed in double precision
+        double tmp[WINOGRAD_MAX_TILE][3];
+
+        for (unsigned int i = 0; i < a; ++i) {
+            for (unsigned int j = 0; j < 3; ++j) {
+                double sum = 0.0;
+
+                for (unsigned int k = 0; k < 3; ++k) {
+                    // Flipped kernel for backward data
+                    const double g = (backward)
+                        ? (double)sharedSynapses(2 - j, 2 - k, channel, output)
+                        : (double)sharedSynapses(j, k, channel, output);
+
+                    sum += mat.G[i * 3 + k] * g;
+                }
+
+                tmp[i][j] = sum;
+            }
+        }
+
+        for (unsigned int i = 0; i < a; ++i) {
+            for (unsigned int j = 0; j < a; ++j) {
+                double sum = 0.0;
+
+                for (unsigned int k = 0; k < 3; ++k)
+                    sum += tmp[i][k] * mat.G[j * 3 + k];
+
+                const T value = (connected) ? T(sum) : T(0.0);
+
+                if (backward)
+                    filters(output, channel, i * a + j) = value;
+                else
+                    filters(channel, output, i * a + j) = value;
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::forwardWinograd(const T* alpha,
+                                                   const Tensor<T>& inputs,
+                                                   const Tensor<T>& filters,
+                                                   const Descriptor& desc,
+                                                   const T* beta,
+                                                   Tensor<T>& outputs)
+{
+    if (!isWinogradCompatible(3, 3, desc)) {
+        throw std::domain_error("ConvCell_Frame_Kernels::forwardWinograd():"
+                                " unsupported convolution descriptor.");
+    }
+
+    winogradConvolution(alpha, inputs, filters,
+                        desc.padding[0], desc.padding[1], beta, outputs);
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::backwardDataWinograd(const T* alpha,
+                                                        const Tensor
+                                                        <T>& filters,
+                                                        const Tensor
+                                                        <T>& diffInputs,
+                                                        const Descriptor& desc,
+                                                        const T* beta,
+                                                        Tensor<T>& diffOutputs)
+{
+    if (!isWinogradCompatible(3, 3, desc)) {
+        throw std::domain_error("ConvCell_Frame_Kernels::"
+                                "backwardDataWinograd(): unsupported"
+                                " convolution descriptor.");
+    }
+
+    // The gradient w.r.t. the inputs of a 3x3 stride-1 convolution is the
+    // convolution of the gradient w.r.t. the outputs, padded by 2 - padding,
+    // with the flipped kernels
+    winogradConvolution(alpha, diffInputs, filters,
+                        2 - desc.padding[0], 2 - desc.padding[1], beta,
+                        diffOutputs);
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::packFilters(const Tensor<T>& sharedSynapses,
+                                               TensorLayout::Layout layout,
+                                               Tensor<T>& filters)
+{
+    const unsigned int kernelWidth = sharedSynapses.dimX();
+    const unsigned int kernelHeight = sharedSynapses.dimY();
+    const unsigned int nbChannels = sharedSynapses.dimZ();
+    const unsigned int nbOutputs = sharedSynapses.dimB();
+
+    if (layout == TensorLayout::NCHW) {
+        filters.resize(sharedSynapses.dims());
+        std::copy(sharedSynapses.begin(), sharedSynapses.end(),
+                  filters.begin());
+        return;
+    }
+    else if (layout == TensorLayout::NHWC) {
+        filters.resize({nbChannels, kernelWidth, kernelHeight, nbOutputs});
+
+#pragma omp parallel for if (nbOutputs > 16)
+        for (int output = 0; output < (int)nbOutputs; ++output) {
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                    for (unsigned int channel = 0; channel < nbChannels;
+                         ++channel)
+                    {
+                        filters(channel, sx, sy, output)
+                            = sharedSynapses(sx, sy, channel, output);
+                    }
+                }
+            }
+        }
+    }
+    else {
+        const unsigned int c = TensorLayout::blockSize(layout);
+        const unsigned int nbChannelBlocks = (nbChannels + c - 1) / c;
+        const unsigned int nbOutputBlocks = (nbOutputs + c - 1) / c;
+
+        filters.resize({c, c, kernelWidth, kernelHeight, nbChannelBlocks,
+                        nbOutputBlocks}, T(0.0));
+
+#pragma omp parallel for if (nbOutputs > 16)
+        for (int output = 0; output < (int)nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                    for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                        filters(output % c, channel % c, sx, sy, channel / c,
+                                output / c)
+                            = sharedSynapses(sx, sy, channel, output);
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace {
+    /// NCHWc convolution, computing C outputs at once with the channels of
+    /// each input block innermost
+    template <class T, unsigned int C>
+    void forwardBlocked(const T* alpha,
+                        const N2D2::Tensor<T>& inputs,
+                        const N2D2::Tensor<T>& filters,
+                        const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                        const T* beta,
+                        N2D2::Tensor<T>& outputs)
+    {
+        const unsigned int kernelWidth = filters.dims()[2];
+        const unsigned int kernelHeight = filters.dims()[3];
+        const unsigned int nbChannelBlocks = filters.dims()[4];
+        const unsigned int nbOutputBlocks = filters.dims()[5];
+        const unsigned int size = outputs.dimB() * nbOutputBlocks;
+        // Outputs kept in the NCHWc layout, {C, X, Y, Z / C, B}
+        const bool blockedOutputs
+            = (outputs.getLayout() != N2D2::TensorLayout::NCHW);
+        N2D2::Tensor<T> layoutOutputs = N2D2::TensorLayout::view(outputs);
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (outputs.dimB() > 4 && size > 16)
+#endif
+        for (int batchPos = 0; batchPos < (int)outputs.dimB(); ++batchPos) {
+            for (unsigned int outputBlock = 0; outputBlock < nbOutputBlocks;
+                 ++outputBlock)
+            {
+                const unsigned int nbBlockOutputs = std::min(C,
+                    (unsigned int)outputs.dimZ() - outputBlock * C);
+
+                for (unsigned int oy = 0; oy < outputs.dimY(); ++oy) {
+                    for (unsigned int ox = 0; ox < outputs.dimX(); ++ox) {
+                        T weightedSums[C];
+                        std::fill(weightedSums, weightedSums + C, T(0.0));
+
+                        for (unsigned int channelBlock = 0;
+                             channelBlock < nbChannelBlocks; ++channelBlock)
+                        {
+                            for (unsigned int sy = 0; sy < kernelHeight; ++sy)
+                            {
+                                const int iy = (int)(oy * desc.stride[1]
+                                                     + sy * desc.dilation[1])
+                                               - desc.padding[1];
+
+                                if (iy < 0 || iy >= (int)inputs.dims()[2])
+                                    continue;
+
+                                for (unsigned int sx = 0; sx < kernelWidth;
+                                     ++sx)
+                                {
+                                    const int ix = (int)(ox * desc.stride[0]
+                                                + sx * desc.dilation[0])
+                                            - desc.padding[0];
+
+                                    if (ix < 0 || ix >= (int)inputs.dims()[1])
+                                        continue;
+
+                                    const T* input = &inputs(0, ix, iy,
+                                                             channelBlock,
+                                                             batchPos);
+                                    const T* filter = &filters(0, 0, sx, sy,
+                                                               channelBlock,
+                                                               outputBlock);
+
+                                    for (unsigned int c = 0; c < C; ++c) {
+                                        for (unsigned int o = 0; o < C; ++o) {
+                                            weightedSums[o]
+                                                += input[c] * filter[c * C + o];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+
+                        for (unsigned int o = 0; o < nbBlockOutputs; ++o) {
+                            T& output = (blockedOutputs)
+                                ? layoutOutputs(o, ox, oy, outputBlock,
+                                                batchPos)
+                                : outputs(ox, oy, outputBlock * C + o,
+                                          batchPos);
+                            output = (*alpha) * weightedSums[o]
+                                     + (*beta) * output;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::ConvCell_Frame_Kernels::forwardLayout(const T* alpha,
+                                                 const Tensor<T>& inputs,
+                                                 const Tensor<T>& filters,
+                                                 TensorLayout::Layout layout,
+                                                 const Descriptor& desc,
+                                                 const T* beta,
+                                                 Tensor<T>& outputs)
+{
+    if (desc.subSample[0] != 1 || desc.subSample[1] != 1) {
+        throw std::domain_error("ConvCell_Frame_Kernels::forwardLayout():"
+                                " sub-sampling is not supported.");
+    }
+
+    if (outputs.getLayout() != TensorLayout::NCHW
+        && outputs.getLayout() != layout)
+    {
+        throw std::domain_error("ConvCell_Frame_Kernels::forwardLayout():"
+                                " the outputs must be in the NCHW layout or"
+                                " in the layout of the inputs.");
+    }
+
+    if (layout == TensorLayout::NCHW) {
+        if (desc.dilation[0] != 1 || desc.dilation[1] != 1)
+            forwardIm2Col(alpha, inputs, filters, desc, beta, outputs);
+        else
+            forward(alpha, inputs, filters, desc, beta, outputs);
+    }
+    else if (layout == TensorLayout::NHWC) {
+        const unsigned int nbChannels = inputs.dims()[0];
+        const unsigned int kernelWidth = filters.dims()[1];
+        const unsigned int kernelHeight = filters.dims()[2];
+        const unsigned int size = outputs.dimB() * outputs.dimY();
+        // Outputs kept in the NHWC layout, {Z, X, Y, B}
+        const bool nhwcOutputs = (outputs.getLayout() == TensorLayout::NHWC);
+        Tensor<T> layoutOutputs = TensorLayout::view(outputs);
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (outputs.dimB() > 4 && size > 16)
+#endif
+        for (int batchPos = 0; batchPos < (int)outputs.dimB(); ++batchPos) {
+            for (unsigned int oy = 0; oy < outputs.dimY(); ++oy) {
+                for (unsigned int ox = 0; ox < outputs.dimX(); ++ox) {
+                    for (unsigned int output = 0; output < outputs.dimZ();
+                         ++output)
+                    {
+                        T weightedSum(0.0);
+
+                        for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                            const int iy = (int)(oy * desc.stride[1]
+                                                 + sy * desc.dilation[1])
+                                           - desc.padding[1];
+
+                            if (iy < 0 || iy >= (int)inputs.dims()[2])
+                                continue;
+
+                            for (unsigned int sx = 0; sx < kernelWidth; ++sx)
+                            {
+                                const int ix = (int)(ox * desc.stride[0]
+                                                     + sx * desc.dilation[0])
+                                               - desc.padding[0];
+
+                                if (ix < 0 || ix >= (int)inputs.dims()[1])
+                                    continue;
+
+                                // Contiguous channels in both the inputs and
+                                // the filters
+                                const T* input = &inputs(0, ix, iy, batchPos);
+                                const T* filter = &filters(0, sx, sy, output);
+
+                                for (unsigned int channel = 0;
+                                     channel < nbChannels; ++channel)
+                                {
+                                    weightedSum += input[channel]
+                                                   * filter[channel];
+                                }
+                            }
+                        }
+
+                        T& outputValue = (nhwcOutputs)
+                            ? layoutOutputs(output, ox, oy, batchPos)
+                            : outputs(ox, oy, output, batchPos);
+                        outputValue = (*alpha) * weightedSum
+                                      + (*beta) * outputValue;
+                    }
+                }
+            }
+        }
+    }
+    else if (layout == TensorLayout::NCHW8c)
+        forwardBlocked<T, 8>(alpha, inputs, filters, desc, beta, outputs);
+    else
+        forwardBlocked<T, 16>(alpha, inputs, filters, desc, beta, outputs);
+}
+
+namespace N2D2 {
+template <>
+void ConvCell_Frame_Kernels::forward<half_float::half>(
+    const half_float::half* alpha,
+    const Tensor<half_float::half>& inputs,
+    const Tensor<half_float::half>& sharedSynapses,
+    const Descriptor& desc,
+    const half_float::half* beta,
+    Tensor<half_float::half>& outputs,
+    const Tensor<bool>& maps)
+{
+    const float floatAlpha = (float)(*alpha);
+    const float floatBeta = (float)(*beta);
+    Tensor<float> floatOutputs = (floatBeta != 0.0f)
+        ? toFloatTensor(outputs)
+        : Tensor<float>(outputs.dims());
+
+    forward<float>(&floatAlpha,
+                   toFloatTensor(inputs),
+                   toFloatTensor(sharedSynapses),
+                   desc,
+                   &floatBeta,
+                   floatOutputs,
+                   maps);
+
+    fromFloatTensor(floatOutputs, outputs);
+}
+
+template <>
+void ConvCell_Frame_Kernels::forwardGrouped<half_float::half>(
+    const half_float::half* alpha,
+    const Tensor<half_float::half>& inputs,
+    const Tensor<half_float::half>& sharedSynapses,
+    const Descriptor& desc,
+    const half_float::half* beta,
+    Tensor<half_float::half>& outputs,
+    unsigned int nbGroups)
+{
+    const float floatAlpha = (float)(*alpha);
+    const float floatBeta = (float)(*beta);
+    Tensor<float> floatOutputs = (floatBeta != 0.0f)
+        ? toFloatTensor(outputs)
+        : Tensor<float>(outputs.dims());
+
+    forwardGrouped<float>(&floatAlpha,
+                          toFloatTensor(inputs),
+                          toFloatTensor(sharedSynapses),
+                          desc,
+                          &floatBeta,
+                          floatOutputs,
+                          nbGroups);
+
+    fromFloatTensor(floatOutputs, outputs);
+}
+
+    template void ConvCell_Frame_Kernels::forward<float>(const float* alpha,
+                                           const Tensor<float>& inputs,
+                                           const Tensor
+                                           <float>& sharedSynapses,
+                                           const Descriptor& desc,
+                                           const float* beta,
+                                           Tensor<float>& outputs,
+                                           const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::forward<double>(const double* alpha,
+                                           const Tensor<double>& inputs,
+                                           const Tensor
+                                           <double>& sharedSynapses,
+                                           const Descriptor& desc,
+                                           const double* beta,
+                                           Tensor<double>& outputs,
+                                           const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::forwardBias<half_float::half>(const half_float::half* alpha,
+                                               const Tensor<half_float::half>& bias,
+                                               const half_float::half* beta,
+                                               Tensor<half_float::half>& outputs);
+    template void ConvCell_Frame_Kernels::forwardBias<float>(const float* alpha,
+                                               const Tensor<float>& bias,
+                                               const float* beta,
+                                               Tensor<float>& outputs);
+    template void ConvCell_Frame_Kernels::forwardBias<double>(const double* alpha,
+                                               const Tensor<double>& bias,
+                                               const double* beta,
+                                               Tensor<double>& outputs);
+
+    template void ConvCell_Frame_Kernels::forwardEpilogue<half_float::half>(
+        const Tensor<half_float::half>* bias,
+        const EpilogueActivation& activation,
+        const std::vector<const Tensor<half_float::half>*>& sumInputs,
+        const std::vector<half_float::half>& sumWeights,
+        const std::vector<half_float::half>& sumShifts,
+        const EpilogueActivation& sumActivation,
+        Tensor<half_float::half>& outputs);
+    template void ConvCell_Frame_Kernels::forwardEpilogue<float>(
+        const Tensor<float>* bias,
+        const EpilogueActivation& activation,
+        const std::vector<const Tensor<float>*>& sumInputs,
+        const std::vector<float>& sumWeights,
+        const std::vector<float>& sumShifts,
+        const EpilogueActivation& sumActivation,
+        Tensor<float>& outputs);
+    template void ConvCell_Frame_Kernels::forwardEpilogue<double>(
+        const Tensor<double>* bias,
+        const EpilogueActivation& activation,
+        const std::vector<const Tensor<double>*>& sumInputs,
+        const std::vector<double>& sumWeights,
+        const std::vector<double>& sumShifts,
+        const EpilogueActivation& sumActivation,
+        Tensor<double>& outputs);
+
+    template void ConvCell_Frame_Kernels::backwardData<half_float::half>(const half_float::half* alpha,
+                                                const Tensor
+                                                <half_float::half>& sharedSynapses,
+                                                const Tensor
+                                                <half_float::half>& diffInputs,
+                                                const Descriptor& desc,
+                                                const half_float::half* beta,
+                                                Tensor<half_float::half>& diffOutputs,
+                                                const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardData<float>(const float* alpha,
+                                                const Tensor
+                                                <float>& sharedSynapses,
+                                                const Tensor
+                                                <float>& diffInputs,
+                                                const Descriptor& desc,
+                                                const float* beta,
+                                                Tensor<float>& diffOutputs,
+                                                const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardData<double>(const double* alpha,
+                                                const Tensor
+                                                <double>& sharedSynapses,
+                                                const Tensor
+                                                <double>& diffInputs,
+                                                const Descriptor& desc,
+                                                const double* beta,
+                                                Tensor<double>& diffOutputs,
+                                                const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::backwardFilter<half_float::half>(const half_float::half* alpha,
+                                                  const Tensor
+                                                  <half_float::half>& inputs,
+                                                  const Tensor
+                                                  <half_float::half>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const half_float::half* beta,
+                                                  Tensor
+                                                  <half_float::half>& diffSharedSynapses,
+                                                  const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardFilter<float>(const float* alpha,
+                                                  const Tensor
+                                                  <float>& inputs,
+                                                  const Tensor
+                                                  <float>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const float* beta,
+                                                  Tensor
+                                                  <float>& diffSharedSynapses,
+                                                  const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardFilter<double>(const double* alpha,
+                                                  const Tensor
+                                                  <double>& inputs,
+                                                  const Tensor
+                                                  <double>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const double* beta,
+                                                  Tensor
+                                                  <double>& diffSharedSynapses,
+                                                  const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::backwardBias<half_float::half>(const half_float::half* alpha,
+                                                const Tensor
+                                                <half_float::half>& diffInputs,
+                                                const half_float::half* beta,
+                                                Tensor<half_float::half>& diffBias);
+    template void ConvCell_Frame_Kernels::backwardBias<float>(const float* alpha,
+                                                const Tensor
+                                                <float>& diffInputs,
+                                                const float* beta,
+                                                Tensor<float>& diffBias);
+    template void ConvCell_Frame_Kernels::backwardBias<double>(const double* alpha,
+                                                const Tensor
+                                                <double>& diffInputs,
+                                                const double* beta,
+                                                Tensor<double>& diffBias);
+
+    template void ConvCell_Frame_Kernels::im2col<half_float::half>(const Tensor<half_float::half>& inputs,
+                                          unsigned int batchPos,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          half_float::half* col);
+    template void ConvCell_Frame_Kernels::im2col<float>(const Tensor<float>& inputs,
+                                          unsigned int batchPos,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          float* col);
+    template void ConvCell_Frame_Kernels::im2col<double>(const Tensor<double>& inputs,
+                                          unsigned int batchPos,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          double* col);
+    template void ConvCell_Frame_Kernels::col2im<half_float::half>(const half_float::half* col,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          const half_float::half* beta,
+                                          Tensor<half_float::half>& outputs,
+                                          unsigned int batchPos);
+    template void ConvCell_Frame_Kernels::col2im<float>(const float* col,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          const float* beta,
+                                          Tensor<float>& outputs,
+                                          unsigned int batchPos);
+    template void ConvCell_Frame_Kernels::col2im<double>(const double* col,
+                                          unsigned int kernelWidth,
+                                          unsigned int kernelHeight,
+                                          const Descriptor& desc,
+                                          unsigned int oxSize,
+                                          unsigned int oySize,
+                                          const double* beta,
+                                          Tensor<double>& outputs,
+                                          unsigned int batchPos);
+
+    template void ConvCell_Frame_Kernels::forwardIm2Col<half_float::half>(const half_float::half* alpha,
+                                           const Tensor<half_float::half>& inputs,
+                                           const Tensor
+                                           <half_float::half>& sharedSynapses,
+                                           const Descriptor& desc,
+                                           const half_float::half* beta,
+                                           Tensor<half_float::half>& outputs,
+                                           const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::forwardIm2Col<float>(const float* alpha,
+                                           const Tensor<float>& inputs,
+                                           const Tensor
+                                           <float>& sharedSynapses,
+                                           const Descriptor& desc,
+                                           const float* beta,
+                                           Tensor<float>& outputs,
+                                           const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::forwardIm2Col<double>(const double* alpha,
+                                           const Tensor<double>& inputs,
+                                           const Tensor
+                                           <double>& sharedSynapses,
+                                           const Descriptor& desc,
+                                           const double* beta,
+                                           Tensor<double>& outputs,
+                                           const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::backwardDataIm2Col<half_float::half>(const half_float::half* alpha,
+                                                const Tensor
+                                                <half_float::half>& sharedSynapses,
+                                                const Tensor
+                                                <half_float::half>& diffInputs,
+                                                const Descriptor& desc,
+                                                const half_float::half* beta,
+                                                Tensor<half_float::half>& diffOutputs,
+                                                const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardDataIm2Col<float>(const float* alpha,
+                                                const Tensor
+                                                <float>& sharedSynapses,
+                                                const Tensor
+                                                <float>& diffInputs,
+                                                const Descriptor& desc,
+                                                const float* beta,
+                                                Tensor<float>& diffOutputs,
+                                                const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardDataIm2Col<double>(const double* alpha,
+                                                const Tensor
+                                                <double>& sharedSynapses,
+                                                const Tensor
+                                                <double>& diffInputs,
+                                                const Descriptor& desc,
+                                                const double* beta,
+                                                Tensor<double>& diffOutputs,
+                                                const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::backwardFilterIm2Col<half_float::half>(const half_float::half* alpha,
+                                                  const Tensor
+                                                  <half_float::half>& inputs,
+                                                  const Tensor
+                                                  <half_float::half>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const half_float::half* beta,
+                                                  Tensor
+                                                  <half_float::half>& diffSharedSynapses,
+                                                  const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardFilterIm2Col<float>(const float* alpha,
+                                                  const Tensor
+                                                  <float>& inputs,
+                                                  const Tensor
+                                                  <float>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const float* beta,
+                                                  Tensor
+                                                  <float>& diffSharedSynapses,
+                                                  const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::backwardFilterIm2Col<double>(const double* alpha,
+                                                  const Tensor
+                                                  <double>& inputs,
+                                                  const Tensor
+                                                  <double>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const double* beta,
+                                                  Tensor
+                                                  <double>& diffSharedSynapses,
+                                                  const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::compressFilters<half_float::half>(
+        const Tensor<half_float::half>& sharedSynapses,
+        Sparse::CsrMatrix<half_float::half>& filters,
+        const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::compressFilters<float>(
+        const Tensor<float>& sharedSynapses,
+        Sparse::CsrMatrix<float>& filters,
+        const Tensor<bool>& maps);
+    template void ConvCell_Frame_Kernels::compressFilters<double>(
+        const Tensor<double>& sharedSynapses,
+        Sparse::CsrMatrix<double>& filters,
+        const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::forwardSparse<half_float::half>(
+        const half_float::half* alpha,
+        const Tensor<half_float::half>& inputs,
+        const Sparse::CsrMatrix<half_float::half>& filters,
+        unsigned int kernelWidth,
+        unsigned int kernelHeight,
+        const Descriptor& desc,
+        const half_float::half* beta,
+        Tensor<half_float::half>& outputs);
+    template void ConvCell_Frame_Kernels::forwardSparse<float>(
+        const float* alpha,
+        const Tensor<float>& inputs,
+        const Sparse::CsrMatrix<float>& filters,
+        unsigned int kernelWidth,
+        unsigned int kernelHeight,
+        const Descriptor& desc,
+        const float* beta,
+        Tensor<float>& outputs);
+    template void ConvCell_Frame_Kernels::forwardSparse<double>(
+        const double* alpha,
+        const Tensor<double>& inputs,
+        const Sparse::CsrMatrix<double>& filters,
+        unsigned int kernelWidth,
+        unsigned int kernelHeight,
+        const Descriptor& desc,
+        const double* beta,
+        Tensor<double>& outputs);
+
+    template bool ConvCell_Frame_Kernels::quantizeFilters<half_float::half>(
+        const Tensor<half_float::half>& sharedSynapses,
+        std::vector<std::int8_t>& filters,
+        const Tensor<bool>& maps);
+    template bool ConvCell_Frame_Kernels::quantizeFilters<float>(
+        const Tensor<float>& sharedSynapses,
+        std::vector<std::int8_t>& filters,
+        const Tensor<bool>& maps);
+    template bool ConvCell_Frame_Kernels::quantizeFilters<double>(
+        const Tensor<double>& sharedSynapses,
+        std::vector<std::int8_t>& filters,
+        const Tensor<bool>& maps);
+    template bool ConvCell_Frame_Kernels::forwardInt8<half_float::half>(
+        const Tensor<half_float::half>& inputs,
+        const std::vector<std::int8_t>& filters,
+        unsigned int kernelWidth,
+        unsigned int kernelHeight,
+        const Descriptor& desc,
+        const half_float::half* beta,
+        Tensor<half_float::half>& outputs);
+    template bool ConvCell_Frame_Kernels::forwardInt8<float>(
+        const Tensor<float>& inputs,
+        const std::vector<std::int8_t>& filters,
+        unsigned int kernelWidth,
+        unsigned int kernelHeight,
+        const Descriptor& desc,
+        const float* beta,
+        Tensor<float>& outputs);
+    template bool ConvCell_Frame_Kernels::forwardInt8<double>(
+        const Tensor<double>& inputs,
+        const std::vector<std::int8_t>& filters,
+        unsigned int kernelWidth,
+        unsigned int kernelHeight,
+        const Descriptor& desc,
+        const double* beta,
+        Tensor<double>& outputs);
+
+    template void ConvCell_Frame_Kernels::winogradFilters<half_float::half>(unsigned int tileSize,
+                                                  const Tensor
+                                                  <half_float::half>& sharedSynapses,
+                                                  bool backward,
+                                                  Tensor<half_float::half>& filters,
+                                                  const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::winogradFilters<float>(unsigned int tileSize,
+                                                  const Tensor
+                                                  <float>& sharedSynapses,
+                                                  bool backward,
+                                                  Tensor<float>& filters,
+                                                  const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::winogradFilters<double>(unsigned int tileSize,
+                                                  const Tensor
+                                                  <double>& sharedSynapses,
+                                                  bool backward,
+                                                  Tensor<double>& filters,
+                                                  const Tensor<bool>& maps);
+
+    template void ConvCell_Frame_Kernels::forwardWinograd<half_float::half>(const half_float::half* alpha,
+                                                  const Tensor<half_float::half>& inputs,
+                                                  const Tensor<half_float::half>& filters,
+                                                  const Descriptor& desc,
+                                                  const half_float::half* beta,
+                                                  Tensor<half_float::half>& outputs);
+
+    template void ConvCell_Frame_Kernels::forwardWinograd<float>(const float* alpha,
+                                                  const Tensor<float>& inputs,
+                                                  const Tensor<float>& filters,
+                                                  const Descriptor& desc,
+                                                  const float* beta,
+                                                  Tensor<float>& outputs);
+
+    template void ConvCell_Frame_Kernels::forwardWinograd<double>(const double* alpha,
+                                                  const Tensor<double>& inputs,
+                                                  const Tensor<double>& filters,
+                                                  const Descriptor& desc,
+                                                  const double* beta,
+                                                  Tensor<double>& outputs);
+
+    template void ConvCell_Frame_Kernels::backwardDataWinograd<half_float::half>(const half_float::half* alpha,
+                                                  const Tensor<half_float::half>& filters,
+                                                  const Tensor
+                                                  <half_float::half>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const half_float::half* beta,
+                                                  Tensor<half_float::half>& diffOutputs);
+
+    template void ConvCell_Frame_Kernels::backwardDataWinograd<float>(const float* alpha,
+                                                  const Tensor<float>& filters,
+                                                  const Tensor
+                                                  <float>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const float* beta,
+                                                  Tensor<float>& diffOutputs);
+
+    template void ConvCell_Frame_Kernels::backwardDataWinograd<double>(const double* alpha,
+                                                  const Tensor<double>& filters,
+                                                  const Tensor
+                                                  <double>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const double* beta,
+                                                  Tensor<double>& diffOutputs);
+
+
+    template void ConvCell_Frame_Kernels::forwardGrouped<float>(const float* alpha,
+                                                  const Tensor<float>& inputs,
+                                                  const Tensor
+                                                  <float>& sharedSynapses,
+                                                  const Descriptor& desc,
+                                                  const float* beta,
+                                                  Tensor<float>& outputs,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::forwardGrouped<double>(const double* alpha,
+                                                  const Tensor<double>& inputs,
+                                                  const Tensor
+                                                  <double>& sharedSynapses,
+                                                  const Descriptor& desc,
+                                                  const double* beta,
+                                                  Tensor<double>& outputs,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::backwardDataGrouped<half_float::half>(const half_float::half* alpha,
+                                                  const Tensor
+                                                  <half_float::half>& sharedSynapses,
+                                                  const Tensor
+                                                  <half_float::half>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const half_float::half* beta,
+                                                  Tensor<half_float::half>& diffOutputs,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::backwardDataGrouped<float>(const float* alpha,
+                                                  const Tensor
+                                                  <float>& sharedSynapses,
+                                                  const Tensor
+                                                  <float>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const float* beta,
+                                                  Tensor<float>& diffOutputs,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::backwardDataGrouped<double>(const double* alpha,
+                                                  const Tensor
+                                                  <double>& sharedSynapses,
+                                                  const Tensor
+                                                  <double>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const double* beta,
+                                                  Tensor<double>& diffOutputs,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::backwardFilterGrouped<half_float::half>(const half_float::half* alpha,
+                                                  const Tensor
+                                                  <half_float::half>& inputs,
+                                                  const Tensor
+                                                  <half_float::half>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const half_float::half* beta,
+                                                  Tensor
+                                                  <half_float::half>& diffSharedSynapses,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::backwardFilterGrouped<float>(const float* alpha,
+                                                  const Tensor
+                                                  <float>& inputs,
+                                                  const Tensor
+                                                  <float>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const float* beta,
+                                                  Tensor
+                                                  <float>& diffSharedSynapses,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::backwardFilterGrouped<double>(const double* alpha,
+                                                  const Tensor
+                                                  <double>& inputs,
+                                                  const Tensor
+                                                  <double>& diffInputs,
+                                                  const Descriptor& desc,
+                                                  const double* beta,
+                                                  Tensor
+                                                  <double>& diffSharedSynapses,
+                                                  unsigned int nbGroups);
+
+    template void ConvCell_Frame_Kernels::packFilters<half_float::half>(
+        const Tensor<half_float::half>& sharedSynapses,
+        TensorLayout::Layout layout,
+        Tensor<half_float::half>& filters);
+    template void ConvCell_Frame_Kernels::forwardLayout<half_float::half>(
+        const half_float::half* alpha,
+        const Tensor<half_float::half>& inputs,
+        const Tensor<half_float::half>& filters,
+        TensorLayout::Layout layout,
+        const Descriptor& desc,
+        const half_float::half* beta,
+        Tensor<half_float::half>& outputs);
+    template void ConvCell_Frame_Kernels::packFilters<float>(
+        const Tensor<float>& sharedSynapses,
+        TensorLayout::Layout layout,
+        Tensor<float>& filters);
+    template void ConvCell_Frame_Kernels::forwardLayout<float>(
+        const float* alpha,
+        const Tensor<float>& inputs,
+        const Tensor<float>& filters,
+        TensorLayout::Layout layout,
+        const Descriptor& desc,
+        const float* beta,
+        Tensor<float>& outputs);
+    template void ConvCell_Frame_Kernels::packFilters<double>(
+        const Tensor<double>& sharedSynapses,
+        TensorLayout::Layout layout,
+        Tensor<double>& filters);
+    template void ConvCell_Frame_Kernels::forwardLayout<double>(
+        const double* alpha,
+        const Tensor<double>& inputs,
+        const Tensor<double>& filters,
+        TensorLayout::Layout layout,
+        const Descriptor& desc,
+        const double* beta,
+        Tensor<double>& outputs);
 }
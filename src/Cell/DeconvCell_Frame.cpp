@@ -65,7 +65,9 @@ N2D2::DeconvCell_Frame<T>::DeconvCell_Frame(const DeepNet& deepNet, const std::s
       mBias(std::make_shared<Tensor<T> >()),
       mDiffBias({1, 1, getNbOutputs(), 1}),
       mConvDesc(std::vector<unsigned int>({1, 1}), strideDims, paddingDims,
-                dilationDims)
+                dilationDims),
+      mConvAlgorithm(ConvCell_Frame_Kernels::Direct),
+      mAlgorithm(this, "Algorithm", ConvCell_Frame_Kernels::Auto)
 {
     // ctor
     if (kernelDims.size() != 2) {
@@ -168,6 +170,38 @@ void N2D2::DeconvCell_Frame<T>::initialize()
 
         mDiffSharedSynapses.push_back(new Tensor<T>(kernelDims), 0);
     }
+
+    const bool dilation = (mConvDesc.dilation[0] != 1
+                           || mConvDesc.dilation[1] != 1);
+    bool grouped = false;
+
+    for (unsigned int k = 0, offset = 0, size = mInputs.size(); k < size;
+        ++k)
+    {
+        grouped = grouped || (getNbGroups(mMapping.rows(offset,
+                                                    mInputs[k].dimZ())) > 1);
+        offset += mInputs[k].dimZ();
+    }
+
+    // The GEMM computes every kernel of a grouped mapping, including the
+    // unconnected (zero) ones
+    if (mAlgorithm == ConvCell_Frame_Kernels::Auto) {
+        mConvAlgorithm = (grouped && !dilation)
+            ? ConvCell_Frame_Kernels::Direct
+            : ConvCell_Frame_Kernels::Im2Col;
+    }
+    else
+        mConvAlgorithm = mAlgorithm;
+
+    if (mConvAlgorithm == ConvCell_Frame_Kernels::Winograd) {
+        throw std::domain_error("DeconvCell_Frame: the Winograd algorithm is"
+                                " not supported.");
+    }
+
+    if (mConvAlgorithm == ConvCell_Frame_Kernels::Direct && dilation) {
+        throw std::domain_error("DeconvCell_Frame: dilation != 1 is only"
+                                " supported with the Im2Col algorithm.");
+    }
 }
 
 template <class T>
@@ -186,14 +220,28 @@ void N2D2::DeconvCell_Frame<T>::propagate(bool inference)
 
         const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
 
-        ConvCell_Frame_Kernels::backwardData<T>(&alpha,
-                                             mSharedSynapses[k],
-                                             input,
-                                             mConvDesc,
-                                             &beta,
-                                             mOutputs,
-                                             mMapping.rows(offset,
+        // The forward deconvolution is the backward data convolution:
+        // GEMM followed by col2im with Im2Col
+        if (mConvAlgorithm == ConvCell_Frame_Kernels::Im2Col) {
+            ConvCell_Frame_Kernels::backwardDataIm2Col<T>(&alpha,
+                                                mSharedSynapses[k],
+                                                input,
+                                                mConvDesc,
+                                                &beta,
+                                                mOutputs,
+                                                mMapping.rows(offset,
                                                         mInputs[k].dimZ()));
+        }
+        else {
+            ConvCell_Frame_Kernels::backwardData<T>(&alpha,
+                                                mSharedSynapses[k],
+                                                input,
+                                                mConvDesc,
+                                                &beta,
+                                                mOutputs,
+                                                mMapping.rows(offset,
+                                                        mInputs[k].dimZ()));
+        }
 
         offset += mInputs[k].dimZ();
     }
@@ -220,14 +268,26 @@ void N2D2::DeconvCell_Frame<T>::backPropagate()
 
         const Tensor<T>& input = tensor_cast_nocopy<T>(mInputs[k]);
 
-        ConvCell_Frame_Kernels::backwardFilter<T>(&alpha,
-                                               mDiffInputs,
-                                               input,
-                                               mConvDesc,
-                                               &beta,
-                                               mDiffSharedSynapses[k],
-                                               mMapping.rows(offset,
-                                                          mInputs[k].dimZ()));
+        if (mConvAlgorithm == ConvCell_Frame_Kernels::Im2Col) {
+            ConvCell_Frame_Kernels::backwardFilterIm2Col<T>(&alpha,
+                                                mDiffInputs,
+                                                input,
+                                                mConvDesc,
+                                                &beta,
+                                                mDiffSharedSynapses[k],
+                                                mMapping.rows(offset,
+                                                        mInputs[k].dimZ()));
+        }
+        else {
+            ConvCell_Frame_Kernels::backwardFilter<T>(&alpha,
+                                                mDiffInputs,
+                                                input,
+                                                mConvDesc,
+                                                &beta,
+                                                mDiffSharedSynapses[k],
+                                                mMapping.rows(offset,
+                                                        mInputs[k].dimZ()));
+        }
 
         offset += mInputs[k].dimZ();
     }
@@ -249,14 +309,26 @@ void N2D2::DeconvCell_Frame<T>::backPropagate()
                 ? tensor_cast<T>(mDiffOutputs[k])
                 : tensor_cast_nocopy<T>(mDiffOutputs[k]);
 
-            ConvCell_Frame_Kernels::forward<T>(&alpha,
-                                            mDiffInputs,
-                                            mSharedSynapses[k],
-                                            mConvDesc,
-                                            &beta,
-                                            diffOutput,
-                                            mMapping.rows(offset,
-                                                       mInputs[k].dimZ()));
+            if (mConvAlgorithm == ConvCell_Frame_Kernels::Im2Col) {
+                ConvCell_Frame_Kernels::forwardIm2Col<T>(&alpha,
+                                                mDiffInputs,
+                                                mSharedSynapses[k],
+                                                mConvDesc,
+                                                &beta,
+                                                diffOutput,
+                                                mMapping.rows(offset,
+                                                        mInputs[k].dimZ()));
+            }
+            else {
+                ConvCell_Frame_Kernels::forward<T>(&alpha,
+                                                mDiffInputs,
+                                                mSharedSynapses[k],
+                                                mConvDesc,
+                                                &beta,
+                                                diffOutput,
+                                                mMapping.rows(offset,
+                                                        mInputs[k].dimZ()));
+            }
 
             offset += mInputs[k].dimZ();
 
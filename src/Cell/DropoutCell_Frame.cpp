@@ -18,9 +18,70 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include <algorithm>
+
 #include "Cell/DropoutCell_Frame.hpp"
 #include "DeepNet.hpp"
 #include "third_party/half.hpp"
+#include "utils/Random.hpp"
+
+namespace {
+    /// dst = mask ? src : 0, for nbBatch blocks of size elements. The
+    /// elements of block batchPos use the bits [offset, offset + size[ of the
+    /// block batchPos of maskStride bits of the Bernoulli mask defined by
+    /// (seed, stream, p) (see Random::randBernoulliMask()). The mask words
+    /// are generated on the fly, for each block of elements, and not stored.
+    template <class T>
+    void applyMask(unsigned long long seed,
+                   unsigned long long stream,
+                   double p,
+                   std::size_t offset,
+                   std::size_t maskStride,
+                   std::size_t size,
+                   unsigned int nbBatch,
+                   const T* src,
+                   std::size_t srcStride,
+                   T* dst,
+                   std::size_t dstStride)
+    {
+        // Blocks of 32 words of the mask (33 words if not aligned on a word)
+        const std::size_t blockWords = 32;
+        const std::size_t blockSize = blockWords * 32;
+        const unsigned int nbBlocks = (size + blockSize - 1) / blockSize;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (nbBatch * size > 16384)
+#else
+#pragma omp parallel for if (nbBatch > 4)
+#endif
+        for (int batchPos = 0; batchPos < (int)nbBatch; ++batchPos) {
+            for (unsigned int block = 0; block < nbBlocks; ++block) {
+                const std::size_t begin = block * blockSize;
+                const std::size_t end = std::min(begin + blockSize, size);
+                const std::size_t maskOffset = batchPos * maskStride + offset;
+                const std::size_t firstWord = (maskOffset + begin) / 32;
+                const std::size_t lastWord = (maskOffset + end - 1) / 32;
+                const T* srcBatch = src + batchPos * srcStride;
+                T* dstBatch = dst + batchPos * dstStride;
+
+                unsigned int mask[blockWords + 1];
+
+                for (std::size_t word = firstWord; word <= lastWord; ++word) {
+                    mask[word - firstWord]
+                        = N2D2::Random::randBernoulliWord(seed, stream, word,
+                                                          p);
+                }
+
+                for (std::size_t index = begin; index < end; ++index) {
+                    const std::size_t bit = maskOffset + index - 32 * firstWord;
+
+                    dstBatch[index] = ((mask[bit / 32] >> (bit % 32)) & 1U)
+                        ? srcBatch[index] : T(0.0);
+                }
+            }
+        }
+    }
+}
 
 template <>
 N2D2::Registrar<N2D2::DropoutCell>
@@ -45,7 +106,9 @@ N2D2::DropoutCell_Frame<T>::DropoutCell_Frame(const DeepNet& deepNet, const std:
                                               unsigned int nbOutputs)
     : Cell(deepNet, name, nbOutputs),
       DropoutCell(deepNet, name, nbOutputs),
-      Cell_Frame<T>(deepNet, name, nbOutputs)
+      Cell_Frame<T>(deepNet, name, nbOutputs),
+      mSeed(0),
+      mStep(0)
 {
     // ctor
 }
@@ -65,8 +128,6 @@ void N2D2::DropoutCell_Frame<T>::initialize()
                                      + mName);
         }
     }
-
-    mMask.resize(mOutputs.dims());
 }
 
 template <class T>
@@ -104,33 +165,24 @@ void N2D2::DropoutCell_Frame<T>::propagate(bool inference)
             }
         }
     } else {
-        for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
-            const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
+        // A new mask is drawn at each step. The seed is taken from the
+        // global generator, for reproducibility with Random::mtSeed().
+        if (mStep == 0) {
+            mSeed = ((unsigned long long)Random::mtRand() << 32)
+                | Random::mtRand();
+        }
 
-            unsigned int outputOffset = offset;
-            unsigned int inputOffset = 0;
+        ++mStep;
 
-            for (unsigned int batchPos = 0; batchPos < mInputs.dimB();
-                ++batchPos)
-            {
-                for (unsigned int index = 0,
-                     batchSize = (mInputs[k].size() / mInputs.dimB());
-                     index < batchSize;
-                     ++index)
-                {
-                    const unsigned int outputIndex = index + outputOffset;
+        for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+            const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
 
-                    mMask(outputIndex) = Random::randBernoulli(1.0 - mDropout);
-                    mOutputs(outputIndex) = (mMask(outputIndex))
-                        ? input(index + inputOffset)
-                        : 0.0;
-                }
+            const unsigned int inputSize = mInputs[k].size() / mInputs.dimB();
+            const unsigned int outputSize = mOutputs.size() / mInputs.dimB();
 
-                outputOffset += mOutputs.dimX() * mOutputs.dimY()
-                                * mInputs.dimZ();
-                inputOffset += mOutputs.dimX() * mOutputs.dimY()
-                               * mInputs[k].dimZ();
-            }
+            applyMask(mSeed, mStep, 1.0 - mDropout,
+                      offset, outputSize, inputSize, mInputs.dimB(),
+                      &input(0), inputSize, &mOutputs(offset), outputSize);
 
             offset += mOutputs.dimX() * mOutputs.dimY() * mInputs[k].dimZ();
         }
@@ -155,28 +207,13 @@ void N2D2::DropoutCell_Frame<T>::backPropagate()
         Tensor<T> diffOutput
             = tensor_cast_nocopy<T>(mDiffOutputs[k]);
 
-        unsigned int outputOffset = offset;
-        unsigned int inputOffset = 0;
-
-        for (unsigned int batchPos = 0; batchPos < mInputs.dimB();
-            ++batchPos)
-        {
-            for (unsigned int index = 0,
-                 batchSize = (mInputs[k].size() / mInputs.dimB());
-                 index < batchSize;
-                 ++index)
-            {
-                const unsigned int outputIndex = index + outputOffset;
-                diffOutput(index + inputOffset) = (mMask(outputIndex))
-                    ? mDiffInputs(outputIndex)
-                    : 0.0;
-            }
+        const unsigned int inputSize = mInputs[k].size() / mInputs.dimB();
+        const unsigned int outputSize = mOutputs.size() / mInputs.dimB();
 
-            outputOffset += mOutputs.dimX() * mOutputs.dimY()
-                            * mInputs.dimZ();
-            inputOffset += mOutputs.dimX() * mOutputs.dimY()
-                           * mInputs[k].dimZ();
-        }
+        // Same mask as in propagate()
+        applyMask(mSeed, mStep, 1.0 - mDropout,
+                  offset, outputSize, inputSize, mInputs.dimB(),
+                  &mDiffInputs(offset), outputSize, &diffOutput(0), inputSize);
 
         offset += mOutputs.dimX() * mOutputs.dimY() * mInputs[k].dimZ();
 
@@ -38,7 +38,9 @@ N2D2::ElemWiseCell_Frame::ElemWiseCell_Frame(const DeepNet& deepNet, const std::
                operation,
                weights,
                shifts),
-      Cell_Frame<Float_T>(deepNet, name, nbOutputs, activation)
+      Cell_Frame<Float_T>(deepNet, name, nbOutputs, activation),
+      mInPlaceInput(-1),
+      mSharedDiffInputs(false)
 {
     // ctor
 }
@@ -69,6 +71,35 @@ void N2D2::ElemWiseCell_Frame::initialize()
         mInterTerm.resize(mOutputs.dims());
 }
 
+bool N2D2::ElemWiseCell_Frame::setInPlace(unsigned int input)
+{
+    if (mOperation != Sum || mInPlaceInput >= 0 || input >= mInputs.size())
+        return false;
+
+    // The outputs of the input are overwritten by the Sum: they must be of
+    // the same type and dimensions
+    Tensor<Float_T>* inputs = dynamic_cast<Tensor<Float_T>*>(&mInputs[input]);
+
+    if (inputs == NULL || inputs->dims() != mOutputs.dims())
+        return false;
+
+    const Float_T weight = (input < mWeights.size()) ? mWeights[input] : 1.0;
+    Tensor<Float_T>* diffOutputs = (input < mDiffOutputs.size())
+        ? dynamic_cast<Tensor<Float_T>*>(&mDiffOutputs[input]) : NULL;
+
+    mInPlaceInput = input;
+    // The diff. outputs of the input are exactly the diff. inputs of the Sum
+    mSharedDiffInputs = (weight == 1.0 && diffOutputs != NULL
+                         && diffOutputs->dims() == mDiffInputs.dims());
+
+    mOutputs.clear();
+
+    if (mSharedDiffInputs)
+        mDiffInputs.clear();
+
+    return true;
+}
+
 void N2D2::ElemWiseCell_Frame::propagate(bool inference)
 {
     const unsigned int nbInputs = mInputs.size();
@@ -81,15 +112,22 @@ void N2D2::ElemWiseCell_Frame::propagate(bool inference)
     for (unsigned int k = 0; k < nbInputs; ++k)
         inputs.push_back(tensor_cast<Float_T>(mInputs[k]));
 
+    Tensor<Float_T>& outputs = dynamic_cast<Tensor<Float_T>&>(getOutputs());
+
     if (mOperation == Sum) {
-        for (unsigned int n = 0; n < nbElems; ++n) {
-            mOutputs(n) = mWeights[0] * inputs[0](n)
-                            + mShifts[0];
+        // The in-place input is accumulated first, as it is overwritten
+        const unsigned int first = (mInPlaceInput >= 0) ? mInPlaceInput : 0;
 
-            for (unsigned int k = 1; k < nbInputs; ++k) {
-                mOutputs(n) += mWeights[k] * inputs[k](n)
-                                + mShifts[k];
+#pragma omp parallel for if (nbElems > 1024)
+        for (int n = 0; n < (int)nbElems; ++n) {
+            Float_T sum = mWeights[first] * inputs[first](n) + mShifts[first];
+
+            for (unsigned int k = 0; k < nbInputs; ++k) {
+                if (k != first)
+                    sum += mWeights[k] * inputs[k](n) + mShifts[k];
             }
+
+            outputs(n) = sum;
         }
     }
     else if (mOperation == AbsSum) {
@@ -145,8 +183,14 @@ void N2D2::ElemWiseCell_Frame::propagate(bool inference)
                                  "unknown operation type.");
     }
 
-    Cell_Frame<Float_T>::propagate(inference);
-    mDiffInputs.clearValid();
+    if (mInPlaceInput >= 0) {
+        if (mActivation)
+            mActivation->propagate(outputs, inference);
+    }
+    else
+        Cell_Frame<Float_T>::propagate(inference);
+
+    getDiffInputs().clearValid();
 }
 
 void N2D2::ElemWiseCell_Frame::backPropagate()
@@ -157,7 +201,15 @@ void N2D2::ElemWiseCell_Frame::backPropagate()
     const unsigned int nbInputs = mInputs.size();
     const unsigned int nbElems = mInputs[0].size();
 
-    Cell_Frame<Float_T>::backPropagate();
+    Tensor<Float_T>& diffInputs
+        = dynamic_cast<Tensor<Float_T>&>(getDiffInputs());
+
+    if (mInPlaceInput >= 0) {
+        if (mActivation)
+            mActivation->backPropagate(getOutputs(), diffInputs);
+    }
+    else
+        Cell_Frame<Float_T>::backPropagate();
 
     std::vector<Tensor<Float_T> > inputs;
 
@@ -166,6 +218,12 @@ void N2D2::ElemWiseCell_Frame::backPropagate()
 
     #pragma omp parallel for
     for (int k = 0; k < (int)nbInputs; ++k) {
+        if (mSharedDiffInputs && k == mInPlaceInput) {
+            // Already computed in place by the childs of this cell
+            mDiffOutputs[k].setValid();
+            continue;
+        }
+
         const float beta = (mDiffOutputs[k].isValid()) ? 1.0f : 0.0f;
 
         Tensor<Float_T> diffOutput = (mDiffOutputs[k].isValid())
@@ -174,14 +232,14 @@ void N2D2::ElemWiseCell_Frame::backPropagate()
 
         if (mOperation == Sum) {
             for (unsigned int n = 0; n < nbElems; ++n) {
-                diffOutput(n) = mWeights[k] * mDiffInputs(n)
+                diffOutput(n) = mWeights[k] * diffInputs(n)
                                     + beta * diffOutput(n);
             }
         }
         else if (mOperation == AbsSum) {
             for (unsigned int n = 0; n < nbElems; ++n) {
                 const Float_T sign = (inputs[k](n) >= 0.0) ? 1.0 : -1.0;
-                diffOutput(n) = mWeights[k] * sign * mDiffInputs(n)
+                diffOutput(n) = mWeights[k] * sign * diffInputs(n)
                                     + beta * diffOutput(n);
             }
         }
@@ -190,7 +248,7 @@ void N2D2::ElemWiseCell_Frame::backPropagate()
                 diffOutput(n) = (mInterTerm(n) != 0.0)
                     ? (mWeights[k] * mWeights[k])
                         * (inputs[k](n) / mInterTerm(n))
-                        * mDiffInputs(n) + beta * diffOutput(n)
+                        * diffInputs(n) + beta * diffOutput(n)
                     : beta * diffOutput(n);
             }
         }
@@ -203,14 +261,14 @@ void N2D2::ElemWiseCell_Frame::backPropagate()
                         prodTerm *= inputs[i](n);
                 }
 
-                diffOutput(n) = prodTerm * mDiffInputs(n)
+                diffOutput(n) = prodTerm * diffInputs(n)
                                     + beta * diffOutput(n);
             }
         }
         else if (mOperation == Max) {
             for (unsigned int n = 0; n < nbElems; ++n) {
                 diffOutput(n) = (mArgMax(n) == (unsigned int)k)
-                    ? (mDiffInputs(n) + beta * diffOutput(n))
+                    ? (diffInputs(n) + beta * diffOutput(n))
                     : beta * diffOutput(n);
             }
         }
@@ -24,6 +24,8 @@
 #include "Filler/NormalFiller.hpp"
 #include "Solver/SGDSolver_Frame.hpp"
 #include "third_party/half.hpp"
+#include "utils/Gemm.hpp"
+#include "utils/Sparse.hpp"
 
 template <>
 N2D2::Registrar<N2D2::FcCell>
@@ -54,6 +56,8 @@ N2D2::FcCell_Frame<T>::FcCell_Frame(const DeepNet& deepNet, const std::string& n
       // IMPORTANT: Do not change the value of the parameters here! Use
       // setParameter() or loadParameters().,
       mDropConnect(this, "DropConnect", 1.0),
+      mSparsityThreshold(this, "SparsityThreshold", 0.7),
+      mQuantizedInference(this, "QuantizedInference", false),
       mLockRandom(false)
 {
     // ctor
@@ -90,6 +94,11 @@ void N2D2::FcCell_Frame<T>::initialize()
             {1, 1, mInputs[k].size() / mInputs.dimB(), mOutputs.dimZ()}, true));
         mWeightsFiller->apply(mSynapses.back());
     }
+
+    mSparseSynapses.resize(mSynapses.size());
+    mSparseSynapsesValid.assign(mSynapses.size(), false);
+    mInt8Synapses.resize(mSynapses.size());
+    mInt8SynapsesValid.assign(mSynapses.size(), false);
 }
 
 template <class T>
@@ -131,7 +140,7 @@ void N2D2::FcCell_Frame<T>::propagate(bool inference)
 
     const unsigned int outputSize = mOutputs.dimX() * mOutputs.dimY()
                                     * mOutputs.dimZ();
-    const unsigned int count = mInputs.dimB() * outputSize;
+    const unsigned int batchSize = mInputs.dimB();
 
     T beta(0.0);
 
@@ -147,43 +156,53 @@ void N2D2::FcCell_Frame<T>::propagate(bool inference)
                     = Random::randBernoulli(mDropConnect);
         }
 
-        const Tensor<T>& synapses = mSynapses[k];
         const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
-        const unsigned int inputSize = input.dimX() * input.dimY()
-                                        * input.dimZ();
+        const unsigned int inputSize = input.size() / batchSize;
+        const std::vector<std::int8_t>* int8Synapses
+            = (mQuantizedInference && inference) ? getInt8Synapses(k) : NULL;
+
+        if (int8Synapses != NULL
+            && (propagateInt8<std::uint8_t>(input, *int8Synapses, beta,
+                                            mOutputs)
+                || propagateInt8<std::int8_t>(input, *int8Synapses, beta,
+                                              mOutputs)))
+        {
+            continue;
+        }
+
+        const Sparse::CsrMatrix<T>* sparseSynapses
+            = (mDropConnect < 1.0 && !inference) ? NULL
+                                                 : getSparseSynapses(k);
+
+        if (sparseSynapses != NULL) {
+            Sparse::denseSparseTrans(*sparseSynapses, batchSize, T(1.0),
+                                     &input(0), inputSize, beta,
+                                     &mOutputs(0), outputSize);
+            continue;
+        }
+
+        const Tensor<T>& synapses = (mDropConnect < 1.0 && !inference)
+            ? getDropConnectSynapses(k)
+            : mSynapses[k];
+
+        // mOutputs[B x O] = input[B x C] * synapses^T[C x O]
+        //                      + beta * mOutputs[B x O]
+        Gemm::gemm(Gemm::NoTrans, Gemm::Trans, batchSize, outputSize,
+                   inputSize, T(1.0), &input(0), inputSize, &synapses(0),
+                   inputSize, beta, &mOutputs(0), outputSize);
+    }
+
+    if (!mNoBias) {
+        const unsigned int count = batchSize * outputSize;
 
 #if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (count > 16)
+#pragma omp parallel for collapse(2) if (count > 1024)
 #else
-#pragma omp parallel for if (mInputs.dimB() > 4 && count > 16)
+#pragma omp parallel for if (batchSize > 4 && count > 1024)
 #endif
-        for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-            for (unsigned int output = 0; output < outputSize; ++output) {
-                // Compute the weighted sum
-                T weightedSum((!mNoBias) ? mBias(output) : 0.0);
-
-                if (mDropConnect < 1.0 && !inference) {
-                    for (unsigned int channel = 0; channel < inputSize;
-                        ++channel)
-                    {
-                        if (mDropConnectMask[k](channel, output))
-                            weightedSum += input(channel, batchPos)
-                                           * synapses(channel, output);
-                    }
-                } else {
-                    // init with weightedSum and not 0.0 to match for loop
-                    // (otherwise it can lead to different result because of
-                    // limited machine precision)
-                    weightedSum = std::inner_product(
-                                    input.begin() + batchPos * inputSize,
-                                    input.begin() + (batchPos + 1) * inputSize,
-                                    synapses[output].begin(),
-                                    weightedSum);
-                }
-
-                mOutputs(output, batchPos)
-                    = weightedSum + beta * mOutputs(output, batchPos);
-            }
+        for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+            for (unsigned int output = 0; output < outputSize; ++output)
+                mOutputs(output, batchPos) += mBias(output);
         }
     }
 
@@ -198,6 +217,7 @@ void N2D2::FcCell_Frame<T>::backPropagate()
 
     const unsigned int outputSize = mOutputs.dimX() * mOutputs.dimY()
                                     * mOutputs.dimZ();
+    const unsigned int batchSize = mInputs.dimB();
 
     for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
         const Tensor<T>& input = tensor_cast_nocopy<T>(mInputs[k]);
@@ -210,40 +230,25 @@ void N2D2::FcCell_Frame<T>::backPropagate()
                 ? tensor_cast<T>(mDiffOutputs[k])
                 : tensor_cast_nocopy<T>(mDiffOutputs[k]);
 
-            const Tensor<T>& synapses = mSynapses[k];
-            const unsigned int count = mInputs.dimB() * nbChannels;
+            const Sparse::CsrMatrix<T>* sparseSynapses = (mDropConnect < 1.0)
+                ? NULL : getSparseSynapses(k);
 
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (count > 16)
-#else
-#pragma omp parallel for if (mInputs.dimB() > 4 && count > 16)
-#endif
-            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                for (unsigned int channel = 0; channel < nbChannels; ++channel)
-                {
-                    T gradient(0.0);
-
-                    if (mDropConnect < 1.0) {
-                        for (unsigned int output = 0; output < outputSize;
-                             ++output)
-                        {
-                            if (mDropConnectMask[k](channel, output))
-                                gradient += synapses(channel, output)
-                                            * mDiffInputs(output, batchPos);
-                        }
-                    }
-                    else {
-                        for (unsigned int output = 0; output < outputSize;
-                             ++output)
-                        {
-                            gradient += synapses(channel, output)
-                                        * mDiffInputs(output, batchPos);
-                        }
-                    }
-
-                    diffOutput(channel, batchPos) = gradient
-                        + beta * diffOutput(channel, batchPos);
-                }
+            if (sparseSynapses != NULL) {
+                Sparse::denseSparse(*sparseSynapses, batchSize, T(1.0),
+                                    &mDiffInputs(0), outputSize, beta,
+                                    &diffOutput(0), nbChannels);
+            }
+            else {
+                const Tensor<T>& synapses = (mDropConnect < 1.0)
+                    ? getDropConnectSynapses(k)
+                    : mSynapses[k];
+
+                // diffOutput[B x C] = mDiffInputs[B x O] * synapses[O x C]
+                //                        + beta * diffOutput[B x C]
+                Gemm::gemm(Gemm::NoTrans, Gemm::NoTrans, batchSize,
+                           nbChannels, outputSize, T(1.0), &mDiffInputs(0),
+                           outputSize, &synapses(0), nbChannels, beta,
+                           &diffOutput(0), nbChannels);
             }
 
             mDiffOutputs[k] = diffOutput;
@@ -251,35 +256,35 @@ void N2D2::FcCell_Frame<T>::backPropagate()
         }
 
         Tensor<T>& diffSynapses = mDiffSynapses[k];
-        const unsigned int count2 = nbChannels * getNbOutputs();
+        const T beta((mWeightsSolvers[k]->isNewIteration()) ? 0.0 : 1.0);
 
-        const float beta = (mWeightsSolvers[k]->isNewIteration()) ? 0.0f : 1.0f;
+        if (mDropConnect < 1.0) {
+            // The gradient of the dropped synapses is zero
+            mDropConnectGradient.resize(diffSynapses.dims());
 
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (count2 > 16)
-#else
-#pragma omp parallel for if (getNbOutputs() > 4 && count2 > 16)
-#endif
-        for (int output = 0; output < (int)getNbOutputs(); ++output) {
-            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
-                if (!(mDropConnect < 1.0)
-                    || mDropConnectMask[k](channel, output)) {
-                    T sum(0.0);
-
-                    for (unsigned int batchPos = 0; batchPos < input.dimB();
-                         ++batchPos)
-                        sum += input(channel, batchPos)
-                               * mDiffInputs(output, batchPos);
-
-                    diffSynapses(channel, output) = sum
-                        + beta * diffSynapses(channel, output);
-                }
-                else {
-                    diffSynapses(channel, output) = beta
-                        * diffSynapses(channel, output);
-                }
+            Gemm::gemm(Gemm::Trans, Gemm::NoTrans, outputSize, nbChannels,
+                       batchSize, T(1.0), &mDiffInputs(0), outputSize,
+                       &input(0), nbChannels, T(0.0),
+                       &mDropConnectGradient(0), nbChannels);
+
+            const Tensor<bool>& mask = mDropConnectMask[k];
+
+#pragma omp parallel for if (diffSynapses.size() > 1024)
+            for (int index = 0; index < (int)diffSynapses.size(); ++index) {
+                diffSynapses(index) = ((mask(index))
+                                        ? mDropConnectGradient(index)
+                                        : T(0.0))
+                                      + beta * diffSynapses(index);
             }
         }
+        else {
+            // diffSynapses[O x C] = mDiffInputs^T[O x B] * input[B x C]
+            //                          + beta * diffSynapses[O x C]
+            Gemm::gemm(Gemm::Trans, Gemm::NoTrans, outputSize, nbChannels,
+                       batchSize, T(1.0), &mDiffInputs(0), outputSize,
+                       &input(0), nbChannels, beta, &diffSynapses(0),
+                       nbChannels);
+        }
     }
 
     if (!mNoBias) {
@@ -303,10 +308,22 @@ void N2D2::FcCell_Frame<T>::backPropagate()
 template <class T>
 void N2D2::FcCell_Frame<T>::update()
 {
-    for (unsigned int k = 0, size = mSynapses.size(); k < size; ++k)
+    for (unsigned int k = 0, size = mSynapses.size(); k < size; ++k) {
         mWeightsSolvers[k]
             ->update(mSynapses[k], mDiffSynapses[k], mInputs.dimB());
 
+        if (mSparseSynapsesValid[k] && !mSparseSynapses[k].empty()) {
+            // Keep the sparsity pattern: the pruned synapses stay at 0
+            Tensor<T>& synapses = mSynapses[k];
+            const unsigned int nbChannels = synapses.size() / synapses.dimB();
+
+            Sparse::applyPattern(mSparseSynapses[k], &synapses(0), nbChannels);
+            Sparse::gather(&synapses(0), nbChannels, mSparseSynapses[k]);
+        }
+    }
+
+    mInt8SynapsesValid.assign(mInt8SynapsesValid.size(), false);
+
     if (!mNoBias)
         mBiasSolver->update(mBias, mDiffBias, mInputs.dimB());
 }
@@ -315,11 +332,22 @@ template <class T>
 void N2D2::FcCell_Frame<T>::checkGradient(double epsilon, double maxError)
 {
     GradientCheck<T> gc(epsilon, maxError);
+    // The weights are modified in place by the gradient check
     gc.initialize(mInputs,
                   mOutputs,
                   mDiffInputs,
-                  std::bind(&FcCell_Frame<T>::propagate, this, false),
-                  std::bind(&FcCell_Frame<T>::backPropagate, this));
+                  [this](bool /*inference*/) {
+                      mSparseSynapsesValid.assign(mSparseSynapses.size(),
+                                                  false);
+                      mInt8SynapsesValid.assign(mInt8Synapses.size(), false);
+                      propagate(false);
+                  },
+                  [this]() {
+                      mSparseSynapsesValid.assign(mSparseSynapses.size(),
+                                                  false);
+                      mInt8SynapsesValid.assign(mInt8Synapses.size(), false);
+                      backPropagate();
+                  });
 
     mLockRandom = true;
 
@@ -388,6 +416,9 @@ void N2D2::FcCell_Frame<T>::loadFreeParameters(const std::string& fileName,
     for (unsigned int k = 0; k < mSynapses.size(); ++k)
         mSynapses[k].load(syn);
 
+    mSparseSynapsesValid.assign(mSparseSynapsesValid.size(), false);
+    mInt8SynapsesValid.assign(mInt8SynapsesValid.size(), false);
+
     if (!mNoBias)
         mBias.load(syn);
 
@@ -403,6 +434,99 @@ void N2D2::FcCell_Frame<T>::loadFreeParameters(const std::string& fileName,
             "Synaptic file (.SYN) size larger than expected: " + fileName);
 }
 
+template <class T>
+const N2D2::Tensor<T>&
+N2D2::FcCell_Frame<T>::getDropConnectSynapses(unsigned int k)
+{
+    const Tensor<T>& synapses = mSynapses[k];
+    const Tensor<bool>& mask = mDropConnectMask[k];
+
+    mDropConnectSynapses.resize(synapses.dims());
+
+#pragma omp parallel for if (synapses.size() > 1024)
+    for (int index = 0; index < (int)synapses.size(); ++index) {
+        mDropConnectSynapses(index) = (mask(index)) ? synapses(index)
+                                                    : T(0.0);
+    }
+
+    return mDropConnectSynapses;
+}
+
+template <class T>
+const N2D2::Sparse::CsrMatrix<T>*
+N2D2::FcCell_Frame<T>::getSparseSynapses(unsigned int k)
+{
+    if (!mSparseSynapsesValid[k]) {
+        // The sparsity pattern is detected once, when the weights are set
+        const Tensor<T>& synapses = mSynapses[k];
+        const unsigned int nbChannels = synapses.size() / synapses.dimB();
+
+        Sparse::compress(synapses.dimB(), nbChannels, &synapses(0),
+                         nbChannels, mSparseSynapses[k]);
+
+        if (mSparseSynapses[k].sparsity() < mSparsityThreshold)
+            mSparseSynapses[k].clear();
+
+        mSparseSynapsesValid[k] = true;
+    }
+
+    return (!mSparseSynapses[k].empty()) ? &mSparseSynapses[k] : NULL;
+}
+
+template <class T>
+const std::vector<std::int8_t>*
+N2D2::FcCell_Frame<T>::getInt8Synapses(unsigned int k)
+{
+    if (!mInt8SynapsesValid[k]) {
+        const Tensor<T>& synapses = mSynapses[k];
+
+        mInt8Synapses[k].resize(synapses.size());
+
+        if (!Gemm::toInteger(synapses.size(), &synapses(0),
+                             &mInt8Synapses[k][0]))
+        {
+            mInt8Synapses[k].clear();
+        }
+
+        mInt8SynapsesValid[k] = true;
+    }
+
+    return (!mInt8Synapses[k].empty()) ? &mInt8Synapses[k] : NULL;
+}
+
+template <class T>
+template <class TI>
+bool N2D2::FcCell_Frame<T>::propagateInt8(const Tensor<T>& input,
+                                          const std::vector<std::int8_t>&
+                                            synapses,
+                                          T beta,
+                                          Tensor<T>& outputs)
+{
+    std::vector<TI> intInput(input.size());
+
+    if (!Gemm::toInteger(input.size(), &input(0), &intInput[0]))
+        return false;
+
+    const unsigned int batchSize = input.dimB();
+    const unsigned int inputSize = input.size() / batchSize;
+    const unsigned int outputSize = outputs.size() / batchSize;
+
+    // weightedSums[B x O] = input[B x C] * synapses^T[C x O]
+    std::vector<std::int32_t> weightedSums(batchSize * outputSize);
+    Gemm::gemmInt8(Gemm::NoTrans, Gemm::Trans, batchSize, outputSize,
+                   inputSize, &intInput[0], inputSize, &synapses[0],
+                   inputSize, false, &weightedSums[0], outputSize);
+
+#pragma omp parallel for if (weightedSums.size() > 1024)
+    for (int index = 0; index < (int)weightedSums.size(); ++index) {
+        outputs(index) = (beta != T(0.0))
+            ? beta * outputs(index) + T(weightedSums[index])
+            : T(weightedSums[index]);
+    }
+
+    return true;
+}
+
 template <class T>
 N2D2::FcCell_Frame<T>::~FcCell_Frame()
 {
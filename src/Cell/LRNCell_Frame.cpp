@@ -19,6 +19,7 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include "GradientCheck.hpp"
 #include "Cell/LRNCell_Frame.hpp"
 #include "DeepNet.hpp"
 #include "third_party/half.hpp"
@@ -41,6 +42,9 @@ N2D2::LRNCell_Frame<double>::mRegistrar("Frame",
     N2D2::LRNCell_Frame<double>::create,
     N2D2::Registrar<N2D2::LRNCell>::Type<double>());
 
+template <class T>
+const unsigned int N2D2::LRNCell_Frame<T>::BlockSize;
+
 template <class T>
 N2D2::LRNCell_Frame<T>::LRNCell_Frame(const DeepNet& deepNet, const std::string& name,
                                    unsigned int nbOutputs)
@@ -64,6 +68,8 @@ void N2D2::LRNCell_Frame<T>::initialize()
         if (mInputs[k].size() == 0)
             throw std::runtime_error("Zero-sized input for LRNCell " + mName);
     }
+
+    mScale.resize(mOutputs.dims());
 }
 
 template <class T>
@@ -76,56 +82,74 @@ void N2D2::LRNCell_Frame<T>::propagate(bool /*inference*/)
 
     mInputs.synchronizeDBasedToH();
 
-    T beta(0.0f);
+    typedef typename Utils::scaling_type<T>::type Float_T;
+
+    const Float_T alpha(mAlpha);
+    const Float_T beta(mBeta);
+    const Float_T k(mK);
+    const unsigned int halfN = mN / 2;
+    const unsigned int channelStride = mOutputs.dimX() * mOutputs.dimY();
+    const unsigned int nbBlocks = (channelStride + BlockSize - 1) / BlockSize;
+    const int size = mOutputs.dimB() * nbBlocks;
 
     unsigned int offset = 0;
 
-    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
-        if (k > 0)
-            beta = 1.0;
-
-        const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
-
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (getNbOutputs() > 16)
-#else
-#pragma omp parallel for if (mInputs.dimB() > 4 && getNbOutputs() > 16)
-#endif
-        for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-            for (unsigned int channel = 0; channel < input.dimZ(); ++channel) {
-                const unsigned int output = channel + offset;
-
-                const unsigned int channelMin
-                    = std::max<int>(0, channel - mN / 2);
-                const unsigned int channelMax
-                    = std::min<size_t>(input.dimZ() - 1, channel + mN / 2);
-
-                for (unsigned int oy = 0; oy < input.dimY(); ++oy) {
-                    for (unsigned int ox = 0; ox < input.dimX(); ++ox) {
-                        // For each input channel, accumulate the value
-                        T accAccrossChannels(0.0);
-
-                        for (unsigned int accChannel = channelMin;
-                            accChannel < channelMax; ++accChannel)
-                        {
-                            accAccrossChannels
-                                += input(ox, oy, accChannel, batchPos);
-                        }
-
-                        // Compute the output signal
-                        mOutputs(ox, oy, output, batchPos)
-                            = normAccrossChannel(input(ox, oy, channel, batchPos),
-                                                 accAccrossChannels,
-                                                 T(mAlpha),
-                                                 T(mBeta),
-                                                 T(mK))
-                            + beta * mOutputs(ox, oy, output, batchPos);
-                    }
+    for (unsigned int in = 0, nbInputs = mInputs.size(); in < nbInputs; ++in) {
+        const Tensor<T>& input = tensor_cast<T>(mInputs[in]);
+        const unsigned int nbChannels = input.dimZ();
+
+        // Running sum of squares over the channels window, vectorized over
+        // a block of spatial positions: O(1) per element, whatever mN
+#pragma omp parallel for if (size > 1 && input.size() > 1024)
+        for (int index = 0; index < size; ++index) {
+            const unsigned int batchPos = index / nbBlocks;
+            const unsigned int pos = (index % nbBlocks) * BlockSize;
+            const unsigned int blockSize
+                = std::min(BlockSize, channelStride - pos);
+            const T* x = &input(0, 0, 0, batchPos) + pos;
+            T* y = &mOutputs(0, 0, offset, batchPos) + pos;
+            T* scale = &mScale(0, 0, offset, batchPos) + pos;
+
+            std::vector<Float_T> acc(blockSize, Float_T(0.0));
+
+            for (unsigned int channel = 0;
+                channel <= std::min(halfN, nbChannels - 1); ++channel)
+            {
+                const T* xc = x + channel * channelStride;
+
+                for (unsigned int i = 0; i < blockSize; ++i)
+                    acc[i] += (Float_T)xc[i] * (Float_T)xc[i];
+            }
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                const unsigned int c = channel * channelStride;
+
+                for (unsigned int i = 0; i < blockSize; ++i) {
+                    const Float_T s = k + alpha * std::max(acc[i],
+                                                           Float_T(0.0));
+
+                    scale[c + i] = (T)s;
+                    y[c + i] = (T)((Float_T)x[c + i] * std::pow(s, -beta));
+                }
+
+                // Slide the window to the next channel
+                if (channel + halfN + 1 < nbChannels) {
+                    const T* xc = x + (channel + halfN + 1) * channelStride;
+
+                    for (unsigned int i = 0; i < blockSize; ++i)
+                        acc[i] += (Float_T)xc[i] * (Float_T)xc[i];
+                }
+
+                if (channel >= halfN) {
+                    const T* xc = x + (channel - halfN) * channelStride;
+
+                    for (unsigned int i = 0; i < blockSize; ++i)
+                        acc[i] -= (Float_T)xc[i] * (Float_T)xc[i];
                 }
             }
         }
 
-        offset += input.dimZ();
+        offset += nbChannels;
     }
 
     mDiffInputs.clearValid();
@@ -134,29 +158,130 @@ void N2D2::LRNCell_Frame<T>::propagate(bool /*inference*/)
 template <class T>
 void N2D2::LRNCell_Frame<T>::backPropagate()
 {
-    throw std::runtime_error(
-        "LRNCell_Frame<T>::backPropagate(): not implemented.");
+    if (mDiffOutputs.empty())
+        return;
+
+    typedef typename Utils::scaling_type<T>::type Float_T;
+
+    const Float_T alpha(mAlpha);
+    const Float_T beta(mBeta);
+    const unsigned int halfN = mN / 2;
+    const unsigned int channelStride = mOutputs.dimX() * mOutputs.dimY();
+    const unsigned int nbBlocks = (channelStride + BlockSize - 1) / BlockSize;
+    const int size = mOutputs.dimB() * nbBlocks;
+
+    unsigned int offset = 0;
+
+    for (unsigned int in = 0, nbInputs = mInputs.size(); in < nbInputs; ++in) {
+        const unsigned int nbChannels = mInputs[in].dimZ();
+
+        if (mDiffOutputs[in].empty()) {
+            offset += nbChannels;
+            continue;
+        }
+
+        const Float_T betaDiff((mDiffOutputs[in].isValid()) ? 1.0 : 0.0);
+
+        const Tensor<T>& input = tensor_cast_nocopy<T>(mInputs[in]);
+        Tensor<T> diffOutput = (mDiffOutputs[in].isValid())
+            ? tensor_cast<T>(mDiffOutputs[in])
+            : tensor_cast_nocopy<T>(mDiffOutputs[in]);
+
+        // dx_j = dy_j * s_j^-beta
+        //        - 2 * alpha * beta * x_j * sum_{c in W(j)}(dy_c * y_c / s_c)
+        // with the same sliding window as in propagate(), W being symmetric
+#pragma omp parallel for if (size > 1 && input.size() > 1024)
+        for (int index = 0; index < size; ++index) {
+            const unsigned int batchPos = index / nbBlocks;
+            const unsigned int pos = (index % nbBlocks) * BlockSize;
+            const unsigned int blockSize
+                = std::min(BlockSize, channelStride - pos);
+            const T* x = &input(0, 0, 0, batchPos) + pos;
+            const T* y = &mOutputs(0, 0, offset, batchPos) + pos;
+            const T* scale = &mScale(0, 0, offset, batchPos) + pos;
+            const T* dy = &mDiffInputs(0, 0, offset, batchPos) + pos;
+            T* dx = &diffOutput(0, 0, 0, batchPos) + pos;
+
+            std::vector<Float_T> acc(blockSize, Float_T(0.0));
+
+            for (unsigned int channel = 0;
+                channel <= std::min(halfN, nbChannels - 1); ++channel)
+            {
+                const unsigned int c = channel * channelStride;
+
+                for (unsigned int i = 0; i < blockSize; ++i) {
+                    acc[i] += (Float_T)dy[c + i] * (Float_T)y[c + i]
+                        / (Float_T)scale[c + i];
+                }
+            }
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                const unsigned int c = channel * channelStride;
+
+                for (unsigned int i = 0; i < blockSize; ++i) {
+                    dx[c + i] = (T)((Float_T)dy[c + i]
+                            * std::pow((Float_T)scale[c + i], -beta)
+                        - 2 * alpha * beta * (Float_T)x[c + i] * acc[i]
+                        + betaDiff * (Float_T)dx[c + i]);
+                }
+
+                if (channel + halfN + 1 < nbChannels) {
+                    const unsigned int cNext
+                        = (channel + halfN + 1) * channelStride;
+
+                    for (unsigned int i = 0; i < blockSize; ++i) {
+                        acc[i] += (Float_T)dy[cNext + i] * (Float_T)y[cNext + i]
+                            / (Float_T)scale[cNext + i];
+                    }
+                }
+
+                if (channel >= halfN) {
+                    const unsigned int cPrev = (channel - halfN) * channelStride;
+
+                    for (unsigned int i = 0; i < blockSize; ++i) {
+                        acc[i] -= (Float_T)dy[cPrev + i] * (Float_T)y[cPrev + i]
+                            / (Float_T)scale[cPrev + i];
+                    }
+                }
+            }
+        }
+
+        mDiffOutputs[in] = diffOutput;
+        offset += nbChannels;
+    }
+
+    mDiffOutputs.setValid();
+    mDiffOutputs.synchronizeHToD();
 }
 
 template <class T>
 void N2D2::LRNCell_Frame<T>::update()
 {
-    for (unsigned int k = 0, size = mDiffOutputs.size(); k < size; ++k) {
-        Tensor<T> diffOutput
-            = tensor_cast_nocopy<T>(mDiffOutputs[k]);
-
-        diffOutput.fill(T(0.0));
-
-        mDiffOutputs[k] = diffOutput;
-    }
+    // Nothing to update
 }
 
 template <class T>
-T N2D2::LRNCell_Frame<T>::normAccrossChannel(
-    T input, T xAcc, T alpha, T beta, T k)
+void N2D2::LRNCell_Frame<T>::checkGradient(double epsilon, double maxError)
 {
-    const T norm(std::pow((k + (xAcc * xAcc) * alpha), beta));
-    return (input / norm);
+    GradientCheck<T> gc(epsilon, maxError);
+    gc.initialize(mInputs,
+                  mOutputs,
+                  mDiffInputs,
+                  std::bind(&LRNCell_Frame<T>::propagate, this, false),
+                  std::bind(&LRNCell_Frame<T>::backPropagate, this));
+
+    if (!mDiffOutputs.empty()) {
+        for (unsigned int in = 0; in < mInputs.size(); ++in) {
+            std::stringstream name;
+            name << mName + "_mDiffOutputs[" << in << "]";
+
+            gc.check(name.str(), mInputs[in], mDiffOutputs[in]);
+        }
+    } else {
+        std::cout << Utils::cwarning << "Empty diff. outputs for cell " << mName
+                  << ", could not check the gradient!" << Utils::cdef
+                  << std::endl;
+    }
 }
 
 namespace N2D2 {
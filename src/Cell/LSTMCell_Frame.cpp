@@ -0,0 +1,763 @@
+/*
+    (C) Copyright 2018 CEA LIST. All Rights Reserved.
+    Contributor(s): Thibault ALLENET (thibault.allenet@cea.fr)
+                    Olivier BICHLER (olivier.bichler@cea.fr)
+                    David BRIAND (david.briand@cea.fr)
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "GradientCheck.hpp"
+#include "Cell/LSTMCell_Frame.hpp"
+#include "DeepNet.hpp"
+#include "Filler/Filler.hpp"
+#include "StimuliProvider.hpp"
+#include "third_party/half.hpp"
+#include "utils/Gemm.hpp"
+
+template <>
+N2D2::Registrar<N2D2::LSTMCell>
+N2D2::LSTMCell_Frame<half_float::half>::mRegistrar("Frame",
+    N2D2::LSTMCell_Frame<half_float::half>::create,
+    N2D2::Registrar<N2D2::LSTMCell>::Type<half_float::half>());
+
+template <>
+N2D2::Registrar<N2D2::LSTMCell>
+N2D2::LSTMCell_Frame<float>::mRegistrar("Frame",
+    N2D2::LSTMCell_Frame<float>::create,
+    N2D2::Registrar<N2D2::LSTMCell>::Type<float>());
+
+template <>
+N2D2::Registrar<N2D2::LSTMCell>
+N2D2::LSTMCell_Frame<double>::mRegistrar("Frame",
+    N2D2::LSTMCell_Frame<double>::create,
+    N2D2::Registrar<N2D2::LSTMCell>::Type<double>());
+
+template <class T>
+N2D2::LSTMCell_Frame<T>::LSTMCell_Frame(const DeepNet& deepNet,
+    const std::string& name,
+    unsigned int seqLength,
+    unsigned int batchSize,
+    unsigned int inputDim,
+    unsigned int numberLayers,
+    unsigned int hiddenSize,
+    unsigned int algo,
+    unsigned int nbOutputs,
+    unsigned int bidirectional,
+    unsigned int inputMode,
+    float dropout,
+    bool singleBackpropFeeding)
+    : Cell(deepNet, name, nbOutputs),
+      LSTMCell(deepNet, name,
+               seqLength,
+               batchSize,
+               inputDim,
+               numberLayers,
+               hiddenSize,
+               algo,
+               nbOutputs,
+               bidirectional,
+               inputMode,
+               dropout,
+               singleBackpropFeeding),
+      Cell_Frame<T>(deepNet, name, nbOutputs),
+      mWeights(std::make_shared<Tensor<T> >()),
+      mhx(std::make_shared<Tensor<T> >()),
+      mDiffhy(std::make_shared<Tensor<T> >()),
+      mcx(std::make_shared<Tensor<T> >()),
+      mDiffcy(std::make_shared<Tensor<T> >()),
+      mContinousBatch(false)
+{
+    // ctor
+    mWeightsSolver = std::make_shared<SGDSolver_Frame<T> >();
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::initialize()
+{
+    if (mInputMode != 1) {
+        throw std::domain_error("LSTMCell_Frame: only the linear input mode"
+                                " (InputMode = 1) is supported, LSTM name : "
+                                + mName);
+    }
+
+    if (!mInputs.empty()
+        && mInputs[0].size() != mSeqLength * mBatchSize * mInputDim)
+    {
+        throw std::runtime_error("Cell " + mName + ", input size must be"
+                                 " SeqLength x BatchSize x InputDim");
+    }
+
+    const std::vector<size_t> statesDims
+        = {1, mHiddenSize, mBatchSize, mNumberLayers * biDirScale};
+
+    mhy.resize(statesDims, T(0.0));
+    mcy.resize(statesDims, T(0.0));
+    mDiffhx.resize(statesDims, T(0.0));
+    mDiffcx.resize(statesDims, T(0.0));
+
+    if (mhx->empty()) {
+        mhx->resize(statesDims, T(0.0));
+
+        if (mhxFiller)
+            mhxFiller->apply((*mhx));
+    }
+    else if (mhx->dims() != statesDims)
+        throw std::runtime_error("Cell " + mName + ", wrong size for hx");
+
+    if (mcx->empty()) {
+        mcx->resize(statesDims, T(0.0));
+
+        if (mcxFiller)
+            mcxFiller->apply((*mcx));
+    }
+    else if (mcx->dims() != statesDims)
+        throw std::runtime_error("Cell " + mName + ", wrong size for cx");
+
+    if (mDiffhy->empty())
+        mDiffhy->resize(statesDims, T(0.0));
+    else if (mDiffhy->dims() != statesDims)
+        throw std::runtime_error("Cell " + mName + ", wrong size for dhy");
+
+    if (mDiffcy->empty())
+        mDiffcy->resize(statesDims, T(0.0));
+    else if (mDiffcy->dims() != statesDims)
+        throw std::runtime_error("Cell " + mName + ", wrong size for dcy");
+
+    if (mDiffOutputs.empty()) {
+        mDiffOutputs.push_back(new Tensor<T>({1, mInputDim, mBatchSize,
+                                              mSeqLength}));
+    }
+
+    // Per layer and per pseudo-layer buffers (Tensor copies share their
+    // data, each buffer must be constructed separately)
+    mLayerOutputs.clear();
+    mGates.clear();
+    mCells.clear();
+
+    for (unsigned int layer = 0; layer < mNumberLayers; ++layer) {
+        mLayerOutputs.push_back(Tensor<T>({1, mHiddenSize * biDirScale,
+                                           mBatchSize, mSeqLength}));
+
+        for (unsigned int dir = 0; dir < biDirScale; ++dir) {
+            mGates.push_back(Tensor<T>({4 * mHiddenSize, mBatchSize,
+                                        mSeqLength}));
+            mCells.push_back(Tensor<T>({mHiddenSize, mBatchSize,
+                                        mSeqLength}));
+        }
+    }
+
+    mLayerInputs.clear();
+    mDropoutMasks.clear();
+
+    if (mDropout > 0.0) {
+        for (unsigned int layer = 0; layer + 1 < mNumberLayers; ++layer) {
+            mLayerInputs.push_back(Tensor<T>(mLayerOutputs[layer].dims()));
+            mDropoutMasks.push_back(
+                Tensor<bool>(mLayerOutputs[layer].dims()));
+        }
+    }
+
+    // Weights and bias of all the pseudo-layers, followed by all the bias
+    const unsigned int weightsSize = getStartPosition(0, 0, false)
+        + mNumberLayers * biDirScale * 8 * mHiddenSize;
+
+    if (mWeights->empty()) {
+        mWeights->resize({1, 1, 1, weightsSize}, T(0.0));
+
+        const std::shared_ptr<Filler> weightsFillers[8]
+            = {mWeightsPreviousLayerInputGateFiller,
+               mWeightsPreviousLayerForgetGateFiller,
+               mWeightsPreviousLayerCellGateFiller,
+               mWeightsPreviousLayerOutputGateFiller,
+               mWeightsRecurrentInputGateFiller,
+               mWeightsRecurrentForgetGateFiller,
+               mWeightsRecurrentCellGateFiller,
+               mWeightsRecurrentOutputGateFiller};
+        const std::shared_ptr<Filler> weightsFillers1stLayer[4]
+            = {mWeightsPreviousLayerInputGateFiller_1stLayer,
+               mWeightsPreviousLayerForgetGateFiller_1stLayer,
+               mWeightsPreviousLayerCellGateFiller_1stLayer,
+               mWeightsPreviousLayerOutputGateFiller_1stLayer};
+        const std::shared_ptr<Filler> biasFillers[8]
+            = {mBiasPreviousLayerInputGateFiller,
+               mBiasPreviousLayerForgetGateFiller,
+               mBiasPreviousLayerCellGateFiller,
+               mBiasPreviousLayerOutputGateFiller,
+               mBiasRecurrentInputGateFiller,
+               mBiasRecurrentForgetGateFiller,
+               mBiasRecurrentCellGateFiller,
+               mBiasRecurrentOutputGateFiller};
+
+        // Same filling order and seeds as LSTMCell_Frame_CUDA
+        for (unsigned int layer = 0; layer < mNumberLayers * biDirScale;
+            ++layer)
+        {
+            const bool firstLayer = (layer < biDirScale);
+            const unsigned int inputDim = (firstLayer)
+                ? mInputDim : mHiddenSize * biDirScale;
+
+            for (unsigned int gate = 0; gate < 8; ++gate) {
+                const std::shared_ptr<Filler>& weightsFiller
+                    = (gate < 4 && firstLayer) ? weightsFillers1stLayer[gate]
+                                               : weightsFillers[gate];
+
+                Random::mtSeed(4 + gate);
+
+                if (weightsFiller) {
+                    Tensor<T> weights({1, 1, mHiddenSize
+                        * ((gate < 4) ? inputDim : mHiddenSize), 1});
+                    weightsFiller->apply(weights);
+
+                    std::copy(weights.begin(), weights.end(),
+                              mWeights->begin()
+                                + getStartPosition(layer, gate, true));
+                }
+
+                if (biasFillers[gate]) {
+                    Tensor<T> bias({1, 1, mHiddenSize, 1});
+                    biasFillers[gate]->apply(bias);
+
+                    std::copy(bias.begin(), bias.end(),
+                              mWeights->begin()
+                                + getStartPosition(layer, gate, false));
+                }
+            }
+        }
+    }
+    else if (mWeights->size() != weightsSize)
+        throw std::runtime_error("Cell " + mName + ", wrong size for Weights");
+
+    mDiffWeights.resize(mWeights->dims(), T(0.0));
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::propagate(bool inference)
+{
+    mInputs.synchronizeDBasedToH();
+
+    const Tensor<T>& input = tensor_cast<T>(mInputs[0]);
+
+    for (unsigned int layer = 0; layer < mNumberLayers; ++layer) {
+        const T* layerInput = &input(0);
+        unsigned int inputDim = mInputDim;
+
+        if (layer > 0) {
+            const Tensor<T>& prevOutput = mLayerOutputs[layer - 1];
+            layerInput = &prevOutput(0);
+            inputDim = mHiddenSize * biDirScale;
+
+            // Dropout between the layers, as cuDNN
+            if (!inference && mDropout > 0.0) {
+                Tensor<T>& dropInput = mLayerInputs[layer - 1];
+                Tensor<bool>& mask = mDropoutMasks[layer - 1];
+                const T scale(1.0 / (1.0 - mDropout));
+
+                for (unsigned int index = 0; index < prevOutput.size();
+                    ++index)
+                {
+                    mask(index) = (Random::randUniform() >= mDropout);
+                    dropInput(index) = (mask(index))
+                        ? T(prevOutput(index) * scale) : T(0.0);
+                }
+
+                layerInput = &dropInput(0);
+            }
+        }
+
+        propagateLayer(layer, layerInput, inputDim,
+                       &mLayerOutputs[layer](0));
+    }
+
+    const Tensor<T>& outputsLocal = mLayerOutputs.back();
+
+    if (mSingleBackpropFeeding) {
+        for (unsigned int z = 0; z < mBatchSize; ++z) {
+            for (unsigned int y = 0; y < mHiddenSize * biDirScale; ++y)
+                mOutputs(0, 0, y, z) = outputsLocal(0, y, z, mSeqLength - 1);
+        }
+    }
+    else {
+        for (unsigned int s = 0; s < mSeqLength; ++s) {
+            for (unsigned int z = 0; z < mBatchSize; ++z) {
+                for (unsigned int y = 0; y < mHiddenSize * biDirScale; ++y)
+                    mOutputs(0, y, z, s) = outputsLocal(0, y, z, s);
+            }
+        }
+    }
+
+    mDiffInputs.clearValid();
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::propagateLayer(unsigned int layer,
+                                             const T* input,
+                                             unsigned int inputDim,
+                                             T* output)
+{
+    typedef typename Utils::scaling_type<T>::type Acc_T;
+
+    const unsigned int H = mHiddenSize;
+    const unsigned int outputStride = H * biDirScale;
+    const unsigned int nbSteps = mSeqLength;
+    const int batchSize = mBatchSize;
+    const T* weights = &(*mWeights)(0);
+
+    for (unsigned int dir = 0; dir < biDirScale; ++dir) {
+        const unsigned int pseudoLayer = layer * biDirScale + dir;
+        const T* W = weights + getStartPosition(pseudoLayer, 0, true);
+        const T* R = weights + getStartPosition(pseudoLayer, 4, true);
+        const T* biasW = weights + getStartPosition(pseudoLayer, 0, false);
+        const T* biasR = biasW + 4 * H;
+        T* gates = &mGates[pseudoLayer](0);
+        T* cells = &mCells[pseudoLayer](0);
+
+        // Input projection of all the time steps at once, the four gates
+        // being fused in a single (4 x H) x inputDim matrix:
+        // gates[t][b] = W.x[t][b]
+        Gemm::gemm<T>(Gemm::NoTrans, Gemm::Trans,
+                      nbSteps * mBatchSize, 4 * H, inputDim,
+                      T(1.0), input, inputDim, W, inputDim,
+                      T(0.0), gates, 4 * H);
+
+        const T* hPrev = &(*mhx)(0) + pseudoLayer * mBatchSize * H;
+        const T* cPrev = &(*mcx)(0) + pseudoLayer * mBatchSize * H;
+        unsigned int hPrevStride = H;
+
+        for (unsigned int step = 0; step < nbSteps; ++step) {
+            const unsigned int t = (dir == 0) ? step : nbSteps - 1 - step;
+            T* gatesT = gates + t * mBatchSize * 4 * H;
+            T* cellsT = cells + t * mBatchSize * H;
+            T* outputT = output + t * mBatchSize * outputStride + dir * H;
+
+            // Recurrent projection, one GEMM for the four gates:
+            // gates[t] += R.h[t-1]
+            Gemm::gemm<T>(Gemm::NoTrans, Gemm::Trans,
+                          mBatchSize, 4 * H, H,
+                          T(1.0), hPrev, hPrevStride, R, H,
+                          T(1.0), gatesT, 4 * H);
+
+#pragma omp parallel for if (batchSize > 1 && batchSize * H > 256)
+            for (int batchPos = 0; batchPos < batchSize; ++batchPos) {
+                T* g = gatesT + batchPos * 4 * H;
+                T* c = cellsT + batchPos * H;
+                T* h = outputT + batchPos * outputStride;
+                const T* cp = cPrev + batchPos * H;
+
+                for (unsigned int j = 0; j < H; ++j) {
+                    const Acc_T inputGate = 1.0 / (1.0 + std::exp(
+                        -((Acc_T)g[j] + biasW[j] + biasR[j])));
+                    const Acc_T forgetGate = 1.0 / (1.0 + std::exp(
+                        -((Acc_T)g[H + j] + biasW[H + j] + biasR[H + j])));
+                    const Acc_T cellGate = std::tanh((Acc_T)g[2 * H + j]
+                        + biasW[2 * H + j] + biasR[2 * H + j]);
+                    const Acc_T outputGate = 1.0 / (1.0 + std::exp(
+                        -((Acc_T)g[3 * H + j] + biasW[3 * H + j]
+                          + biasR[3 * H + j])));
+                    const Acc_T cell = forgetGate * (Acc_T)cp[j]
+                        + inputGate * cellGate;
+
+                    g[j] = (T)inputGate;
+                    g[H + j] = (T)forgetGate;
+                    g[2 * H + j] = (T)cellGate;
+                    g[3 * H + j] = (T)outputGate;
+                    c[j] = (T)cell;
+                    h[j] = (T)(outputGate * std::tanh(cell));
+                }
+            }
+
+            hPrev = outputT;
+            hPrevStride = outputStride;
+            cPrev = cellsT;
+        }
+
+        // Final hidden and cell states
+        T* hy = &mhy(0) + pseudoLayer * mBatchSize * H;
+        T* cy = &mcy(0) + pseudoLayer * mBatchSize * H;
+
+        for (unsigned int batchPos = 0; batchPos < mBatchSize; ++batchPos) {
+            std::copy(hPrev + batchPos * hPrevStride,
+                      hPrev + batchPos * hPrevStride + H,
+                      hy + batchPos * H);
+            std::copy(cPrev + batchPos * H, cPrev + (batchPos + 1) * H,
+                      cy + batchPos * H);
+        }
+    }
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::backPropagate()
+{
+    const unsigned int outputStride = mHiddenSize * biDirScale;
+
+    // Gradient of the last layer outputs, for all the time steps
+    Tensor<T> diffLayerOutput({1, outputStride, mBatchSize, mSeqLength},
+                              T(0.0));
+
+    if (mSingleBackpropFeeding) {
+        for (unsigned int z = 0; z < mBatchSize; ++z) {
+            for (unsigned int y = 0; y < outputStride; ++y) {
+                diffLayerOutput(0, y, z, mSeqLength - 1)
+                    = mDiffInputs(0, 0, y, z);
+            }
+        }
+    }
+    else {
+        for (unsigned int s = 0; s < mSeqLength; ++s) {
+            for (unsigned int z = 0; z < mBatchSize; ++z) {
+                for (unsigned int y = 0; y < outputStride; ++y)
+                    diffLayerOutput(0, y, z, s) = mDiffInputs(0, y, z, s);
+            }
+        }
+    }
+
+    mDiffWeights.fill(T(0.0));
+
+    const Tensor<T>& input = tensor_cast_nocopy<T>(mInputs[0]);
+    Tensor<T> diffOutput = (mDiffOutputs[0].isValid())
+        ? tensor_cast<T>(mDiffOutputs[0])
+        : tensor_cast_nocopy<T>(mDiffOutputs[0]);
+
+    for (int layer = mNumberLayers - 1; layer >= 0; --layer) {
+        if (layer == 0) {
+            backPropagateLayer(0, &input(0), mInputDim, &diffLayerOutput(0),
+                               &diffOutput(0), mDiffOutputs[0].isValid());
+        }
+        else {
+            const bool dropout = (mDropout > 0.0);
+            const Tensor<T>& layerInput = (dropout)
+                ? mLayerInputs[layer - 1] : mLayerOutputs[layer - 1];
+            Tensor<T> diffLayerInput(layerInput.dims());
+
+            backPropagateLayer(layer, &layerInput(0), outputStride,
+                               &diffLayerOutput(0), &diffLayerInput(0),
+                               false);
+
+            if (dropout) {
+                const Tensor<bool>& mask = mDropoutMasks[layer - 1];
+                const T scale(1.0 / (1.0 - mDropout));
+
+                for (unsigned int index = 0; index < diffLayerInput.size();
+                    ++index)
+                {
+                    diffLayerInput(index) = (mask(index))
+                        ? T(diffLayerInput(index) * scale) : T(0.0);
+                }
+            }
+
+            diffLayerOutput = diffLayerInput;
+        }
+    }
+
+    mDiffOutputs[0] = diffOutput;
+    mDiffOutputs.setValid();
+    mDiffOutputs.synchronizeHToD();
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::backPropagateLayer(unsigned int layer,
+                                                 const T* input,
+                                                 unsigned int inputDim,
+                                                 const T* diffOutput,
+                                                 T* diffInput,
+                                                 bool accumulate)
+{
+    typedef typename Utils::scaling_type<T>::type Acc_T;
+
+    const unsigned int H = mHiddenSize;
+    const unsigned int outputStride = H * biDirScale;
+    const unsigned int nbSteps = mSeqLength;
+    const int batchSize = mBatchSize;
+    const T* weights = &(*mWeights)(0);
+    T* diffWeights = &mDiffWeights(0);
+    const T* output = &mLayerOutputs[layer](0);
+
+    // Gradient of the gates pre-activation, for all the time steps
+    Tensor<T> diffGates({4 * H, mBatchSize, nbSteps});
+    // Hidden state entering each time step
+    Tensor<T> hPrevs({H, mBatchSize, nbSteps});
+
+    for (unsigned int dir = 0; dir < biDirScale; ++dir) {
+        const unsigned int pseudoLayer = layer * biDirScale + dir;
+        const unsigned int statesOffset = pseudoLayer * mBatchSize * H;
+        const T* W = weights + getStartPosition(pseudoLayer, 0, true);
+        const T* R = weights + getStartPosition(pseudoLayer, 4, true);
+        T* diffW = diffWeights + getStartPosition(pseudoLayer, 0, true);
+        T* diffR = diffWeights + getStartPosition(pseudoLayer, 4, true);
+        T* diffBiasW = diffWeights + getStartPosition(pseudoLayer, 0, false);
+        T* diffBiasR = diffBiasW + 4 * H;
+        const T* gates = &mGates[pseudoLayer](0);
+        const T* cells = &mCells[pseudoLayer](0);
+
+        std::vector<T> diffH(&(*mDiffhy)(0) + statesOffset,
+                             &(*mDiffhy)(0) + statesOffset + mBatchSize * H);
+        std::vector<T> diffC(&(*mDiffcy)(0) + statesOffset,
+                             &(*mDiffcy)(0) + statesOffset + mBatchSize * H);
+
+        for (int step = nbSteps - 1; step >= 0; --step) {
+            const unsigned int t = (dir == 0) ? step : nbSteps - 1 - step;
+            const unsigned int tPrev = (dir == 0) ? t - 1 : t + 1;
+            const T* gatesT = gates + t * mBatchSize * 4 * H;
+            const T* cellsT = cells + t * mBatchSize * H;
+            const T* cPrev = (step > 0)
+                ? cells + tPrev * mBatchSize * H
+                : &(*mcx)(0) + statesOffset;
+            const T* diffOutputT = diffOutput + t * mBatchSize * outputStride
+                + dir * H;
+            T* diffGatesT = &diffGates(0) + t * mBatchSize * 4 * H;
+            T* hPrevT = &hPrevs(0) + t * mBatchSize * H;
+
+#pragma omp parallel for if (batchSize > 1 && batchSize * H > 256)
+            for (int batchPos = 0; batchPos < batchSize; ++batchPos) {
+                const T* g = gatesT + batchPos * 4 * H;
+                const T* c = cellsT + batchPos * H;
+                const T* cp = cPrev + batchPos * H;
+                const T* dy = diffOutputT + batchPos * outputStride;
+                T* dg = diffGatesT + batchPos * 4 * H;
+                T* dh = &diffH[batchPos * H];
+                T* dc = &diffC[batchPos * H];
+
+                for (unsigned int j = 0; j < H; ++j) {
+                    const Acc_T inputGate = g[j];
+                    const Acc_T forgetGate = g[H + j];
+                    const Acc_T cellGate = g[2 * H + j];
+                    const Acc_T outputGate = g[3 * H + j];
+                    const Acc_T tanhCell = std::tanh((Acc_T)c[j]);
+                    const Acc_T diffHidden = (Acc_T)dy[j] + (Acc_T)dh[j];
+                    const Acc_T diffCell = (Acc_T)dc[j] + diffHidden
+                        * outputGate * (1.0 - tanhCell * tanhCell);
+
+                    dg[j] = (T)(diffCell * cellGate
+                                * inputGate * (1.0 - inputGate));
+                    dg[H + j] = (T)(diffCell * (Acc_T)cp[j]
+                                    * forgetGate * (1.0 - forgetGate));
+                    dg[2 * H + j] = (T)(diffCell * inputGate
+                                        * (1.0 - cellGate * cellGate));
+                    dg[3 * H + j] = (T)(diffHidden * tanhCell
+                                        * outputGate * (1.0 - outputGate));
+                    dc[j] = (T)(diffCell * forgetGate);
+                }
+
+                const T* hp = (step > 0)
+                    ? output + tPrev * mBatchSize * outputStride + dir * H
+                        + batchPos * outputStride
+                    : &(*mhx)(0) + statesOffset + batchPos * H;
+                std::copy(hp, hp + H, hPrevT + batchPos * H);
+            }
+
+            // dh[t-1] = R^T.dgates[t], one GEMM for the four gates
+            Gemm::gemm<T>(Gemm::NoTrans, Gemm::NoTrans,
+                          mBatchSize, H, 4 * H,
+                          T(1.0), diffGatesT, 4 * H, R, H,
+                          T(0.0), &diffH[0], H);
+        }
+
+        std::copy(diffH.begin(), diffH.end(), &mDiffhx(0) + statesOffset);
+        std::copy(diffC.begin(), diffC.end(), &mDiffcx(0) + statesOffset);
+
+        // Weights gradients, for all the time steps at once
+        Gemm::gemm<T>(Gemm::Trans, Gemm::NoTrans,
+                      4 * H, inputDim, nbSteps * mBatchSize,
+                      T(1.0), &diffGates(0), 4 * H, input, inputDim,
+                      T(1.0), diffW, inputDim);
+        Gemm::gemm<T>(Gemm::Trans, Gemm::NoTrans,
+                      4 * H, H, nbSteps * mBatchSize,
+                      T(1.0), &diffGates(0), 4 * H, &hPrevs(0), H,
+                      T(1.0), diffR, H);
+
+        for (unsigned int index = 0; index < nbSteps * mBatchSize; ++index) {
+            const T* dg = &diffGates(0) + index * 4 * H;
+
+            for (unsigned int j = 0; j < 4 * H; ++j)
+                diffBiasW[j] += dg[j];
+        }
+
+        std::copy(diffBiasW, diffBiasW + 4 * H, diffBiasR);
+
+        // Inputs gradient, the directions are accumulated
+        Gemm::gemm<T>(Gemm::NoTrans, Gemm::NoTrans,
+                      nbSteps * mBatchSize, inputDim, 4 * H,
+                      T(1.0), &diffGates(0), 4 * H, W, inputDim,
+                      T((accumulate || dir > 0) ? 1.0 : 0.0),
+                      diffInput, inputDim);
+    }
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::update()
+{
+    mWeightsSolver->update(*mWeights, mDiffWeights, mBatchSize);
+
+    if (mContinousBatch) {
+        std::copy(mhy.begin(), mhy.end(), mhx->begin());
+        std::copy(mcy.begin(), mcy.end(), mcx->begin());
+    }
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::checkGradient(double epsilon, double maxError)
+{
+    GradientCheck<T> gc(epsilon, maxError);
+    Random::mtSeed(21);
+
+    for (unsigned int index = 0; index < mhx->size(); ++index)
+        (*mhx)(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < mcx->size(); ++index)
+        (*mcx)(index) = Random::randUniform(-1.0, 1.0);
+
+    gc.initialize(mInputs,
+                  mOutputs,
+                  mDiffInputs,
+                  std::bind(&LSTMCell_Frame<T>::propagate, this, false),
+                  std::bind(&LSTMCell_Frame<T>::backPropagate, this));
+
+    if (!mDiffOutputs.empty()) {
+        for (unsigned int k = 0; k < mInputs.size(); ++k) {
+            std::stringstream name;
+            name << mName + "_mDiffOutputs[" << k << "]";
+
+            gc.check(name.str(), mInputs[k], mDiffOutputs[k]);
+        }
+    } else {
+        std::cout << Utils::cwarning << "Empty diff. outputs for cell " << mName
+                  << ", could not check the gradient!" << Utils::cdef
+                  << std::endl;
+    }
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::addInput(Cell* cell, const Tensor<bool>& mapping)
+{
+    Cell_Frame<T>::addInput(cell, mapping);
+
+    // Share the initial states with a parent LSTM of the same geometry
+    LSTMCell_Frame<T>* cellLSTM = dynamic_cast<LSTMCell_Frame<T>*>(cell);
+
+    if (cellLSTM != NULL
+        && cellLSTM->getHiddenSize() == mHiddenSize
+        && cellLSTM->getBatchSize() == mBatchSize
+        && cellLSTM->getNumberLayers() == mNumberLayers
+        && cellLSTM->getBidirectional() == mBidirectional)
+    {
+        mhx = cellLSTM->getmhx();
+        mDiffhy = cellLSTM->getmDiffhy();
+        mcx = cellLSTM->getmcx();
+        mDiffcy = cellLSTM->getmDiffcy();
+    }
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::addInput(StimuliProvider& sp,
+                                       unsigned int x0,
+                                       unsigned int y0,
+                                       unsigned int width,
+                                       unsigned int height,
+                                       const Tensor<bool>& mapping)
+{
+    Cell_Frame<T>::addInput(sp, x0, y0, width, height, mapping);
+
+    if (mSingleBackpropFeeding) {
+        mOutputs.resize({1, 1, mHiddenSize * biDirScale, mBatchSize});
+        mDiffInputs.resize({1, 1, mHiddenSize * biDirScale, mBatchSize});
+    }
+}
+
+template <class T>
+unsigned int N2D2::LSTMCell_Frame<T>::getStartPosition(unsigned int layer,
+                                                       unsigned int gate,
+                                                       bool weight) const
+{
+    if (gate >= 8) {
+        throw std::runtime_error("LSTMCell_Frame::getStartPosition(): gate"
+                                 " invalid");
+    }
+
+    const unsigned int layer0PLSize = 4 * mInputDim * mHiddenSize;
+    const unsigned int layer0RSize = 4 * mHiddenSize * mHiddenSize;
+    const unsigned int layer0Size = layer0PLSize + layer0RSize;
+    const unsigned int layerxPLSize = 4 * mHiddenSize * biDirScale
+                                        * mHiddenSize;
+    const unsigned int layerxRSize = 4 * mHiddenSize * mHiddenSize;
+    const unsigned int layerxSize = layerxPLSize + layerxRSize;
+    const unsigned int allLayerSize = layer0Size
+                                        + (mNumberLayers - 1) * layerxSize;
+
+    if (!weight)
+        return (biDirScale * allLayerSize + layer * 8 * mHiddenSize
+                + gate * mHiddenSize);
+
+    if (layer < biDirScale) {
+        return (layer * layer0Size + ((gate < 4)
+            ? gate * mInputDim * mHiddenSize
+            : layer0PLSize + (gate - 4) * mHiddenSize * mHiddenSize));
+    }
+
+    return (biDirScale * layer0Size + (layer - biDirScale) * layerxSize
+        + ((gate < 4)
+            ? gate * mHiddenSize * biDirScale * mHiddenSize
+            : layerxPLSize + (gate - 4) * mHiddenSize * mHiddenSize));
+}
+
+template <class T>
+unsigned int N2D2::LSTMCell_Frame<T>::getWeightPosition(unsigned int layer,
+                                                        unsigned int gate,
+                                                        unsigned int channel,
+                                                        unsigned int output,
+                                                        unsigned int nbChannels)
+    const
+{
+    if (channel >= nbChannels || output >= mHiddenSize) {
+        throw std::runtime_error("LSTMCell_Frame::getWeightPosition(): index"
+                                 " invalid");
+    }
+
+    return getStartPosition(layer, gate, true) + channel * mHiddenSize
+        + output;
+}
+
+template <class T>
+unsigned int N2D2::LSTMCell_Frame<T>::getBiasPosition(unsigned int layer,
+                                                      unsigned int gate,
+                                                      unsigned int output)
+    const
+{
+    if (output >= mHiddenSize) {
+        throw std::runtime_error("LSTMCell_Frame::getBiasPosition(): hiddenidx"
+                                 " invalid");
+    }
+
+    return getStartPosition(layer, gate, false) + output;
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::getWeight(unsigned int pos,
+                                        BaseTensor& value) const
+{
+    value.resize({1});
+    value = Tensor<T>({1}, (*mWeights)(pos));
+}
+
+template <class T>
+void N2D2::LSTMCell_Frame<T>::setWeight(unsigned int pos, BaseTensor& value)
+{
+    (*mWeights)(pos) = tensor_cast<T>(value)(0);
+}
+
+namespace N2D2 {
+    template class LSTMCell_Frame<half_float::half>;
+    template class LSTMCell_Frame<float>;
+    template class LSTMCell_Frame<double>;
+}
@@ -21,6 +21,7 @@
 #include "Cell/ObjectDetCell_Frame.hpp"
 #include "DeepNet.hpp"
 #include "StimuliProvider.hpp"
+#include "utils/Nms.hpp"
 
 N2D2::Registrar<N2D2::ObjectDetCell>
 N2D2::ObjectDetCell_Frame::mRegistrar("Frame", N2D2::ObjectDetCell_Frame::create);
@@ -103,7 +104,10 @@ void N2D2::ObjectDetCell_Frame::propagate(bool inference)
 
         ROIs.resize(mNbClass);
         ROIsPredicted.resize(mNbClass);
-        for(unsigned int cls = 0; cls < mNbClass; ++ cls)
+
+        // The classes are processed independently
+#pragma omp parallel for if (mNbClass > 1)
+        for(int cls = 0; cls < (int)mNbClass; ++ cls)
         {
             //Keep ROIs with scores superior to the class threshold
             for (unsigned int anchor = 0; anchor < mNbAnchors; ++anchor)
@@ -137,89 +141,43 @@ void N2D2::ObjectDetCell_Frame::propagate(bool inference)
 
             if(inference)
             {
-                std::vector<BBox_T> final_rois;
-                BBox_T next_candidate;
-                //Apply efficient Non Maximal Suppression
-                std::reverse(ROIs[cls].begin(),ROIs[cls].end());
-                while (final_rois.size() < mNbProposals && !ROIs[cls].empty()) {
-                    next_candidate.x = ROIs[cls].back().first[0];
-                    next_candidate.y = ROIs[cls].back().first[1];
-                    next_candidate.w = ROIs[cls].back().first[2];
-                    next_candidate.h = ROIs[cls].back().first[3];
-                    next_candidate.s = ROIs[cls].back().second;
-                    ROIs[cls].pop_back();
-
-                    bool should_select = true;
-                    const float x0 = input(   next_candidate.x, 
-                                            next_candidate.y, 
-                                            next_candidate.w + cls*mNbAnchors + offset, 
-                                            next_candidate.h);
-                    const float y0 = input(   next_candidate.x, 
-                                            next_candidate.y, 
-                                            next_candidate.w + cls*mNbAnchors + 2*offset, 
-                                            next_candidate.h);
-                    const float w0 = input(   next_candidate.x, 
-                                            next_candidate.y, 
-                                            next_candidate.w + cls*mNbAnchors + 3*offset, 
-                                            next_candidate.h);
-                    const float h0 = input(   next_candidate.x, 
-                                            next_candidate.y, 
-                                            next_candidate.w + cls*mNbAnchors + 4*offset, 
-                                            next_candidate.h);
-
-                    for (int j = static_cast<int>(final_rois.size()) - 1; j >= 0; --j) {
-
-                        const float x = input(final_rois[j].x, 
-                                            final_rois[j].y, 
-                                            final_rois[j].w + cls*mNbAnchors + offset, 
-                                            final_rois[j].h);
-
-                        const float y = input(final_rois[j].x, 
-                                            final_rois[j].y, 
-                                            final_rois[j].w + cls*mNbAnchors + 2*offset, 
-                                            final_rois[j].h);
-                        const float w = input(final_rois[j].x, 
-                                            final_rois[j].y, 
-                                            final_rois[j].w + cls*mNbAnchors + 3*offset, 
-                                            final_rois[j].h);
-                        const float h = input(final_rois[j].x, 
-                                            final_rois[j].y, 
-                                            final_rois[j].w + cls*mNbAnchors + 4*offset, 
-                                            final_rois[j].h);
-
-                        const float interLeft = std::max(x0, x);
-                        const float interRight = std::min(x0 + w0, x + w);
-                        const float interTop = std::max(y0, y);
-                        const float interBottom = std::min(y0 + h0, y + h);
-
-                        if (interLeft < interRight && interTop < interBottom) {
-                            const float interArea = (interRight - interLeft)
-                                                        * (interBottom - interTop);
-                            const float unionArea = w0 * h0 + w * h - interArea;
-                            const float IoU = interArea / unionArea;
-
-                            if (IoU > mNMS_IoU_Threshold) {
-                                should_select = false;
-                                break;
-
-                            }
-                        }
-
-                    }
-                    if (should_select) 
-                        final_rois.push_back(next_candidate);
+                // Non-Maximum Suppression (NMS)
+                Nms::Boxes boxes;
+                boxes.reserve(ROIs[cls].size());
+
+                for (unsigned int i = 0; i < ROIs[cls].size(); ++i) {
+                    const Tensor<int>::Index& ROI = ROIs[cls][i].first;
+
+                    boxes.push_back(input(ROI[0], ROI[1],
+                                        ROI[2] + cls*mNbAnchors + offset,
+                                        ROI[3]),
+                                    input(ROI[0], ROI[1],
+                                        ROI[2] + cls*mNbAnchors + 2*offset,
+                                        ROI[3]),
+                                    input(ROI[0], ROI[1],
+                                        ROI[2] + cls*mNbAnchors + 3*offset,
+                                        ROI[3]),
+                                    input(ROI[0], ROI[1],
+                                        ROI[2] + cls*mNbAnchors + 4*offset,
+                                        ROI[3]));
                 }
 
+                const std::vector<unsigned int> kept
+                    = Nms::nms(boxes, mNMS_IoU_Threshold, mNbProposals);
 
-                ROIsPredicted[cls].resize(final_rois.size());
+                ROIsPredicted[cls].resize(kept.size());
 
-                for(unsigned int proposal = 0; proposal < final_rois.size(); ++ proposal )
+                for(unsigned int proposal = 0; proposal < kept.size(); ++ proposal )
                 {
-                    ROIsPredicted[cls][proposal].x = final_rois[proposal].x;
-                    ROIsPredicted[cls][proposal].y = final_rois[proposal].y;
-                    ROIsPredicted[cls][proposal].w = final_rois[proposal].w;
-                    ROIsPredicted[cls][proposal].h = final_rois[proposal].h;
-                    ROIsPredicted[cls][proposal].s = final_rois[proposal].s;
+                    const Tensor<int>::Index& ROI
+                        = ROIs[cls][kept[proposal]].first;
+
+                    ROIsPredicted[cls][proposal].x = ROI[0];
+                    ROIsPredicted[cls][proposal].y = ROI[1];
+                    ROIsPredicted[cls][proposal].w = ROI[2];
+                    ROIsPredicted[cls][proposal].h = ROI[3];
+                    ROIsPredicted[cls][proposal].s
+                        = ROIs[cls][kept[proposal]].second;
                 }
             }
             else
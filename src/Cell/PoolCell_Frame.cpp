@@ -62,7 +62,9 @@ N2D2::PoolCell_Frame<T>::PoolCell_Frame(const DeepNet& deepNet,
       mPoolDesc(poolDims.size(),
                 &poolDims[0],
                 &strideDims[0],
-                &paddingDims[0])
+                &paddingDims[0]),
+      mArgMaxShared(false),
+      mSpecialization(PoolCell_Frame_Kernels::Generic)
 {
     // ctor
     assert(poolDims.size() <= POOL_KERNEL_MAX_DIMS);
@@ -97,6 +99,13 @@ void N2D2::PoolCell_Frame<T>::initialize()
                               (mOutputs.dims()));
         }
     }
+
+    // The specialized kernels require a one-to-one mapping
+    mSpecialization = (mInputs.size() == 1 && isUnitMap())
+        ? PoolCell_Frame_Kernels::getSpecialization(mPoolDesc,
+                                                    mInputs[0].dims(),
+                                                    mOutputs.dims())
+        : PoolCell_Frame_Kernels::Generic;
 }
 
 template <class T>
@@ -107,6 +116,9 @@ void N2D2::PoolCell_Frame<T>::propagate(bool inference)
     const T alpha = T(1.0);
     T beta = T(0.0);
 
+    Tensor<PoolCell_Frame_Kernels::ArgMax> noArgMax;
+    const bool recordArgMax = (!inference || mArgMaxShared);
+
     unsigned int offset = 0;
 
     for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
@@ -121,10 +133,13 @@ void N2D2::PoolCell_Frame<T>::propagate(bool inference)
                                                     mPoolDesc,
                                                     &beta,
                                                     mOutputs,
-                                                    mArgMax[k],
+                                                    (recordArgMax)
+                                                        ? mArgMax[k]
+                                                        : noArgMax,
                                                     false,
                                                     mMapping.rows(offset,
-                                                                mInputs[k].dimZ()));
+                                                                mInputs[k].dimZ()),
+                                                    mSpecialization);
         }
         else {
             PoolCell_Frame_Kernels::forwardAverage<T>(&alpha,
@@ -134,7 +149,8 @@ void N2D2::PoolCell_Frame<T>::propagate(bool inference)
                                                    mOutputs,
                                                    true,
                                                    mMapping.rows(offset,
-                                                        mInputs[k].dimZ()));
+                                                        mInputs[k].dimZ()),
+                                                   mSpecialization);
         }
 
         offset += mInputs[k].dimZ();
@@ -197,6 +213,31 @@ void N2D2::PoolCell_Frame<T>::update()
 {
 }
 
+template <class T>
+bool N2D2::PoolCell_Frame<T>::fusePadding(int paddingX, int paddingY)
+{
+    // The max. pooling ignores the padding, which is not equivalent to a
+    // zero padding
+    if (mPooling != Average || paddingX < 0 || paddingY < 0
+        || mInputsDims.size() < 2)
+        return false;
+
+    mPaddingDims[0] += paddingX;
+    mPaddingDims[1] += paddingY;
+    mPoolDesc.padding[0] += paddingX;
+    mPoolDesc.padding[1] += paddingY;
+    mInputsDims[0] -= 2 * paddingX;
+    mInputsDims[1] -= 2 * paddingY;
+
+    if (mSpecialization != PoolCell_Frame_Kernels::Generic) {
+        mSpecialization = PoolCell_Frame_Kernels::getSpecialization(mPoolDesc,
+                                                                mInputsDims,
+                                                                mOutputs.dims());
+    }
+
+    return true;
+}
+
 template <class T>
 void N2D2::PoolCell_Frame<T>::checkGradient(double epsilon, double maxError)
 {
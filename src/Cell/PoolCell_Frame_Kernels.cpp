@@ -22,6 +22,436 @@
 #include "Cell/PoolCell_Frame_Kernels.hpp"
 #include "Cell/PoolCell_Frame_Kernels_struct.hpp"
 #include "third_party/half.hpp"
+#include "utils/HalfConversion.hpp"
+
+namespace {
+    using N2D2::PoolCell_Frame_Kernels::ArgMax;
+    using N2D2::PoolCell_Frame_Kernels::Descriptor;
+
+    /// Range [begin, end[ of the outputs along one dimension whose window of
+    /// size P (with a stride S) is entirely inside the input
+    template <unsigned int P, unsigned int S>
+    void interiorRange(unsigned int inputSize,
+                       int padding,
+                       unsigned int outputSize,
+                       unsigned int& begin,
+                       unsigned int& end)
+    {
+        end = ((int)inputSize + padding >= (int)P)
+            ? std::min(outputSize,
+                       (unsigned int)(((int)inputSize + padding - (int)P)
+                                      / (int)S + 1))
+            : 0U;
+        begin = std::min((unsigned int)((padding + (int)S - 1) / (int)S), end);
+    }
+
+    /// Average of the P x P window at (@p ix, @p iy), clipped to the input
+    template <class T, unsigned int P>
+    T averageWindow(const T* input,
+                    unsigned int width,
+                    unsigned int height,
+                    int ix,
+                    int iy,
+                    bool countIncludePadding)
+    {
+        const unsigned int sxMin = (unsigned int)std::max(-ix, 0);
+        const unsigned int syMin = (unsigned int)std::max(-iy, 0);
+        const unsigned int sxMax = N2D2::Utils::clamp<int>(width - ix, 0, P);
+        const unsigned int syMax = N2D2::Utils::clamp<int>(height - iy, 0, P);
+
+        T poolValue(0.0);
+
+        for (unsigned int sy = syMin; sy < syMax; ++sy) {
+            for (unsigned int sx = sxMin; sx < sxMax; ++sx)
+                poolValue += input[(iy + sy) * width + ix + sx];
+        }
+
+        const unsigned int poolCount = (countIncludePadding)
+            ? P * P
+            : (sxMax - sxMin) * (syMax - syMin);
+
+        return (poolCount > 0) ? poolValue / (T)poolCount : T(0.0);
+    }
+
+    /// Max. of the P x P window at (@p ix, @p iy), clipped to the input
+    template <class T, unsigned int P>
+    T maxWindow(const T* input,
+                unsigned int width,
+                unsigned int height,
+                int ix,
+                int iy,
+                unsigned int channel,
+                ArgMax* argMax)
+    {
+        const unsigned int sxMin = (unsigned int)std::max(-ix, 0);
+        const unsigned int syMin = (unsigned int)std::max(-iy, 0);
+        const unsigned int sxMax = N2D2::Utils::clamp<int>(width - ix, 0, P);
+        const unsigned int syMax = N2D2::Utils::clamp<int>(height - iy, 0, P);
+
+        T poolValue(0.0);
+        unsigned int ixMax = 0;
+        unsigned int iyMax = 0;
+        bool valid = false;
+
+        for (unsigned int sy = syMin; sy < syMax; ++sy) {
+            for (unsigned int sx = sxMin; sx < sxMax; ++sx) {
+                const T value = input[(iy + sy) * width + ix + sx];
+
+                if (!valid || value > poolValue) {
+                    poolValue = value;
+                    valid = true;
+
+                    ixMax = ix + sx;
+                    iyMax = iy + sy;
+                }
+            }
+        }
+
+        if (argMax != NULL)
+            (*argMax) = ArgMax(ixMax, iyMax, channel, valid);
+
+        return poolValue;
+    }
+
+    /// P x P average pooling with a stride S of an input map. The windows
+    /// entirely inside the input have a fixed size, which is unrolled and
+    /// vectorized over X.
+    template <class T, unsigned int P, unsigned int S>
+    void forwardAveragePlane(T alpha,
+                             const T* input,
+                             unsigned int width,
+                             unsigned int height,
+                             const Descriptor& desc,
+                             bool countIncludePadding,
+                             T beta,
+                             T* output,
+                             unsigned int oxSize,
+                             unsigned int oySize)
+    {
+        unsigned int oxBegin, oxEnd, oyBegin, oyEnd;
+        interiorRange<P, S>(width, desc.padding[0], oxSize, oxBegin, oxEnd);
+        interiorRange<P, S>(height, desc.padding[1], oySize, oyBegin, oyEnd);
+
+        for (unsigned int oy = 0; oy < oySize; ++oy) {
+            const int iy = (int)(oy * S) - desc.padding[1];
+            const bool interior = (oy >= oyBegin && oy < oyEnd);
+            const unsigned int fastBegin = (interior) ? oxBegin : oxSize;
+            const unsigned int fastEnd = (interior) ? oxEnd : oxSize;
+            T* outputRow = output + oy * oxSize;
+
+            for (unsigned int ox = 0; ox < fastBegin; ++ox) {
+                const int ix = (int)(ox * S) - desc.padding[0];
+
+                outputRow[ox] = alpha * averageWindow<T, P>(input, width,
+                                            height, ix, iy, countIncludePadding)
+                                + beta * outputRow[ox];
+            }
+
+            for (unsigned int ox = fastBegin; ox < fastEnd; ++ox) {
+                const T* window = input + iy * width
+                                  + (ox * S - desc.padding[0]);
+                T poolValue(0.0);
+
+                for (unsigned int sy = 0; sy < P; ++sy) {
+                    for (unsigned int sx = 0; sx < P; ++sx)
+                        poolValue += window[sy * width + sx];
+                }
+
+                outputRow[ox] = alpha * (poolValue / (T)(P * P))
+                                + beta * outputRow[ox];
+            }
+
+            for (unsigned int ox = fastEnd; ox < oxSize; ++ox) {
+                const int ix = (int)(ox * S) - desc.padding[0];
+
+                outputRow[ox] = alpha * averageWindow<T, P>(input, width,
+                                            height, ix, iy, countIncludePadding)
+                                + beta * outputRow[ox];
+            }
+        }
+    }
+
+    /// P x P max pooling with a stride S of an input map, see
+    /// forwardAveragePlane(). The max. inputs are recorded in @p argMax if it
+    /// is not NULL.
+    template <class T, unsigned int P, unsigned int S>
+    void forwardMaxPlane(T alpha,
+                         const T* input,
+                         unsigned int width,
+                         unsigned int height,
+                         const Descriptor& desc,
+                         unsigned int channel,
+                         T beta,
+                         T* output,
+                         ArgMax* argMax,
+                         unsigned int oxSize,
+                         unsigned int oySize)
+    {
+        unsigned int oxBegin, oxEnd, oyBegin, oyEnd;
+        interiorRange<P, S>(width, desc.padding[0], oxSize, oxBegin, oxEnd);
+        interiorRange<P, S>(height, desc.padding[1], oySize, oyBegin, oyEnd);
+
+        for (unsigned int oy = 0; oy < oySize; ++oy) {
+            const int iy = (int)(oy * S) - desc.padding[1];
+            const bool interior = (oy >= oyBegin && oy < oyEnd);
+            const unsigned int fastBegin = (interior) ? oxBegin : oxSize;
+            const unsigned int fastEnd = (interior) ? oxEnd : oxSize;
+            T* outputRow = output + oy * oxSize;
+            ArgMax* argMaxRow = (argMax != NULL) ? argMax + oy * oxSize : NULL;
+
+            for (unsigned int ox = 0; ox < fastBegin; ++ox) {
+                const int ix = (int)(ox * S) - desc.padding[0];
+
+                outputRow[ox] = alpha * maxWindow<T, P>(input, width, height,
+                        ix, iy, channel, (argMaxRow) ? argMaxRow + ox : NULL)
+                                + beta * outputRow[ox];
+            }
+
+            for (unsigned int ox = fastBegin; ox < fastEnd; ++ox) {
+                const unsigned int ix = ox * S - desc.padding[0];
+                const T* window = input + iy * width + ix;
+                T poolValue = window[0];
+                unsigned int sxMax = 0;
+                unsigned int syMax = 0;
+
+                for (unsigned int sy = 0; sy < P; ++sy) {
+                    for (unsigned int sx = 0; sx < P; ++sx) {
+                        if (window[sy * width + sx] > poolValue) {
+                            poolValue = window[sy * width + sx];
+                            sxMax = sx;
+                            syMax = sy;
+                        }
+                    }
+                }
+
+                if (argMaxRow != NULL) {
+                    argMaxRow[ox]
+                        = ArgMax(ix + sxMax, iy + syMax, channel, true);
+                }
+
+                outputRow[ox] = alpha * poolValue + beta * outputRow[ox];
+            }
+
+            for (unsigned int ox = fastEnd; ox < oxSize; ++ox) {
+                const int ix = (int)(ox * S) - desc.padding[0];
+
+                outputRow[ox] = alpha * maxWindow<T, P>(input, width, height,
+                        ix, iy, channel, (argMaxRow) ? argMaxRow + ox : NULL)
+                                + beta * outputRow[ox];
+            }
+        }
+    }
+
+    // Number of independent accumulators of the global pooling
+    const std::size_t GLOBAL_LANES = 8;
+
+    /// Sum of an input map, with GLOBAL_LANES independent partial sums that
+    /// can be vectorized. The summation order only depends on the size.
+    template <class T>
+    T sumPlane(const T* input, std::size_t size)
+    {
+        T partials[GLOBAL_LANES];
+        std::fill(partials, partials + GLOBAL_LANES, T(0.0));
+
+        std::size_t i = 0;
+
+        for (; i + GLOBAL_LANES <= size; i += GLOBAL_LANES) {
+            for (std::size_t lane = 0; lane < GLOBAL_LANES; ++lane)
+                partials[lane] += input[i + lane];
+        }
+
+        for (; i < size; ++i)
+            partials[i % GLOBAL_LANES] += input[i];
+
+        for (std::size_t width = GLOBAL_LANES / 2; width > 0; width /= 2) {
+            for (std::size_t lane = 0; lane < width; ++lane)
+                partials[lane] += partials[lane + width];
+        }
+
+        return partials[0];
+    }
+
+    /// Max. of an input map and index of its first occurrence, with
+    /// GLOBAL_LANES independent partial max. (0 at index 0 for an empty map).
+    template <class T>
+    T maxPlane(const T* input, std::size_t size, std::size_t& index)
+    {
+        T partials[GLOBAL_LANES];
+        std::size_t indexes[GLOBAL_LANES];
+        std::fill(partials, partials + GLOBAL_LANES, T(0.0));
+        std::fill(indexes, indexes + GLOBAL_LANES, 0U);
+        const std::size_t nbLanes = std::min(size, GLOBAL_LANES);
+
+        for (std::size_t lane = 0; lane < nbLanes; ++lane) {
+            partials[lane] = input[lane];
+            indexes[lane] = lane;
+        }
+
+        std::size_t i = nbLanes;
+
+        for (; i + GLOBAL_LANES <= size; i += GLOBAL_LANES) {
+            for (std::size_t lane = 0; lane < GLOBAL_LANES; ++lane) {
+                if (input[i + lane] > partials[lane]) {
+                    partials[lane] = input[i + lane];
+                    indexes[lane] = i + lane;
+                }
+            }
+        }
+
+        for (; i < size; ++i) {
+            if (input[i] > partials[i % GLOBAL_LANES]) {
+                partials[i % GLOBAL_LANES] = input[i];
+                indexes[i % GLOBAL_LANES] = i;
+            }
+        }
+
+        // Ties are resolved to the first occurrence
+        std::size_t best = 0;
+
+        for (std::size_t lane = 1; lane < nbLanes; ++lane) {
+            if (partials[lane] > partials[best]
+                || (partials[lane] == partials[best]
+                    && indexes[lane] < indexes[best]))
+            {
+                best = lane;
+            }
+        }
+
+        index = indexes[best];
+        return partials[best];
+    }
+
+    template <class T>
+    void forwardAverageSpecialized(
+        T alpha,
+        const N2D2::Tensor<T>& inputs,
+        const Descriptor& desc,
+        T beta,
+        N2D2::Tensor<T>& outputs,
+        bool countIncludePadding,
+        N2D2::PoolCell_Frame_Kernels::Specialization specialization)
+    {
+        const unsigned int width = inputs.dimX();
+        const unsigned int height = inputs.dimY();
+        const unsigned int size = inputs.dimB() * inputs.dimZ();
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (inputs.dimB() > 4 && size > 16)
+#endif
+        for (int batchPos = 0; batchPos < (int)inputs.dimB(); ++batchPos) {
+            for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel)
+            {
+                const T* input = &inputs(0, 0, channel, batchPos);
+                T* output = &outputs(0, 0, channel, batchPos);
+
+                if (specialization
+                    == N2D2::PoolCell_Frame_Kernels::Pool2x2Stride2)
+                {
+                    forwardAveragePlane<T, 2, 2>(alpha, input, width, height,
+                        desc, countIncludePadding, beta, output,
+                        outputs.dimX(), outputs.dimY());
+                }
+                else if (specialization
+                         == N2D2::PoolCell_Frame_Kernels::Pool3x3Stride2)
+                {
+                    forwardAveragePlane<T, 3, 2>(alpha, input, width, height,
+                        desc, countIncludePadding, beta, output,
+                        outputs.dimX(), outputs.dimY());
+                }
+                else {
+                    output[0] = alpha * (sumPlane(input, width * height)
+                                         / (T)(width * height))
+                                + beta * output[0];
+                }
+            }
+        }
+    }
+
+    template <class T>
+    void forwardMaxSpecialized(
+        T alpha,
+        const N2D2::Tensor<T>& inputs,
+        const Descriptor& desc,
+        T beta,
+        N2D2::Tensor<T>& outputs,
+        N2D2::Tensor<ArgMax>& argMax,
+        N2D2::PoolCell_Frame_Kernels::Specialization specialization)
+    {
+        const unsigned int width = inputs.dimX();
+        const unsigned int height = inputs.dimY();
+        const unsigned int size = inputs.dimB() * inputs.dimZ();
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (inputs.dimB() > 4 && size > 16)
+#endif
+        for (int batchPos = 0; batchPos < (int)inputs.dimB(); ++batchPos) {
+            for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel)
+            {
+                const T* input = &inputs(0, 0, channel, batchPos);
+                T* output = &outputs(0, 0, channel, batchPos);
+                ArgMax* argMaxPlane = (!argMax.empty())
+                    ? &argMax(0, 0, channel, batchPos) : NULL;
+
+                if (specialization
+                    == N2D2::PoolCell_Frame_Kernels::Pool2x2Stride2)
+                {
+                    forwardMaxPlane<T, 2, 2>(alpha, input, width, height,
+                        desc, channel, beta, output, argMaxPlane,
+                        outputs.dimX(), outputs.dimY());
+                }
+                else if (specialization
+                         == N2D2::PoolCell_Frame_Kernels::Pool3x3Stride2)
+                {
+                    forwardMaxPlane<T, 3, 2>(alpha, input, width, height,
+                        desc, channel, beta, output, argMaxPlane,
+                        outputs.dimX(), outputs.dimY());
+                }
+                else {
+                    std::size_t index;
+                    const T poolValue = maxPlane(input, width * height,
+                                                 index);
+
+                    if (argMaxPlane != NULL) {
+                        argMaxPlane[0] = ArgMax(index % width, index / width,
+                                                channel, true);
+                    }
+
+                    output[0] = alpha * poolValue + beta * output[0];
+                }
+            }
+        }
+    }
+}
+
+N2D2::PoolCell_Frame_Kernels::Specialization
+N2D2::PoolCell_Frame_Kernels::getSpecialization(
+    const Descriptor& desc,
+    const std::vector<size_t>& inputsDims,
+    const std::vector<size_t>& outputsDims)
+{
+    if (desc.nbDims != 2 || inputsDims.size() < 2 || outputsDims.size() < 2)
+        return Generic;
+
+    if (desc.pool[0] == inputsDims[0] && desc.pool[1] == inputsDims[1]
+        && desc.padding[0] == 0 && desc.padding[1] == 0
+        && outputsDims[0] == 1 && outputsDims[1] == 1)
+    {
+        return Global;
+    }
+
+    if (desc.stride[0] == 2 && desc.stride[1] == 2) {
+        if (desc.pool[0] == 2 && desc.pool[1] == 2)
+            return Pool2x2Stride2;
+        else if (desc.pool[0] == 3 && desc.pool[1] == 3)
+            return Pool3x3Stride2;
+    }
+
+    return Generic;
+}
 
 template <class T>
 void N2D2::PoolCell_Frame_Kernels::forwardAverage(const T* alpha,
@@ -31,8 +461,16 @@ void N2D2::PoolCell_Frame_Kernels::forwardAverage(const T* alpha,
                                                   const T* beta,
                                                   Tensor<T>& outputs,
                                                   bool countIncludePadding,
-                                                  const Tensor<bool>& maps)
+                                                  const Tensor<bool>& maps,
+                                                  Specialization
+                                                  specialization)
 {
+    if (specialization != Generic) {
+        forwardAverageSpecialized(*alpha, inputs, desc, *beta, outputs,
+                                  countIncludePadding, specialization);
+        return;
+    }
+
     const unsigned int size = inputs.dimB() * outputs.dimZ();
 
 #if defined(_OPENMP) && _OPENMP >= 200805
@@ -103,8 +541,16 @@ void N2D2::PoolCell_Frame_Kernels::forwardMax(const T* alpha,
                                               Tensor<T>& outputs,
                                               Tensor<ArgMax>& argMax,
                                               bool useArgMax,
-                                              const Tensor<bool>& maps)
+                                              const Tensor<bool>& maps,
+                                              Specialization specialization)
 {
+    if (specialization != Generic && !useArgMax) {
+        forwardMaxSpecialized(*alpha, inputs, desc, *beta, outputs, argMax,
+                              specialization);
+        return;
+    }
+
+    const bool recordArgMax = !argMax.empty();
     const unsigned int size = inputs.dimB() * outputs.dimZ();
 
 #if defined(_OPENMP) && _OPENMP >= 200805
@@ -178,8 +624,10 @@ void N2D2::PoolCell_Frame_Kernels::forwardMax(const T* alpha,
                             }
                         }
 
-                        argMax(ox, oy, output, batchPos)
-                            = ArgMax(ixMax, iyMax, channelMax, valid);
+                        if (recordArgMax) {
+                            argMax(ox, oy, output, batchPos)
+                                = ArgMax(ixMax, iyMax, channelMax, valid);
+                        }
                     }
 
                     outputs(ox, oy, output, batchPos)
@@ -290,17 +738,18 @@ template <class T>
 void N2D2::PoolCell_Frame_Kernels::backwardMax(const T* alpha,
                                                const Tensor
                                                <T>& diffInputs,
-                                               const Descriptor& desc,
+                                               const Descriptor& /*desc*/,
                                                const T* beta,
                                                Tensor<T>&
                                                diffOutputs,
                                                const Tensor<ArgMax>& argMax,
                                                const Tensor<bool>& maps)
 {
-    const unsigned int oxStride = desc.stride[0] * diffInputs.dimX();
-    const unsigned int oyStride = desc.stride[1] * diffInputs.dimY();
     const unsigned int size = diffOutputs.dimB() * diffOutputs.dimZ();
 
+    // The gradient of each output is scattered to its max. input. Each
+    // thread processes a channel of diffOutputs, so that there is no race
+    // and the summation order is fixed.
 #if defined(_OPENMP) && _OPENMP >= 200805
 #pragma omp parallel for collapse(2) if (size > 16)
 #else
@@ -310,63 +759,39 @@ void N2D2::PoolCell_Frame_Kernels::backwardMax(const T* alpha,
         for (unsigned int channel = 0; channel < diffOutputs.dimZ();
              ++channel)
         {
-            for (unsigned int iy = 0; iy < diffOutputs.dimY(); ++iy) {
-                for (unsigned int ix = 0; ix < diffOutputs.dimX(); ++ix) {
-                    const unsigned int ixPad = ix + desc.padding[0];
-                    const unsigned int iyPad = iy + desc.padding[1];
-                    const unsigned int sxMax
-                        = std::min(desc.pool[0], ixPad + 1);
-                    const unsigned int syMax
-                        = std::min(desc.pool[1], iyPad + 1);
-
-                    T poolGradient(0.0);
-
-                    for (unsigned int sy = iyPad % desc.stride[1],
-                                      sx0 = ixPad % desc.stride[0];
-                         sy < syMax;
-                         sy += desc.stride[1])
-                    {
-                        if (iyPad >= oyStride + sy)
-                            continue;
-
-                        for (unsigned int sx = sx0; sx < sxMax;
-                             sx += desc.stride[0])
-                        {
-                            // Border conditions
-                            if (ixPad >= oxStride + sx)
-                                continue;
-
-                            // Output node coordinates
-                            const unsigned int ox = (ixPad - sx) / desc.stride[0];
-                            const unsigned int oy = (iyPad - sy) / desc.stride[1];
+            T* diffOutput = &diffOutputs(0, 0, channel, batchPos);
+            const unsigned int mapSize = diffOutputs.dimX()
+                                         * diffOutputs.dimY();
+
+            if ((*beta) == T(0.0))
+                std::fill(diffOutput, diffOutput + mapSize, T(0.0));
+            else {
+                for (unsigned int index = 0; index < mapSize; ++index)
+                    diffOutput[index] *= (*beta);
+            }
 
-                            for (unsigned int output = 0;
-                                 output < diffInputs.dimZ();
-                                 ++output)
-                            {
-                                if (!maps.empty() && !maps(output, channel))
-                                    continue;
+            for (unsigned int output = 0; output < diffInputs.dimZ();
+                 ++output)
+            {
+                if (!maps.empty() && !maps(output, channel))
+                    continue;
 
-                                const ArgMax inputMax
-                                    = argMax(ox, oy, output, batchPos);
+                for (unsigned int oy = 0; oy < diffInputs.dimY(); ++oy) {
+                    for (unsigned int ox = 0; ox < diffInputs.dimX(); ++ox) {
+                        const ArgMax& inputMax
+                            = argMax(ox, oy, output, batchPos);
 
-                                if (ix == inputMax.ix
-                                    && iy == inputMax.iy
-                                    && channel == inputMax.channel
-                                    && inputMax.valid)
-                                {
-                                    poolGradient += diffInputs(ox,
-                                                               oy,
-                                                               output,
-                                                               batchPos);
-                                }
-                            }
+                        if (inputMax.valid && inputMax.channel == channel) {
+                            diffOutputs(inputMax.ix,
+                                        inputMax.iy,
+                                        channel,
+                                        batchPos)
+                                += (*alpha) * diffInputs(ox,
+                                                         oy,
+                                                         output,
+                                                         batchPos);
                         }
                     }
-
-                    diffOutputs(ix, iy, channel, batchPos)
-                        = (*alpha) * poolGradient
-                          + (*beta) * diffOutputs(ix, iy, channel, batchPos);
                 }
             }
         }
@@ -374,14 +799,43 @@ void N2D2::PoolCell_Frame_Kernels::backwardMax(const T* alpha,
 }
 
 namespace N2D2 {
-    template void PoolCell_Frame_Kernels::forwardAverage<half_float::half>(
-        const half_float::half* alpha,
-        const Tensor<half_float::half>& inputs,
-        const Descriptor& desc,
-        const half_float::half* beta,
-        Tensor<half_float::half>& outputs,
-        bool countIncludePadding,
-        const Tensor<bool>& maps);
+template <>
+void PoolCell_Frame_Kernels::forwardAverage<half_float::half>(
+    const half_float::half* alpha,
+    const Tensor<half_float::half>& inputs,
+    const Descriptor& desc,
+    const half_float::half* beta,
+    Tensor<half_float::half>& outputs,
+    bool countIncludePadding,
+    const Tensor<bool>& maps,
+    Specialization specialization)
+{
+    const float floatAlpha = (float)(*alpha);
+    const float floatBeta = (float)(*beta);
+
+    Tensor<float> floatInputs(inputs.dims());
+    Tensor<float> floatOutputs(outputs.dims());
+
+    if (!inputs.empty())
+        HalfConversion::toFloat(&inputs(0), inputs.size(), &floatInputs(0));
+
+    if (floatBeta != 0.0f && !outputs.empty())
+        HalfConversion::toFloat(&outputs(0), outputs.size(), &floatOutputs(0));
+
+    forwardAverage<float>(&floatAlpha,
+                          floatInputs,
+                          desc,
+                          &floatBeta,
+                          floatOutputs,
+                          countIncludePadding,
+                          maps,
+                          specialization);
+
+    if (!outputs.empty())
+        HalfConversion::fromFloat(&floatOutputs(0), outputs.size(),
+                                  &outputs(0));
+}
+
     template void PoolCell_Frame_Kernels::forwardAverage<float>(
         const float* alpha,
         const Tensor<float>& inputs,
@@ -389,7 +843,8 @@ namespace N2D2 {
         const float* beta,
         Tensor<float>& outputs,
         bool countIncludePadding,
-        const Tensor<bool>& maps);
+        const Tensor<bool>& maps,
+        Specialization specialization);
     template void PoolCell_Frame_Kernels::forwardAverage<double>(
         const double* alpha,
         const Tensor<double>& inputs,
@@ -397,7 +852,8 @@ namespace N2D2 {
         const double* beta,
         Tensor<double>& outputs,
         bool countIncludePadding,
-        const Tensor<bool>& maps);
+        const Tensor<bool>& maps,
+        Specialization specialization);
 
     template void PoolCell_Frame_Kernels::forwardMax<half_float::half>(
         const half_float::half* alpha,
@@ -407,7 +863,8 @@ namespace N2D2 {
         Tensor<half_float::half>& outputs,
         Tensor<ArgMax>& argMax,
         bool useArgMax,
-        const Tensor<bool>& maps);
+        const Tensor<bool>& maps,
+        Specialization specialization);
     template void PoolCell_Frame_Kernels::forwardMax<float>(
         const float* alpha,
         const Tensor<float>& inputs,
@@ -416,7 +873,8 @@ namespace N2D2 {
         Tensor<float>& outputs,
         Tensor<ArgMax>& argMax,
         bool useArgMax,
-        const Tensor<bool>& maps);
+        const Tensor<bool>& maps,
+        Specialization specialization);
     template void PoolCell_Frame_Kernels::forwardMax<double>(
         const double* alpha,
         const Tensor<double>& inputs,
@@ -425,7 +883,8 @@ namespace N2D2 {
         Tensor<double>& outputs,
         Tensor<ArgMax>& argMax,
         bool useArgMax,
-        const Tensor<bool>& maps);
+        const Tensor<bool>& maps,
+        Specialization specialization);
 
     template void PoolCell_Frame_Kernels::backwardAverage<half_float::half>(
         const half_float::half* alpha,
@@ -39,6 +39,8 @@ N2D2::ProposalCell::ProposalCell(const DeepNet& deepNet, const std::string& name
       mNMS_IoU_Threshold(this, "NMS_IoU_Threshold", 0.3),
       mScoreThreshold(this, "Score_Threshold", 0.0),
       mKeepMax(this, "KeepMaxCls", false),
+      mNMS_Method(this, "NMS_Method", Greedy),
+      mNMS_SoftSigma(this, "NMS_SoftSigma", 0.5),
       mStimuliProvider(sp),
       mNbProposals(nbProposals),
       mScoreIndex(scoreIndex),
@@ -22,6 +22,7 @@
 #include "Cell/ProposalCell_Frame.hpp"
 #include "DeepNet.hpp"
 #include "StimuliProvider.hpp"
+#include "utils/Nms.hpp"
 
 N2D2::Registrar<N2D2::ProposalCell>
 N2D2::ProposalCell_Frame::mRegistrar("Frame", N2D2::ProposalCell_Frame::create);
@@ -201,9 +202,14 @@ void N2D2::ProposalCell_Frame::propagate(bool inference)
             ROIs[n].resize(mNbClass);
             std::vector<std::vector<unsigned int>> indexP;
             indexP.resize(mNbClass);
+            std::vector<std::vector<float> > scores;
+            scores.resize(mNbClass);
             unsigned int nbRoiDetected = 0;
 
-            for(unsigned int cls = mScoreIndex; cls < mNbClass; ++ cls)
+            // The classes are processed independently
+#pragma omp parallel for if (mNbClass - mScoreIndex > 1) \
+    reduction(+:nbRoiDetected)
+            for(int cls = mScoreIndex; cls < (int)mNbClass; ++ cls)
             {
 
                 for (unsigned int proposal = 0; proposal < mNbProposals; ++proposal)
@@ -251,6 +257,7 @@ void N2D2::ProposalCell_Frame::propagate(bool inference)
                     if( scoreEstimated >= mScoreThreshold )
                     {
                         ROIs[n][cls].push_back(BBox_T(x,y,w,h));
+                        scores[cls].push_back(scoreEstimated);
                         if(mMaxParts > 0)
                         {
                             int partsIdx = std::accumulate(mNumParts.begin(), mNumParts.begin() + cls, 0) * 2;
@@ -288,66 +295,71 @@ void N2D2::ProposalCell_Frame::propagate(bool inference)
                     }
                 }
 
-                if(mApplyNMS)
+                if(mApplyNMS && !ROIs[n][cls].empty())
                 {
+                    // Non-Maximum Suppression (NMS)
+                    Nms::Boxes boxes;
+                    boxes.reserve(ROIs[n][cls].size());
+
+                    for (unsigned int i = 0; i < ROIs[n][cls].size(); ++i) {
+                        boxes.push_back(ROIs[n][cls][i].x,
+                                        ROIs[n][cls][i].y,
+                                        ROIs[n][cls][i].w,
+                                        ROIs[n][cls][i].h);
+                    }
 
-                    if(ROIs[n][cls].size() > 0)
-                    {
-                        // Non-Maximum Suppression (NMS)
-                        for (unsigned int i = 0; i < ROIs[n][cls].size() - 1;
-                            ++i)
-                        {
-                            const Float_T x0 = ROIs[n][cls][i].x;
-                            const Float_T y0 = ROIs[n][cls][i].y;
-                            const Float_T w0 = ROIs[n][cls][i].w;
-                            const Float_T h0 = ROIs[n][cls][i].h;
-
-                            for (unsigned int j = i + 1; j < ROIs[n][cls].size(); ) {
-
-                                const Float_T x = ROIs[n][cls][j].x;
-                                const Float_T y = ROIs[n][cls][j].y;
-                                const Float_T w = ROIs[n][cls][j].w;
-                                const Float_T h = ROIs[n][cls][j].h;
-
-                                const Float_T interLeft = std::max(x0, x);
-                                const Float_T interRight = std::min(x0 + w0, x + w);
-                                const Float_T interTop = std::max(y0, y);
-                                const Float_T interBottom = std::min(y0 + h0, y + h);
-
-                                if (interLeft < interRight && interTop < interBottom) {
-                                    const Float_T interArea = (interRight - interLeft)
-                                                                * (interBottom - interTop);
-                                    const Float_T unionArea = w0 * h0 + w * h - interArea;
-                                    const Float_T IoU = interArea / unionArea;
-
-                                    if (IoU > mNMS_IoU_Threshold) {
-                                        // Suppress ROI
-                                        ROIs[n][cls].erase(ROIs[n][cls].begin() + j);
-
-                                        if(mMaxParts > 0)
-                                        {
-                                            for(unsigned int part = 0; part < mNumParts[cls]; ++part)
-                                            {
-                                                mPartsPrediction(0, part, cls, indexP[cls][j]) = 0.0;
-                                                mPartsPrediction(1, part, cls, indexP[cls][j]) = 0.0;
-                                            }
-                                            for(unsigned int tpl = 0; tpl < mNumTemplates[cls]; ++tpl)
-                                            {
-                                                mTemplatesPrediction(0, tpl, cls, indexP[cls][j]) = 0.0;
-                                                mTemplatesPrediction(1, tpl, cls, indexP[cls][j]) = 0.0;
-                                                mTemplatesPrediction(2, tpl, cls, indexP[cls][j]) = 0.0;
-                                            }
-                                        }
-
-                                        indexP[cls].erase(indexP[cls].begin() + j);
-                                        continue;
-                                    }
-                                }
-                                ++j;
+                    const std::vector<unsigned int> kept
+                        = (mNMS_Method == Greedy)
+                            ? Nms::nms(boxes, mNMS_IoU_Threshold)
+                            : Nms::softNms(boxes,
+                                           scores[cls],
+                                           (mNMS_Method == SoftLinear)
+                                                ? Nms::Linear
+                                                : Nms::Gaussian,
+                                           mNMS_IoU_Threshold,
+                                           mNMS_SoftSigma,
+                                           mScoreThreshold);
+
+                    if (mMaxParts > 0) {
+                        // Suppressed ROIs
+                        std::vector<bool> isKept(ROIs[n][cls].size(), false);
+
+                        for (unsigned int i = 0; i < kept.size(); ++i)
+                            isKept[kept[i]] = true;
+
+                        for (unsigned int j = 0; j < isKept.size(); ++j) {
+                            if (isKept[j])
+                                continue;
+
+                            for(unsigned int part = 0; part < mNumParts[cls]; ++part)
+                            {
+                                mPartsPrediction(0, part, cls, indexP[cls][j]) = 0.0;
+                                mPartsPrediction(1, part, cls, indexP[cls][j]) = 0.0;
+                            }
+                            for(unsigned int tpl = 0; tpl < mNumTemplates[cls]; ++tpl)
+                            {
+                                mTemplatesPrediction(0, tpl, cls, indexP[cls][j]) = 0.0;
+                                mTemplatesPrediction(1, tpl, cls, indexP[cls][j]) = 0.0;
+                                mTemplatesPrediction(2, tpl, cls, indexP[cls][j]) = 0.0;
                             }
                         }
                     }
+
+                    std::vector<BBox_T> keptROIs;
+                    std::vector<unsigned int> keptIndexP;
+                    keptROIs.reserve(kept.size());
+
+                    for (unsigned int i = 0; i < kept.size(); ++i) {
+                        keptROIs.push_back(ROIs[n][cls][kept[i]]);
+
+                        if (mMaxParts > 0)
+                            keptIndexP.push_back(indexP[cls][kept[i]]);
+                    }
+
+                    ROIs[n][cls].swap(keptROIs);
+                    indexP[cls].swap(keptIndexP);
                 }
+
                 nbRoiDetected += ROIs[n][cls].size();
             }
 
@@ -193,6 +193,11 @@ void N2D2::ProposalCell_Frame_CUDA::initialize()
         //mKeepIndex.synchronizeHToD();
     }
 
+    if (mApplyNMS && mNMS_Method != Greedy) {
+        throw std::runtime_error("Only the Greedy NMS_Method is supported by"
+                                 " ProposalCell::Frame_CUDA: " + mName);
+    }
+
     std::cout << "PropocalCell::Frame " << mName << " provide "
             <<  mNbClass << " class\n"
             << std::endl;
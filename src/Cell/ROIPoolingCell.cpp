@@ -34,6 +34,7 @@ N2D2::ROIPoolingCell::ROIPoolingCell(const DeepNet& deepNet,
     : Cell(deepNet, name, nbOutputs),
       mFlip(this, "Flip", false),
       mIgnorePad(this, "IgnorePadding", 0),
+      mSamplingRatio(this, "SamplingRatio", 0U),
       mStimuliProvider(sp),
       mPooling(pooling)
 {
@@ -85,6 +85,244 @@ void N2D2::ROIPoolingCell_Frame::initialize()
     mParentProposals = mInputs[kRef-1].dimB()/mInputs[kRef].dimB();
 }
 
+void N2D2::ROIPoolingCell_Frame::computeROIAlignSample(Float_T s,
+                                                      unsigned int size,
+                                                      Float_T scale,
+                                                      BilinearSample& sample)
+    const
+{
+    // Samples outside the input do not contribute to the bin value
+    if (s < -1.0 || s > size) {
+        sample.low = 0;
+        sample.high = 0;
+        sample.lowWeight = 0.0;
+        sample.highWeight = 0.0;
+        return;
+    }
+
+    if (s <= 0.0)
+        s = 0.0;
+
+    sample.low = (unsigned int)s;
+
+    if (sample.low >= size - 1) {
+        sample.low = size - 1;
+        sample.high = size - 1;
+        s = sample.low;
+    }
+    else
+        sample.high = sample.low + 1;
+
+    const Float_T ds = s - sample.low;
+
+    sample.lowWeight = (1.0 - ds) * scale;
+    sample.highWeight = ds * scale;
+}
+
+void N2D2::ROIPoolingCell_Frame::computeROIBins(unsigned int k)
+{
+    const Tensor<Float_T>& proposals = tensor_cast<Float_T>(mInputs[0]);
+    const unsigned int inputWidth = mInputs[k].dimX();
+    const unsigned int inputHeight = mInputs[k].dimY();
+
+    const double xRatio = std::ceil(mStimuliProvider.getSizeX()
+                                    / (double)inputWidth);
+    const double yRatio = std::ceil(mStimuliProvider.getSizeY()
+                                    / (double)inputHeight);
+
+    Float_T xOffset = 0.0;
+    Float_T yOffset = 0.0;
+
+    if (mFlip && (mPooling == Bilinear || mPooling == BilinearTF)) {
+        xOffset = (mStimuliProvider.getSizeX() - 1) / xRatio
+                    - (inputWidth - 1);
+        yOffset = (mStimuliProvider.getSizeY() - 1) / yRatio
+                    - (inputHeight - 1);
+    }
+
+    if (mROIBins.size() < k)
+        mROIBins.resize(k);
+
+    std::vector<ROIBins>& roiBins = mROIBins[k - 1];
+    roiBins.resize(mOutputs.dimB());
+
+#pragma omp parallel for if (mOutputs.dimB() > 16)
+    for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos) {
+        const Tensor<Float_T>& proposal = proposals[batchPos];
+        ROIBins& bins = roiBins[batchPos];
+        bins.inputBatch = batchPos / proposals.dimB();
+
+        Float_T x = proposal(0) / xRatio - xOffset;
+        Float_T y = proposal(1) / yRatio - yOffset;
+        Float_T w = proposal(2) / xRatio;
+        Float_T h = proposal(3) / yRatio;
+
+        if (mPooling == ROIAlign) {
+            // The ROI is neither cropped nor rounded
+            w = std::max<Float_T>(w, 1.0);
+            h = std::max<Float_T>(h, 1.0);
+
+            const Float_T binWidth = w / mOutputs.dimX();
+            const Float_T binHeight = h / mOutputs.dimY();
+
+            bins.gridX = (mSamplingRatio > 0U) ? (unsigned int)mSamplingRatio
+                : (unsigned int)std::ceil(binWidth);
+            bins.gridY = (mSamplingRatio > 0U) ? (unsigned int)mSamplingRatio
+                : (unsigned int)std::ceil(binHeight);
+
+            bins.xSamples.resize(mOutputs.dimX() * bins.gridX);
+            bins.ySamples.resize(mOutputs.dimY() * bins.gridY);
+
+            for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
+                for (unsigned int gx = 0; gx < bins.gridX; ++gx) {
+                    computeROIAlignSample(x + ox * binWidth
+                                            + (gx + 0.5) * binWidth / bins.gridX,
+                                          inputWidth,
+                                          1.0 / bins.gridX,
+                                          bins.xSamples[ox * bins.gridX + gx]);
+                }
+            }
+
+            for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
+                for (unsigned int gy = 0; gy < bins.gridY; ++gy) {
+                    computeROIAlignSample(y + oy * binHeight
+                                            + (gy + 0.5) * binHeight / bins.gridY,
+                                          inputHeight,
+                                          1.0 / bins.gridY,
+                                          bins.ySamples[oy * bins.gridY + gy]);
+                }
+            }
+
+            continue;
+        }
+
+        assert(w >= 0);
+        assert(h >= 0);
+
+        // Crop ROI to image boundaries
+        if (x < 0) {
+            w+= x;
+            x = 0;
+        }
+        if (y < 0) {
+            h+= y;
+            y = 0;
+        }
+        if (x + w > (int)inputWidth)
+            w = inputWidth - x;
+        if (y + h > (int)inputHeight)
+            h = inputHeight - y;
+
+        if (mPooling == Max || mPooling == Average) {
+            const Float_T poolWidth = w / mOutputs.dimX();
+            const Float_T poolHeight = h / mOutputs.dimY();
+
+            assert(poolWidth >= 0);
+            assert(poolHeight >= 0);
+
+            bins.xMin.resize(mOutputs.dimX());
+            bins.xMax.resize(mOutputs.dimX());
+            bins.yMin.resize(mOutputs.dimY());
+            bins.yMax.resize(mOutputs.dimY());
+
+            for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
+                bins.xMin[ox] = (unsigned int)(x + ox * poolWidth);
+                bins.xMax[ox] = (unsigned int)(x + (ox + 1) * poolWidth);
+            }
+
+            for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
+                bins.yMin[oy] = (unsigned int)(y + oy * poolHeight);
+                bins.yMax[oy] = (unsigned int)(y + (oy + 1) * poolHeight);
+            }
+        }
+        else {
+            // Bilinear
+            Float_T xPoolRatio, yPoolRatio;
+
+            if (mPooling == BilinearTF) {
+                xPoolRatio = w / (mOutputs.dimX() - 1);
+                yPoolRatio = h / (mOutputs.dimY() - 1);
+            }
+            else {
+                xPoolRatio = w / mOutputs.dimX();
+                yPoolRatio = h / mOutputs.dimY();
+            }
+
+            bins.gridX = 1;
+            bins.gridY = 1;
+            bins.xSamples.resize(mOutputs.dimX());
+            bins.ySamples.resize(mOutputs.dimY());
+
+            for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
+                Float_T sx;
+
+                if (mPooling == BilinearTF) {
+                    sx = std::min<Float_T>(x + ox * xPoolRatio,
+                        inputWidth - 1);
+                }
+                else {
+                    // -0.5 + (ox + 0.5) and not ox because the
+                    // interpolation is done relative to the CENTER
+                    // of the pixels
+                    sx = x + Utils::clamp<Float_T>(
+                        -0.5 + (ox + 0.5) * xPoolRatio, 0, w - 1);
+                }
+
+                BilinearSample& sample = bins.xSamples[ox];
+                sample.low = (int)(sx);
+
+                const Float_T dx = sx - sample.low;
+
+                sample.lowWeight = 1.0 - dx;
+
+                if (sample.low + 1 < inputWidth) {
+                    sample.high = sample.low + 1;
+                    sample.highWeight = dx;
+                }
+                else {
+                    sample.high = sample.low;
+                    sample.highWeight = 0.0;
+
+                    if (mIgnorePad)
+                        sample.lowWeight = 0.0;
+                }
+            }
+
+            for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
+                Float_T sy;
+
+                if (mPooling == BilinearTF) {
+                    sy = std::min<Float_T>(y + oy * yPoolRatio,
+                        inputHeight - 1);
+                }
+                else {
+                    sy = y + Utils::clamp<Float_T>(
+                        -0.5 + (oy + 0.5) * yPoolRatio, 0, h - 1);
+                }
+
+                BilinearSample& sample = bins.ySamples[oy];
+                sample.low = (int)(sy);
+
+                const Float_T dy = sy - sample.low;
+
+                sample.lowWeight = 1.0 - dy;
+
+                if (sample.low + 1 < inputHeight) {
+                    sample.high = sample.low + 1;
+                    sample.highWeight = dy;
+                }
+                else {
+                    sample.high = sample.low;
+                    sample.highWeight = 0.0;
+
+                    if (mIgnorePad)
+                        sample.lowWeight = 0.0;
+                }
+            }
+        }
+    }
+}
+
 void N2D2::ROIPoolingCell_Frame::propagate(bool inference)
 {
     mInputs.synchronizeDBasedToH();
@@ -92,79 +330,40 @@ void N2D2::ROIPoolingCell_Frame::propagate(bool inference)
     const float alpha = 1.0f;
     float beta = 0.0f;
 
-    const Tensor<Float_T>& proposals = tensor_cast<Float_T>(mInputs[0]);
     unsigned int outputOffset = 0;
 
     for (unsigned int k = 1, size = mInputs.size(); k < size; ++k) {
         const Tensor<Float_T>& input = tensor_cast<Float_T>(mInputs[k]);
 
-        const double xRatio = std::ceil(mStimuliProvider.getSizeX()
-                                        / (double)input.dimX());
-        const double yRatio = std::ceil(mStimuliProvider.getSizeY()
-                                        / (double)input.dimY());
+        // The ROIs geometry is computed once for all the channels
+        computeROIBins(k);
+
+        const std::vector<ROIBins>& roiBins = mROIBins[k - 1];
 
-        if (mPooling == Max) {
 #if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (size > 16)
+#pragma omp parallel for collapse(2) if (mOutputs.dimB() * input.dimZ() > 16)
 #else
-#pragma omp parallel for if (mOutputs.dimB() > 4 && size > 16)
+#pragma omp parallel for if (mOutputs.dimB() > 4)
 #endif
-            for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos)
-            {
-                for (unsigned int channel = 0; channel < input.dimZ();
-                    ++channel)
-                {
-                    const Tensor<Float_T>& proposal = proposals[batchPos];
-                    const unsigned int inputBatch = batchPos / proposals.dimB();
+        for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos) {
+            for (unsigned int channel = 0; channel < input.dimZ(); ++channel) {
+                const ROIBins& bins = roiBins[batchPos];
+                const unsigned int inputBatch = bins.inputBatch;
 
-                    Float_T x = proposal(0) / xRatio;
-                    Float_T y = proposal(1) / yRatio;
-                    Float_T w = proposal(2) / xRatio;
-                    Float_T h = proposal(3) / yRatio;
-
-                    assert(w >= 0);
-                    assert(h >= 0);
-
-                    // Crop ROI to image boundaries
-                    if (x < 0) {
-                        w+= x;
-                        x = 0;
-                    }
-                    if (y < 0) {
-                        h+= y;
-                        y = 0;
-                    }
-                    if (x + w > (int)input.dimX())
-                        w = input.dimX() - x;
-                    if (y + h > (int)input.dimY())
-                        h = input.dimY() - y;
-
-                    const Float_T poolWidth = w / mOutputs.dimX();
-                    const Float_T poolHeight = h / mOutputs.dimY();
-
-                    assert(poolWidth >= 0);
-                    assert(poolHeight >= 0);
-
-                    for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
-                            const unsigned int sxMin = (unsigned int)(x
-                                                    + ox * poolWidth);
-                            const unsigned int sxMax = (unsigned int)(x
-                                                    + (ox + 1) * poolWidth);
-                            const unsigned int syMin = (unsigned int)(y
-                                                    + oy * poolHeight);
-                            const unsigned int syMax = (unsigned int)(y
-                                                    + (oy + 1) * poolHeight);
-
-                            // For each channel, compute the pool value
-                            Float_T poolValue = 0.0;
+                for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
+                    for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
+                        Float_T poolValue = 0.0;
 
+                        if (mPooling == Max) {
                             unsigned int ixMax = 0;
                             unsigned int iyMax = 0;
                             bool valid = false;
 
-                            for (unsigned int sy = syMin; sy < syMax; ++sy) {
-                                for (unsigned int sx = sxMin; sx < sxMax; ++sx)
+                            for (unsigned int sy = bins.yMin[oy];
+                                sy < bins.yMax[oy]; ++sy)
+                            {
+                                for (unsigned int sx = bins.xMin[ox];
+                                    sx < bins.xMax[ox]; ++sx)
                                 {
                                     const Float_T value = input(sx,
                                                             sy,
@@ -186,201 +385,58 @@ void N2D2::ROIPoolingCell_Frame::propagate(bool inference)
                                                                  iyMax,
                                                                  channel,
                                                                  valid);
-
-                            mOutputs(ox, oy, outputOffset + channel, batchPos)
-                                = alpha * poolValue
-                                  + beta * mOutputs(ox, oy, outputOffset
-                                                        + channel, batchPos);
                         }
-                    }
-                }
-            }
-        }
-        else if (mPooling == Average) {
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (size > 16)
-#else
-#pragma omp parallel for if (mOutputs.dimB() > 4 && size > 16)
-#endif
-            for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos)
-            {
-                for (unsigned int channel = 0; channel < input.dimZ();
-                    ++channel)
-                {
-                    const Tensor<Float_T>& proposal = proposals[batchPos];
-                    const unsigned int inputBatch = batchPos / proposals.dimB();
-
-                    Float_T x = proposal(0) / xRatio;
-                    Float_T y = proposal(1) / yRatio;
-                    Float_T w = proposal(2) / xRatio;
-                    Float_T h = proposal(3) / yRatio;
-
-                    // Crop ROI to image boundaries
-                    if (x < 0) {
-                        w+= x;
-                        x = 0;
-                    }
-                    if (y < 0) {
-                        h+= y;
-                        y = 0;
-                    }
-                    if (x + w > (int)input.dimX())
-                        w = input.dimX() - x;
-                    if (y + h > (int)input.dimY())
-                        h = input.dimY() - y;
-
-                    const Float_T poolWidth = w / mOutputs.dimX();
-                    const Float_T poolHeight = h / mOutputs.dimY();
-
-                    for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
-                            const unsigned int sxMin = (unsigned int)(x
-                                                    + ox * poolWidth);
-                            const unsigned int sxMax = (unsigned int)(x
-                                                    + (ox + 1) * poolWidth);
-                            const unsigned int syMin = (unsigned int)(y
-                                                    + oy * poolHeight);
-                            const unsigned int syMax = (unsigned int)(y
-                                                    + (oy + 1) * poolHeight);
-
-                            // For each channel, compute the pool value
-                            Float_T poolValue = 0.0;
-                            unsigned int poolCount = 0;
-
-                            for (unsigned int sy = syMin; sy < syMax; ++sy) {
-                                for (unsigned int sx = sxMin; sx < sxMax; ++sx)
+                        else if (mPooling == Average) {
+                            for (unsigned int sy = bins.yMin[oy];
+                                sy < bins.yMax[oy]; ++sy)
+                            {
+                                for (unsigned int sx = bins.xMin[ox];
+                                    sx < bins.xMax[ox]; ++sx)
                                 {
                                     poolValue += input(sx,
-                                                            sy,
-                                                            channel,
-                                                            inputBatch);
+                                                       sy,
+                                                       channel,
+                                                       inputBatch);
                                 }
                             }
 
-                            poolCount += (sxMax - sxMin)*(syMax - syMin);
+                            const unsigned int poolCount
+                                = (bins.xMax[ox] - bins.xMin[ox])
+                                    * (bins.yMax[oy] - bins.yMin[oy]);
 
-                            mOutputs(ox, oy, outputOffset + channel, batchPos)
-                                = alpha * ((poolCount > 0) ?
-                                              (poolValue / poolCount) : 0.0)
-                                  + beta * mOutputs(ox, oy, outputOffset
-                                                        + channel, batchPos);
+                            if (poolCount > 0)
+                                poolValue /= poolCount;
                         }
-                    }
-                }
-            }
-        }
-        else {
-            // Bilinear
-            Float_T xOffset = 0.0;
-            Float_T yOffset = 0.0;
-
-            if (mFlip) {
-                xOffset = (mStimuliProvider.getSizeX() - 1) / xRatio
-                            - (input.dimX() - 1);
-                yOffset = (mStimuliProvider.getSizeY() - 1) / yRatio
-                            - (input.dimY() - 1);
-            }
-
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (size > 16)
-#else
-#pragma omp parallel for if (mOutputs.dimB() > 4 && size > 16)
-#endif
-            for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos)
-            {
-                for (unsigned int channel = 0; channel < input.dimZ();
-                    ++channel)
-                {
-                    const Tensor<Float_T>& proposal = proposals[batchPos];
-                    const unsigned int inputBatch = batchPos / proposals.dimB();
-
-                    Float_T x = proposal(0) / xRatio - xOffset;
-                    Float_T y = proposal(1) / yRatio - yOffset;
-                    Float_T w = proposal(2) / xRatio;
-                    Float_T h = proposal(3) / yRatio;
-
-                    // Crop ROI to image boundaries
-                    if (x < 0) {
-                        w+= x;
-                        x = 0;
-                    }
-                    if (y < 0) {
-                        h+= y;
-                        y = 0;
-                    }
-                    if (x + w > (int)input.dimX())
-                        w = input.dimX() - x;
-                    if (y + h > (int)input.dimY())
-                        h = input.dimY() - y;
-
-                    Float_T xPoolRatio, yPoolRatio;
-
-                    if (mPooling == BilinearTF) {
-                        xPoolRatio = w / (mOutputs.dimX() - 1);
-                        yPoolRatio = h / (mOutputs.dimY() - 1);
-                    }
-                    else {
-                        xPoolRatio = w / mOutputs.dimX();
-                        yPoolRatio = h / mOutputs.dimY();
-                    }
-
-                    for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
-                        for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
-                            Float_T sx, sy;
-
-                            if (mPooling == BilinearTF) {
-                                sx = std::min<Float_T>(x + ox * xPoolRatio,
-                                    input.dimX() - 1);
-                                sy = std::min<Float_T>(y + oy * yPoolRatio,
-                                    input.dimY() - 1);
-                            }
-                            else {
-                                // -0.5 + (ox + 0.5) and not ox because the
-                                // interpolation is done relative to the CENTER
-                                // of the pixels
-                                sx = x + Utils::clamp<Float_T>(
-                                    -0.5 + (ox + 0.5) * xPoolRatio, 0, w - 1);
-                                sy = y + Utils::clamp<Float_T>(
-                                    -0.5 + (oy + 0.5) * yPoolRatio, 0, h - 1);
+                        else {
+                            // Bilinear and ROIAlign
+                            for (unsigned int gy = 0; gy < bins.gridY; ++gy) {
+                                const BilinearSample& sy
+                                    = bins.ySamples[oy * bins.gridY + gy];
+
+                                for (unsigned int gx = 0; gx < bins.gridX;
+                                    ++gx)
+                                {
+                                    const BilinearSample& sx
+                                        = bins.xSamples[ox * bins.gridX + gx];
+
+                                    poolValue += sy.lowWeight
+                                        * (sx.lowWeight * input(sx.low,
+                                            sy.low, channel, inputBatch)
+                                        + sx.highWeight * input(sx.high,
+                                            sy.low, channel, inputBatch))
+                                        + sy.highWeight
+                                        * (sx.lowWeight * input(sx.low,
+                                            sy.high, channel, inputBatch)
+                                        + sx.highWeight * input(sx.high,
+                                            sy.high, channel, inputBatch));
+                                }
                             }
-
-                            const unsigned int sx0 = (int)(sx);
-                            const unsigned int sy0 = (int)(sy);
-                            const Float_T dx = sx - sx0;
-                            const Float_T dy = sy - sy0;
-
-                            const bool invalid = mIgnorePad ?
-                                    (((sx0 + 1 < input.dimX() )
-                                        && (sy0 + 1 < input.dimY() ))  ?
-                                        false : true) : false;
-
-
-                            const Float_T i00 = (!invalid) ?
-                                    input(sx0, sy0, channel, inputBatch)
-                                    : 0.0;
-
-                            const Float_T i10 = (sx0 + 1 < input.dimX()) && (!invalid) ?
-                                        input(sx0 + 1, sy0, channel, inputBatch)
-                                        : 0.0;
-                            const Float_T i01 = (sy0 + 1 < input.dimY()) && (!invalid) ?
-                                        input(sx0, sy0 + 1, channel, inputBatch)
-                                        : 0.0;
-                            const Float_T i11 = (sx0 + 1 < input.dimX() && sy0 + 1
-                                                    < input.dimY()) && (!invalid) ?
-                                                input(sx0 + 1, sy0 + 1, channel, inputBatch)
-                                                : 0.0;
-
-                            const Float_T value
-                                = i00 * (1 - dx) * (1 - dy)
-                                + i10 * dx * (1 - dy)
-                                + i01 * (1 - dx) * dy
-                                + i11 * (dx * dy);
-
-                            mOutputs(ox, oy, outputOffset + channel, batchPos)
-                                = alpha * value
-                                  + beta * mOutputs(ox, oy, outputOffset
-                                                        + channel, batchPos);
                         }
+
+                        mOutputs(ox, oy, outputOffset + channel, batchPos)
+                            = alpha * poolValue
+                              + beta * mOutputs(ox, oy, outputOffset
+                                                    + channel, batchPos);
                     }
                 }
             }
@@ -402,12 +458,9 @@ void N2D2::ROIPoolingCell_Frame::backPropagate()
 
     const Float_T alpha = 1.0;
 
-    const Tensor<Float_T>& proposals = tensor_cast_nocopy<Float_T>(mInputs[0]);
     unsigned int outputOffset = 0;
 
     for (unsigned int k = 1, size = mInputs.size(); k < size; ++k) {
-        //const Float_T beta = (mDiffOutputs[k].isValid()) ? 1.0 : 0.0;
-
         Tensor<Float_T> diffOutput = (mDiffOutputs[k].isValid())
             ? tensor_cast<Float_T>(mDiffOutputs[k])
             : tensor_cast_nocopy<Float_T>(mDiffOutputs[k]);
@@ -417,107 +470,110 @@ void N2D2::ROIPoolingCell_Frame::backPropagate()
             mDiffOutputs[k].setValid();
         }
 
-        const double xRatio = std::ceil(mStimuliProvider.getSizeX()
-                                        / (double)mInputs[k].dimX());
-        const double yRatio = std::ceil(mStimuliProvider.getSizeY()
-                                        / (double)mInputs[k].dimY());
+        const std::vector<ROIBins>& roiBins = mROIBins[k - 1];
+        const unsigned int nbChannels = mDiffOutputs[k].dimZ();
+        const unsigned int inputBatchSize = mDiffOutputs[k].dimB();
 
-        if (mPooling == Max) {
+        // Parallelize over input images x channels: the ROIs of an image are
+        // processed sequentially, so that the gradient accumulation needs no
+        // synchronization
 #if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (size > 16)
+#pragma omp parallel for collapse(2) if (inputBatchSize * nbChannels > 16)
 #else
-#pragma omp parallel for if (mDiffInputs.dimB() > 4 && size > 16)
+#pragma omp parallel for if (inputBatchSize > 4)
 #endif
-            for (int batchPos = 0; batchPos < (int)mDiffInputs.dimB();
-                ++batchPos)
-            {
-                for (unsigned int channel = 0; channel < mDiffOutputs[k].dimZ();
-                     ++channel)
+        for (int inputBatch = 0; inputBatch < (int)inputBatchSize;
+            ++inputBatch)
+        {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                for (unsigned int batchPos = 0; batchPos < mDiffInputs.dimB();
+                    ++batchPos)
                 {
-                    const Tensor<Float_T>& proposal = proposals[batchPos];
-                    const unsigned int inputBatch = batchPos / proposals.dimB();
-                    //const Float_T betaBatch = (batchPos % proposals.dimB() == 0)
-                    //                            ? beta : 1.0;
-
-                    Float_T x = proposal(0) / xRatio;
-                    Float_T y = proposal(1) / yRatio;
-                    Float_T w = proposal(2) / xRatio;
-                    Float_T h = proposal(3) / yRatio;
-
-                    // Crop ROI to image boundaries
-                    if (x < 0) {
-                        w+= x;
-                        x = 0;
-                    }
-                    if (y < 0) {
-                        h+= y;
-                        y = 0;
-                    }
-                    if (x + w > (int)mInputs[k].dimX())
-                        w = mInputs[k].dimX() - x;
-                    if (y + h > (int)mInputs[k].dimY())
-                        h = mInputs[k].dimY() - y;
-
-                    const Float_T poolWidth = w / mOutputs.dimX();
-                    const Float_T poolHeight = h / mOutputs.dimY();
-
-                    const unsigned int ixMin = (unsigned int)(x);
-                    const unsigned int ixMax = (unsigned int)(x + w);
-                    const unsigned int iyMin = (unsigned int)(y);
-                    const unsigned int iyMax = (unsigned int)(y + h);
-
-                    assert(ixMin <= ixMax);
-                    assert(ixMax < mDiffOutputs[k].dimX());
-                    assert(iyMin <= iyMax);
-                    assert(iyMax < mDiffOutputs[k].dimY());
-
-                    for (unsigned int iy = 0; iy < mDiffOutputs[k].dimY(); ++iy)
-                    {
-                        for (unsigned int ix = 0; ix < mDiffOutputs[k].dimX();
-                            ++ix)
-                        {
-                            if (ix >= ixMin && ix < ixMax
-                                && iy >= iyMin && iy < iyMax)
-                            {
-                                const unsigned int ox = (unsigned int)
-                                    ((ix - ixMin + 0.5) / poolWidth);
-                                const unsigned int oy = (unsigned int)
-                                    ((iy - iyMin + 0.5) / poolHeight);
+                    const ROIBins& bins = roiBins[batchPos];
 
-                                assert(ox < mOutputs.dimX());
-                                assert(oy < mOutputs.dimY());
+                    if (bins.inputBatch != (unsigned int)inputBatch)
+                        continue;
 
+                    for (unsigned int oy = 0; oy < mDiffInputs.dimY(); ++oy) {
+                        for (unsigned int ox = 0; ox < mDiffInputs.dimX();
+                            ++ox)
+                        {
+                            const Float_T diffInput = alpha * mDiffInputs(ox,
+                                oy, outputOffset + channel, batchPos);
+
+                            if (mPooling == Max) {
                                 const PoolCell_Frame_Kernels::ArgMax inputMax
                                     = mArgMax[k-1](ox, oy, channel, batchPos);
 
-                                if (ix == inputMax.ix
-                                    && iy == inputMax.iy
-                                    && inputMax.valid)
-                                {
-                                    #pragma omp atomic
-                                    diffOutput(ix, iy, channel, inputBatch)
-                                        += alpha * mDiffInputs(ox, oy,
-                                            outputOffset + channel, batchPos);
+                                if (inputMax.valid) {
+                                    diffOutput(inputMax.ix, inputMax.iy,
+                                               channel, inputBatch)
+                                        += diffInput;
                                 }
                             }
+                            else if (mPooling == Average) {
+                                const unsigned int poolCount
+                                    = (bins.xMax[ox] - bins.xMin[ox])
+                                        * (bins.yMax[oy] - bins.yMin[oy]);
+
+                                if (poolCount == 0)
+                                    continue;
 
-                            //mDiffOutputs[k](ix, iy, channel, inputBatch)
-                            //    = alpha * poolGradient
-                            //      + betaBatch * mDiffOutputs[k](ix, iy, channel,
-                            //                               inputBatch);
+                                const Float_T poolGradient
+                                    = diffInput / poolCount;
+
+                                for (unsigned int sy = bins.yMin[oy];
+                                    sy < bins.yMax[oy]; ++sy)
+                                {
+                                    for (unsigned int sx = bins.xMin[ox];
+                                        sx < bins.xMax[ox]; ++sx)
+                                    {
+                                        diffOutput(sx, sy, channel, inputBatch)
+                                            += poolGradient;
+                                    }
+                                }
+                            }
+                            else {
+                                // Bilinear and ROIAlign
+                                for (unsigned int gy = 0; gy < bins.gridY;
+                                    ++gy)
+                                {
+                                    const BilinearSample& sy
+                                        = bins.ySamples[oy * bins.gridY + gy];
+
+                                    for (unsigned int gx = 0; gx < bins.gridX;
+                                        ++gx)
+                                    {
+                                        const BilinearSample& sx
+                                            = bins.xSamples[ox * bins.gridX
+                                                            + gx];
+
+                                        diffOutput(sx.low, sy.low, channel,
+                                                   inputBatch)
+                                            += sy.lowWeight * sx.lowWeight
+                                                * diffInput;
+                                        diffOutput(sx.high, sy.low, channel,
+                                                   inputBatch)
+                                            += sy.lowWeight * sx.highWeight
+                                                * diffInput;
+                                        diffOutput(sx.low, sy.high, channel,
+                                                   inputBatch)
+                                            += sy.highWeight * sx.lowWeight
+                                                * diffInput;
+                                        diffOutput(sx.high, sy.high, channel,
+                                                   inputBatch)
+                                            += sy.highWeight * sx.highWeight
+                                                * diffInput;
+                                    }
+                                }
+                            }
                         }
                     }
                 }
             }
         }
-        else {
-            throw std::runtime_error("ROIPoolingCell_Frame::backPropagate():"
-                                     " only Max pooling back-"
-                                     "propagation is implemented");
-        }
 
         mDiffOutputs[k] = diffOutput;
-        //mDiffOutputs[k].setValid();
 
         outputOffset += mDiffOutputs[k].dimZ();
     }
@@ -20,6 +20,7 @@
 
 #include "Cell/RPCell_Frame.hpp"
 #include "DeepNet.hpp"
+#include "utils/Nms.hpp"
 
 N2D2::Registrar<N2D2::RPCell>
 N2D2::RPCell_Frame::mRegistrar("Frame", N2D2::RPCell_Frame::create);
@@ -97,134 +98,33 @@ void N2D2::RPCell_Frame::propagate(bool inference)
 
         if (inference) {
             // Non-Maximum Suppression (NMS)
+            Nms::Boxes boxes;
+            boxes.reserve(ROIs.size());
 
-            // This implementation is inspired by D. Oro, C. Fern, X. Martorell
-            // and J. Hernando, "WORK-EFFICIENT PARALLEL NON-MAXIMUM SUPPRESSION
-            // FOR EMBEDDED GPU ARCHITECTURES"
-            // http://rapid-project.eu/_docs/icassp2016.pdf
-
-            Tensor<int> invalid({ROIs.size(), ROIs.size()}, 0);
-
-            // Flag
-#pragma omp parallel for if (ROIs.size() > 16)
-            for (int i = 0; i < (int)ROIs.size(); ++i) {
-                const Tensor<int>::Index& ROIMax = ROIs[i].first;
-
-                const Float_T x0 = input0(ROIMax[0],
-                                           ROIMax[1],
-                                           ROIMax[2] + 1 * mNbAnchors,
-                                           ROIMax[3]);
-                const Float_T y0 = input0(ROIMax[0],
-                                           ROIMax[1],
-                                           ROIMax[2] + 2 * mNbAnchors,
-                                           ROIMax[3]);
-                const Float_T w0 = input0(ROIMax[0],
-                                           ROIMax[1],
-                                           ROIMax[2] + 3 * mNbAnchors,
-                                           ROIMax[3]);
-                const Float_T h0 = input0(ROIMax[0],
-                                           ROIMax[1],
-                                           ROIMax[2] + 4 * mNbAnchors,
-                                           ROIMax[3]);
-
-                for (unsigned int j = i + 1; j < ROIs.size(); ++j) {
-                    const Tensor<int>::Index& ROI = ROIs[j].first;
-
-                    const Float_T x = input0(ROI[0],
-                                              ROI[1],
-                                              ROI[2] + 1 * mNbAnchors,
-                                              ROI[3]);
-                    const Float_T y = input0(ROI[0],
-                                              ROI[1],
-                                              ROI[2] + 2 * mNbAnchors,
-                                              ROI[3]);
-                    const Float_T w = input0(ROI[0],
-                                              ROI[1],
-                                              ROI[2] + 3 * mNbAnchors,
-                                              ROI[3]);
-                    const Float_T h = input0(ROI[0],
-                                              ROI[1],
-                                              ROI[2] + 4 * mNbAnchors,
-                                              ROI[3]);
-
-                    const Float_T interLeft = std::max(x0, x);
-                    const Float_T interRight = std::min(x0 + w0, x + w);
-                    const Float_T interTop = std::max(y0, y);
-                    const Float_T interBottom = std::min(y0 + h0, y + h);
-
-                    if (interLeft < interRight && interTop < interBottom) {
-                        const Float_T interArea = (interRight - interLeft)
-                                                    * (interBottom - interTop);
-                        const Float_T unionArea = w0 * h0 + w * h - interArea;
-                        const Float_T IoU = interArea / unionArea;
-
-                        if (IoU > mNMS_IoU_Threshold) {
-                            // Row j is invalid at column i
-                            // = ROI j is invalid because it overlaps with ROI i
-                            // Thread-safe because i is != for every thread
-                            invalid(j, i) = 1;
-                        }
-                    }
-                }
+            for (unsigned int i = 0; i < ROIs.size(); ++i) {
+                const Tensor<int>::Index& ROI = ROIs[i].first;
+
+                boxes.push_back(input0(ROI[0], ROI[1],
+                                       ROI[2] + 1 * mNbAnchors, ROI[3]),
+                                input0(ROI[0], ROI[1],
+                                       ROI[2] + 2 * mNbAnchors, ROI[3]),
+                                input0(ROI[0], ROI[1],
+                                       ROI[2] + 3 * mNbAnchors, ROI[3]),
+                                input0(ROI[0], ROI[1],
+                                       ROI[2] + 4 * mNbAnchors, ROI[3]));
             }
 
-            // Reduction
-            for (unsigned int i = 0, n = 0; i < ROIs.size() && n < mNbProposals;
-                ++i)
-            {
-                // Check if any preceding ROI invalidates this ROI
-                // => the row i from column 0 to i (excluded) must be valid
-#if __cplusplus >= 201703L
-                const int isInvalid
-                    = std::reduce(std::execution::par_unseq,
-                                  invalid[i].begin(),
-                                  invalid[i].begin() + i,
-                                  0);
-#else
-                int isInvalid = 0;
-                    //= std::accumulate(invalid[i].begin(),
-                    //                  invalid[i].begin() + i,
-                    //                  0);
-                for(unsigned int k = 0; k < i; ++k)
-                    if(invalid(i,k) == 1)
-                        isInvalid += 1;
-#endif
-
-                if (isInvalid) {
-                    // Main difference with D. Oro et al. reference:
-                    // our implementation is NOT greedy
-
-                    // ROI i is invalid:
-                    // => ROI i cannot invalidate another ROI anymore
-                    // => clear all following rows at column i
-                    for (unsigned int j = i + 1; j < ROIs.size(); ++j)
-                        invalid(j, i) = 0;
-                }
-                else {
-                    mOutputs(0, n + batchPos * mNbProposals)
-                        = input0(ROIs[i].first[0],
-                                  ROIs[i].first[1],
-                                  ROIs[i].first[2] + 1 * mNbAnchors,
-                                  ROIs[i].first[3]);
-                    mOutputs(1, n + batchPos * mNbProposals)
-                        = input0(ROIs[i].first[0],
-                                  ROIs[i].first[1],
-                                  ROIs[i].first[2] + 2 * mNbAnchors,
-                                  ROIs[i].first[3]);
-                    mOutputs(2, n + batchPos * mNbProposals)
-                        = input0(ROIs[i].first[0],
-                                  ROIs[i].first[1],
-                                  ROIs[i].first[2] + 3 * mNbAnchors,
-                                  ROIs[i].first[3]);
-                    mOutputs(3, n + batchPos * mNbProposals)
-                        = input0(ROIs[i].first[0],
-                                  ROIs[i].first[1],
-                                  ROIs[i].first[2] + 4 * mNbAnchors,
-                                  ROIs[i].first[3]);
-                    mAnchors[n + batchPos * mNbProposals] = ROIs[i].first;
-
-                    ++n;
-                }
+            const std::vector<unsigned int> kept
+                = Nms::nms(boxes, mNMS_IoU_Threshold, mNbProposals);
+
+            for (unsigned int n = 0; n < kept.size(); ++n) {
+                const unsigned int i = kept[n];
+
+                mOutputs(0, n + batchPos * mNbProposals) = boxes.x[i];
+                mOutputs(1, n + batchPos * mNbProposals) = boxes.y[i];
+                mOutputs(2, n + batchPos * mNbProposals) = boxes.w[i];
+                mOutputs(3, n + batchPos * mNbProposals) = boxes.h[i];
+                mAnchors[n + batchPos * mNbProposals] = ROIs[i].first;
             }
 
 /*
@@ -17,10 +17,10 @@
     The fact that you are presently reading this means that you have had
     knowledge of the CeCILL-C license and that you accept its terms.
 */
-
 #include "Cell/ResizeCell_Frame.hpp"
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -60,6 +60,51 @@ void N2D2::ResizeCell_Frame::BilinearInterpolation(const int out_size,
 
 }
 
+void N2D2::ResizeCell_Frame::LinearInterpolation(const int out_size,
+                                                  const int in_size,
+                                                  ResizeCell_Frame_Kernels::PreComputed* interpolation)
+{
+  // Same coordinates mapping as OpenCV resize() with INTER_LINEAR
+  const double scale = in_size / (double)out_size;
+
+  interpolation[out_size].low_index = 0;
+  interpolation[out_size].high_index = 0;
+  for (int i = 0; i < out_size; ++i) {
+    Float_T in = (Float_T)((i + 0.5) * scale - 0.5);
+    int low = (int)std::floor(in);
+    in -= low;
+
+    if (low < 0) {
+      low = 0;
+      in = 0.0;
+    }
+
+    if (low >= in_size - 1) {
+      low = in_size - 1;
+      in = 0.0;
+    }
+
+    interpolation[i].low_index = low;
+    interpolation[i].high_index = std::min(low + 1, in_size - 1);
+    interpolation[i].interpolation = in;
+  }
+}
+
+void N2D2::ResizeCell_Frame::NearestNeighborInterpolation(const int out_size,
+                                                           const int in_size,
+                                                           ResizeCell_Frame_Kernels::PreComputed* interpolation)
+{
+  const Float_T mult = ((Float_T) in_size)/((Float_T) out_size);
+
+  interpolation[out_size].low_index = 0;
+  interpolation[out_size].high_index = 0;
+  for (int i = 0; i < out_size; ++i) {
+    interpolation[i].low_index = static_cast<int>(((std::size_t)i) * mult);
+    interpolation[i].high_index = interpolation[i].low_index;
+    interpolation[i].interpolation = 0.0;
+  }
+}
+
 void N2D2::ResizeCell_Frame::initialize()
 {
     for(unsigned int input = 1; input < mInputs.size(); ++input) {
@@ -70,13 +115,18 @@ void N2D2::ResizeCell_Frame::initialize()
         }
     }
 
+    const unsigned int outputDimX = mOutputs.dimX();
+    const unsigned int outputDimY = mOutputs.dimY();
+    const unsigned int inputDimX = mInputs[0].dimX();
+    const unsigned int inputDimY = mInputs[0].dimY();
+
+    mYStride.resize(outputDimY + 1);
+    mXStride.resize(outputDimX + 1);
+    mDiffYStride.clear();
+    mDiffXStride.clear();
+
     if(mResizeMode == BilinearTF)
     {
-        const unsigned int outputDimX = mOutputs.dimX();
-        const unsigned int outputDimY = mOutputs.dimY();
-        const unsigned int inputDimX = mInputs[0].dimX();
-        const unsigned int inputDimY = mInputs[0].dimY();
-
         mScaleX = (mAlignCorners && outputDimX > 1) ?
                       (inputDimX - 1) / (Float_T) (outputDimX - 1)
                     : (inputDimX) / (Float_T) (outputDimX);
@@ -85,82 +135,52 @@ void N2D2::ResizeCell_Frame::initialize()
                       (inputDimY - 1) / (Float_T) (outputDimY - 1)
                     : (inputDimY) / (Float_T) (outputDimY);
 
-        mYStride.resize(outputDimY + 1);
-        mXStride.resize(outputDimX + 1);
-
         // Compute the cached interpolation weights on the x and y dimensions.
         BilinearInterpolation(outputDimY, inputDimY, mScaleY, mYStride.data());
         BilinearInterpolation(outputDimX, inputDimX, mScaleX, mXStride.data());
     }
     else if (mResizeMode == Bilinear) {
-        throw std::runtime_error("ResizeCell_Frame: Bilinear interpolation is not yet implemented.");
+        mScaleX = (inputDimX) / (Float_T) (outputDimX);
+        mScaleY = (inputDimY) / (Float_T) (outputDimY);
+
+        LinearInterpolation(outputDimY, inputDimY, mYStride.data());
+        LinearInterpolation(outputDimX, inputDimX, mXStride.data());
+    }
+    else if (mResizeMode == NearestNeighbor) {
+        mScaleX = (inputDimX) / (Float_T) (outputDimX);
+        mScaleY = (inputDimY) / (Float_T) (outputDimY);
+
+        NearestNeighborInterpolation(outputDimY, inputDimY, mYStride.data());
+        NearestNeighborInterpolation(outputDimX, inputDimX, mXStride.data());
+
+        mDiffYStride.resize(inputDimY + 1);
+        mDiffXStride.resize(inputDimX + 1);
+
+        NearestNeighborInterpolation(inputDimY, outputDimY,
+                                     mDiffYStride.data());
+        NearestNeighborInterpolation(inputDimX, outputDimX,
+                                     mDiffXStride.data());
     }
+    else
+        throw std::runtime_error("ResizeCell_Frame: Unknown resize mode.");
 }
 
-void N2D2::ResizeCell_Frame::propagate(bool inference)
+void N2D2::ResizeCell_Frame::propagate(bool /*inference*/)
 {
     mInputs.synchronizeDBasedToH();
 
-    switch(mResizeMode) {
-        case Bilinear:
-            throw std::runtime_error("ResizeCell_Frame: Bilinear interpolation is not yet implemented.");
-        case BilinearTF:
-            propagateBilinearTF(inference);
-            break;
-        case NearestNeighbor:
-            propagateNearestNeighbor(inference);
-            break;
-        default:
-            throw std::runtime_error("ResizeCell_Frame: Unknown resize mode.");
-    }
+    unsigned int offset = 0;
 
-    Cell_Frame<Float_T>::propagate();
-    mDiffInputs.clearValid();
-}
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        const Tensor<Float_T>& input = tensor_cast<Float_T>(mInputs[k]);
 
-void N2D2::ResizeCell_Frame::propagateBilinearTF(bool /*inference*/)
-{
-    const Tensor<Float_T>& input = tensor_cast<Float_T>(mInputs[0]);
-
-#pragma omp parallel for if (mOutputs.dimB() > 3)
-    for (int batchPos = 0; batchPos < (int)mOutputs.dimB(); ++batchPos) {
-#pragma omp parallel for if (mOutputs.size() > 2)
-        for(int oy = 0; oy < (int)mOutputs.dimY(); ++oy) {
-            for(std::size_t ox = 0; ox < mOutputs.dimX(); ++ox) {
-                for(std::size_t channel = 0; channel < mOutputs.dimZ(); ++channel) {
-                    const Float_T top_left = input( mXStride[ox].low_index,
-                                                    mYStride[oy].low_index,
-                                                    channel,
-                                                    batchPos);
-                    const Float_T top_right = input( mXStride[ox].high_index,
-                                                        mYStride[oy].low_index,
-                                                        channel,
-                                                        batchPos);
-                    const Float_T bottom_left = input( mXStride[ox].low_index,
-                                                        mYStride[oy].high_index,
-                                                        channel,
-                                                        batchPos);
-                    const Float_T bottom_right = input( mXStride[ox].high_index,
-                                                        mYStride[oy].high_index,
-                                                        channel,
-                                                        batchPos);
-
-                    const Float_T top = top_left
-                                            + (top_right - top_left) * mXStride[ox].interpolation;
-                    const Float_T bottom = bottom_left
-                                            + (bottom_right - bottom_left) * mXStride[ox].interpolation;
-
-                    mOutputs(ox, oy, channel, batchPos)
-                        = top + (bottom - top) * mYStride[oy].interpolation;
-                }
-            }
-        }
+        interpolate(input, 0, mXStride, mYStride, 0.0, mOutputs, offset);
+
+        offset += input.dimZ();
     }
-}
 
-void N2D2::ResizeCell_Frame::propagateNearestNeighbor(bool /*inference*/) {
-    assert(mInputs.size() == 1);
-    nearestNeighbor(tensor_cast_nocopy<Float_T>(mInputs[0]), mOutputs);
+    Cell_Frame<Float_T>::propagate();
+    mDiffInputs.clearValid();
 }
 
 void N2D2::ResizeCell_Frame::backPropagate()
@@ -170,81 +190,191 @@ void N2D2::ResizeCell_Frame::backPropagate()
 
     Cell_Frame<Float_T>::backPropagate();
 
-    switch(mResizeMode) {
-        case Bilinear:
-            throw std::runtime_error("ResizeCell_Frame: Bilinear interpolation is not yet implemented.");
-        case BilinearTF:
-            backPropagateBilinearTF();
-            break;
-        case NearestNeighbor:
-            backPropagateNearestNeighbor();
-            break;
-        default:
-            throw std::runtime_error("ResizeCell_Frame: Unknown resize mode.");
+    unsigned int offset = 0;
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        if (mDiffOutputs[k].empty()) {
+            offset += mInputs[k].dimZ();
+            continue;
+        }
+
+        const Float_T beta = (mDiffOutputs[k].isValid()) ? 1.0 : 0.0;
+
+        Tensor<Float_T> diffOutput = (mDiffOutputs[k].isValid())
+            ? tensor_cast<Float_T>(mDiffOutputs[k])
+            : tensor_cast_nocopy<Float_T>(mDiffOutputs[k]);
+
+        if (mResizeMode == NearestNeighbor) {
+            // Compatible with OpenCV: the gradient is resized back to the
+            // input size
+            interpolate(mDiffInputs, offset, mDiffXStride, mDiffYStride,
+                        beta, diffOutput, 0);
+        }
+        else {
+            interpolateBackward(mDiffInputs, offset, mXStride, mYStride,
+                                beta, diffOutput);
+        }
+
+        mDiffOutputs[k] = diffOutput;
+        mDiffOutputs[k].setValid();
+        offset += mInputs[k].dimZ();
     }
 
-    mDiffOutputs.setValid();
     mDiffOutputs.synchronizeHToD();
 }
 
-void N2D2::ResizeCell_Frame::backPropagateBilinearTF()
+void N2D2::ResizeCell_Frame::interpolate(
+    const Tensor<Float_T>& inputs,
+    unsigned int inputOffset,
+    const std::vector<ResizeCell_Frame_Kernels::PreComputed>& xStride,
+    const std::vector<ResizeCell_Frame_Kernels::PreComputed>& yStride,
+    Float_T beta,
+    Tensor<Float_T>& outputs,
+    unsigned int outputOffset)
 {
-    Tensor<Float_T> diffOutput
-            = tensor_cast_nocopy<Float_T>(mDiffOutputs[0]);
-    for (std::size_t idx = 0; idx < diffOutput.size(); ++idx) {
-        diffOutput(idx) = 0.0f;
+    assert(inputs.dimB() == outputs.dimB());
+
+    const unsigned int inputDimX = inputs.dimX();
+    const unsigned int inputDimY = inputs.dimY();
+    const unsigned int outputDimX = outputs.dimX();
+    const unsigned int outputDimY = outputs.dimY();
+    const unsigned int nbChannels = std::min(inputs.dimZ() - inputOffset,
+                                             outputs.dimZ() - outputOffset);
+    const int nbPlanes = nbChannels * outputs.dimB();
+
+    // Only the input rows referenced by the y table are interpolated
+    std::vector<unsigned int> rows;
+    std::vector<bool> used(inputDimY, false);
+
+    for (unsigned int oy = 0; oy < outputDimY; ++oy) {
+        used[yStride[oy].low_index] = true;
+        used[yStride[oy].high_index] = true;
     }
 
-    #pragma omp parallel for if (mInputs.dimB() > 1)
-    for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-        for (std::size_t oy = 0; oy < mDiffInputs.dimY(); ++oy) {
-            const Float_T in_y = oy * mScaleY;
-            const int top_y_index = (int)(floorf(in_y));
-            const int bottom_y_index =
-                std::min((int)(ceilf(in_y)), (int) (mInputs[0].dimY() - 1) ) ;
-            const Float_T y_lerp = in_y - top_y_index;
-            const Float_T inverse_y_lerp = (1.0f - y_lerp);
-
-            for (std::size_t ox = 0; ox < mDiffInputs.dimX(); ++ox) {
-                const Float_T in_x = ox * mScaleX;
-                const int left_x_index = (int)(floorf(in_x));
-                const int right_x_index = std::min((int)(ceilf(in_x)), (int)(mInputs[0].dimX() - 1));
-                const Float_T x_lerp = in_x - left_x_index;
-                const Float_T inverse_x_lerp = (1.0f - x_lerp);
-
-                #pragma omp parallel for if (mDiffInputs.dimZ() > 2)
-                for (int channel = 0; channel < (int)mDiffInputs.dimZ(); ++channel) {
-                    diffOutput(left_x_index,
-                                    top_y_index,
-                                    channel,
-                                    batchPos) += mDiffInputs(ox, oy, channel, batchPos) * inverse_y_lerp * inverse_x_lerp;
-                    diffOutput(right_x_index,
-                                    top_y_index,
-                                    channel,
-                                    batchPos) += mDiffInputs(ox, oy, channel, batchPos) * inverse_y_lerp * x_lerp;
-                    diffOutput(left_x_index,
-                                    bottom_y_index,
-                                    channel,
-                                    batchPos) += mDiffInputs(ox, oy, channel, batchPos) * y_lerp * inverse_x_lerp;
-                    diffOutput(right_x_index,
-                                    bottom_y_index,
-                                    channel,
-                                    batchPos) += mDiffInputs(ox, oy, channel, batchPos) * y_lerp * x_lerp;
+    for (unsigned int iy = 0; iy < inputDimY; ++iy) {
+        if (used[iy])
+            rows.push_back(iy);
+    }
+
+#pragma omp parallel for if (nbPlanes > 1 && nbPlanes * outputDimX * outputDimY > 1024)
+    for (int plane = 0; plane < nbPlanes; ++plane) {
+        const unsigned int channel = plane % nbChannels;
+        const unsigned int batchPos = plane / nbChannels;
+        const Float_T* input
+            = &inputs(0, 0, inputOffset + channel, batchPos);
+        Float_T* output = &outputs(0, 0, outputOffset + channel, batchPos);
+
+        // 1st pass: interpolation along x of the used input rows
+        std::vector<Float_T> rowsX(inputDimY * outputDimX);
+
+        for (std::vector<unsigned int>::const_iterator it = rows.begin(),
+            itEnd = rows.end(); it != itEnd; ++it)
+        {
+            const Float_T* inputRow = input + (*it) * inputDimX;
+            Float_T* rowX = &rowsX[(*it) * outputDimX];
 
+            for (unsigned int ox = 0; ox < outputDimX; ++ox) {
+                const Float_T left = inputRow[xStride[ox].low_index];
+                const Float_T right = inputRow[xStride[ox].high_index];
+
+                rowX[ox] = left + (right - left) * xStride[ox].interpolation;
+            }
+        }
+
+        // 2nd pass: interpolation along y, contiguous on x
+        for (unsigned int oy = 0; oy < outputDimY; ++oy) {
+            const Float_T* top = &rowsX[yStride[oy].low_index * outputDimX];
+            const Float_T* bottom
+                = &rowsX[yStride[oy].high_index * outputDimX];
+            const Float_T lerp = yStride[oy].interpolation;
+            Float_T* outputRow = output + oy * outputDimX;
+
+            if (beta != 0.0) {
+                for (unsigned int ox = 0; ox < outputDimX; ++ox) {
+                    outputRow[ox] = top[ox] + (bottom[ox] - top[ox]) * lerp
+                        + beta * outputRow[ox];
                 }
             }
+            else {
+                for (unsigned int ox = 0; ox < outputDimX; ++ox)
+                    outputRow[ox] = top[ox] + (bottom[ox] - top[ox]) * lerp;
+            }
         }
     }
-
-    mDiffOutputs[0] = diffOutput;
 }
 
-void N2D2::ResizeCell_Frame::backPropagateNearestNeighbor() {
-    assert(mDiffOutputs.size() == 1);
-    Tensor<Float_T> diffOutput = tensor_cast_nocopy<Float_T>(mDiffOutputs[0]);
-    nearestNeighbor(mDiffInputs, diffOutput);
+void N2D2::ResizeCell_Frame::interpolateBackward(
+    const Tensor<Float_T>& diffInputs,
+    unsigned int diffInputOffset,
+    const std::vector<ResizeCell_Frame_Kernels::PreComputed>& xStride,
+    const std::vector<ResizeCell_Frame_Kernels::PreComputed>& yStride,
+    Float_T beta,
+    Tensor<Float_T>& diffOutputs)
+{
+    assert(diffInputs.dimB() == diffOutputs.dimB());
+
+    const unsigned int inputDimX = diffOutputs.dimX();
+    const unsigned int inputDimY = diffOutputs.dimY();
+    const unsigned int outputDimX = diffInputs.dimX();
+    const unsigned int outputDimY = diffInputs.dimY();
+    const unsigned int nbChannels = diffOutputs.dimZ();
+    const int nbPlanes = nbChannels * diffOutputs.dimB();
+
+#pragma omp parallel for if (nbPlanes > 1 && nbPlanes * outputDimX * outputDimY > 1024)
+    for (int plane = 0; plane < nbPlanes; ++plane) {
+        const unsigned int channel = plane % nbChannels;
+        const unsigned int batchPos = plane / nbChannels;
+        const Float_T* diffInput
+            = &diffInputs(0, 0, diffInputOffset + channel, batchPos);
+        Float_T* diffOutput = &diffOutputs(0, 0, channel, batchPos);
+
+        // 1st pass: scatter along y, contiguous on x
+        std::vector<Float_T> rowsX(inputDimY * outputDimX, 0.0);
+        std::vector<bool> used(inputDimY, false);
+
+        for (unsigned int oy = 0; oy < outputDimY; ++oy) {
+            const unsigned int top = yStride[oy].low_index;
+            const unsigned int bottom = yStride[oy].high_index;
+            const Float_T lerp = yStride[oy].interpolation;
+            const Float_T* diffInputRow = diffInput + oy * outputDimX;
+            Float_T* topRow = &rowsX[top * outputDimX];
+            Float_T* bottomRow = &rowsX[bottom * outputDimX];
+
+            for (unsigned int ox = 0; ox < outputDimX; ++ox)
+                topRow[ox] += diffInputRow[ox] * (1.0f - lerp);
+
+            for (unsigned int ox = 0; ox < outputDimX; ++ox)
+                bottomRow[ox] += diffInputRow[ox] * lerp;
+
+            used[top] = true;
+            used[bottom] = true;
+        }
+
+        // 2nd pass: scatter along x
+        for (unsigned int iy = 0; iy < inputDimY; ++iy) {
+            Float_T* diffOutputRow = diffOutput + iy * inputDimX;
+
+            if (beta != 0.0) {
+                for (unsigned int ix = 0; ix < inputDimX; ++ix)
+                    diffOutputRow[ix] *= beta;
+            }
+            else
+                std::fill(diffOutputRow, diffOutputRow + inputDimX, 0.0f);
+
+            if (!used[iy])
+                continue;
+
+            const Float_T* rowX = &rowsX[iy * outputDimX];
 
-    mDiffOutputs[0] = diffOutput;
+            for (unsigned int ox = 0; ox < outputDimX; ++ox) {
+                const Float_T lerp = xStride[ox].interpolation;
+
+                diffOutputRow[xStride[ox].low_index]
+                    += rowX[ox] * (1.0f - lerp);
+                diffOutputRow[xStride[ox].high_index] += rowX[ox] * lerp;
+            }
+        }
+    }
 }
 
 void N2D2::ResizeCell_Frame::update()
@@ -274,28 +404,3 @@ void N2D2::ResizeCell_Frame::checkGradient(double epsilon, double maxError)
                   << std::endl;
     }
 }
-
-void N2D2::ResizeCell_Frame::nearestNeighbor(const Tensor<Float_T>& inputs, Tensor<Float_T>& outputs) {
-    assert(inputs.dimB() == outputs.dimB());
-    assert(inputs.dimZ() == outputs.dimZ());
-    assert(inputs.nbDims() == outputs.nbDims());
-    assert(inputs.nbDims() == 4);
-
-    const Float_T multy = ((Float_T) inputs.dimY())/((Float_T) outputs.dimY());
-    const Float_T multx = ((Float_T) inputs.dimX())/((Float_T) outputs.dimX());
-
-    #pragma omp parallel for if (outputs.dimB() > 1)
-    for(int batch = 0; batch < (int)outputs.dimB(); batch++) {
-        #pragma omp parallel for if (outputs.dimZ() > 3)
-        for(int channel = 0; channel < (int)outputs.dimZ(); channel++) {
-            for(std::size_t oy = 0; oy < outputs.dimY(); oy++) {
-                for(std::size_t ox = 0; ox < outputs.dimX(); ox++) {
-                    const std::size_t iy = static_cast<std::size_t>(oy*multy);
-                    const std::size_t ix = static_cast<std::size_t>(ox*multx);
-
-                    outputs(ox, oy, channel, batch) = inputs(ix, iy, channel, batch);
-                }
-            }
-        }
-    }
-}
@@ -80,41 +80,55 @@ template <class T>
 void N2D2::SoftmaxCell_Frame<T>::propagate(bool /*inference*/)
 {
     mInputs.synchronizeDBasedToH();
-    const unsigned int groupStride = mGroupSize > 0 ? mGroupSize : getNbOutputs();
+
+    typedef typename Utils::scaling_type<T>::type Acc_T;
+
+    const unsigned int groupStride = mGroupSize > 0 ? mGroupSize
+                                                    : getNbOutputs();
+    const unsigned int nbGroups = getNbOutputs() / groupStride;
+    // Distance between two channels of the same (x, y) position
+    const unsigned int channelStride = mOutputsDims[0] * mOutputsDims[1];
+    const int size = mInputs.dimB() * channelStride;
 
     const Tensor<T>& input = tensor_cast<T>(mInputs[0]);
 
-#pragma omp parallel for if (mInputs.dimB() > 4)
-    for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-        for (unsigned int oy = 0; oy < mOutputsDims[1]; ++oy) {
-            for (unsigned int ox = 0; ox < mOutputsDims[0]; ++ox) {
-                for(unsigned int step = 0; step < getNbOutputs()/groupStride; ++step)
-                {
-                    const unsigned int stride = step*mGroupSize;
-                    const unsigned int nbNeurons = stride + groupStride;
-
-                    T maxVal(input(ox, oy, stride, batchPos));
-
-                    for (unsigned int output = stride + 1; output < nbNeurons; ++output)
-                        maxVal
-                            = std::max(maxVal, input(ox, oy, output, batchPos));
-
-                    // double required for large number of channels
-                    T sum(0.0);
-
-                    for (unsigned int output = stride; output < nbNeurons; ++output)
-                        sum += std::exp(input(ox, oy, output, batchPos) - maxVal);
-
-                    if (sum > T(0.0)) {
-                        for (unsigned int output = stride; output < nbNeurons; ++output)
-                            mOutputs(ox, oy, output, batchPos)
-                                = std::exp(input(ox, oy, output, batchPos)
-                                        - maxVal) / sum;
-                    } else {
-                        for (unsigned int output = stride; output < nbNeurons; ++output)
-                            mOutputs(ox, oy, output, batchPos) = T(0.0);
-                    }
-                }
+#pragma omp parallel for if (size > 16)
+    for (int index = 0; index < size; ++index) {
+        const unsigned int batchPos = index / channelStride;
+        const unsigned int pos = index % channelStride;
+        const T* inputData = &input(0, 0, 0, batchPos) + pos;
+        T* outputData = &mOutputs(0, 0, 0, batchPos) + pos;
+
+        for (unsigned int group = 0; group < nbGroups; ++group) {
+            const unsigned int offset = group * groupStride * channelStride;
+            const T* x = inputData + offset;
+            T* y = outputData + offset;
+
+            Acc_T maxVal = (Acc_T)x[0];
+
+            for (unsigned int output = 1; output < groupStride; ++output) {
+                maxVal = std::max(maxVal,
+                                  (Acc_T)x[output * channelStride]);
+            }
+
+            // Stable log-sum-exp: the exponentials are computed once and
+            // stored in the outputs, before the normalization.
+            // double required for large number of channels
+            double sum = 0.0;
+
+            for (unsigned int output = 0; output < groupStride; ++output) {
+                const Acc_T e = std::exp((Acc_T)x[output * channelStride]
+                                         - maxVal);
+                y[output * channelStride] = (T)e;
+                sum += e;
+            }
+
+            const Acc_T invSum = (sum > 0.0) ? (Acc_T)(1.0 / sum)
+                                             : Acc_T(0.0);
+
+            for (unsigned int output = 0; output < groupStride; ++output) {
+                y[output * channelStride]
+                    = (T)((Acc_T)y[output * channelStride] * invSum);
             }
         }
     }
@@ -128,51 +142,56 @@ void N2D2::SoftmaxCell_Frame<T>::backPropagate()
     if (mDiffOutputs.empty())
         return;
 
-    const unsigned int size = mInputs.dimB() * getNbChannels();
-    const unsigned int groupStride = mGroupSize > 0 ? mGroupSize : getNbOutputs();
+    typedef typename Utils::scaling_type<T>::type Acc_T;
+
+    const unsigned int groupStride = mGroupSize > 0 ? mGroupSize
+                                                    : getNbOutputs();
+    const unsigned int nbGroups = getNbOutputs() / groupStride;
+    const unsigned int channelStride = mOutputsDims[0] * mOutputsDims[1];
+    const int size = mInputs.dimB() * channelStride;
 
-    const T beta((mDiffOutputs[0].isValid()) ? 1.0 : 0.0);
+    const Acc_T beta((mDiffOutputs[0].isValid()) ? 1.0 : 0.0);
 
     Tensor<T> diffOutput = (mDiffOutputs[0].isValid())
         ? tensor_cast<T>(mDiffOutputs[0])
         : tensor_cast_nocopy<T>(mDiffOutputs[0]);
 
-#if defined(_OPENMP) && _OPENMP >= 200805
-#pragma omp parallel for collapse(2) if (size > 16)
-#else
-#pragma omp parallel for if (mInputs.dimB() > 4 && size > 16)
-#endif
-    for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-        for (unsigned int channel = 0; channel < getNbChannels(); ++channel)
-        {
-            for (unsigned int iy = 0; iy < mInputs[0].dimY(); ++iy) {
-                for (unsigned int ix = 0; ix < mInputs[0].dimX(); ++ix) {
-                    if (mWithLoss) {
-                        diffOutput(ix, iy, channel, batchPos)
-                            = mDiffInputs(ix, iy, channel, batchPos)
-                              + beta
-                                * diffOutput(ix, iy, channel, batchPos);
-                    } else {
-                        T gradient(0.0);
-
-                        for(unsigned int step = 0; step < getNbOutputs()/groupStride; ++step)
-                        {
-                            const unsigned int stride = step*mGroupSize;
-                            const unsigned int nbNeurons = stride + groupStride;
-
-                            for (unsigned int output = stride; output < nbNeurons;
-                                ++output) {
-                                gradient += ((output == channel)
-                                            - mOutputs(ix, iy, channel, batchPos))
-                                            * mOutputs(ix, iy, output, batchPos)
-                                            * mDiffInputs(ix, iy, output, batchPos);
-                            }
-                        }
-                        diffOutput(ix, iy, channel, batchPos)
-                            = gradient
-                              + beta
-                                * diffOutput(ix, iy, channel, batchPos);
-                    }
+#pragma omp parallel for if (size > 16)
+    for (int index = 0; index < size; ++index) {
+        const unsigned int batchPos = index / channelStride;
+        const unsigned int pos = index % channelStride;
+        const T* outputData = &mOutputs(0, 0, 0, batchPos) + pos;
+        const T* diffInputData = &mDiffInputs(0, 0, 0, batchPos) + pos;
+        T* diffOutputData = &diffOutput(0, 0, 0, batchPos) + pos;
+
+        for (unsigned int group = 0; group < nbGroups; ++group) {
+            const unsigned int offset = group * groupStride * channelStride;
+            const T* y = outputData + offset;
+            const T* dy = diffInputData + offset;
+            T* dx = diffOutputData + offset;
+
+            if (mWithLoss) {
+                // The diff. inputs are already the gradient of the
+                // cross-entropy loss in respect of the softmax inputs
+                for (unsigned int output = 0; output < groupStride; ++output) {
+                    const unsigned int i = output * channelStride;
+                    dx[i] = (T)((Acc_T)dy[i] + beta * (Acc_T)dx[i]);
+                }
+            }
+            else {
+                // Jacobian product, in O(N):
+                // dx_i = y_i * (dy_i - sum_j(y_j * dy_j))
+                Acc_T dot(0.0);
+
+                for (unsigned int output = 0; output < groupStride; ++output) {
+                    const unsigned int i = output * channelStride;
+                    dot += (Acc_T)y[i] * (Acc_T)dy[i];
+                }
+
+                for (unsigned int output = 0; output < groupStride; ++output) {
+                    const unsigned int i = output * channelStride;
+                    dx[i] = (T)((Acc_T)y[i] * ((Acc_T)dy[i] - dot)
+                                + beta * (Acc_T)dx[i]);
                 }
             }
         }
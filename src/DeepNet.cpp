@@ -25,6 +25,7 @@
 #include "Environment.hpp"
 #include "Monitor.hpp"
 #include "NodeEnv.hpp"
+#include "Cell/AnchorCell.hpp"
 #include "Cell/BatchNormCell.hpp"
 #include "Cell/Cell_CSpike_Top.hpp"
 #include "Cell/Cell_Frame_Top.hpp"
@@ -32,8 +33,13 @@
 #include "Cell/DeconvCell.hpp"
 #include "Cell/ConvCell_Spike.hpp"
 #include "Cell/DropoutCell.hpp"
+#include "Cell/ElemWiseCell.hpp"
 #include "Cell/FcCell.hpp"
+#include "Cell/PaddingCell.hpp"
+#include "Cell/PoolCell.hpp"
 #include "Cell/SoftmaxCell.hpp"
+#include "Activation/LinearActivation.hpp"
+#include "containers/TensorLayout.hpp"
 #include "utils/Utils.hpp"
 #include "Solver/Solver.hpp"
 
@@ -842,6 +848,32 @@ void N2D2::DeepNet::fuseBatchNormWithConv() {
 
         assert(convChilds[0] == cell);
 
+        // An ElemWise computed in place aliases the BatchNorm outputs
+        const std::vector<std::shared_ptr<Cell> > bnChilds
+            = getChildCells(cell->getName());
+        bool inPlaceChild = false;
+
+        for (std::vector<std::shared_ptr<Cell> >::const_iterator itChild
+             = bnChilds.begin(), itChildEnd = bnChilds.end();
+             itChild != itChildEnd; ++itChild)
+        {
+            if (*itChild && (*itChild)->getType() == ElemWiseCell::Type
+                && std::dynamic_pointer_cast<ElemWiseCell>(*itChild)
+                    ->isInPlace())
+            {
+                inPlaceChild = true;
+            }
+        }
+
+        if (inPlaceChild) {
+            std::cout << Utils::cnotice << "  cannot fuse BatchNorm \""
+                << cell->getName() << "\" because its outputs are "
+                "overwritten by an ElemWise computed in place"
+                << Utils::cdef << std::endl;
+
+            continue;
+        }
+
         // OK, Conv's only child is BatchNorm, fuse them...
         std::cout << "  fuse BatchNorm \"" << cell->getName()
             << "\" with Conv \"" << bnParents[0]->getName() << "\""
@@ -923,6 +955,445 @@ void N2D2::DeepNet::fuseBatchNormWithConv() {
     }
 }
 
+void N2D2::DeepNet::fuseElemWiseWithConv() {
+    std::cout << "Fuse ElemWise with Conv..." << std::endl;
+
+    // Layer of each cell, the stimuli provider ("env") being layer 0
+    std::map<std::string, unsigned int> cellLayer;
+
+    for (unsigned int l = 0; l < mLayers.size(); ++l) {
+        for (std::vector<std::string>::const_iterator it = mLayers[l].begin(),
+             itEnd = mLayers[l].end(); it != itEnd; ++it)
+        {
+            cellLayer[*it] = l;
+        }
+    }
+
+    for (auto it = mCells.begin(); it != mCells.end(); ) {
+        // copy, as the cell may be erased from mCells by removeCell()
+        const std::shared_ptr<Cell> cell = (*it).second;
+        ++it; // increase it before being potentially invalided by removeCell()
+
+        if (cell->getType() != ElemWiseCell::Type)
+            continue;
+
+        std::shared_ptr<ElemWiseCell> ewCell =
+            std::dynamic_pointer_cast<ElemWiseCell>(cell);
+
+        if (ewCell->getOperation() != ElemWiseCell::Sum) {
+            std::cout << Utils::cnotice << "  cannot fuse ElemWise \""
+                << cell->getName() << "\" because its operation is not Sum"
+                << Utils::cdef << std::endl;
+            continue;
+        }
+
+        if (ewCell->isInPlace()) {
+            std::cout << Utils::cnotice << "  cannot fuse ElemWise \""
+                << cell->getName() << "\" because it is computed in place"
+                << Utils::cdef << std::endl;
+            continue;
+        }
+
+        bool isTarget = false;
+
+        for (std::vector<std::shared_ptr<Target> >::const_iterator itTarget
+             = mTargets.begin(), itTargetEnd = mTargets.end();
+             itTarget != itTargetEnd; ++itTarget)
+        {
+            if ((*itTarget)->getCell() == cell)
+                isTarget = true;
+        }
+
+        if (isTarget) {
+            std::cout << Utils::cnotice << "  cannot fuse ElemWise \""
+                << cell->getName() << "\" because it is a target cell"
+                << Utils::cdef << std::endl;
+            continue;
+        }
+
+        // The Conv to fuse with must be the only parent in the highest layer,
+        // so that all the other inputs of the sum are computed before it
+        const std::vector<std::shared_ptr<Cell> > ewParents
+            = getParentCells(cell->getName());
+        std::vector<unsigned int> parentLayers;
+        unsigned int maxLayer = 0;
+
+        for (std::vector<std::shared_ptr<Cell> >::const_iterator itParent
+             = ewParents.begin(), itParentEnd = ewParents.end();
+             itParent != itParentEnd; ++itParent)
+        {
+            const unsigned int layer = (*itParent)
+                ? cellLayer[(*itParent)->getName()] : 0;
+
+            parentLayers.push_back(layer);
+            maxLayer = std::max(maxLayer, layer);
+        }
+
+        int convIndex = -1;
+
+        for (unsigned int k = 0; k < ewParents.size(); ++k) {
+            if (parentLayers[k] == maxLayer) {
+                if (convIndex < 0 && ewParents[k]
+                    && ewParents[k]->getType() == ConvCell::Type)
+                {
+                    convIndex = k;
+                }
+                else {
+                    convIndex = -1;
+                    break;
+                }
+            }
+        }
+
+        if (convIndex < 0) {
+            std::cout << Utils::cnotice << "  cannot fuse ElemWise \""
+                << cell->getName() << "\" because its last computed parent "
+                "is not a single Conv" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        const std::shared_ptr<Cell>& parent = ewParents[convIndex];
+
+        if (getChildCells(parent->getName()).size() != 1) {
+            std::cout << Utils::cnotice << "  cannot fuse ElemWise \""
+                << cell->getName() << "\" because parent Conv "
+                "(\"" << parent->getName() << "\") has multiple "
+                "childs" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        std::shared_ptr<ConvCell> convCell =
+            std::dynamic_pointer_cast<ConvCell>(parent);
+        std::shared_ptr<Cell_Frame_Top> convCellTop =
+            std::dynamic_pointer_cast<Cell_Frame_Top>(parent);
+        std::shared_ptr<Cell_Frame_Top> ewCellTop =
+            std::dynamic_pointer_cast<Cell_Frame_Top>(cell);
+
+        if (!convCellTop || !ewCellTop)
+            continue;
+
+        // Inputs of the sum, NULL standing for the Conv outputs
+        std::vector<BaseTensor*> inputs;
+        bool validInputs = true;
+
+        for (unsigned int k = 0; k < ewParents.size(); ++k) {
+            BaseTensor* input = NULL;
+
+            if ((int)k != convIndex) {
+                if (ewParents[k]) {
+                    std::shared_ptr<Cell_Frame_Top> parentTop =
+                        std::dynamic_pointer_cast<Cell_Frame_Top>(ewParents[k]);
+
+                    if (!parentTop) {
+                        validInputs = false;
+                        break;
+                    }
+
+                    input = &parentTop->getOutputs();
+                }
+                else
+                    input = &mStimuliProvider->getData();
+
+                if (input->size() != convCellTop->getOutputs().size()) {
+                    validInputs = false;
+                    break;
+                }
+            }
+
+            inputs.push_back(input);
+        }
+
+        std::vector<Float_T> weights = ewCell->getWeights();
+        std::vector<Float_T> shifts = ewCell->getShifts();
+        weights.resize(inputs.size(), 1.0);
+        shifts.resize(inputs.size(), 0.0);
+
+        if (!validInputs
+            || !convCell->fuseElemWiseSum(inputs, weights, shifts,
+                                          ewCellTop->getActivation()))
+        {
+            std::cout << Utils::cnotice << "  cannot fuse ElemWise \""
+                << cell->getName() << "\" with Conv \"" << parent->getName()
+                << "\" (not supported)" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        std::cout << "  fuse ElemWise \"" << cell->getName()
+            << "\" with Conv \"" << parent->getName() << "\"" << std::endl;
+
+        // Replace ElemWise by Conv for ElemWise childs and ElemWise cell
+        // removal from DeepNet. The other parents of the ElemWise become
+        // parents of the Conv, so that they are still computed before it.
+        const std::vector<std::shared_ptr<Cell> > ewChilds
+            = getChildCells(cell->getName());
+
+        for (std::vector<std::shared_ptr<Cell> >::const_iterator itChild
+             = ewChilds.begin(), itChildEnd = ewChilds.end();
+             itChild != itChildEnd; ++itChild)
+        {
+            std::shared_ptr<Cell_Frame_Top> childCellTop =
+                std::dynamic_pointer_cast<Cell_Frame_Top>(*itChild);
+
+            if (childCellTop) {
+                childCellTop->replaceInput(ewCellTop->getOutputs(),
+                                           convCellTop->getOutputs(),
+                                           convCellTop->getDiffInputs());
+            }
+        }
+
+        removeCell(cell, false);
+
+        for (std::vector<std::shared_ptr<Cell> >::const_iterator itChild
+             = ewChilds.begin(), itChildEnd = ewChilds.end();
+             itChild != itChildEnd; ++itChild)
+        {
+            mParentLayers.insert(std::make_pair((*itChild)->getName(),
+                                                parent->getName()));
+        }
+
+        for (unsigned int k = 0; k < ewParents.size(); ++k) {
+            if ((int)k != convIndex) {
+                mParentLayers.insert(std::make_pair(parent->getName(),
+                    (ewParents[k]) ? ewParents[k]->getName()
+                                   : std::string("env")));
+            }
+        }
+    }
+}
+
+void N2D2::DeepNet::fusePaddingWithConvPool() {
+    std::cout << "Fuse Padding with Conv and Pool..." << std::endl;
+
+    for (auto it = mCells.begin(); it != mCells.end(); ) {
+        // copy, as the cell may be erased from mCells by removeCell()
+        const std::shared_ptr<Cell> cell = (*it).second;
+        ++it; // increase it before being potentially invalided by removeCell()
+
+        if (cell->getType() != PaddingCell::Type)
+            continue;
+
+        std::shared_ptr<PaddingCell> paddingCell =
+            std::dynamic_pointer_cast<PaddingCell>(cell);
+
+        // Conv and Pool only have a symmetric padding
+        if (paddingCell->getLeftPad() != paddingCell->getRightPad()
+            || paddingCell->getTopPad() != paddingCell->getBotPad()
+            || paddingCell->getLeftPad() < 0 || paddingCell->getTopPad() < 0)
+        {
+            std::cout << Utils::cnotice << "  cannot fuse Padding \""
+                << cell->getName() << "\" because it is not a symmetric "
+                "padding" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        bool isTarget = false;
+
+        for (std::vector<std::shared_ptr<Target> >::const_iterator itTarget
+             = mTargets.begin(), itTargetEnd = mTargets.end();
+             itTarget != itTargetEnd; ++itTarget)
+        {
+            if ((*itTarget)->getCell() == cell)
+                isTarget = true;
+        }
+
+        if (isTarget) {
+            std::cout << Utils::cnotice << "  cannot fuse Padding \""
+                << cell->getName() << "\" because it is a target cell"
+                << Utils::cdef << std::endl;
+            continue;
+        }
+
+        // The stimuli provider has no diff. inputs to connect to the child
+        const std::vector<std::shared_ptr<Cell> > paddingParents
+            = getParentCells(cell->getName());
+
+        if (paddingParents.size() != 1 || !paddingParents[0]) {
+            std::cout << Utils::cnotice << "  cannot fuse Padding \""
+                << cell->getName() << "\" because its input is not a single "
+                "cell" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        const std::vector<std::shared_ptr<Cell> > paddingChilds
+            = getChildCells(cell->getName());
+
+        if (paddingChilds.size() != 1
+            || getParentCells(paddingChilds[0]->getName()).size() != 1)
+        {
+            std::cout << Utils::cnotice << "  cannot fuse Padding \""
+                << cell->getName() << "\" because it is not the single input "
+                "of a single child" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        const std::shared_ptr<Cell>& parent = paddingParents[0];
+        const std::shared_ptr<Cell>& child = paddingChilds[0];
+
+        std::shared_ptr<Cell_Frame_Top> paddingCellTop =
+            std::dynamic_pointer_cast<Cell_Frame_Top>(cell);
+        std::shared_ptr<Cell_Frame_Top> parentCellTop =
+            std::dynamic_pointer_cast<Cell_Frame_Top>(parent);
+        std::shared_ptr<Cell_Frame_Top> childCellTop =
+            std::dynamic_pointer_cast<Cell_Frame_Top>(child);
+
+        if (!paddingCellTop || !parentCellTop || !childCellTop)
+            continue;
+
+        bool fused = false;
+
+        if (child->getType() == ConvCell::Type) {
+            fused = std::dynamic_pointer_cast<ConvCell>(child)->fusePadding(
+                paddingCell->getLeftPad(), paddingCell->getTopPad());
+        }
+        else if (child->getType() == PoolCell::Type) {
+            fused = std::dynamic_pointer_cast<PoolCell>(child)->fusePadding(
+                paddingCell->getLeftPad(), paddingCell->getTopPad());
+        }
+
+        if (!fused) {
+            std::cout << Utils::cnotice << "  cannot fuse Padding \""
+                << cell->getName() << "\" with \"" << child->getName()
+                << "\" (not supported)" << Utils::cdef << std::endl;
+            continue;
+        }
+
+        std::cout << "  fuse Padding \"" << cell->getName() << "\" with \""
+            << child->getName() << "\"" << std::endl;
+
+        // Padding cell removal from DeepNet, its child reading directly the
+        // outputs of its parent
+        removeCell(cell, true);
+    }
+}
+
+void N2D2::DeepNet::setElemWiseInPlace(bool inference) {
+    std::cout << "Set ElemWise in place..." << std::endl;
+
+    for (std::map<std::string, std::shared_ptr<Cell> >::const_iterator it
+         = mCells.begin(), itEnd = mCells.end(); it != itEnd; ++it)
+    {
+        const std::shared_ptr<Cell>& cell = (*it).second;
+
+        if (cell->getType() != ElemWiseCell::Type)
+            continue;
+
+        std::shared_ptr<ElemWiseCell> ewCell =
+            std::dynamic_pointer_cast<ElemWiseCell>(cell);
+        std::shared_ptr<Cell_Frame_Top> ewCellTop =
+            std::dynamic_pointer_cast<Cell_Frame_Top>(cell);
+
+        if (ewCell->getOperation() != ElemWiseCell::Sum || !ewCellTop)
+            continue;
+
+        std::vector<std::shared_ptr<Target> >::const_iterator itTarget
+            = mTargets.begin();
+
+        for (; itTarget != mTargets.end(); ++itTarget) {
+            if ((*itTarget)->getCell() == cell)
+                break;
+        }
+
+        // Targets directly access the cell own outputs
+        if (itTarget != mTargets.end())
+            continue;
+
+        const std::vector<std::shared_ptr<Cell> > ewParents
+            = getParentCells(cell->getName());
+
+        for (unsigned int k = 0; k < ewParents.size(); ++k) {
+            const std::shared_ptr<Cell>& parent = ewParents[k];
+
+            // The stimuli provider data cannot be overwritten
+            if (!parent || std::count(ewParents.begin(), ewParents.end(),
+                                      parent) > 1)
+            {
+                continue;
+            }
+
+            // The parent outputs must have no other consumer
+            if (getChildCells(parent->getName()).size() != 1)
+                continue;
+
+            for (itTarget = mTargets.begin(); itTarget != mTargets.end();
+                ++itTarget)
+            {
+                if ((*itTarget)->getCell() == parent)
+                    break;
+            }
+
+            if (itTarget != mTargets.end())
+                continue;
+
+            if (!inference) {
+                // The parent back-propagation must not read its outputs,
+                // which are overwritten by the Sum
+                const std::string parentType = parent->getType();
+
+                if (parentType != ConvCell::Type
+                    && parentType != FcCell::Type
+                    && parentType != BatchNormCell::Type
+                    && parentType != ElemWiseCell::Type)
+                {
+                    continue;
+                }
+
+                if (parentType == ElemWiseCell::Type
+                    && std::dynamic_pointer_cast<ElemWiseCell>(parent)
+                        ->getOperation() != ElemWiseCell::Sum)
+                {
+                    continue;
+                }
+
+                std::shared_ptr<Cell_Frame_Top> parentTop =
+                    std::dynamic_pointer_cast<Cell_Frame_Top>(parent);
+
+                if (!parentTop)
+                    continue;
+
+                const std::shared_ptr<Activation>& activation
+                    = parentTop->getActivation();
+
+                if (activation
+                    && (activation->getType() != LinearActivation::Type
+                        || activation->getParameter<unsigned int>(
+                                                "QuantizationLevels") > 0
+                        || activation->getParameter<double>("Clipping")
+                                                                    != 0.0))
+                {
+                    continue;
+                }
+            }
+
+            BaseTensor& outputs = ewCellTop->getOutputs();
+
+            if (ewCell->setInPlace(k)) {
+                std::cout << "  compute ElemWise \"" << cell->getName()
+                    << "\" in place of \"" << parent->getName() << "\""
+                    << std::endl;
+
+                const std::vector<std::shared_ptr<Cell> > ewChilds
+                    = getChildCells(cell->getName());
+
+                for (std::vector<std::shared_ptr<Cell> >::const_iterator
+                     itChild = ewChilds.begin(), itChildEnd = ewChilds.end();
+                     itChild != itChildEnd; ++itChild)
+                {
+                    std::shared_ptr<Cell_Frame_Top> childCellTop =
+                        std::dynamic_pointer_cast<Cell_Frame_Top>(*itChild);
+
+                    if (childCellTop) {
+                        childCellTop->replaceInput(outputs,
+                                                ewCellTop->getOutputs(),
+                                                ewCellTop->getDiffInputs());
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+}
+
 void N2D2::DeepNet::removeDropout() {
     std::cout << "Remove Dropout..." << std::endl;
 
@@ -943,6 +1414,305 @@ void N2D2::DeepNet::removeDropout() {
     }
 }
 
+void N2D2::DeepNet::keepConvDataLayouts() {
+    // Conv cells whose childs are all Conv cells accepting their DataLayout
+    // keep their outputs in this layout in inference, instead of converting
+    // them back and forth to NCHW
+    for (std::map<std::string, std::shared_ptr<Cell> >::const_iterator it
+         = mCells.begin(), itEnd = mCells.end(); it != itEnd; ++it)
+    {
+        const std::shared_ptr<Cell>& cell = (*it).second;
+
+        if (cell->getType() != ConvCell::Type)
+            continue;
+
+        std::shared_ptr<ConvCell> convCell =
+            std::dynamic_pointer_cast<ConvCell>(cell);
+        const TensorLayout::Layout layout = convCell->getDataLayout();
+
+        if (layout == TensorLayout::NCHW)
+            continue;
+
+        // Outputs read outside of the cells graph stay in the NCHW layout:
+        // targets and monitors
+        bool keep = (mMonitors.find(cell->getName()) == mMonitors.end());
+
+        for (std::vector<std::shared_ptr<Target> >::const_iterator itTarget
+             = mTargets.begin(), itTargetEnd = mTargets.end();
+             itTarget != itTargetEnd; ++itTarget)
+        {
+            if ((*itTarget)->getCell() == cell)
+                keep = false;
+        }
+
+        const std::vector<std::shared_ptr<Cell> > convChilds
+            = getChildCells(cell->getName());
+
+        if (convChilds.empty())
+            keep = false;
+
+        for (std::vector<std::shared_ptr<Cell> >::const_iterator itChild
+             = convChilds.begin(), itChildEnd = convChilds.end();
+             itChild != itChildEnd; ++itChild)
+        {
+            if ((*itChild)->getType() != ConvCell::Type
+                || std::dynamic_pointer_cast<ConvCell>(*itChild)
+                        ->getDataLayout() != layout)
+            {
+                keep = false;
+            }
+        }
+
+        if (keep && convCell->keepOutputsLayout(true)) {
+            std::cout << "  keep the " << layout << " outputs of Conv \""
+                << cell->getName() << "\"" << std::endl;
+        }
+    }
+}
+
+void N2D2::DeepNet::planInferenceMemory() {
+    std::cout << "Plan inference memory..." << std::endl;
+
+    // Cells schedule, as in test()
+    std::map<std::string, unsigned int> steps;
+    unsigned int nbSteps = 0;
+
+    for (unsigned int l = 1; l < mLayers.size(); ++l) {
+        for (std::vector<std::string>::const_iterator itCell
+             = mLayers[l].begin(), itCellEnd = mLayers[l].end();
+             itCell != itCellEnd; ++itCell)
+        {
+            steps[*itCell] = nbSteps++;
+        }
+    }
+
+    // Outputs lifetime, in steps. The same outputs tensor may be shared by
+    // several cells (ElemWise in place).
+    struct Lifetime {
+        Tensor<Float_T>* tensor;
+        size_t size;
+        unsigned int first;
+        unsigned int last;
+        bool pinned;
+        size_t offset;
+    };
+
+    // Sizes are padded to multiples of 64 bytes, so that the offsets are
+    // multiples of 64 bytes from the arena base (which is only aligned as
+    // malloc() is)
+    const size_t alignment = 64 / sizeof(Float_T);
+
+    std::vector<Lifetime> lifetimes;
+    std::map<Tensor<Float_T>*, unsigned int> lifetimesIdx;
+    std::vector<Tensor<Float_T>*> diffInputs;
+    std::vector<Tensor<Float_T>*> pinnedDiffInputs;
+
+    for (std::map<std::string, unsigned int>::const_iterator it
+         = steps.begin(), itEnd = steps.end(); it != itEnd; ++it)
+    {
+        const std::map<std::string, std::shared_ptr<Cell> >::const_iterator
+            itCell = mCells.find((*it).first);
+
+        if (itCell == mCells.end())
+            continue;
+
+        const std::shared_ptr<Cell>& cell = (*itCell).second;
+        std::shared_ptr<Cell_Frame_Top> cellFrame
+            = std::dynamic_pointer_cast<Cell_Frame_Top>(cell);
+
+        if (!cellFrame || cellFrame->isCuda())
+            continue;
+
+        Tensor<Float_T>* outputs
+            = dynamic_cast<Tensor<Float_T>*>(&cellFrame->getOutputs());
+        Tensor<Float_T>* diff
+            = dynamic_cast<Tensor<Float_T>*>(&cellFrame->getDiffInputs());
+
+        if (outputs == NULL || outputs->size() == 0)
+            continue;
+
+        // Outputs read outside of the cells graph keep their own memory:
+        // targets and monitors, and anchors queried by the targets
+        bool pinned = (mMonitors.find(cell->getName()) != mMonitors.end()
+                       || cell->getType() == AnchorCell::Type);
+
+        for (std::vector<std::shared_ptr<Target> >::const_iterator itTarget
+             = mTargets.begin(), itTargetEnd = mTargets.end();
+             itTarget != itTargetEnd; ++itTarget)
+        {
+            if ((*itTarget)->getCell() == cell)
+                pinned = true;
+        }
+
+        std::map<Tensor<Float_T>*, unsigned int>::iterator itIdx
+            = lifetimesIdx.find(outputs);
+
+        if (itIdx == lifetimesIdx.end()) {
+            const Lifetime lifetime = {outputs, outputs->size(),
+                                       (*it).second, (*it).second, pinned, 0};
+
+            itIdx = lifetimesIdx.insert(
+                std::make_pair(outputs, lifetimes.size())).first;
+            lifetimes.push_back(lifetime);
+        }
+        else {
+            Lifetime& lifetime = lifetimes[(*itIdx).second];
+            lifetime.first = std::min(lifetime.first, (*it).second);
+            lifetime.last = std::max(lifetime.last, (*it).second);
+            lifetime.pinned = lifetime.pinned || pinned;
+        }
+
+        // The diff. inputs are not used for inference
+        if (diff != NULL && diff->size() > 0) {
+            if (pinned)
+                pinnedDiffInputs.push_back(diff);
+            else
+                diffInputs.push_back(diff);
+        }
+    }
+
+    // The outputs are live until their last consumer
+    for (std::multimap<std::string, std::string>::const_iterator it
+         = mParentLayers.begin(), itEnd = mParentLayers.end(); it != itEnd;
+         ++it)
+    {
+        const std::map<std::string, std::shared_ptr<Cell> >::const_iterator
+            itParent = mCells.find((*it).second);
+        const std::map<std::string, unsigned int>::const_iterator itStep
+            = steps.find((*it).first);
+
+        if (itParent == mCells.end() || itStep == steps.end())
+            continue;
+
+        std::shared_ptr<Cell_Frame_Top> parentFrame
+            = std::dynamic_pointer_cast<Cell_Frame_Top>((*itParent).second);
+
+        if (!parentFrame)
+            continue;
+
+        const std::map<Tensor<Float_T>*, unsigned int>::const_iterator itIdx
+            = lifetimesIdx.find(
+                dynamic_cast<Tensor<Float_T>*>(&parentFrame->getOutputs()));
+
+        if (itIdx != lifetimesIdx.end()) {
+            Lifetime& lifetime = lifetimes[(*itIdx).second];
+            lifetime.last = std::max(lifetime.last, (*itStep).second);
+        }
+    }
+
+    // Interval packing, largest outputs first: each outputs tensor is placed
+    // in the smallest gap left by the outputs live at the same time
+    std::vector<unsigned int> order;
+
+    for (unsigned int i = 0; i < lifetimes.size(); ++i) {
+        if (!lifetimes[i].pinned)
+            order.push_back(i);
+    }
+
+    std::stable_sort(order.begin(), order.end(),
+        [&lifetimes](unsigned int i, unsigned int j)
+            { return (lifetimes[i].size > lifetimes[j].size); });
+
+    std::vector<unsigned int> placed;
+    size_t totalSize = 0;
+    size_t arenaSize = 0;
+
+    for (std::vector<unsigned int>::const_iterator it = order.begin(),
+         itEnd = order.end(); it != itEnd; ++it)
+    {
+        Lifetime& lifetime = lifetimes[*it];
+        const size_t size = alignment
+            * ((lifetime.size + alignment - 1) / alignment);
+
+        std::vector<std::pair<size_t, size_t> > ranges;
+
+        for (std::vector<unsigned int>::const_iterator itPlaced
+             = placed.begin(), itPlacedEnd = placed.end();
+             itPlaced != itPlacedEnd; ++itPlaced)
+        {
+            const Lifetime& other = lifetimes[*itPlaced];
+
+            if (other.first <= lifetime.last && lifetime.first <= other.last) {
+                ranges.push_back(std::make_pair(other.offset,
+                                                other.offset + other.size));
+            }
+        }
+
+        std::sort(ranges.begin(), ranges.end());
+
+        size_t end = 0;
+        size_t bestGap = std::numeric_limits<size_t>::max();
+        bool fit = false;
+
+        for (std::vector<std::pair<size_t, size_t> >::const_iterator itRange
+             = ranges.begin(), itRangeEnd = ranges.end();
+             itRange != itRangeEnd; ++itRange)
+        {
+            if ((*itRange).first >= end + size
+                && (*itRange).first - end < bestGap)
+            {
+                bestGap = (*itRange).first - end;
+                lifetime.offset = end;
+                fit = true;
+            }
+
+            end = std::max(end, (*itRange).second);
+        }
+
+        if (!fit)
+            lifetime.offset = end;
+
+        lifetime.size = size;
+        totalSize += size;
+        arenaSize = std::max(arenaSize, lifetime.offset + size);
+        placed.push_back(*it);
+    }
+
+    // Bind the outputs to the shared arena
+    Tensor<Float_T> arena({arenaSize});
+
+    for (std::vector<unsigned int>::const_iterator it = placed.begin(),
+         itEnd = placed.end(); it != itEnd; ++it)
+    {
+        lifetimes[*it].tensor->bindData(arena, lifetimes[*it].offset);
+    }
+
+    // All the diff. inputs can share the same memory
+    size_t diffSize = 0;
+    size_t diffTotalSize = 0;
+
+    for (std::vector<Tensor<Float_T>*>::iterator it = diffInputs.begin();
+         it != diffInputs.end(); )
+    {
+        if (std::find(pinnedDiffInputs.begin(), pinnedDiffInputs.end(), *it)
+                != pinnedDiffInputs.end()
+            || std::find(diffInputs.begin(), it, *it) != it)
+        {
+            it = diffInputs.erase(it);
+            continue;
+        }
+
+        diffSize = std::max(diffSize, (*it)->size());
+        diffTotalSize += (*it)->size();
+        ++it;
+    }
+
+    Tensor<Float_T> diffArena({diffSize});
+
+    for (std::vector<Tensor<Float_T>*>::const_iterator it
+         = diffInputs.begin(), itEnd = diffInputs.end(); it != itEnd; ++it)
+    {
+        (*it)->bindData(diffArena);
+    }
+
+    std::cout << "  " << placed.size() << " outputs: "
+        << (totalSize * sizeof(Float_T) / 1024) << " kB -> "
+        << (arenaSize * sizeof(Float_T) / 1024) << " kB\n"
+        << "  " << diffInputs.size() << " diff. inputs: "
+        << (diffTotalSize * sizeof(Float_T) / 1024) << " kB -> "
+        << (diffSize * sizeof(Float_T) / 1024) << " kB" << std::endl;
+}
+
 void N2D2::DeepNet::logOutputs(const std::string& dirName,
                                unsigned int batchPos) const
 {
@@ -2252,7 +3022,11 @@ void init_DeepNet(py::module &m) {
     .def("initializeCMonitors", &DeepNet::initializeCMonitors, py::arg("nbTimesteps"))
     .def("spikeCodingCompare", &DeepNet::spikeCodingCompare, py::arg("dirName"), py::arg("idx"))
     .def("fuseBatchNormWithConv", &DeepNet::fuseBatchNormWithConv)
+    .def("fuseElemWiseWithConv", &DeepNet::fuseElemWiseWithConv)
+    .def("fusePaddingWithConvPool", &DeepNet::fusePaddingWithConvPool)
     .def("removeDropout", &DeepNet::removeDropout)
+    .def("keepConvDataLayouts", &DeepNet::keepConvDataLayouts)
+    .def("planInferenceMemory", &DeepNet::planInferenceMemory)
     .def("setDatabase", &DeepNet::setDatabase, py::arg("database"))
     .def("setStimuliProvider", &DeepNet::setStimuliProvider, py::arg("sp"))
     .def("getDatabase", &DeepNet::getDatabase)
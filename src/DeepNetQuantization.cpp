@@ -385,6 +385,12 @@ void N2D2::DeepNetQuantization::quantizeNormalizedNetwork(std::size_t nbBits,
         // Must come after approximateRescalings as the approximation may modify the weights
         // if the actScalingMode is SINGLE_SHIFT or DOUBLE_SHIFT
         quantizeFreeParemeters(*cell, nbBits);
+
+        // The weights now fit in 8 bits integers: use the integer kernels
+        // of the cells that have them in inference
+        if(nbBits <= 8 && cell->isParameter("QuantizedInference")) {
+            cell->setParameter("QuantizedInference", true);
+        }
     }
 }
 
@@ -167,8 +167,9 @@ N2D2::Tensor<T>::Tensor(const std::vector<size_t>& dims,
                         const std::shared_ptr<bool>& valid,
                         size_t dataOffset,
                         size_t size,
-                        size_t sizeM1)
-    : BaseTensor(dims, valid, size, sizeM1),
+                        size_t sizeM1,
+                        const std::shared_ptr<TensorLayout::Layout>& layout)
+    : BaseTensor(dims, valid, size, sizeM1, layout),
       mData(data),
       mDataOffset(dataOffset)
 {
@@ -535,6 +536,18 @@ void N2D2::Tensor<T>::swap(Tensor<T>& tensor)
     assert((*tensor.mData)().size() == tensor.size());
 }
 
+template <class T>
+void N2D2::Tensor<T>::bindData(const Tensor<T>& storage, size_t offset)
+{
+    if (storage.mDataOffset + offset + size() > (*storage.mData)().size()) {
+        throw std::runtime_error("Tensor<T>::bindData(): storage is too small"
+                                 " for the tensor.");
+    }
+
+    mData = storage.mData;
+    mDataOffset = storage.mDataOffset + offset;
+}
+
 template <class T>
 N2D2::Tensor<T> N2D2::Tensor<T>::clone() const {
     return Tensor<T>(mDims,
@@ -543,7 +556,8 @@ N2D2::Tensor<T> N2D2::Tensor<T>::clone() const {
                      mValid,
                      0,
                      mSize,
-                     mSizeM1);
+                     mSizeM1,
+                     std::make_shared<TensorLayout::Layout>(*mLayout));
 }
 
 template <class T>
@@ -553,7 +567,8 @@ N2D2::Tensor<T> N2D2::Tensor<T>::operator[](size_t i)
     std::vector<size_t> newDims = mDims;
     newDims.pop_back();
     return Tensor<T>(newDims, mData, mValid, mDataOffset + i * mSizeM1,
-                mSizeM1, (newDims.back() > 0) ? mSizeM1 / newDims.back() : 0);
+                mSizeM1, (newDims.back() > 0) ? mSizeM1 / newDims.back() : 0,
+                mLayout);
 }
 
 template <class T>
@@ -563,7 +578,8 @@ const N2D2::Tensor<T> N2D2::Tensor<T>::operator[](size_t i) const
     std::vector<size_t> newDims = mDims;
     newDims.pop_back();
     return Tensor<T>(newDims, mData, mValid, mDataOffset + i * mSizeM1,
-                mSizeM1, (newDims.back() > 0) ? mSizeM1 / newDims.back() : 0);
+                mSizeM1, (newDims.back() > 0) ? mSizeM1 / newDims.back() : 0,
+                mLayout);
 }
 
 template <class T>
@@ -576,7 +592,7 @@ N2D2::Tensor<T> N2D2::Tensor<T>::rows(size_t j0,
     std::vector<size_t> newDims = mDims;
     newDims.back() = nb;
     return Tensor<T>(newDims, mData, mValid, mDataOffset + j0 * mSizeM1,
-                     nb * mSizeM1, mSizeM1);
+                     nb * mSizeM1, mSizeM1, mLayout);
 }
 
 template <class T>
@@ -589,7 +605,7 @@ const N2D2::Tensor<T> N2D2::Tensor<T>::rows(size_t j0,
     std::vector<size_t> newDims = mDims;
     newDims.back() = nb;
     return Tensor<T>(newDims, mData, mValid, mDataOffset + j0 * mSizeM1,
-                     nb * mSizeM1, mSizeM1);
+                     nb * mSizeM1, mSizeM1, mLayout);
 }
 
 template <class T>
@@ -855,6 +871,7 @@ template class N2D2::Tensor<double>;
 template class N2D2::Tensor<half_float::half>;
 template class N2D2::Tensor<bool>;
 template class N2D2::Tensor<char>;
+template class N2D2::Tensor<signed char>;
 template class N2D2::Tensor<unsigned char>;
 template class N2D2::Tensor<short>;
 template class N2D2::Tensor<unsigned short>;
@@ -0,0 +1,174 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "containers/TensorLayout.hpp"
+#include "third_party/half.hpp"
+
+unsigned int N2D2::TensorLayout::blockSize(Layout layout)
+{
+    return (layout == NCHW8c) ? 8
+         : (layout == NCHW16c) ? 16
+         : 1;
+}
+
+std::vector<size_t>
+N2D2::TensorLayout::dims(const std::vector<size_t>& dims, Layout layout)
+{
+    if (dims.size() != 4) {
+        throw std::domain_error("TensorLayout::dims(): only 4D tensors are"
+                                " supported.");
+    }
+
+    if (layout == NCHW)
+        return dims;
+    else if (layout == NHWC)
+        return std::vector<size_t>({dims[2], dims[0], dims[1], dims[3]});
+    else {
+        const size_t c = blockSize(layout);
+
+        return std::vector<size_t>({c, dims[0], dims[1],
+                                    (dims[2] + c - 1) / c, dims[3]});
+    }
+}
+
+template <class T>
+void N2D2::TensorLayout::toLayout(const Tensor<T>& tensor,
+                                  Layout layout,
+                                  Tensor<T>& dst)
+{
+    dst.resize(dims(tensor.dims(), layout));
+
+    if (layout == NCHW) {
+        std::copy(tensor.begin(), tensor.end(), dst.begin());
+        return;
+    }
+
+    const unsigned int nbChannels = tensor.dimZ();
+    const unsigned int c = blockSize(layout);
+    // Number of channels (zero-padded in the blocked layouts)
+    const unsigned int dstChannels = (layout == NHWC) ? nbChannels
+        : c * ((nbChannels + c - 1) / c);
+    const unsigned int size = tensor.dimB() * tensor.dimY();
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (tensor.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)tensor.dimB(); ++batchPos) {
+        for (unsigned int y = 0; y < tensor.dimY(); ++y) {
+            for (unsigned int x = 0; x < tensor.dimX(); ++x) {
+                for (unsigned int channel = 0; channel < dstChannels;
+                     ++channel)
+                {
+                    const T value = (channel < nbChannels)
+                        ? tensor(x, y, channel, batchPos) : T(0.0);
+
+                    if (layout == NHWC)
+                        dst(channel, x, y, batchPos) = value;
+                    else {
+                        dst(channel % c, x, y, channel / c, batchPos)
+                            = value;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void N2D2::TensorLayout::fromLayout(const Tensor<T>& tensor,
+                                    Layout layout,
+                                    Tensor<T>& dst)
+{
+    if (tensor.dims() != dims(dst.dims(), layout)) {
+        throw std::domain_error("TensorLayout::fromLayout(): tensor"
+                                " dimensions do not match the destination"
+                                " dimensions in this layout.");
+    }
+
+    if (layout == NCHW) {
+        std::copy(tensor.begin(), tensor.end(), dst.begin());
+        return;
+    }
+
+    const unsigned int c = blockSize(layout);
+    const unsigned int size = dst.dimB() * dst.dimZ();
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) if (size > 16)
+#else
+#pragma omp parallel for if (dst.dimB() > 4 && size > 16)
+#endif
+    for (int batchPos = 0; batchPos < (int)dst.dimB(); ++batchPos) {
+        for (unsigned int channel = 0; channel < dst.dimZ(); ++channel) {
+            for (unsigned int y = 0; y < dst.dimY(); ++y) {
+                for (unsigned int x = 0; x < dst.dimX(); ++x) {
+                    dst(x, y, channel, batchPos) = (layout == NHWC)
+                        ? tensor(channel, x, y, batchPos)
+                        : tensor(channel % c, x, y, channel / c, batchPos);
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+N2D2::Tensor<T> N2D2::TensorLayout::view(const Tensor<T>& tensor)
+{
+    Tensor<T> layoutTensor = tensor;
+
+    if (tensor.getLayout() != NCHW)
+        layoutTensor.reshape(dims(tensor.dims(), tensor.getLayout()));
+
+    return layoutTensor;
+}
+
+namespace N2D2 {
+    template void TensorLayout::toLayout<half_float::half>(
+        const Tensor<half_float::half>& tensor,
+        Layout layout,
+        Tensor<half_float::half>& dst);
+    template void TensorLayout::toLayout<float>(const Tensor<float>& tensor,
+                                                Layout layout,
+                                                Tensor<float>& dst);
+    template void TensorLayout::toLayout<double>(const Tensor<double>& tensor,
+                                                 Layout layout,
+                                                 Tensor<double>& dst);
+
+    template void TensorLayout::fromLayout<half_float::half>(
+        const Tensor<half_float::half>& tensor,
+        Layout layout,
+        Tensor<half_float::half>& dst);
+    template void TensorLayout::fromLayout<float>(const Tensor<float>& tensor,
+                                                  Layout layout,
+                                                  Tensor<float>& dst);
+    template void TensorLayout::fromLayout<double>(
+        const Tensor<double>& tensor,
+        Layout layout,
+        Tensor<double>& dst);
+
+    template Tensor<half_float::half> TensorLayout::view<half_float::half>(
+        const Tensor<half_float::half>& tensor);
+    template Tensor<float> TensorLayout::view<float>(
+        const Tensor<float>& tensor);
+    template Tensor<double> TensorLayout::view<double>(
+        const Tensor<double>& tensor);
+}
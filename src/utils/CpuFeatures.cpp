@@ -0,0 +1,76 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <algorithm>
+
+#ifdef __GNUC__
+#include <cpuid.h>
+#endif
+
+#include "utils/CpuFeatures.hpp"
+#include "utils/SimdMath.hpp"
+
+namespace {
+    N2D2::CpuFeatures::InstructionSet detectInstructionSet()
+    {
+#ifdef N2D2_SIMD
+        // __builtin_cpu_supports() also checks that the OS saves the AVX and
+        // AVX-512 registers (XCR0)
+        __builtin_cpu_init();
+
+        // F16C (CPUID.1:ECX), available on every AVX2 CPU, is required for
+        // the AVX2 half precision conversions
+        unsigned int eax, ebx, ecx = 0, edx;
+        const bool f16c = (__get_cpuid(1, &eax, &ebx, &ecx, &edx)
+                           && (ecx & bit_F16C));
+
+        if (__builtin_cpu_supports("avx512f") && f16c)
+            return N2D2::CpuFeatures::AVX512;
+        else if (__builtin_cpu_supports("avx2")
+                 && __builtin_cpu_supports("fma") && f16c)
+        {
+            return N2D2::CpuFeatures::AVX2;
+        }
+        else if (__builtin_cpu_supports("sse4.1"))
+            return N2D2::CpuFeatures::SSE4;
+#endif
+
+        return N2D2::CpuFeatures::Scalar;
+    }
+
+    N2D2::CpuFeatures::InstructionSet maxInstructionSet
+        = N2D2::CpuFeatures::AVX512;
+}
+
+N2D2::CpuFeatures::InstructionSet N2D2::CpuFeatures::detect()
+{
+    static const InstructionSet instructionSet = detectInstructionSet();
+    return instructionSet;
+}
+
+N2D2::CpuFeatures::InstructionSet N2D2::CpuFeatures::getInstructionSet()
+{
+    return std::min(detect(), maxInstructionSet);
+}
+
+void N2D2::CpuFeatures::setMaxInstructionSet(InstructionSet instructionSet)
+{
+    maxInstructionSet = instructionSet;
+}
@@ -0,0 +1,447 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "third_party/half.hpp"
+#include "utils/Gemm.hpp"
+#include "utils/HalfConversion.hpp"
+
+namespace {
+    // Register block (micro-kernel size)
+    const std::size_t MR = 4;
+    const std::size_t NR = 8;
+    // Cache blocks
+    const std::size_t MC = 64;
+    const std::size_t NC = 64;
+    const std::size_t KC = 256;
+
+    // Below this number of multiply-add, OpenMP is not used
+    const std::size_t PARALLEL_THRESHOLD = 32768;
+
+    /// Pack the rows [0, M[ and columns [k0, k0 + kc[ of op(A) in panels of
+    /// MR rows, zero-padded: packedA[panel][k][MR]
+    template <class T>
+    void packA(N2D2::Gemm::Transpose transA,
+               std::size_t M,
+               std::size_t k0,
+               std::size_t kc,
+               const T* A,
+               std::size_t lda,
+               T* packedA)
+    {
+        const int nbPanels = (int)((M + MR - 1) / MR);
+
+#pragma omp parallel for if (nbPanels > 1 && M * kc > PARALLEL_THRESHOLD)
+        for (int panel = 0; panel < nbPanels; ++panel) {
+            T* dst = packedA + panel * kc * MR;
+            const std::size_t i0 = panel * MR;
+
+            for (std::size_t k = 0; k < kc; ++k) {
+                for (std::size_t ir = 0; ir < MR; ++ir) {
+                    const std::size_t i = i0 + ir;
+
+                    dst[k * MR + ir] = (i < M)
+                        ? ((transA == N2D2::Gemm::Trans)
+                            ? A[(k0 + k) * lda + i]
+                            : A[i * lda + k0 + k])
+                        : T(0.0);
+                }
+            }
+        }
+    }
+
+    /// Pack the rows [k0, k0 + kc[ and columns [j0, j0 + nc[ of op(B) in
+    /// panels of NR columns, zero-padded: packedB[panel][k][NR]
+    template <class T>
+    void packB(N2D2::Gemm::Transpose transB,
+               std::size_t j0,
+               std::size_t nc,
+               std::size_t k0,
+               std::size_t kc,
+               const T* B,
+               std::size_t ldb,
+               T* packedB)
+    {
+        const int nbPanels = (int)((nc + NR - 1) / NR);
+
+#pragma omp parallel for if (nbPanels > 1 && nc * kc > PARALLEL_THRESHOLD)
+        for (int panel = 0; panel < nbPanels; ++panel) {
+            T* dst = packedB + panel * kc * NR;
+            const std::size_t jp = panel * NR;
+
+            for (std::size_t k = 0; k < kc; ++k) {
+                for (std::size_t jr = 0; jr < NR; ++jr) {
+                    const std::size_t j = jp + jr;
+
+                    dst[k * NR + jr] = (j < nc)
+                        ? ((transB == N2D2::Gemm::Trans)
+                            ? B[(j0 + j) * ldb + k0 + k]
+                            : B[(k0 + k) * ldb + j0 + j])
+                        : T(0.0);
+                }
+            }
+        }
+    }
+
+    /// C[m x n] += alpha * packedA[MR x kc] * packedB[kc x NR]
+    /// If @p carry is true (only valid with alpha = 1), the accumulation
+    /// continues directly from the values of C, so that the summation order
+    /// is the same as a single loop over the whole K dimension.
+    template <class T>
+    inline void microKernel(std::size_t kc,
+                            const T* a,
+                            const T* b,
+                            const T& alpha,
+                            bool carry,
+                            T* C,
+                            std::size_t ldc,
+                            std::size_t m,
+                            std::size_t n)
+    {
+        T acc[MR][NR];
+
+        for (std::size_t ir = 0; ir < MR; ++ir) {
+            for (std::size_t jr = 0; jr < NR; ++jr) {
+                acc[ir][jr] = (carry && ir < m && jr < n)
+                    ? C[ir * ldc + jr] : T(0.0);
+            }
+        }
+
+        for (std::size_t k = 0; k < kc; ++k) {
+            for (std::size_t ir = 0; ir < MR; ++ir) {
+                const T ai = a[ir];
+
+                for (std::size_t jr = 0; jr < NR; ++jr)
+                    acc[ir][jr] += ai * b[jr];
+            }
+
+            a += MR;
+            b += NR;
+        }
+
+        for (std::size_t ir = 0; ir < m; ++ir) {
+            for (std::size_t jr = 0; jr < n; ++jr) {
+                if (carry)
+                    C[ir * ldc + jr] = acc[ir][jr];
+                else
+                    C[ir * ldc + jr] += alpha * acc[ir][jr];
+            }
+        }
+    }
+
+    /// C[m x n] += packedA[MR x kc] * packedB[kc x NR], with 32 bits
+    /// accumulators (the integer sums do not depend on the order)
+    template <class TA, class TB>
+    inline void microKernelInt8(std::size_t kc,
+                                const TA* a,
+                                const TB* b,
+                                std::int32_t* C,
+                                std::size_t ldc,
+                                std::size_t m,
+                                std::size_t n)
+    {
+        std::int32_t acc[MR][NR] = {{0}};
+
+        for (std::size_t k = 0; k < kc; ++k) {
+            for (std::size_t ir = 0; ir < MR; ++ir) {
+                const std::int32_t ai = a[ir];
+
+                for (std::size_t jr = 0; jr < NR; ++jr)
+                    acc[ir][jr] += ai * (std::int32_t)b[jr];
+            }
+
+            a += MR;
+            b += NR;
+        }
+
+        for (std::size_t ir = 0; ir < m; ++ir) {
+            for (std::size_t jr = 0; jr < n; ++jr)
+                C[ir * ldc + jr] += acc[ir][jr];
+        }
+    }
+}
+
+template <class T>
+void N2D2::Gemm::gemm(Transpose transA,
+                      Transpose transB,
+                      std::size_t M,
+                      std::size_t N,
+                      std::size_t K,
+                      const T& alpha,
+                      const T* A,
+                      std::size_t lda,
+                      const T* B,
+                      std::size_t ldb,
+                      const T& beta,
+                      T* C,
+                      std::size_t ldc)
+{
+    if (M == 0 || N == 0)
+        return;
+
+    // C = beta * C
+    if (beta != T(1.0)) {
+#pragma omp parallel for if (M > 1 && M * N > PARALLEL_THRESHOLD)
+        for (int i = 0; i < (int)M; ++i) {
+            T* row = C + i * ldc;
+
+            if (beta == T(0.0))
+                std::fill(row, row + N, T(0.0));
+            else {
+                for (std::size_t j = 0; j < N; ++j)
+                    row[j] *= beta;
+            }
+        }
+    }
+
+    if (K == 0 || alpha == T(0.0))
+        return;
+
+    const std::size_t kBlock = std::min(K, KC);
+    std::vector<T> packedA(((M + MR - 1) / MR) * MR * kBlock);
+    std::vector<T> packedB(((N + NR - 1) / NR) * NR * kBlock);
+
+    const int nbMBlocks = (int)((M + MC - 1) / MC);
+    const int nbNBlocks = (int)((N + NC - 1) / NC);
+    const std::size_t size = M * N * kBlock;
+
+    // The K blocks are processed sequentially, so that the summation order
+    // is always the same for a given element of C
+    for (std::size_t k0 = 0; k0 < K; k0 += KC) {
+        const std::size_t kc = std::min(KC, K - k0);
+        const bool carry = (k0 > 0 && alpha == T(1.0));
+
+        packA(transA, M, k0, kc, A, lda, &packedA[0]);
+        packB(transB, 0, N, k0, kc, B, ldb, &packedB[0]);
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) schedule(static) \
+    if (nbMBlocks * nbNBlocks > 1 && size > PARALLEL_THRESHOLD)
+#else
+#pragma omp parallel for schedule(static) \
+    if (nbMBlocks > 1 && size > PARALLEL_THRESHOLD)
+#endif
+        for (int mBlock = 0; mBlock < nbMBlocks; ++mBlock) {
+            for (int nBlock = 0; nBlock < nbNBlocks; ++nBlock) {
+                const std::size_t i0 = mBlock * MC;
+                const std::size_t iEnd = std::min(i0 + MC, M);
+                const std::size_t j0 = nBlock * NC;
+                const std::size_t jEnd = std::min(j0 + NC, N);
+
+                for (std::size_t j = j0; j < jEnd; j += NR) {
+                    const T* b = &packedB[0] + (j / NR) * kc * NR;
+                    const std::size_t n = std::min(NR, jEnd - j);
+
+                    for (std::size_t i = i0; i < iEnd; i += MR) {
+                        const T* a = &packedA[0] + (i / MR) * kc * MR;
+                        const std::size_t m = std::min(MR, iEnd - i);
+
+                        microKernel(kc, a, b, alpha, carry, C + i * ldc + j,
+                                    ldc, m, n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace N2D2 {
+template <>
+void Gemm::gemm<half_float::half>(Transpose transA,
+                                  Transpose transB,
+                                  std::size_t M,
+                                  std::size_t N,
+                                  std::size_t K,
+                                  const half_float::half& alpha,
+                                  const half_float::half* A,
+                                  std::size_t lda,
+                                  const half_float::half* B,
+                                  std::size_t ldb,
+                                  const half_float::half& beta,
+                                  half_float::half* C,
+                                  std::size_t ldc)
+{
+    if (M == 0 || N == 0)
+        return;
+
+    // A and B are converted in their storage layout
+    const std::size_t rowsA = (transA == Trans) ? K : M;
+    const std::size_t colsA = (transA == Trans) ? M : K;
+    const std::size_t rowsB = (transB == Trans) ? N : K;
+    const std::size_t colsB = (transB == Trans) ? K : N;
+
+    std::vector<float> floatA(rowsA * colsA);
+    std::vector<float> floatB(rowsB * colsB);
+    std::vector<float> floatC(M * N);
+
+    if (K > 0) {
+        HalfConversion::toFloat(A, rowsA, colsA, lda, &floatA[0]);
+        HalfConversion::toFloat(B, rowsB, colsB, ldb, &floatB[0]);
+    }
+
+    if (beta != half_float::half(0.0f))
+        HalfConversion::toFloat(C, M, N, ldc, &floatC[0]);
+
+    gemm<float>(transA, transB, M, N, K, (float)alpha,
+                (K > 0) ? &floatA[0] : NULL, colsA,
+                (K > 0) ? &floatB[0] : NULL, colsB,
+                (float)beta, &floatC[0], N);
+
+    HalfConversion::fromFloat(&floatC[0], M, N, C, ldc);
+}
+}
+
+template <class TA, class TB>
+void N2D2::Gemm::gemmInt8(Transpose transA,
+                          Transpose transB,
+                          std::size_t M,
+                          std::size_t N,
+                          std::size_t K,
+                          const TA* A,
+                          std::size_t lda,
+                          const TB* B,
+                          std::size_t ldb,
+                          bool accumulate,
+                          std::int32_t* C,
+                          std::size_t ldc)
+{
+    if (M == 0 || N == 0)
+        return;
+
+    if (!accumulate) {
+#pragma omp parallel for if (M > 1 && M * N > PARALLEL_THRESHOLD)
+        for (int i = 0; i < (int)M; ++i)
+            std::fill(C + i * ldc, C + i * ldc + N, 0);
+    }
+
+    if (K == 0)
+        return;
+
+    const std::size_t kBlock = std::min(K, KC);
+    std::vector<TA> packedA(((M + MR - 1) / MR) * MR * kBlock);
+    std::vector<TB> packedB(((N + NR - 1) / NR) * NR * kBlock);
+
+    const int nbMBlocks = (int)((M + MC - 1) / MC);
+    const int nbNBlocks = (int)((N + NC - 1) / NC);
+    const std::size_t size = M * N * kBlock;
+
+    for (std::size_t k0 = 0; k0 < K; k0 += KC) {
+        const std::size_t kc = std::min(KC, K - k0);
+
+        packA(transA, M, k0, kc, A, lda, &packedA[0]);
+        packB(transB, 0, N, k0, kc, B, ldb, &packedB[0]);
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) schedule(static) \
+    if (nbMBlocks * nbNBlocks > 1 && size > PARALLEL_THRESHOLD)
+#else
+#pragma omp parallel for schedule(static) \
+    if (nbMBlocks > 1 && size > PARALLEL_THRESHOLD)
+#endif
+        for (int mBlock = 0; mBlock < nbMBlocks; ++mBlock) {
+            for (int nBlock = 0; nBlock < nbNBlocks; ++nBlock) {
+                const std::size_t i0 = mBlock * MC;
+                const std::size_t iEnd = std::min(i0 + MC, M);
+                const std::size_t j0 = nBlock * NC;
+                const std::size_t jEnd = std::min(j0 + NC, N);
+
+                for (std::size_t j = j0; j < jEnd; j += NR) {
+                    const TB* b = &packedB[0] + (j / NR) * kc * NR;
+                    const std::size_t n = std::min(NR, jEnd - j);
+
+                    for (std::size_t i = i0; i < iEnd; i += MR) {
+                        const TA* a = &packedA[0] + (i / MR) * kc * MR;
+                        const std::size_t m = std::min(MR, iEnd - i);
+
+                        microKernelInt8(kc, a, b, C + i * ldc + j, ldc, m, n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace N2D2 {
+    template void Gemm::gemm<float>(Transpose transA,
+                                    Transpose transB,
+                                    std::size_t M,
+                                    std::size_t N,
+                                    std::size_t K,
+                                    const float& alpha,
+                                    const float* A,
+                                    std::size_t lda,
+                                    const float* B,
+                                    std::size_t ldb,
+                                    const float& beta,
+                                    float* C,
+                                    std::size_t ldc);
+    template void Gemm::gemm<double>(Transpose transA,
+                                     Transpose transB,
+                                     std::size_t M,
+                                     std::size_t N,
+                                     std::size_t K,
+                                     const double& alpha,
+                                     const double* A,
+                                     std::size_t lda,
+                                     const double* B,
+                                     std::size_t ldb,
+                                     const double& beta,
+                                     double* C,
+                                     std::size_t ldc);
+
+    template void Gemm::gemmInt8<std::int8_t, std::int8_t>(Transpose transA,
+                                                           Transpose transB,
+                                                           std::size_t M,
+                                                           std::size_t N,
+                                                           std::size_t K,
+                                                           const std::int8_t* A,
+                                                           std::size_t lda,
+                                                           const std::int8_t* B,
+                                                           std::size_t ldb,
+                                                           bool accumulate,
+                                                           std::int32_t* C,
+                                                           std::size_t ldc);
+    template void Gemm::gemmInt8<std::int8_t, std::uint8_t>(Transpose transA,
+                                                            Transpose transB,
+                                                            std::size_t M,
+                                                            std::size_t N,
+                                                            std::size_t K,
+                                                            const std::int8_t* A,
+                                                            std::size_t lda,
+                                                            const std::uint8_t* B,
+                                                            std::size_t ldb,
+                                                            bool accumulate,
+                                                            std::int32_t* C,
+                                                            std::size_t ldc);
+    template void Gemm::gemmInt8<std::uint8_t, std::int8_t>(Transpose transA,
+                                                            Transpose transB,
+                                                            std::size_t M,
+                                                            std::size_t N,
+                                                            std::size_t K,
+                                                            const std::uint8_t* A,
+                                                            std::size_t lda,
+                                                            const std::int8_t* B,
+                                                            std::size_t ldb,
+                                                            bool accumulate,
+                                                            std::int32_t* C,
+                                                            std::size_t ldc);
+}
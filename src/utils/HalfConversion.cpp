@@ -0,0 +1,251 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include <algorithm>
+#include <cstring>
+
+#include "utils/CpuFeatures.hpp"
+#include "utils/HalfConversion.hpp"
+#include "utils/SimdMath.hpp"
+
+#ifdef N2D2_SIMD
+#ifndef WIN32
+#include <fenv.h>
+#endif
+
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Below this number of elements, OpenMP is not used
+    const std::size_t PARALLEL_THRESHOLD = 65536;
+    // Number of elements converted by each OpenMP iteration
+    const std::size_t CHUNK_SIZE = 4096;
+
+    inline unsigned int floatBits(float value)
+    {
+        unsigned int bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline float bitsFloat(unsigned int bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    inline unsigned short halfBits(half_float::half value)
+    {
+        unsigned short bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline half_float::half bitsHalf(unsigned short bits)
+    {
+        half_float::half value;
+        std::memcpy(static_cast<void*>(&value), &bits, sizeof(value));
+        return value;
+    }
+
+    /// Exact half to float conversion: the exponent is rebiased, the
+    /// subnormals are normalized with a float subtraction.
+    inline float halfToFloat(unsigned short h)
+    {
+        const unsigned int shiftedExp = 0x7c00U << 13;
+        unsigned int bits = (h & 0x7fffU) << 13;
+        const unsigned int exp = bits & shiftedExp;
+
+        bits += (127U - 15U) << 23;
+
+        if (exp == shiftedExp)          // Inf or NaN
+            bits += (128U - 16U) << 23;
+        else if (exp == 0) {            // Zero or subnormal
+            bits += 1U << 23;
+            bits = floatBits(bitsFloat(bits) - bitsFloat(113U << 23));
+        }
+
+        return bitsFloat(bits | ((h & 0x8000U) << 16));
+    }
+
+    /// Float to half conversion, rounded to nearest even
+    inline unsigned short floatToHalf(float value)
+    {
+        unsigned int bits = floatBits(value);
+        const unsigned int sign = bits & 0x80000000U;
+        bits ^= sign;
+
+        unsigned short h;
+
+        if (bits >= ((127U + 16U) << 23)) {
+            // Overflow to Inf, NaN to quiet NaN
+            h = (bits > (255U << 23)) ? 0x7e00 : 0x7c00;
+        }
+        else if (bits < (113U << 23)) {
+            // Subnormal or zero: the rounding is done by a float addition
+            const unsigned int denormMagic = ((127U - 15U) + (23U - 10U) + 1U)
+                                             << 23;
+            h = (unsigned short)(floatBits(bitsFloat(bits)
+                                           + bitsFloat(denormMagic))
+                                 - denormMagic);
+        }
+        else {
+            const unsigned int mantOdd = (bits >> 13) & 1U;
+
+            // Rebias the exponent and round (ties to even)
+            bits += ((unsigned int)(15 - 127) << 23) + 0xfffU;
+            bits += mantOdd;
+            h = (unsigned short)(bits >> 13);
+        }
+
+        return (unsigned short)(h | (sign >> 16));
+    }
+
+    void toFloatScalar(const half_float::half* src, std::size_t size,
+                       float* dst)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] = halfToFloat(halfBits(src[i]));
+    }
+
+    void fromFloatScalar(const float* src, std::size_t size,
+                         half_float::half* dst)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] = bitsHalf(floatToHalf(src[i]));
+    }
+
+#ifdef N2D2_SIMD
+    N2D2_SIMD_TARGET_AVX2 void toFloat_AVX2(const half_float::half* src,
+                                            std::size_t size,
+                                            float* dst)
+    {
+        std::size_t i = 0;
+
+        for (; i + 8 <= size; i += 8) {
+            const __m128i h = _mm_loadu_si128((const __m128i*)(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+        }
+
+        toFloatScalar(src + i, size - i, dst + i);
+    }
+
+    N2D2_SIMD_TARGET_AVX2 void fromFloat_AVX2(const float* src,
+                                              std::size_t size,
+                                              half_float::half* dst)
+    {
+#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
+        // The overflow to infinity is expected, but raises FE_OVERFLOW
+        const int excepts = fegetexcept();
+        fedisableexcept(FE_OVERFLOW);
+#endif
+
+        std::size_t i = 0;
+
+        for (; i + 8 <= size; i += 8) {
+            const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                              _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128((__m128i*)(dst + i), h);
+        }
+
+#if !defined(WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__) && !defined(_WIN32)
+        feenableexcept(excepts);
+#endif
+
+        fromFloatScalar(src + i, size - i, dst + i);
+    }
+
+#define N2D2_HALF_CONVERSION_KERNELS(name) NULL, &name##_AVX2, NULL
+#else
+#define N2D2_HALF_CONVERSION_KERNELS(name) NULL, NULL, NULL
+#endif
+
+    /// Run @p kernel in parallel over chunks of CHUNK_SIZE elements
+    template <class Kernel, class TSrc, class TDst>
+    void convert(Kernel kernel, const TSrc* src, std::size_t size, TDst* dst)
+    {
+        const int nbChunks = (int)((size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+#pragma omp parallel for if (size > PARALLEL_THRESHOLD)
+        for (int chunk = 0; chunk < nbChunks; ++chunk) {
+            const std::size_t offset = chunk * CHUNK_SIZE;
+
+            (*kernel)(src + offset, std::min(CHUNK_SIZE, size - offset),
+                      dst + offset);
+        }
+    }
+}
+
+void N2D2::HalfConversion::toFloat(const half_float::half* src,
+                                   std::size_t size,
+                                   float* dst)
+{
+    typedef void (*Kernel)(const half_float::half*, std::size_t, float*);
+
+    const Kernel kernel = CpuFeatures::select<Kernel>(&toFloatScalar,
+        N2D2_HALF_CONVERSION_KERNELS(toFloat));
+
+    convert(kernel, src, size, dst);
+}
+
+void N2D2::HalfConversion::fromFloat(const float* src,
+                                     std::size_t size,
+                                     half_float::half* dst)
+{
+    typedef void (*Kernel)(const float*, std::size_t, half_float::half*);
+
+    const Kernel kernel = CpuFeatures::select<Kernel>(&fromFloatScalar,
+        N2D2_HALF_CONVERSION_KERNELS(fromFloat));
+
+    convert(kernel, src, size, dst);
+}
+
+void N2D2::HalfConversion::toFloat(const half_float::half* src,
+                                   std::size_t rows,
+                                   std::size_t cols,
+                                   std::size_t ldSrc,
+                                   float* dst)
+{
+    if (ldSrc == cols) {
+        toFloat(src, rows * cols, dst);
+        return;
+    }
+
+    for (std::size_t row = 0; row < rows; ++row)
+        toFloat(src + row * ldSrc, cols, dst + row * cols);
+}
+
+void N2D2::HalfConversion::fromFloat(const float* src,
+                                     std::size_t rows,
+                                     std::size_t cols,
+                                     half_float::half* dst,
+                                     std::size_t ldDst)
+{
+    if (ldDst == cols) {
+        fromFloat(src, rows * cols, dst);
+        return;
+    }
+
+    for (std::size_t row = 0; row < rows; ++row)
+        fromFloat(src + row * cols, cols, dst + row * ldDst);
+}
@@ -0,0 +1,208 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "utils/Nms.hpp"
+
+std::vector<unsigned int> N2D2::Nms::nms(const Boxes& boxes,
+                                         double threshold,
+                                         unsigned int maxKeep)
+{
+    const unsigned int size = boxes.size();
+    const unsigned int nbBlocks = (size + 63) / 64;
+    const float iouThreshold = threshold;
+
+    std::vector<float> area(size);
+
+    for (unsigned int i = 0; i < size; ++i)
+        area[i] = boxes.w[i] * boxes.h[i];
+
+    // Bit (i % 64) of suppressed[i / 64] is set when box i is suppressed.
+    // The padding bits of the last block are set, so that a fully suppressed
+    // block is always ~0.
+    std::vector<uint64_t> suppressed(nbBlocks, 0);
+
+    if (size % 64 != 0)
+        suppressed.back() = (~0ULL) << (size % 64);
+
+    std::vector<unsigned int> kept;
+
+    for (unsigned int i = 0; i < size; ++i) {
+        if ((suppressed[i / 64] >> (i % 64)) & 1ULL)
+            continue;
+
+        kept.push_back(i);
+
+        if (maxKeep > 0 && kept.size() >= maxKeep)
+            break;
+
+        const float left0 = boxes.x[i];
+        const float top0 = boxes.y[i];
+        const float right0 = boxes.x[i] + boxes.w[i];
+        const float bottom0 = boxes.y[i] + boxes.h[i];
+        const float area0 = area[i];
+        const unsigned int firstBlock = (i + 1) / 64;
+
+#pragma omp parallel for if (nbBlocks - firstBlock > 64)
+        for (int block = firstBlock; block < (int)nbBlocks; ++block) {
+            if (suppressed[block] == ~0ULL)
+                continue;
+
+            const unsigned int begin = block * 64;
+            const unsigned int end = std::min(begin + 64, size);
+            uint64_t mask = 0;
+
+            for (unsigned int j = begin; j < end; ++j) {
+                const float interWidth = std::min(right0, boxes.x[j]
+                                                            + boxes.w[j])
+                    - std::max(left0, boxes.x[j]);
+                const float interHeight = std::min(bottom0, boxes.y[j]
+                                                            + boxes.h[j])
+                    - std::max(top0, boxes.y[j]);
+                const float interArea = interWidth * interHeight;
+                const float IoU = interArea / (area0 + area[j] - interArea);
+                const bool overlap = (interWidth > 0.0f && interHeight > 0.0f
+                                      && IoU > iouThreshold);
+
+                mask |= ((uint64_t)overlap << (j - begin));
+            }
+
+            // Only the boxes after i can be suppressed by i
+            if (begin <= i) {
+                mask &= (i % 64 == 63) ? 0ULL
+                                       : (~0ULL) << ((i % 64) + 1);
+            }
+
+            suppressed[block] |= mask;
+        }
+    }
+
+    return kept;
+}
+
+std::vector<unsigned int> N2D2::Nms::softNms(const Boxes& boxes,
+                                             std::vector<float>& scores,
+                                             SoftMethod method,
+                                             double threshold,
+                                             double sigma,
+                                             double scoreThreshold,
+                                             unsigned int maxKeep)
+{
+    // The remaining candidates are kept compacted in contiguous arrays
+    std::vector<unsigned int> index;
+    std::vector<float> left;
+    std::vector<float> top;
+    std::vector<float> right;
+    std::vector<float> bottom;
+    std::vector<float> area;
+    std::vector<float> score;
+
+    for (unsigned int i = 0, size = boxes.size(); i < size; ++i) {
+        if (scores[i] < scoreThreshold)
+            continue;
+
+        index.push_back(i);
+        left.push_back(boxes.x[i]);
+        top.push_back(boxes.y[i]);
+        right.push_back(boxes.x[i] + boxes.w[i]);
+        bottom.push_back(boxes.y[i] + boxes.h[i]);
+        area.push_back(boxes.w[i] * boxes.h[i]);
+        score.push_back(scores[i]);
+    }
+
+    const float iouThreshold = threshold;
+    const float minScore = scoreThreshold;
+    std::vector<unsigned int> kept;
+    unsigned int nbRemaining = index.size();
+
+    while (nbRemaining > 0) {
+        // Select the highest score (the lowest index on ties)
+        unsigned int iMax = 0;
+
+        for (unsigned int k = 1; k < nbRemaining; ++k) {
+            if (score[k] > score[iMax]
+                || (score[k] == score[iMax] && index[k] < index[iMax]))
+            {
+                iMax = k;
+            }
+        }
+
+        kept.push_back(index[iMax]);
+        scores[index[iMax]] = score[iMax];
+
+        if (maxKeep > 0 && kept.size() >= maxKeep)
+            break;
+
+        const float left0 = left[iMax];
+        const float top0 = top[iMax];
+        const float right0 = right[iMax];
+        const float bottom0 = bottom[iMax];
+        const float area0 = area[iMax];
+
+        // Decay the scores
+        for (unsigned int k = 0; k < nbRemaining; ++k) {
+            const float interWidth = std::max(0.0f,
+                std::min(right0, right[k]) - std::max(left0, left[k]));
+            const float interHeight = std::max(0.0f,
+                std::min(bottom0, bottom[k]) - std::max(top0, top[k]));
+            const float interArea = interWidth * interHeight;
+            const float IoU = (interArea > 0.0f)
+                ? interArea / (area0 + area[k] - interArea) : 0.0f;
+
+            if (method == Linear)
+                score[k] *= (IoU > iouThreshold) ? (1.0f - IoU) : 1.0f;
+            else
+                score[k] *= std::exp(-IoU * IoU / sigma);
+        }
+
+        // Remove the selected box and the boxes below the score threshold
+        unsigned int n = 0;
+
+        for (unsigned int k = 0; k < nbRemaining; ++k) {
+            if (k == iMax)
+                continue;
+
+            if (score[k] < minScore) {
+                scores[index[k]] = score[k];
+                continue;
+            }
+
+            index[n] = index[k];
+            left[n] = left[k];
+            top[n] = top[k];
+            right[n] = right[k];
+            bottom[n] = bottom[k];
+            area[n] = area[k];
+            score[n] = score[k];
+            ++n;
+        }
+
+        nbRemaining = n;
+    }
+
+    // Scores of the boxes remaining after maxKeep was reached
+    for (unsigned int k = 0; k < nbRemaining; ++k)
+        scores[index[k]] = score[k];
+
+    return kept;
+}
@@ -173,3 +173,87 @@ bool N2D2::Random::randBernoulli(double p)
     // return 0 if x is in [p,1[ (p = 1 => return always 1)
     return (Random::randUniform(0.0, 1.0, Random::RightHalfOpenInterval) < p);
 }
+
+void N2D2::Random::philox(const unsigned int counter[4],
+                          const unsigned int key[2],
+                          unsigned int output[4])
+{
+    unsigned int c0 = counter[0];
+    unsigned int c1 = counter[1];
+    unsigned int c2 = counter[2];
+    unsigned int c3 = counter[3];
+    unsigned int k0 = key[0];
+    unsigned int k1 = key[1];
+
+    for (unsigned int round = 0; round < 10; ++round) {
+        if (round > 0) {
+            // Bump the key (Weyl sequence)
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+
+        const unsigned long long p0 = 0xD2511F53ULL * c0;
+        const unsigned long long p1 = 0xCD9E8D57ULL * c2;
+
+        c0 = (unsigned int)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (unsigned int)p1;
+        c2 = (unsigned int)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (unsigned int)p0;
+    }
+
+    output[0] = c0;
+    output[1] = c1;
+    output[2] = c2;
+    output[3] = c3;
+}
+
+unsigned int N2D2::Random::randBernoulliWord(unsigned long long seed,
+                                             unsigned long long stream,
+                                             unsigned long long word,
+                                             double p)
+{
+    // uniform random number x is in [0,2^32[
+    // return 1 if x is in [0,p*2^32[, as in randBernoulli()
+    const unsigned long long threshold = (p <= 0.0) ? 0ULL
+        : (p >= 1.0) ? (MT_RAND_MAX + 1ULL)
+        : (unsigned long long)(p * (MT_RAND_MAX + 1.0));
+    const unsigned int key[2] = {(unsigned int)seed,
+                                 (unsigned int)(seed >> 32)};
+
+    unsigned int bits = 0;
+
+    // 8 Philox calls of 4 random numbers each for 32 bits
+    for (unsigned int i = 0; i < 8; ++i) {
+        const unsigned long long index = 8 * word + i;
+        const unsigned int counter[4] = {(unsigned int)index,
+                                         (unsigned int)(index >> 32),
+                                         (unsigned int)stream,
+                                         (unsigned int)(stream >> 32)};
+        unsigned int output[4];
+        philox(counter, key, output);
+
+        for (unsigned int j = 0; j < 4; ++j) {
+            if (output[j] < threshold)
+                bits |= (1U << (4 * i + j));
+        }
+    }
+
+    return bits;
+}
+
+void N2D2::Random::randBernoulliMask(unsigned long long seed,
+                                     unsigned long long stream,
+                                     double p,
+                                     size_t size,
+                                     std::vector<unsigned int>& mask)
+{
+    const int nbWords = (size + 31) / 32;
+    mask.resize(nbWords);
+
+#pragma omp parallel for if (nbWords > 16)
+    for (int word = 0; word < nbWords; ++word)
+        mask[word] = randBernoulliWord(seed, stream, word, p);
+
+    if (size % 32 != 0)
+        mask.back() &= (1U << (size % 32)) - 1U;
+}
@@ -0,0 +1,312 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include <algorithm>
+
+#include "third_party/half.hpp"
+#include "utils/Sparse.hpp"
+
+namespace {
+    // Below this number of multiply-add, OpenMP is not used
+    const std::size_t PARALLEL_THRESHOLD = 32768;
+
+    /// row[0, size[ = beta * row[0, size[, without reading row if beta = 0
+    template <class T>
+    inline void scaleRow(const T& beta, T* row, std::size_t size)
+    {
+        if (beta == T(0.0))
+            std::fill(row, row + size, T(0.0));
+        else if (beta != T(1.0)) {
+            for (std::size_t j = 0; j < size; ++j)
+                row[j] *= beta;
+        }
+    }
+}
+
+template <class T>
+void N2D2::Sparse::compress(std::size_t rows,
+                            std::size_t cols,
+                            const T* A,
+                            std::size_t lda,
+                            CsrMatrix<T>& csr)
+{
+    csr.rows = rows;
+    csr.cols = cols;
+    csr.rowPtr.assign(1, 0);
+    csr.rowPtr.reserve(rows + 1);
+    csr.colIndices.clear();
+    csr.values.clear();
+
+    for (std::size_t i = 0; i < rows; ++i) {
+        const T* row = A + i * lda;
+
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (row[j] != T(0.0)) {
+                csr.colIndices.push_back(j);
+                csr.values.push_back(row[j]);
+            }
+        }
+
+        csr.rowPtr.push_back(csr.values.size());
+    }
+}
+
+template <class T>
+void N2D2::Sparse::gather(const T* A, std::size_t lda, CsrMatrix<T>& csr)
+{
+#pragma omp parallel for if (csr.nnz() > PARALLEL_THRESHOLD)
+    for (int i = 0; i < (int)csr.rows; ++i) {
+        const T* row = A + i * lda;
+
+        for (std::size_t idx = csr.rowPtr[i]; idx < csr.rowPtr[i + 1]; ++idx)
+            csr.values[idx] = row[csr.colIndices[idx]];
+    }
+}
+
+template <class T>
+void N2D2::Sparse::applyPattern(const CsrMatrix<T>& csr,
+                                T* A,
+                                std::size_t lda)
+{
+#pragma omp parallel for if (csr.rows * csr.cols > PARALLEL_THRESHOLD)
+    for (int i = 0; i < (int)csr.rows; ++i) {
+        T* row = A + i * lda;
+        std::size_t idx = csr.rowPtr[i];
+
+        for (std::size_t j = 0; j < csr.cols; ++j) {
+            if (idx < csr.rowPtr[i + 1] && csr.colIndices[idx] == j)
+                ++idx;
+            else
+                row[j] = T(0.0);
+        }
+    }
+}
+
+template <class T>
+void N2D2::Sparse::sparseDense(const CsrMatrix<T>& A,
+                               std::size_t N,
+                               const T& alpha,
+                               const T* B,
+                               std::size_t ldb,
+                               const T& beta,
+                               T* C,
+                               std::size_t ldc)
+{
+#pragma omp parallel for schedule(dynamic) \
+    if (A.rows > 1 && A.nnz() * N > PARALLEL_THRESHOLD)
+    for (int i = 0; i < (int)A.rows; ++i) {
+        T* row = C + i * ldc;
+        scaleRow(beta, row, N);
+
+        for (std::size_t idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) {
+            const T a = alpha * A.values[idx];
+            const T* b = B + A.colIndices[idx] * ldb;
+
+            for (std::size_t j = 0; j < N; ++j)
+                row[j] += a * b[j];
+        }
+    }
+}
+
+template <class T>
+void N2D2::Sparse::denseSparseTrans(const CsrMatrix<T>& A,
+                                    std::size_t N,
+                                    const T& alpha,
+                                    const T* B,
+                                    std::size_t ldb,
+                                    const T& beta,
+                                    T* C,
+                                    std::size_t ldc)
+{
+    const std::size_t size = A.nnz() * N;
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel for collapse(2) schedule(dynamic, 16) \
+    if (N * A.rows > 1 && size > PARALLEL_THRESHOLD)
+#else
+#pragma omp parallel for if (N > 1 && size > PARALLEL_THRESHOLD)
+#endif
+    for (int n = 0; n < (int)N; ++n) {
+        for (std::size_t i = 0; i < A.rows; ++i) {
+            const T* b = B + n * ldb;
+            T sum(0.0);
+
+            for (std::size_t idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx)
+                sum += A.values[idx] * b[A.colIndices[idx]];
+
+            T& c = C[n * ldc + i];
+            c = (beta == T(0.0)) ? T(alpha * sum) : T(alpha * sum + beta * c);
+        }
+    }
+}
+
+template <class T>
+void N2D2::Sparse::denseSparse(const CsrMatrix<T>& A,
+                               std::size_t N,
+                               const T& alpha,
+                               const T* B,
+                               std::size_t ldb,
+                               const T& beta,
+                               T* C,
+                               std::size_t ldc)
+{
+#pragma omp parallel for if (N > 1 && A.nnz() * N > PARALLEL_THRESHOLD)
+    for (int n = 0; n < (int)N; ++n) {
+        const T* b = B + n * ldb;
+        T* row = C + n * ldc;
+        scaleRow(beta, row, A.cols);
+
+        for (std::size_t i = 0; i < A.rows; ++i) {
+            if (b[i] == T(0.0))
+                continue;
+
+            const T a = alpha * b[i];
+
+            for (std::size_t idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx)
+                row[A.colIndices[idx]] += a * A.values[idx];
+        }
+    }
+}
+
+namespace N2D2 {
+    template void Sparse::compress<half_float::half>(std::size_t rows,
+        std::size_t cols,
+        const half_float::half* A,
+        std::size_t lda,
+        CsrMatrix<half_float::half>& csr);
+    template void Sparse::compress<float>(std::size_t rows,
+        std::size_t cols,
+        const float* A,
+        std::size_t lda,
+        CsrMatrix<float>& csr);
+    template void Sparse::compress<double>(std::size_t rows,
+        std::size_t cols,
+        const double* A,
+        std::size_t lda,
+        CsrMatrix<double>& csr);
+
+    template void Sparse::gather<half_float::half>(const half_float::half* A,
+        std::size_t lda,
+        CsrMatrix<half_float::half>& csr);
+    template void Sparse::gather<float>(const float* A,
+        std::size_t lda,
+        CsrMatrix<float>& csr);
+    template void Sparse::gather<double>(const double* A,
+        std::size_t lda,
+        CsrMatrix<double>& csr);
+
+    template void Sparse::applyPattern<half_float::half>(
+        const CsrMatrix<half_float::half>& csr,
+        half_float::half* A,
+        std::size_t lda);
+    template void Sparse::applyPattern<float>(
+        const CsrMatrix<float>& csr,
+        float* A,
+        std::size_t lda);
+    template void Sparse::applyPattern<double>(
+        const CsrMatrix<double>& csr,
+        double* A,
+        std::size_t lda);
+
+    template void Sparse::sparseDense<half_float::half>(
+        const CsrMatrix<half_float::half>& A,
+        std::size_t N,
+        const half_float::half& alpha,
+        const half_float::half* B,
+        std::size_t ldb,
+        const half_float::half& beta,
+        half_float::half* C,
+        std::size_t ldc);
+    template void Sparse::sparseDense<float>(
+        const CsrMatrix<float>& A,
+        std::size_t N,
+        const float& alpha,
+        const float* B,
+        std::size_t ldb,
+        const float& beta,
+        float* C,
+        std::size_t ldc);
+    template void Sparse::sparseDense<double>(
+        const CsrMatrix<double>& A,
+        std::size_t N,
+        const double& alpha,
+        const double* B,
+        std::size_t ldb,
+        const double& beta,
+        double* C,
+        std::size_t ldc);
+
+    template void Sparse::denseSparseTrans<half_float::half>(
+        const CsrMatrix<half_float::half>& A,
+        std::size_t N,
+        const half_float::half& alpha,
+        const half_float::half* B,
+        std::size_t ldb,
+        const half_float::half& beta,
+        half_float::half* C,
+        std::size_t ldc);
+    template void Sparse::denseSparseTrans<float>(
+        const CsrMatrix<float>& A,
+        std::size_t N,
+        const float& alpha,
+        const float* B,
+        std::size_t ldb,
+        const float& beta,
+        float* C,
+        std::size_t ldc);
+    template void Sparse::denseSparseTrans<double>(
+        const CsrMatrix<double>& A,
+        std::size_t N,
+        const double& alpha,
+        const double* B,
+        std::size_t ldb,
+        const double& beta,
+        double* C,
+        std::size_t ldc);
+
+    template void Sparse::denseSparse<half_float::half>(
+        const CsrMatrix<half_float::half>& A,
+        std::size_t N,
+        const half_float::half& alpha,
+        const half_float::half* B,
+        std::size_t ldb,
+        const half_float::half& beta,
+        half_float::half* C,
+        std::size_t ldc);
+    template void Sparse::denseSparse<float>(
+        const CsrMatrix<float>& A,
+        std::size_t N,
+        const float& alpha,
+        const float* B,
+        std::size_t ldb,
+        const float& beta,
+        float* C,
+        std::size_t ldc);
+    template void Sparse::denseSparse<double>(
+        const CsrMatrix<double>& A,
+        std::size_t N,
+        const double& alpha,
+        const double* B,
+        std::size_t ldb,
+        const double& beta,
+        double* C,
+        std::size_t ldc);
+}
@@ -21,8 +21,10 @@
 #include "N2D2.hpp"
 
 #include "Activation/Activation.hpp"
+#include "Activation/ActivationScaling.hpp"
 #include "Activation/Activation_Kernels.hpp"
 #include "Network.hpp"
+#include "utils/CpuFeatures.hpp"
 #include "utils/UnitTest.hpp"
 
 using namespace N2D2;
@@ -55,4 +57,131 @@ TEST_DATASET(Activation,
     ASSERT_EQUALS_DELTA(result, expectedValue, 1.0e-12);
 }
 
+TEST(Activation, scaling_integer)
+{
+    // 2 channels of 4 values
+    const float values[] = {0.0f, 5.0f, -5.0f, 1000.0f,
+                            7.0f, -7.0f, 255.0f, -1.0f};
+    Tensor<float> data({4, 1, 2, 1});
+
+    // (data * scaling + 2^(n - 1)) >> n, with n = 4
+    std::copy(values, values + 8, data.begin());
+    ActivationScaling::fixedPointScaling(4, std::vector<std::int32_t>({3, 8}))
+        .propagate(data);
+
+    const float fixedMult[] = {0.0f, 1.0f, -1.0f, 188.0f,
+                               4.0f, -3.0f, 128.0f, 0.0f};
+
+    for (unsigned int index = 0; index < data.size(); ++index) {
+        ASSERT_EQUALS(data(index), fixedMult[index]);
+    }
+
+    // (data + 2^(n - 1)) >> n, and data for n = 0
+    std::copy(values, values + 8, data.begin());
+    ActivationScaling::singleShiftScaling(std::vector<unsigned char>({2, 0}))
+        .propagate(data);
+
+    const float singleShift[] = {0.0f, 1.0f, -1.0f, 250.0f,
+                                 7.0f, -7.0f, 255.0f, -1.0f};
+
+    for (unsigned int index = 0; index < data.size(); ++index) {
+        ASSERT_EQUALS(data(index), singleShift[index]);
+    }
+
+    // (data + (data << first) + 2^(second - 1)) >> second
+    std::copy(values, values + 8, data.begin());
+    ActivationScaling::doubleShiftScaling(
+        std::vector<std::pair<unsigned char, unsigned char> >({{1, 3},
+                                                               {2, 4}}))
+        .propagate(data);
+
+    const float doubleShift[] = {0.0f, 2.0f, -2.0f, 375.0f,
+                                 2.0f, -2.0f, 80.0f, 0.0f};
+
+    for (unsigned int index = 0; index < data.size(); ++index) {
+        ASSERT_EQUALS(data(index), doubleShift[index]);
+    }
+}
+
+// Return the max. error in ULP of an in-place activation kernel against its
+// double precision reference
+template <class Func>
+double maxUlpError(Func func, double (*reference)(double),
+                   float minVal, float maxVal)
+{
+    // Not a multiple of the vector width and of the OpenMP chunk size
+    const std::size_t size = 10007;
+    std::vector<float> data(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+        data[i] = minVal + (maxVal - minVal) * i / (float)(size - 1);
+
+    const std::vector<float> input(data);
+    func(&data[0], size);
+
+    double maxError = 0.0;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const double expected = reference(input[i]);
+        const float absExpected = std::fabs((float)expected);
+        const double ulp = std::nextafter(absExpected,
+                                          std::numeric_limits<float>::max())
+                           - absExpected;
+
+        maxError = std::max(maxError, std::fabs(data[i] - expected) / ulp);
+    }
+
+    return maxError;
+}
+
+double tanh2(double x) { return std::tanh(2.0 * x); }
+double logistic(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+double softplus(double x) { return std::log1p(std::exp(x)); }
+double leakyRectifier(double x) { return (x > 0.0) ? x : 0.1f * (float)x; }
+double clippedRectifier(double x) { return (x > 0.0) ? std::min(x, 5.0) : 0.0; }
+double saturation(double x) { return std::max(-2.5, std::min(x, 2.5)); }
+
+void tanhKernel(float* data, std::size_t size)
+{ tanhActivation(data, size, 2.0f); }
+void logisticKernel(float* data, std::size_t size)
+{ logisticActivation(data, size); }
+void softplusKernel(float* data, std::size_t size)
+{ softplusActivation(data, size); }
+void leakyRectifierKernel(float* data, std::size_t size)
+{ rectifierActivation(data, size, 0.1f, 0.0f); }
+void clippedRectifierKernel(float* data, std::size_t size)
+{ rectifierActivation(data, size, 0.0f, 5.0f); }
+void saturationKernel(float* data, std::size_t size)
+{ saturationActivation(data, size, 2.5f); }
+
+TEST_DATASET(Activation,
+             simd_kernels,
+             (CpuFeatures::InstructionSet instructionSet),
+             std::make_tuple(CpuFeatures::Scalar),
+             std::make_tuple(CpuFeatures::SSE4),
+             std::make_tuple(CpuFeatures::AVX2),
+             std::make_tuple(CpuFeatures::AVX512))
+{
+    REQUIRED(instructionSet <= CpuFeatures::detect());
+
+    CpuFeatures::setMaxInstructionSet(instructionSet);
+    ASSERT_EQUALS(CpuFeatures::getInstructionSet(), instructionSet);
+
+    // Max. errors of utils/SimdMath.hpp + 1 ULP (rounding of the reference
+    // and accuracy of the scalar libm functions)
+    ASSERT_TRUE(maxUlpError(&tanhKernel, &tanh2, -10.0f, 10.0f) <= 2.0);
+    ASSERT_TRUE(maxUlpError(&logisticKernel, &logistic, -80.0f, 80.0f)
+                <= 3.0);
+    ASSERT_TRUE(maxUlpError(&softplusKernel, &softplus, -80.0f, 80.0f)
+                <= 4.0);
+    ASSERT_EQUALS(maxUlpError(&leakyRectifierKernel, &leakyRectifier,
+                              -10.0f, 10.0f), 0.0);
+    ASSERT_EQUALS(maxUlpError(&clippedRectifierKernel, &clippedRectifier,
+                              -10.0f, 10.0f), 0.0);
+    ASSERT_EQUALS(maxUlpError(&saturationKernel, &saturation, -10.0f, 10.0f),
+                  0.0);
+
+    CpuFeatures::setMaxInstructionSet(CpuFeatures::AVX512);
+}
+
 RUN_TESTS()
@@ -0,0 +1,143 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/AnchorCell_Frame_Kernels.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+using AnchorCell_Frame_Kernels::BBox_T;
+using AnchorCell_Frame_Kernels::BBoxGrid;
+
+namespace {
+int argMaxIoU(const std::vector<BBox_T>& boxes,
+              const BBox_T& bb,
+              float& maxIoU)
+{
+    maxIoU = 0.0f;
+    int argMax = -1;
+
+    for (unsigned int l = 0; l < boxes.size(); ++l) {
+        const BBox_T& gt = boxes[l];
+
+        const float interLeft = std::max(gt.x, bb.x);
+        const float interRight = std::min(gt.x + gt.w, bb.x + bb.w);
+        const float interTop = std::max(gt.y, bb.y);
+        const float interBottom = std::min(gt.y + gt.h, bb.y + bb.h);
+
+        if (interLeft < interRight && interTop < interBottom) {
+            const float interArea = (interRight - interLeft)
+                                        * (interBottom - interTop);
+            const float unionArea = gt.w * gt.h + bb.w * bb.h - interArea;
+            const float IoU = interArea / unionArea;
+
+            if (IoU > maxIoU) {
+                maxIoU = IoU;
+                argMax = l;
+            }
+        }
+    }
+
+    return argMax;
+}
+
+BBox_T randomBox(float maxSize)
+{
+    return BBox_T(Random::randUniform(-20.0, 500.0),
+                  Random::randUniform(-20.0, 500.0),
+                  Random::randUniform(1.0, maxSize),
+                  Random::randUniform(1.0, maxSize));
+}
+}
+
+TEST(BBoxGrid, argMaxIoU)
+{
+    std::vector<BBox_T> boxes;
+    boxes.push_back(BBox_T(0.0, 0.0, 10.0, 10.0));
+    boxes.push_back(BBox_T(100.0, 100.0, 20.0, 20.0));
+    boxes.push_back(BBox_T(0.0, 0.0, 10.0, 10.0));  // Same as box 0
+    boxes.push_back(BBox_T(50.0, 0.0, 100.0, 10.0));
+
+    BBoxGrid grid;
+    float maxIoU;
+
+    ASSERT_EQUALS(grid.argMaxIoU(boxes, BBox_T(0.0, 0.0, 10.0, 10.0), maxIoU),
+                  -1);
+
+    grid.build(boxes);
+
+    ASSERT_EQUALS(grid.argMaxIoU(boxes, BBox_T(1.0, 1.0, 10.0, 10.0), maxIoU),
+                  0);
+    ASSERT_EQUALS_DELTA(maxIoU, 81.0 / 119.0, 1.0e-6);
+    ASSERT_EQUALS(grid.argMaxIoU(boxes, BBox_T(90.0, 90.0, 20.0, 20.0),
+                                 maxIoU), 1);
+    ASSERT_EQUALS_DELTA(maxIoU, 100.0 / 700.0, 1.0e-6);
+    ASSERT_EQUALS(grid.argMaxIoU(boxes, BBox_T(140.0, 0.0, 20.0, 10.0),
+                                 maxIoU), 3);
+    ASSERT_EQUALS_DELTA(maxIoU, 100.0 / 1100.0, 1.0e-6);
+    ASSERT_EQUALS(grid.argMaxIoU(boxes, BBox_T(20.0, 20.0, 10.0, 10.0),
+                                 maxIoU), -1);
+    ASSERT_EQUALS(maxIoU, 0.0f);
+    ASSERT_EQUALS(grid.argMaxIoU(boxes, BBox_T(-1000.0, -1000.0, 5000.0,
+                                               5000.0), maxIoU), 3);
+}
+
+TEST_DATASET(BBoxGrid,
+             argMaxIoU_reference,
+             (unsigned int nbBoxes, float maxSize),
+             std::make_tuple(0U, 50.0f),
+             std::make_tuple(1U, 50.0f),
+             std::make_tuple(10U, 50.0f),
+             std::make_tuple(100U, 50.0f),
+             std::make_tuple(100U, 500.0f),
+             std::make_tuple(500U, 20.0f),
+             std::make_tuple(5000U, 10.0f))
+{
+    Random::mtSeed(0);
+
+    std::vector<BBox_T> boxes;
+
+    for (unsigned int l = 0; l < nbBoxes; ++l) {
+        boxes.push_back(randomBox(maxSize));
+
+        // Duplicates, to check ties
+        if (Random::randUniform() < 0.1)
+            boxes.push_back(boxes.back());
+    }
+
+    BBoxGrid grid;
+    grid.build(boxes);
+
+    for (unsigned int i = 0; i < 2000; ++i) {
+        const BBox_T bb = randomBox(100.0);
+
+        float maxIoU;
+        float maxIoURef;
+        const int argMax = grid.argMaxIoU(boxes, bb, maxIoU);
+        const int argMaxRef = argMaxIoU(boxes, bb, maxIoURef);
+
+        ASSERT_EQUALS(argMax, argMaxRef);
+        ASSERT_EQUALS(maxIoU, maxIoURef);
+    }
+}
+
+RUN_TESTS()
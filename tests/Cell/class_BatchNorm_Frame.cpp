@@ -25,6 +25,7 @@
 #include "DeepNet.hpp"
 #include "Environment.hpp"
 #include "Network.hpp"
+#include "utils/Random.hpp"
 #include "utils/UnitTest.hpp"
 
 using namespace N2D2;
@@ -44,6 +45,7 @@ public:
     friend class UnitTest_BatchNormCell_Frame_float_setScales;
     friend class UnitTest_BatchNormCell_Frame_float_addInput__env;
     friend class UnitTest_BatchNormCell_Frame_float_addInput;
+    friend class UnitTest_BatchNormCell_Frame_float_propagate_backPropagate;
     friend class UnitTest_BatchNormCell_Frame_double_setScales;
     friend class UnitTest_BatchNormCell_Frame_double_addInput__env;
     friend class UnitTest_BatchNormCell_Frame_double_addInput;
@@ -177,4 +179,126 @@ TEST_DATASET(BatchNormCell_Frame_float,
                   * conv1.getOutputsHeight());
 }
 
+TEST_DATASET(BatchNormCell_Frame_float,
+             propagate_backPropagate,
+             (unsigned int channelsWidth,
+              unsigned int channelsHeight,
+              unsigned int nbChannels,
+              unsigned int batchSize),
+             std::make_tuple(1U, 1U, 8U, 16U),
+             std::make_tuple(7U, 5U, 16U, 4U),
+             std::make_tuple(40U, 40U, 2U, 3U),
+             std::make_tuple(64U, 33U, 1U, 2U))
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> diffOutputs(inputs.dims());
+
+    // Large mean compared to the standard deviation
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = 10.0 + Random::randUniform(-1.0, 1.0);
+
+    BatchNormCell_Frame_Test<float> bn1(
+        dn, "bn1", nbChannels, std::shared_ptr<Activation>());
+    bn1.addInput(inputs, diffOutputs);
+    bn1.initialize();
+
+    for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+        bn1.setScale(channel, Tensor<float>({1}, 0.5 + channel));
+        bn1.setBias(channel, Tensor<float>({1}, -1.0 * channel));
+    }
+
+    bn1.propagate(false);
+
+    for (unsigned int index = 0; index < bn1.mDiffInputs.size(); ++index)
+        bn1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    bn1.mDiffInputs.setValid();
+    bn1.backPropagate();
+
+    const Tensor<float>& outputs = tensor_cast<float>(bn1.getOutputs());
+    const Tensor<float>& diffOut = tensor_cast<float>(bn1.mDiffOutputs[0]);
+    const double size = channelsWidth * channelsHeight * batchSize;
+    const double epsilon = bn1.getParameter<double>("Epsilon");
+
+    // Double precision two-pass reference
+    for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+        const double scale = 0.5 + channel;
+        const double bias = -1.0 * channel;
+
+        double mean = 0.0;
+
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            for (unsigned int y = 0; y < channelsHeight; ++y) {
+                for (unsigned int x = 0; x < channelsWidth; ++x)
+                    mean += inputs(x, y, channel, batchPos);
+            }
+        }
+
+        mean /= size;
+
+        double variance = 0.0;
+        double sumDiff = 0.0;
+        double sumDiffNormalized = 0.0;
+
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            for (unsigned int y = 0; y < channelsHeight; ++y) {
+                for (unsigned int x = 0; x < channelsWidth; ++x) {
+                    const double zeroed = inputs(x, y, channel, batchPos)
+                                          - mean;
+                    variance += zeroed * zeroed;
+                }
+            }
+        }
+
+        variance /= size;
+        const double invStd = 1.0 / std::sqrt(variance + epsilon);
+
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            for (unsigned int y = 0; y < channelsHeight; ++y) {
+                for (unsigned int x = 0; x < channelsWidth; ++x) {
+                    const double normalized
+                        = (inputs(x, y, channel, batchPos) - mean) * invStd;
+                    const double diff = bn1.mDiffInputs(x, y, channel,
+                                                        batchPos);
+
+                    ASSERT_EQUALS_DELTA(outputs(x, y, channel, batchPos),
+                                        scale * normalized + bias, 1.0e-4);
+
+                    sumDiff += diff;
+                    sumDiffNormalized += diff * normalized;
+                }
+            }
+        }
+
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            for (unsigned int y = 0; y < channelsHeight; ++y) {
+                for (unsigned int x = 0; x < channelsWidth; ++x) {
+                    const double normalized
+                        = (inputs(x, y, channel, batchPos) - mean) * invStd;
+                    const double diff = bn1.mDiffInputs(x, y, channel,
+                                                        batchPos);
+                    const double gradient = scale * invStd / size
+                        * (size * diff - sumDiff
+                           - normalized * sumDiffNormalized);
+
+                    ASSERT_EQUALS_DELTA(diffOut(x, y, channel, batchPos),
+                                        gradient, 1.0e-3);
+                }
+            }
+        }
+
+        ASSERT_EQUALS_DELTA(bn1.mSavedMean(channel), mean, 1.0e-5);
+        ASSERT_EQUALS_DELTA(bn1.mSavedVariance(channel), variance, 1.0e-5);
+        ASSERT_EQUALS_DELTA(bn1.mDiffBias(channel), sumDiff, 1.0e-3);
+        ASSERT_EQUALS_DELTA(bn1.mDiffScale(channel), sumDiffNormalized,
+                            1.0e-3);
+    }
+}
+
 RUN_TESTS()
@@ -27,8 +27,13 @@
 #include "Network.hpp"
 #include "third_party/half.hpp"
 #include "Transformation/RescaleTransformation.hpp"
+#include "utils/Random.hpp"
 #include "utils/UnitTest.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace N2D2;
 
 template <class T>
@@ -65,6 +70,9 @@ public:
     friend class UnitTest_ConvCell_Frame_float_propagate_input_check;
     friend class UnitTest_ConvCell_Frame_float_propagate_2_input_check;
     friend class UnitTest_ConvCell_Frame_float_setWeight;
+    friend class UnitTest_ConvCell_Frame_float_winograd_cache;
+    friend class UnitTest_ConvCell_Frame_float_algorithm;
+    friend class UnitTest_ConvCell_Frame_float_sparse_update;
     friend class UnitTest_ConvCell_Frame_double_addInput__env;
     friend class UnitTest_ConvCell_Frame_double_addInput;
     friend class UnitTest_ConvCell_Frame_double_propagate_input_check;
@@ -444,6 +452,7 @@ TEST_DATASET(ConvCell_Frame_float,
         std::vector<unsigned int>({1U, 1U}),
         std::shared_ptr<Activation>());
     conv1.setParameter("NoBias", true);
+    conv1.setParameter("Algorithm", std::string("Direct"));
 
     Environment env(net, getDatabase(), {channelsWidth, channelsHeight, 1}, 2, false);
     env.addTransformation(RescaleTransformation(channelsWidth, channelsHeight));
@@ -585,6 +594,7 @@ TEST_DATASET(ConvCell_Frame_float,
         std::vector<unsigned int>({1U, 1U}),
         std::shared_ptr<Activation>());
     conv1.setParameter("NoBias", true);
+    conv1.setParameter("Algorithm", std::string("Direct"));
 
     Environment env(net, getDatabase(), {channelsWidth, channelsHeight, 1}, 2, false);
     env.addTransformation(RescaleTransformation(channelsWidth, channelsHeight));
@@ -761,6 +771,1063 @@ TEST_DATASET(ConvCell_Frame_float,
     }
 }
 
+TEST_DATASET(ConvCell_Frame_float,
+             im2col_check,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int subSampleX,
+              unsigned int subSampleY,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              bool mapping),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 0U, 0U, false),
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 1U, 0U, 0U, false),
+             std::make_tuple(3U, 3U, 2U, 2U, 1U, 1U, 0U, 0U, false),
+             std::make_tuple(3U, 3U, 1U, 3U, 1U, 1U, 0U, 0U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 2U, 2U, 0U, 0U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 3U, 0U, 0U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 2U, 2U, false),
+             std::make_tuple(2U, 5U, 1U, 1U, 1U, 1U, 1U, 3U, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 1U, 1U, true),
+             std::make_tuple(2U, 5U, 2U, 2U, 2U, 1U, 1U, 3U, true))
+{
+    Random::mtSeed(0);
+
+    const unsigned int channelsWidth = 11;
+    const unsigned int channelsHeight = 13;
+    const unsigned int nbChannels = 3;
+    const unsigned int nbOutputs = 5;
+    const unsigned int batchSize = 2;
+
+    const unsigned int oxSize = (channelsWidth + 2 * paddingX - kernelWidth
+                                 + strideX) / strideX;
+    const unsigned int oySize = (channelsHeight + 2 * paddingY - kernelHeight
+                                 + strideY) / strideY;
+    const unsigned int outputsWidth = (oxSize + subSampleX - 1) / subSampleX;
+    const unsigned int outputsHeight = (oySize + subSampleY - 1) / subSampleY;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({subSampleX, subSampleY}),
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> kernels({kernelWidth, kernelHeight, nbChannels, nbOutputs});
+    Tensor<float> diffInputs({outputsWidth, outputsHeight, nbOutputs,
+                              batchSize});
+    Tensor<bool> maps;
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < kernels.size(); ++index)
+        kernels(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    if (mapping) {
+        maps.resize({nbOutputs, nbChannels});
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel)
+                maps(output, channel) = ((output + channel) % 3 != 0);
+        }
+    }
+
+    const float alpha = 1.5f;
+    const float beta = 0.5f;
+
+    // Forward
+    Tensor<float> outputs({outputsWidth, outputsHeight, nbOutputs,
+                           batchSize});
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        outputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> outputsIm2Col = outputs.clone();
+
+    ConvCell_Frame_Kernels::forward(&alpha, inputs, kernels, desc, &beta,
+                                    outputs, maps);
+    ConvCell_Frame_Kernels::forwardIm2Col(&alpha, inputs, kernels, desc, &beta,
+                                          outputsIm2Col, maps);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(outputsIm2Col(index), outputs(index), 1.0e-4);
+    }
+
+    // Backward data
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index)
+        diffOutputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> diffOutputsIm2Col = diffOutputs.clone();
+
+    ConvCell_Frame_Kernels::backwardData(&alpha, kernels, diffInputs, desc,
+                                         &beta, diffOutputs, maps);
+    ConvCell_Frame_Kernels::backwardDataIm2Col(&alpha, kernels, diffInputs,
+                                               desc, &beta, diffOutputsIm2Col,
+                                               maps);
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputsIm2Col(index), diffOutputs(index),
+                            1.0e-4);
+    }
+
+    // Backward filter
+    Tensor<float> diffKernels(kernels.dims());
+
+    for (unsigned int index = 0; index < diffKernels.size(); ++index)
+        diffKernels(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> diffKernelsIm2Col = diffKernels.clone();
+
+    ConvCell_Frame_Kernels::backwardFilter(&alpha, inputs, diffInputs, desc,
+                                           &beta, diffKernels, maps);
+    ConvCell_Frame_Kernels::backwardFilterIm2Col(&alpha, inputs, diffInputs,
+                                                 desc, &beta,
+                                                 diffKernelsIm2Col, maps);
+
+    for (unsigned int index = 0; index < diffKernels.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffKernelsIm2Col(index), diffKernels(index),
+                            1.0e-4);
+    }
+}
+
+TEST_DATASET(ConvCell_Frame_float,
+             im2col_dilation_check,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int dilationX,
+              unsigned int dilationY),
+             std::make_tuple(3U, 3U, 1U, 1U, 0U, 0U, 2U, 2U),
+             std::make_tuple(3U, 3U, 1U, 1U, 2U, 2U, 2U, 2U),
+             std::make_tuple(2U, 3U, 2U, 1U, 1U, 2U, 3U, 2U),
+             std::make_tuple(3U, 2U, 1U, 2U, 3U, 1U, 1U, 3U))
+{
+    Random::mtSeed(0);
+
+    const unsigned int channelsWidth = 12;
+    const unsigned int channelsHeight = 10;
+    const unsigned int nbChannels = 2;
+    const unsigned int nbOutputs = 4;
+    const unsigned int batchSize = 2;
+
+    // A dilated convolution is a convolution with a kernel spread out with
+    // zeros
+    const unsigned int kernelExtentX = dilationX * (kernelWidth - 1) + 1;
+    const unsigned int kernelExtentY = dilationY * (kernelHeight - 1) + 1;
+    const unsigned int outputsWidth = (channelsWidth + 2 * paddingX
+                                       - kernelExtentX + strideX) / strideX;
+    const unsigned int outputsHeight = (channelsHeight + 2 * paddingY
+                                        - kernelExtentY + strideY) / strideY;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({dilationX, dilationY}));
+    const ConvCell_Frame_Kernels::Descriptor descDirect(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> kernels({kernelWidth, kernelHeight, nbChannels, nbOutputs});
+    Tensor<float> kernelsDilated({kernelExtentX, kernelExtentY, nbChannels,
+                                  nbOutputs}, 0.0f);
+    Tensor<float> diffInputs({outputsWidth, outputsHeight, nbOutputs,
+                              batchSize});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                    const float value = Random::randUniform(-1.0, 1.0);
+
+                    kernels(sx, sy, channel, output) = value;
+                    kernelsDilated(sx * dilationX, sy * dilationY,
+                                   channel, output) = value;
+                }
+            }
+        }
+    }
+
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+
+    // Forward
+    Tensor<float> outputs({outputsWidth, outputsHeight, nbOutputs,
+                           batchSize});
+    Tensor<float> outputsIm2Col(outputs.dims());
+
+    ConvCell_Frame_Kernels::forward(&alpha, inputs, kernelsDilated, descDirect,
+                                    &beta, outputs);
+    ConvCell_Frame_Kernels::forwardIm2Col(&alpha, inputs, kernels, desc, &beta,
+                                          outputsIm2Col);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(outputsIm2Col(index), outputs(index), 1.0e-4);
+    }
+
+    // Backward data
+    Tensor<float> diffOutputs(inputs.dims());
+    Tensor<float> diffOutputsIm2Col(inputs.dims());
+
+    ConvCell_Frame_Kernels::backwardData(&alpha, kernelsDilated, diffInputs,
+                                         descDirect, &beta, diffOutputs);
+    ConvCell_Frame_Kernels::backwardDataIm2Col(&alpha, kernels, diffInputs,
+                                               desc, &beta, diffOutputsIm2Col);
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputsIm2Col(index), diffOutputs(index),
+                            1.0e-4);
+    }
+
+    // Backward filter
+    Tensor<float> diffKernelsDilated(kernelsDilated.dims());
+    Tensor<float> diffKernelsIm2Col(kernels.dims());
+
+    ConvCell_Frame_Kernels::backwardFilter(&alpha, inputs, diffInputs,
+                                           descDirect, &beta,
+                                           diffKernelsDilated);
+    ConvCell_Frame_Kernels::backwardFilterIm2Col(&alpha, inputs, diffInputs,
+                                                 desc, &beta,
+                                                 diffKernelsIm2Col);
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                for (unsigned int sx = 0; sx < kernelWidth; ++sx) {
+                    ASSERT_EQUALS_DELTA(
+                        diffKernelsIm2Col(sx, sy, channel, output),
+                        diffKernelsDilated(sx * dilationX, sy * dilationY,
+                                           channel, output),
+                        1.0e-4);
+                }
+            }
+        }
+    }
+}
+
+TEST_DATASET(ConvCell_Frame_float,
+             grouped_check,
+             (unsigned int nbGroups,
+              unsigned int nbChannels,
+              unsigned int nbOutputs,
+              unsigned int subSampleX,
+              unsigned int subSampleY,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY),
+             std::make_tuple(3U, 3U, 3U, 1U, 1U, 1U, 1U, 0U, 0U),
+             std::make_tuple(3U, 3U, 6U, 1U, 1U, 1U, 1U, 1U, 1U),
+             std::make_tuple(2U, 4U, 6U, 1U, 1U, 1U, 1U, 1U, 1U),
+             std::make_tuple(2U, 6U, 4U, 1U, 1U, 2U, 2U, 1U, 2U),
+             std::make_tuple(4U, 4U, 4U, 2U, 2U, 1U, 1U, 1U, 1U),
+             std::make_tuple(2U, 4U, 2U, 1U, 2U, 2U, 1U, 0U, 1U))
+{
+    Random::mtSeed(0);
+
+    const unsigned int kernelWidth = 3;
+    const unsigned int kernelHeight = 3;
+    const unsigned int channelsWidth = 11;
+    const unsigned int channelsHeight = 13;
+    const unsigned int batchSize = 2;
+
+    const unsigned int oxSize = (channelsWidth + 2 * paddingX - kernelWidth
+                                 + strideX) / strideX;
+    const unsigned int oySize = (channelsHeight + 2 * paddingY - kernelHeight
+                                 + strideY) / strideY;
+    const unsigned int outputsWidth = (oxSize + subSampleX - 1) / subSampleX;
+    const unsigned int outputsHeight = (oySize + subSampleY - 1) / subSampleY;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({subSampleX, subSampleY}),
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> kernels({kernelWidth, kernelHeight, nbChannels, nbOutputs});
+    Tensor<float> diffInputs({outputsWidth, outputsHeight, nbOutputs,
+                              batchSize});
+    Tensor<bool> maps({nbOutputs, nbChannels});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < kernels.size(); ++index)
+        kernels(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    // Block-diagonal mapping
+    const unsigned int nbOutputsPerGroup = nbOutputs / nbGroups;
+    const unsigned int nbChannelsPerGroup = nbChannels / nbGroups;
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            maps(output, channel) = (output / nbOutputsPerGroup
+                                     == channel / nbChannelsPerGroup);
+        }
+    }
+
+    const float alpha = 1.5f;
+    const float beta = 0.5f;
+
+    // Forward
+    Tensor<float> outputs({outputsWidth, outputsHeight, nbOutputs,
+                           batchSize});
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        outputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> outputsGrouped = outputs.clone();
+
+    ConvCell_Frame_Kernels::forward(&alpha, inputs, kernels, desc, &beta,
+                                    outputs, maps);
+    ConvCell_Frame_Kernels::forwardGrouped(&alpha, inputs, kernels, desc,
+                                           &beta, outputsGrouped, nbGroups);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(outputsGrouped(index), outputs(index), 1.0e-4);
+    }
+
+    // Backward data
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index)
+        diffOutputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> diffOutputsGrouped = diffOutputs.clone();
+
+    ConvCell_Frame_Kernels::backwardData(&alpha, kernels, diffInputs, desc,
+                                         &beta, diffOutputs, maps);
+    ConvCell_Frame_Kernels::backwardDataGrouped(&alpha, kernels, diffInputs,
+                                                desc, &beta,
+                                                diffOutputsGrouped, nbGroups);
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputsGrouped(index), diffOutputs(index),
+                            1.0e-4);
+    }
+
+    // Backward filter
+    Tensor<float> diffKernels(kernels.dims());
+
+    for (unsigned int index = 0; index < diffKernels.size(); ++index)
+        diffKernels(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> diffKernelsGrouped = diffKernels.clone();
+
+    ConvCell_Frame_Kernels::backwardFilter(&alpha, inputs, diffInputs, desc,
+                                           &beta, diffKernels, maps);
+    ConvCell_Frame_Kernels::backwardFilterGrouped(&alpha, inputs, diffInputs,
+                                                  desc, &beta,
+                                                  diffKernelsGrouped,
+                                                  nbGroups);
+
+    for (unsigned int index = 0; index < diffKernels.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffKernelsGrouped(index), diffKernels(index),
+                            1.0e-4);
+    }
+}
+
+TEST_DATASET(ConvCell_Frame_float,
+             reduction_check,
+             (unsigned int nbChannels,
+              unsigned int nbOutputs,
+              unsigned int batchSize,
+              unsigned int subSample),
+             std::make_tuple(1U, 2U, 4U, 1U),
+             std::make_tuple(3U, 4U, 1U, 1U),
+             std::make_tuple(2U, 3U, 3U, 2U),
+             std::make_tuple(16U, 32U, 2U, 1U))
+{
+    Random::mtSeed(0);
+
+    const unsigned int channelsWidth = 11;
+    const unsigned int channelsHeight = 13;
+    const unsigned int outputsWidth
+        = (channelsWidth - 3 + 1 + subSample - 1) / subSample;
+    const unsigned int outputsHeight
+        = (channelsHeight - 3 + 1 + subSample - 1) / subSample;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({subSample, subSample}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<int>({0, 0}),
+        std::vector<unsigned int>({1U, 1U}));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> diffInputs({outputsWidth, outputsHeight, nbOutputs,
+                              batchSize});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+
+    Tensor<float> diffKernels({3, 3, nbChannels, nbOutputs});
+    Tensor<float> diffBias({1, 1, nbOutputs});
+
+    ConvCell_Frame_Kernels::backwardFilter(&alpha, inputs, diffInputs, desc,
+                                           &beta, diffKernels);
+    ConvCell_Frame_Kernels::backwardBias(&alpha, diffInputs, &beta,
+                                         diffBias);
+
+    // Reference gradients, accumulated sequentially in double precision
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        double biasSum = 0.0;
+
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+                for (unsigned int ox = 0; ox < outputsWidth; ++ox)
+                    biasSum += diffInputs(ox, oy, output, batchPos);
+            }
+        }
+
+        ASSERT_EQUALS_DELTA(diffBias(output), biasSum, 1.0e-4);
+
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int sy = 0; sy < 3; ++sy) {
+                for (unsigned int sx = 0; sx < 3; ++sx) {
+                    double gradient = 0.0;
+
+                    for (unsigned int batchPos = 0; batchPos < batchSize;
+                         ++batchPos)
+                    {
+                        for (unsigned int oy = 0; oy < channelsHeight - 2;
+                             ++oy)
+                        {
+                            for (unsigned int ox = 0; ox < channelsWidth - 2;
+                                 ++ox)
+                            {
+                                gradient += inputs(ox + sx, oy + sy, channel,
+                                                   batchPos)
+                                    * diffInputs(ox / subSample,
+                                                 oy / subSample,
+                                                 output,
+                                                 batchPos);
+                            }
+                        }
+                    }
+
+                    ASSERT_EQUALS_DELTA(diffKernels(sx, sy, channel, output),
+                                        gradient, 1.0e-4);
+                }
+            }
+        }
+    }
+
+#ifdef _OPENMP
+    // The result must not depend on the number of threads
+    const int maxThreads = omp_get_max_threads();
+
+    for (int nbThreads = 1; nbThreads <= 7; nbThreads += 3) {
+        omp_set_num_threads(nbThreads);
+
+        Tensor<float> diffKernelsThreads(diffKernels.dims());
+        Tensor<float> diffBiasThreads(diffBias.dims());
+
+        ConvCell_Frame_Kernels::backwardFilter(&alpha, inputs, diffInputs,
+                                               desc, &beta,
+                                               diffKernelsThreads);
+        ConvCell_Frame_Kernels::backwardBias(&alpha, diffInputs, &beta,
+                                             diffBiasThreads);
+
+        for (unsigned int index = 0; index < diffKernels.size(); ++index) {
+            ASSERT_EQUALS(diffKernelsThreads(index), diffKernels(index));
+        }
+
+        for (unsigned int index = 0; index < diffBias.size(); ++index) {
+            ASSERT_EQUALS(diffBiasThreads(index), diffBias(index));
+        }
+    }
+
+    omp_set_num_threads(maxThreads);
+#endif
+}
+
+TEST_DATASET(ConvCell_Frame_float,
+             layout_check,
+             (TensorLayout::Layout layout,
+              unsigned int nbChannels,
+              unsigned int nbOutputs,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int dilation),
+             std::make_tuple(TensorLayout::NHWC, 3U, 5U, 1U, 1U, 0U, 0U, 1U),
+             std::make_tuple(TensorLayout::NHWC, 20U, 7U, 2U, 1U, 1U, 2U, 1U),
+             std::make_tuple(TensorLayout::NHWC, 4U, 4U, 1U, 1U, 2U, 2U, 2U),
+             std::make_tuple(TensorLayout::NCHW8c, 3U, 5U, 1U, 1U, 0U, 0U, 1U),
+             std::make_tuple(TensorLayout::NCHW8c, 20U, 9U, 1U, 2U, 1U, 1U, 1U),
+             std::make_tuple(TensorLayout::NCHW8c, 8U, 8U, 1U, 1U, 2U, 2U, 2U),
+             std::make_tuple(TensorLayout::NCHW16c, 20U, 17U, 2U, 2U, 1U, 0U,
+                             1U))
+{
+    Random::mtSeed(0);
+
+    const unsigned int kernelWidth = 3;
+    const unsigned int kernelHeight = 3;
+    const unsigned int channelsWidth = 11;
+    const unsigned int channelsHeight = 13;
+    const unsigned int batchSize = 2;
+
+    const unsigned int kernelExtentX = dilation * (kernelWidth - 1) + 1;
+    const unsigned int kernelExtentY = dilation * (kernelHeight - 1) + 1;
+    const unsigned int outputsWidth = (channelsWidth + 2 * paddingX
+                                       - kernelExtentX + strideX) / strideX;
+    const unsigned int outputsHeight = (channelsHeight + 2 * paddingY
+                                        - kernelExtentY + strideY) / strideY;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({dilation, dilation}));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> kernels({kernelWidth, kernelHeight, nbChannels, nbOutputs});
+    Tensor<float> outputs({outputsWidth, outputsHeight, nbOutputs,
+                           batchSize});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < kernels.size(); ++index)
+        kernels(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        outputs(index) = Random::randUniform(-1.0, 1.0);
+
+    const float alpha = 1.5f;
+    const float beta = 0.5f;
+
+    Tensor<float> outputsLayout = outputs.clone();
+
+    // Reference in the NCHW layout
+    ConvCell_Frame_Kernels::forwardIm2Col(&alpha, inputs, kernels, desc,
+                                          &beta, outputs);
+
+    Tensor<float> layoutInputs;
+    Tensor<float> layoutFilters;
+    TensorLayout::toLayout(inputs, layout, layoutInputs);
+    ConvCell_Frame_Kernels::packFilters(kernels, layout, layoutFilters);
+    ConvCell_Frame_Kernels::forwardLayout(&alpha, layoutInputs, layoutFilters,
+                                          layout, desc, &beta, outputsLayout);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(outputsLayout(index), outputs(index), 1.0e-4);
+    }
+}
+
+TEST_DATASET(ConvCell_Frame_float,
+             winograd_check,
+             (unsigned int tileSize,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight,
+              bool mapping),
+             std::make_tuple(2U, 0U, 0U, 8U, 8U, false),
+             std::make_tuple(2U, 1U, 1U, 11U, 13U, false),
+             std::make_tuple(2U, 2U, 0U, 13U, 10U, true),
+             std::make_tuple(4U, 0U, 0U, 10U, 10U, false),
+             std::make_tuple(4U, 1U, 1U, 13U, 11U, false),
+             std::make_tuple(4U, 0U, 2U, 9U, 14U, true),
+             std::make_tuple(4U, 2U, 2U, 3U, 5U, false))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbChannels = 3;
+    const unsigned int nbOutputs = 5;
+    const unsigned int batchSize = 2;
+    const unsigned int outputsWidth = channelsWidth + 2 * paddingX - 2;
+    const unsigned int outputsHeight = channelsHeight + 2 * paddingY - 2;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}));
+
+    ASSERT_TRUE(ConvCell_Frame_Kernels::isWinogradCompatible(3, 3, desc));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> kernels({3, 3, nbChannels, nbOutputs});
+    Tensor<float> diffInputs({outputsWidth, outputsHeight, nbOutputs,
+                              batchSize});
+    Tensor<bool> maps;
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < kernels.size(); ++index)
+        kernels(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    if (mapping) {
+        maps.resize({nbOutputs, nbChannels});
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel)
+                maps(output, channel) = ((output + channel) % 3 != 0);
+        }
+    }
+
+    const float alpha = 1.5f;
+    const float beta = 0.5f;
+
+    // Forward
+    Tensor<float> filters;
+    ConvCell_Frame_Kernels::winogradFilters(tileSize, kernels, false, filters,
+                                            maps);
+
+    ASSERT_EQUALS(filters.dimZ(), (tileSize + 2) * (tileSize + 2));
+
+    Tensor<float> outputs({outputsWidth, outputsHeight, nbOutputs,
+                           batchSize});
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        outputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> outputsWinograd = outputs.clone();
+
+    ConvCell_Frame_Kernels::forward(&alpha, inputs, kernels, desc, &beta,
+                                    outputs, maps);
+    ConvCell_Frame_Kernels::forwardWinograd(&alpha, inputs, filters, desc,
+                                            &beta, outputsWinograd);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(outputsWinograd(index), outputs(index), 1.0e-4);
+    }
+
+    // Backward data
+    Tensor<float> diffFilters;
+    ConvCell_Frame_Kernels::winogradFilters(tileSize, kernels, true,
+                                            diffFilters, maps);
+
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index)
+        diffOutputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> diffOutputsWinograd = diffOutputs.clone();
+
+    ConvCell_Frame_Kernels::backwardData(&alpha, kernels, diffInputs, desc,
+                                         &beta, diffOutputs, maps);
+    ConvCell_Frame_Kernels::backwardDataWinograd(&alpha, diffFilters,
+                                                 diffInputs, desc, &beta,
+                                                 diffOutputsWinograd);
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputsWinograd(index), diffOutputs(index),
+                            1.0e-4);
+    }
+}
+
+TEST(ConvCell_Frame_float, winograd_cache)
+{
+    const unsigned int nbChannels = 2;
+    const unsigned int nbOutputs = 3;
+
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {12, 10, nbChannels}, 2);
+
+    ConvCell_Frame_Test<float> conv1(dn, "conv1",
+        std::vector<unsigned int>({3U, 3U}),
+        nbOutputs,
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<int>({1, 1}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::shared_ptr<Activation>());
+    conv1.setParameter("NoBias", true);
+    conv1.addInput(env);
+    conv1.initialize();
+
+    ASSERT_EQUALS(conv1.mConvAlgorithm, ConvCell_Frame_Kernels::Winograd);
+
+    Tensor<Float_T>& in = env.getData();
+
+    for (unsigned int index = 0; index < in.size(); ++index)
+        in(index) = Random::randUniform(-1.0, 1.0);
+
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+    Tensor<float> outputs(conv1.mOutputs.dims());
+
+    for (unsigned int step = 0; step < 3; ++step) {
+        conv1.propagate();
+
+        ConvCell_Frame_Kernels::forward(&alpha,
+                                        tensor_cast<float>(in),
+                                        conv1.mSharedSynapses[0],
+                                        conv1.mConvDesc,
+                                        &beta,
+                                        outputs);
+
+        for (unsigned int index = 0; index < outputs.size(); ++index) {
+            ASSERT_EQUALS_DELTA(conv1.mOutputs(index), outputs(index),
+                                1.0e-4);
+        }
+
+        if (step == 0) {
+            // Weights changed with setWeight()
+            Tensor<float> kernel({3, 3}, 1.0f);
+            conv1.setWeight(1, 0, kernel);
+        }
+        else {
+            // Weights changed by the solver
+            for (unsigned int index = 0; index < conv1.mDiffInputs.size();
+                 ++index)
+            {
+                conv1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+            }
+
+            conv1.mDiffInputs.setValid();
+            conv1.backPropagate();
+            conv1.update();
+        }
+    }
+}
+
+TEST_DATASET(ConvCell_Frame_float,
+             sparse_check,
+             (unsigned int subSampleX,
+              unsigned int strideX,
+              unsigned int paddingX,
+              unsigned int dilationX,
+              double sparsity,
+              bool mapping),
+             std::make_tuple(1U, 1U, 0U, 1U, 0.7, false),
+             std::make_tuple(1U, 1U, 1U, 1U, 0.9, true),
+             std::make_tuple(1U, 2U, 1U, 1U, 0.8, false),
+             std::make_tuple(2U, 1U, 0U, 1U, 0.9, false),
+             std::make_tuple(1U, 1U, 2U, 2U, 0.95, true),
+             std::make_tuple(1U, 1U, 1U, 1U, 1.0, false))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbChannels = 4;
+    const unsigned int nbOutputs = 6;
+    const unsigned int batchSize = 2;
+    const unsigned int channelsWidth = 13;
+    const unsigned int channelsHeight = 11;
+
+    const unsigned int kernelExtent = dilationX * 2 + 1;
+    const unsigned int oxSize = (channelsWidth + 2 * paddingX - kernelExtent
+                                 + strideX) / strideX;
+    const unsigned int oySize = (channelsHeight + 2 * paddingX - kernelExtent
+                                 + strideX) / strideX;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({subSampleX, subSampleX}),
+        std::vector<unsigned int>({strideX, strideX}),
+        std::vector<int>({(int)paddingX, (int)paddingX}),
+        std::vector<unsigned int>({dilationX, dilationX}));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> kernels({3, 3, nbChannels, nbOutputs});
+    Tensor<bool> maps;
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < kernels.size(); ++index) {
+        kernels(index) = (Random::randUniform() < sparsity)
+            ? 0.0f : Random::randUniform(-1.0, 1.0);
+    }
+
+    if (mapping) {
+        maps.resize({nbOutputs, nbChannels});
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel)
+                maps(output, channel) = ((output + channel) % 3 != 0);
+        }
+    }
+
+    Sparse::CsrMatrix<float> filters;
+    ConvCell_Frame_Kernels::compressFilters(kernels, filters, maps);
+
+    ASSERT_EQUALS(filters.rows, nbOutputs);
+    ASSERT_EQUALS(filters.cols, 3U * 3U * nbChannels);
+    ASSERT_TRUE(filters.sparsity() >= sparsity - 0.15);
+
+    const float alpha = 1.5f;
+    const float beta = 0.5f;
+
+    Tensor<float> outputs({(oxSize + subSampleX - 1) / subSampleX,
+                           (oySize + subSampleX - 1) / subSampleX,
+                           nbOutputs, batchSize});
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        outputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<float> outputsSparse = outputs.clone();
+
+    ConvCell_Frame_Kernels::forwardIm2Col(&alpha, inputs, kernels, desc,
+                                          &beta, outputs, maps);
+    ConvCell_Frame_Kernels::forwardSparse(&alpha, inputs, filters, 3U, 3U,
+                                          desc, &beta, outputsSparse);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(outputsSparse(index), outputs(index), 1.0e-5);
+    }
+}
+
+TEST_DATASET(ConvCell_Frame_float,
+             int8_check,
+             (unsigned int subSampleX,
+              unsigned int strideX,
+              unsigned int paddingX,
+              bool unsignedInputs,
+              bool mapping),
+             std::make_tuple(1U, 1U, 0U, true, false),
+             std::make_tuple(1U, 1U, 1U, false, true),
+             std::make_tuple(1U, 2U, 1U, true, false),
+             std::make_tuple(2U, 1U, 0U, false, false))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbChannels = 4;
+    const unsigned int nbOutputs = 6;
+    const unsigned int batchSize = 2;
+    const unsigned int channelsWidth = 13;
+    const unsigned int channelsHeight = 11;
+
+    const unsigned int oxSize = (channelsWidth + 2 * paddingX - 3 + strideX)
+                                / strideX;
+    const unsigned int oySize = (channelsHeight + 2 * paddingX - 3 + strideX)
+                                / strideX;
+
+    const ConvCell_Frame_Kernels::Descriptor desc(
+        std::vector<unsigned int>({subSampleX, subSampleX}),
+        std::vector<unsigned int>({strideX, strideX}),
+        std::vector<int>({(int)paddingX, (int)paddingX}),
+        std::vector<unsigned int>({1U, 1U}));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> kernels({3, 3, nbChannels, nbOutputs});
+    Tensor<bool> maps;
+
+    for (unsigned int index = 0; index < inputs.size(); ++index) {
+        inputs(index) = (unsignedInputs)
+            ? Utils::round(Random::randUniform(0.0, 255.0))
+            : Utils::round(Random::randUniform(-128.0, 127.0));
+    }
+
+    for (unsigned int index = 0; index < kernels.size(); ++index)
+        kernels(index) = Utils::round(Random::randUniform(-127.0, 127.0));
+
+    if (mapping) {
+        maps.resize({nbOutputs, nbChannels});
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel)
+                maps(output, channel) = ((output + channel) % 3 != 0);
+        }
+    }
+
+    std::vector<std::int8_t> filters;
+    ASSERT_TRUE(ConvCell_Frame_Kernels::quantizeFilters(kernels, filters,
+                                                        maps));
+    ASSERT_EQUALS(filters.size(), kernels.size());
+
+    const float alpha = 1.0f;
+    const float beta = 0.5f;
+
+    Tensor<float> outputs({(oxSize + subSampleX - 1) / subSampleX,
+                           (oySize + subSampleX - 1) / subSampleX,
+                           nbOutputs, batchSize});
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        outputs(index) = Utils::round(Random::randUniform(-100.0, 100.0));
+
+    Tensor<float> outputsInt8 = outputs.clone();
+
+    ConvCell_Frame_Kernels::forwardIm2Col(&alpha, inputs, kernels, desc,
+                                          &beta, outputs, maps);
+    ASSERT_TRUE(ConvCell_Frame_Kernels::forwardInt8(inputs, filters, 3U, 3U,
+                                                    desc, &beta,
+                                                    outputsInt8));
+
+    // All the values are exactly representable
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS(outputsInt8(index), outputs(index));
+    }
+
+    // Non-integer inputs or weights are rejected
+    inputs(0) = 0.5f;
+    ASSERT_TRUE(!ConvCell_Frame_Kernels::forwardInt8(inputs, filters, 3U, 3U,
+                                                     desc, &beta,
+                                                     outputsInt8));
+
+    kernels(0) = 128.0f;
+    ASSERT_TRUE(!ConvCell_Frame_Kernels::quantizeFilters(kernels, filters));
+    ASSERT_TRUE(filters.empty());
+}
+
+TEST(ConvCell_Frame_float, sparse_update)
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbChannels = 3;
+    const unsigned int nbOutputs = 8;
+
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {12, 10, nbChannels}, 2);
+
+    ConvCell_Frame_Test<float> conv1(dn, "conv1",
+        std::vector<unsigned int>({3U, 3U}),
+        nbOutputs,
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<int>({1, 1}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::shared_ptr<Activation>());
+    conv1.setParameter("NoBias", true);
+    conv1.setParameter("SparsityThreshold", 0.75);
+    conv1.addInput(env);
+    conv1.initialize();
+
+    Tensor<Float_T>& in = env.getData();
+
+    for (unsigned int index = 0; index < in.size(); ++index)
+        in(index) = Random::randUniform(-1.0, 1.0);
+
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+    Tensor<float> outputs(conv1.mOutputs.dims());
+
+    // Dense weights
+    conv1.propagate();
+    ASSERT_TRUE(conv1.getSparseFilters(0, 0) == NULL);
+
+    // Pruned weights (80%)
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            Tensor<float> kernel;
+            conv1.getWeight(output, channel, kernel);
+
+            for (unsigned int index = 0; index < kernel.size(); ++index) {
+                if ((output * 9 * nbChannels + channel * 9 + index) % 5 != 0)
+                    kernel(index) = 0.0f;
+            }
+
+            conv1.setWeight(output, channel, kernel);
+        }
+    }
+
+    for (unsigned int step = 0; step < 3; ++step) {
+        conv1.propagate();
+
+        ASSERT_TRUE(conv1.getSparseFilters(0, 0) != NULL);
+
+        ConvCell_Frame_Kernels::forward(&alpha,
+                                        tensor_cast<float>(in),
+                                        conv1.mSharedSynapses[0],
+                                        conv1.mConvDesc,
+                                        &beta,
+                                        outputs);
+
+        for (unsigned int index = 0; index < outputs.size(); ++index) {
+            ASSERT_EQUALS_DELTA(conv1.mOutputs(index), outputs(index),
+                                1.0e-4);
+        }
+
+        // The sparsity pattern is kept by the solver
+        const Tensor<float>& sharedSynapses = conv1.mSharedSynapses[0];
+
+        for (unsigned int index = 0; index < sharedSynapses.size(); ++index) {
+            if (index % 5 != 0) {
+                ASSERT_EQUALS(sharedSynapses(index), 0.0f);
+            }
+        }
+
+        for (unsigned int index = 0; index < conv1.mDiffInputs.size();
+             ++index)
+        {
+            conv1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+        }
+
+        conv1.mDiffInputs.setValid();
+        conv1.backPropagate();
+        conv1.update();
+    }
+}
+
+TEST(ConvCell_Frame_float, algorithm)
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {16, 16, 1});
+
+    ConvCell_Frame_Test<float> conv1(dn, "conv1",
+        std::vector<unsigned int>({3U, 3U}),
+        4U,
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<int>({0, 0}),
+        std::vector<unsigned int>({2U, 2U}),
+        std::shared_ptr<Activation>());
+    conv1.addInput(env);
+
+    ASSERT_EQUALS(conv1.getOutputsWidth(), 12U);
+    ASSERT_EQUALS(conv1.getOutputsHeight(), 12U);
+
+    conv1.setParameter("Algorithm", std::string("Direct"));
+    ASSERT_THROW(conv1.initialize(), std::domain_error);
+
+    conv1.setParameter("Algorithm", std::string("Winograd"));
+    ASSERT_THROW(conv1.initialize(), std::domain_error);
+
+    conv1.setParameter("Algorithm", std::string("Im2Col"));
+    ASSERT_NOTHROW_ANY(conv1.initialize());
+
+    conv1.setParameter("Algorithm", std::string("Auto"));
+    ASSERT_NOTHROW_ANY(conv1.initialize());
+    ASSERT_EQUALS(conv1.mConvAlgorithm, ConvCell_Frame_Kernels::Im2Col);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // double
 ////////////////////////////////////////////////////////////////////////////////
@@ -1123,6 +2190,7 @@ TEST_DATASET(ConvCell_Frame_double,
         std::vector<unsigned int>({1U, 1U}),
         std::shared_ptr<Activation>());
     conv1.setParameter("NoBias", true);
+    conv1.setParameter("Algorithm", std::string("Direct"));
 
     Environment env(net, getDatabase(), {channelsWidth, channelsHeight, 1}, 2, false);
     env.addTransformation(RescaleTransformation(channelsWidth, channelsHeight));
@@ -1264,6 +2332,7 @@ TEST_DATASET(ConvCell_Frame_double,
         std::vector<unsigned int>({1U, 1U}),
         std::shared_ptr<Activation>());
     conv1.setParameter("NoBias", true);
+    conv1.setParameter("Algorithm", std::string("Direct"));
 
     Environment env(net, getDatabase(), {channelsWidth, channelsHeight, 1}, 2, false);
     env.addTransformation(RescaleTransformation(channelsWidth, channelsHeight));
@@ -1802,6 +2871,7 @@ TEST_DATASET(ConvCell_Frame_half,
         std::vector<unsigned int>({1U, 1U}),
         std::shared_ptr<Activation>());
     conv1.setParameter("NoBias", true);
+    conv1.setParameter("Algorithm", std::string("Direct"));
 
     Environment env(net, getDatabase(), {channelsWidth, channelsHeight, 1}, 2, false);
     env.addTransformation(RescaleTransformation(channelsWidth, channelsHeight));
@@ -1943,6 +3013,7 @@ TEST_DATASET(ConvCell_Frame_half,
         std::vector<unsigned int>({1U, 1U}),
         std::shared_ptr<Activation>());
     conv1.setParameter("NoBias", true);
+    conv1.setParameter("Algorithm", std::string("Direct"));
 
     Environment env(net, getDatabase(), {channelsWidth, channelsHeight, 1}, 2, false);
     env.addTransformation(RescaleTransformation(channelsWidth, channelsHeight));
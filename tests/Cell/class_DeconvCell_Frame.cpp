@@ -0,0 +1,162 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include "N2D2.hpp"
+
+#include "Cell/DeconvCell_Frame.hpp"
+#include "DeepNet.hpp"
+#include "Network.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+template <class T>
+class DeconvCell_Frame_Test : public DeconvCell_Frame<T> {
+public:
+    DeconvCell_Frame_Test(const DeepNet& deepNet,
+                          const std::string& name,
+                          const std::vector<unsigned int>& kernelDims,
+                          unsigned int nbOutputs,
+                          const std::vector<unsigned int>& strideDims,
+                          const std::vector<int>& paddingDims,
+                          const std::vector<unsigned int>& dilationDims)
+        : Cell(deepNet, name, nbOutputs),
+          DeconvCell(deepNet, name,
+                     kernelDims,
+                     nbOutputs,
+                     strideDims,
+                     paddingDims,
+                     dilationDims),
+          DeconvCell_Frame<T>(deepNet, name,
+                              kernelDims,
+                              nbOutputs,
+                              strideDims,
+                              paddingDims,
+                              dilationDims,
+                              std::shared_ptr<Activation>()) {};
+
+    friend class UnitTest_DeconvCell_Frame_float_Im2Col;
+};
+
+TEST_DATASET(DeconvCell_Frame_float,
+             Im2Col,
+             (unsigned int kernelSize,
+              unsigned int stride,
+              int padding,
+              unsigned int nbChannels,
+              unsigned int nbOutputs),
+             std::make_tuple(4U, 2U, 1, 8U, 8U),
+             std::make_tuple(3U, 1U, 1, 4U, 4U),
+             std::make_tuple(3U, 2U, 0, 4U, 4U),
+             std::make_tuple(2U, 2U, 0, 6U, 6U))
+{
+    const unsigned int channelsWidth = 9;
+    const unsigned int channelsHeight = 7;
+    const unsigned int batchSize = 2;
+
+    Network net;
+    DeepNet dn(net);
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, nbChannels,
+                          batchSize});
+    Tensor<float> diffOutputsDirect(inputs.dims());
+    Tensor<float> diffOutputsIm2Col(inputs.dims());
+
+    Random::mtSeed(0);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    std::vector<std::shared_ptr<DeconvCell_Frame_Test<float> > > cells;
+
+    for (unsigned int algo = 0; algo < 2; ++algo) {
+        cells.push_back(std::make_shared<DeconvCell_Frame_Test<float> >(dn,
+            "deconv" + std::to_string(algo),
+            std::vector<unsigned int>({kernelSize, kernelSize}),
+            nbOutputs,
+            std::vector<unsigned int>({stride, stride}),
+            std::vector<int>({padding, padding}),
+            std::vector<unsigned int>({1U, 1U})));
+
+        cells.back()->setParameter("Algorithm", (algo == 0)
+            ? ConvCell_Frame_Kernels::Direct : ConvCell_Frame_Kernels::Im2Col);
+        cells.back()->addInput(inputs, (algo == 0) ? diffOutputsDirect
+                                                   : diffOutputsIm2Col);
+        cells.back()->initialize();
+    }
+
+    DeconvCell_Frame_Test<float>& direct = *cells[0];
+    DeconvCell_Frame_Test<float>& im2Col = *cells[1];
+
+    // Same weights and biases for both cells
+    im2Col.mSharedSynapses[0] = direct.mSharedSynapses[0];
+    (*im2Col.mBias) = (*direct.mBias);
+
+    ASSERT_TRUE(direct.mConvAlgorithm == ConvCell_Frame_Kernels::Direct);
+    ASSERT_TRUE(im2Col.mConvAlgorithm == ConvCell_Frame_Kernels::Im2Col);
+
+    direct.propagate();
+    im2Col.propagate();
+
+    const Tensor<float>& outputsDirect
+        = tensor_cast<float>(direct.getOutputs());
+    const Tensor<float>& outputsIm2Col
+        = tensor_cast<float>(im2Col.getOutputs());
+
+    ASSERT_EQUALS(outputsIm2Col.dims(), outputsDirect.dims());
+
+    for (unsigned int index = 0; index < outputsDirect.size(); ++index) {
+        ASSERT_EQUALS_DELTA(outputsIm2Col(index), outputsDirect(index),
+                            1.0e-5);
+    }
+
+    for (unsigned int index = 0; index < direct.mDiffInputs.size(); ++index) {
+        direct.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+        im2Col.mDiffInputs(index) = direct.mDiffInputs(index);
+    }
+
+    direct.mDiffInputs.setValid();
+    im2Col.mDiffInputs.setValid();
+
+    direct.backPropagate();
+    im2Col.backPropagate();
+
+    for (unsigned int index = 0; index < diffOutputsDirect.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputsIm2Col(index),
+                            diffOutputsDirect(index), 1.0e-5);
+    }
+
+    const Tensor<float>& diffKernelsDirect = direct.mDiffSharedSynapses[0];
+    const Tensor<float>& diffKernelsIm2Col = im2Col.mDiffSharedSynapses[0];
+
+    for (unsigned int index = 0; index < diffKernelsDirect.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffKernelsIm2Col(index),
+                            diffKernelsDirect(index), 1.0e-4);
+    }
+
+    for (unsigned int index = 0; index < direct.mDiffBias.size(); ++index) {
+        ASSERT_EQUALS_DELTA(im2Col.mDiffBias(index),
+                            direct.mDiffBias(index), 1.0e-4);
+    }
+}
+
+RUN_TESTS()
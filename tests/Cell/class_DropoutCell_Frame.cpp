@@ -0,0 +1,108 @@
+/*
+    (C) Copyright 2014 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/DropoutCell_Frame.hpp"
+#include "DeepNet.hpp"
+#include "Network.hpp"
+#include "utils/UnitTest.hpp"
+#include "utils/Random.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(DropoutCell_Frame,
+             propagate,
+             (double dropout,
+              unsigned int inputWidth,
+              unsigned int inputHeight,
+              unsigned int batchSize),
+             std::make_tuple(0.5, 16, 16, 1),
+             std::make_tuple(0.2, 13, 7, 4),
+             std::make_tuple(0.8, 5, 9, 8))
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+
+    const unsigned int nbChannels = 5;
+    Tensor<Float_T> inputs({inputWidth, inputHeight, nbChannels, batchSize});
+    Tensor<Float_T> diffOutputs(inputs.dims());
+
+    for (unsigned int i = 0; i < inputs.size(); ++i)
+        inputs(i) = 1.0 + std::fabs(Random::randNormal());
+
+    DropoutCell_Frame<Float_T> dropout1(dn, "dropout1", nbChannels);
+    dropout1.setParameter("Dropout", dropout);
+    dropout1.addInput(inputs, diffOutputs);
+    dropout1.initialize();
+
+    // Inference: identity
+    dropout1.propagate(true);
+
+    const Tensor<Float_T>& outputs
+        = tensor_cast<Float_T>(dropout1.getOutputs());
+
+    for (unsigned int i = 0; i < inputs.size(); ++i)
+        ASSERT_EQUALS(outputs(i), inputs(i));
+
+    // Learning: the back-propagation must use the same mask as the
+    // propagation, which is different at each step
+    Tensor<Float_T> prevOutputs(outputs.dims());
+
+    for (unsigned int step = 0; step < 2; ++step) {
+        dropout1.propagate();
+
+        Tensor<Float_T>& diffInputs
+            = dynamic_cast<Tensor<Float_T>&>(dropout1.getDiffInputs());
+
+        for (unsigned int i = 0; i < diffInputs.size(); ++i)
+            diffInputs(i) = 1.0 + std::fabs(Random::randNormal());
+
+        diffInputs.setValid();
+        dropout1.backPropagate();
+
+        unsigned int nbKept = 0;
+
+        for (unsigned int i = 0; i < outputs.size(); ++i) {
+            if (outputs(i) != 0.0) {
+                ASSERT_EQUALS(outputs(i), inputs(i));
+                ASSERT_EQUALS(diffOutputs(i), diffInputs(i));
+                ++nbKept;
+            }
+            else
+                ASSERT_EQUALS(diffOutputs(i), 0.0);
+        }
+
+        ASSERT_EQUALS_DELTA(nbKept / (double)outputs.size(),
+                            1.0 - dropout, 0.1);
+
+        if (step > 0) {
+            ASSERT_TRUE(!std::equal(outputs.begin(), outputs.end(),
+                                    prevOutputs.begin()));
+        }
+
+        prevOutputs = outputs;
+        diffOutputs.clearValid();
+    }
+}
+
+RUN_TESTS()
@@ -27,6 +27,7 @@
 #include "Database/MNIST_IDX_Database.hpp"
 #include "Cell/FcCell_Frame.hpp"
 #include "third_party/half.hpp"
+#include "utils/Random.hpp"
 #include "utils/UnitTest.hpp"
 
 using namespace N2D2;
@@ -50,6 +51,9 @@ public:
     friend class UnitTest_FcCell_Frame_float_propagate_input_check;
     friend class UnitTest_FcCell_Frame_float_propagate_2_input_check;
     friend class UnitTest_FcCell_Frame_float_propagate_weight_check;
+    friend class UnitTest_FcCell_Frame_float_propagate_backpropagate_check;
+    friend class UnitTest_FcCell_Frame_float_sparse_check;
+    friend class UnitTest_FcCell_Frame_float_quantized_inference;
     friend class UnitTest_FcCell_Frame_double_addInput__env;
     friend class UnitTest_FcCell_Frame_double_addInput;
     friend class UnitTest_FcCell_Frame_double_addInput_multi_outputs;
@@ -623,9 +627,284 @@ TEST_DATASET(FcCell_Frame_float,
     }
 }
 
+TEST_DATASET(FcCell_Frame_float,
+             propagate_backpropagate_check,
+             (unsigned int nbOutputs,
+              unsigned int nbChannels,
+              unsigned int batchSize,
+              double dropConnect),
+             std::make_tuple(1U, 1U, 1U, 1.0),
+             std::make_tuple(3U, 5U, 2U, 1.0),
+             std::make_tuple(10U, 37U, 4U, 1.0),
+             std::make_tuple(67U, 300U, 5U, 1.0),
+             std::make_tuple(3U, 5U, 2U, 0.5),
+             std::make_tuple(67U, 300U, 5U, 0.5))
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {1, 1, 1}, batchSize, false);
+
+    FcCell_Frame_Test<float> fc1(
+        dn, "fc1", nbChannels, std::shared_ptr<Activation>());
+    FcCell_Frame_Test<float> fc2(
+        dn, "fc2", nbOutputs, std::shared_ptr<Activation>());
+    fc2.setParameter("DropConnect", dropConnect);
+
+    fc1.addInput(env);
+    fc2.addInput(&fc1);
+    fc1.initialize();
+    fc2.initialize();
+
+    Tensor<float> inputs = tensor_cast<float>(fc2.mInputs[0]);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    fc2.propagate();
+
+    const Tensor<float>& synapses = fc2.mSynapses[0];
+    const Tensor<bool>& mask = fc2.mDropConnectMask[0];
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            double weightedSum = fc2.mBias(output);
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                if (mask(channel, output)) {
+                    weightedSum += synapses(channel, output)
+                                   * inputs(channel, batchPos);
+                }
+            }
+
+            ASSERT_EQUALS_DELTA(fc2.mOutputs(output, batchPos), weightedSum,
+                                1.0e-5);
+        }
+    }
+
+    for (unsigned int index = 0; index < fc2.mDiffInputs.size(); ++index)
+        fc2.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    fc2.mDiffInputs.setValid();
+    fc2.backPropagate();
+
+    const Tensor<float> diffOutputs = tensor_cast<float>(fc2.mDiffOutputs[0]);
+    const Tensor<float>& diffSynapses = fc2.mDiffSynapses[0];
+
+    for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            double gradient = 0.0;
+
+            for (unsigned int output = 0; output < nbOutputs; ++output) {
+                if (mask(channel, output)) {
+                    gradient += synapses(channel, output)
+                                * fc2.mDiffInputs(output, batchPos);
+                }
+            }
+
+            ASSERT_EQUALS_DELTA(diffOutputs(channel, batchPos), gradient,
+                                1.0e-5);
+        }
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            double gradient = 0.0;
+
+            if (mask(channel, output)) {
+                for (unsigned int batchPos = 0; batchPos < batchSize;
+                     ++batchPos)
+                {
+                    gradient += inputs(channel, batchPos)
+                                * fc2.mDiffInputs(output, batchPos);
+                }
+            }
+
+            ASSERT_EQUALS_DELTA(diffSynapses(channel, output), gradient,
+                                1.0e-5);
+        }
+    }
+}
+
+TEST_DATASET(FcCell_Frame_float,
+             sparse_check,
+             (unsigned int nbOutputs,
+              unsigned int nbChannels,
+              unsigned int batchSize,
+              double sparsity),
+             std::make_tuple(3U, 5U, 2U, 0.8),
+             std::make_tuple(10U, 37U, 4U, 0.9),
+             std::make_tuple(67U, 300U, 5U, 0.7),
+             std::make_tuple(67U, 300U, 5U, 0.95))
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {1, 1, 1}, batchSize, false);
+
+    FcCell_Frame_Test<float> fc1(
+        dn, "fc1", nbChannels, std::shared_ptr<Activation>());
+    FcCell_Frame_Test<float> fc2(
+        dn, "fc2", nbOutputs, std::shared_ptr<Activation>());
+    fc2.setParameter("SparsityThreshold", 0.5);
+
+    fc1.addInput(env);
+    fc2.addInput(&fc1);
+    fc1.initialize();
+    fc2.initialize();
+
+    // Prune the weights
+    Tensor<bool> pruned({nbChannels, nbOutputs});
+
+    for (unsigned int output = 0; output < nbOutputs; ++output) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            pruned(channel, output) = (Random::randUniform() < sparsity);
+
+            if (pruned(channel, output)) {
+                Tensor<float> weight({1}, 0.0f);
+                fc2.setWeight(output, channel, weight);
+            }
+        }
+    }
+
+    Tensor<float> inputs = tensor_cast<float>(fc2.mInputs[0]);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int step = 0; step < 2; ++step) {
+        fc2.propagate();
+
+        ASSERT_TRUE(fc2.getSparseSynapses(0) != NULL);
+
+        const Tensor<float>& synapses = fc2.mSynapses[0];
+
+        for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+            for (unsigned int output = 0; output < nbOutputs; ++output) {
+                double weightedSum = fc2.mBias(output);
+
+                for (unsigned int channel = 0; channel < nbChannels;
+                     ++channel)
+                {
+                    weightedSum += synapses(channel, output)
+                                   * inputs(channel, batchPos);
+                }
+
+                ASSERT_EQUALS_DELTA(fc2.mOutputs(output, batchPos),
+                                    weightedSum, 1.0e-5);
+            }
+        }
+
+        for (unsigned int index = 0; index < fc2.mDiffInputs.size(); ++index)
+            fc2.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+        fc2.mDiffInputs.setValid();
+        fc2.mDiffOutputs.clearValid();
+        fc2.backPropagate();
+
+        const Tensor<float> diffOutputs
+            = tensor_cast<float>(fc2.mDiffOutputs[0]);
+
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int batchPos = 0; batchPos < batchSize;
+                 ++batchPos)
+            {
+                double gradient = 0.0;
+
+                for (unsigned int output = 0; output < nbOutputs; ++output) {
+                    gradient += synapses(channel, output)
+                                * fc2.mDiffInputs(output, batchPos);
+                }
+
+                ASSERT_EQUALS_DELTA(diffOutputs(channel, batchPos), gradient,
+                                    1.0e-5);
+            }
+        }
+
+        fc2.update();
+
+        // The sparsity pattern is kept by the solver
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                if (pruned(channel, output)) {
+                    ASSERT_EQUALS(synapses(channel, output), 0.0f);
+                }
+            }
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // double
 ////////////////////////////////////////////////////////////////////////////////
+TEST_DATASET(FcCell_Frame_float,
+             quantized_inference,
+             (unsigned int nbOutputs,
+              unsigned int nbChannels,
+              unsigned int batchSize,
+              bool unsignedInputs),
+             std::make_tuple(3U, 5U, 2U, true),
+             std::make_tuple(67U, 300U, 5U, true),
+             std::make_tuple(67U, 300U, 5U, false))
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {1, 1, 1}, batchSize, false);
+
+    FcCell_Frame_Test<float> fc1(
+        dn, "fc1", nbChannels, std::shared_ptr<Activation>());
+    FcCell_Frame_Test<float> fc2(
+        dn, "fc2", nbOutputs, std::shared_ptr<Activation>());
+    fc2.setParameter("QuantizedInference", true);
+
+    fc1.addInput(env);
+    fc2.addInput(&fc1);
+    fc1.initialize();
+    fc2.initialize();
+
+    // 8 bits weights, as after DeepNetQuantization
+    fc2.processFreeParameters([](double wt) {
+        return Utils::round(wt * 127.0); }, Cell::Multiplicative);
+    fc2.processFreeParameters([](double bias) {
+        return Utils::round(bias * 1000.0); }, Cell::Additive);
+
+    Tensor<float> inputs = tensor_cast<float>(fc2.mInputs[0]);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index) {
+        inputs(index) = (unsignedInputs)
+            ? Utils::round(Random::randUniform(0.0, 255.0))
+            : Utils::round(Random::randUniform(-128.0, 127.0));
+    }
+
+    fc2.propagate(true);
+
+    ASSERT_TRUE(fc2.getInt8Synapses(0) != NULL);
+
+    const Tensor<float>& synapses = fc2.mSynapses[0];
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            double weightedSum = fc2.mBias(output);
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                weightedSum += synapses(channel, output)
+                               * inputs(channel, batchPos);
+            }
+
+            ASSERT_EQUALS(fc2.mOutputs(output, batchPos), weightedSum);
+        }
+    }
+
+    // Non-integer weights: the float kernels are used
+    Tensor<float> weight({1}, 0.5f);
+    fc2.setWeight(0, 0, weight);
+    fc2.propagate(true);
+
+    ASSERT_TRUE(fc2.getInt8Synapses(0) == NULL);
+}
+
 TEST_DATASET(FcCell_Frame_double,
              FcCell_Frame,
              (unsigned int nbOutputs),
@@ -1713,17 +1992,20 @@ TEST_DATASET(FcCell_Frame_half,
     ASSERT_EQUALS(out.dimX(), 1U);
     ASSERT_EQUALS(out.dimY(), 1U);
 
+    // The half precision kernels accumulate in float: only the final
+    // rounding to half is expected
     for (unsigned int output = 0; output < out.dimZ(); ++output) {
-        half_float::half sum(0.0f);
+        float sum = 0.0f;
 
         for (unsigned int channel = 0; channel < inputSize; ++channel) {
             Tensor<half_float::half> weight;
             fc1.getWeight(output, channel, weight);
 
-            sum += weight(0);
+            sum += (float)weight(0);
         }
 
-        ASSERT_EQUALS_DELTA(out(output, 0), sum, 1e-5);
+        ASSERT_EQUALS_DELTA((float)out(output, 0), sum,
+                            std::fabs(sum) * 1.0e-3 + 1.0e-5);
     }
 }
 
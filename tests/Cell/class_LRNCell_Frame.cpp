@@ -0,0 +1,98 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include "N2D2.hpp"
+
+#include "Cell/LRNCell_Frame.hpp"
+#include "DeepNet.hpp"
+#include "Network.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(LRNCell_Frame_double,
+             propagate_backPropagate,
+             (unsigned int n,
+              unsigned int nbOutputs,
+              unsigned int width,
+              unsigned int height),
+             std::make_tuple(1U, 4U, 5U, 3U),
+             std::make_tuple(3U, 4U, 5U, 3U),
+             std::make_tuple(5U, 5U, 5U, 3U),
+             std::make_tuple(5U, 16U, 20U, 15U),
+             std::make_tuple(4U, 9U, 20U, 15U))
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int batchSize = 2;
+    const double alpha = 0.1;
+    const double beta = 0.75;
+    const double k = 2.0;
+
+    LRNCell_Frame<double> lrn(dn, "lrn", nbOutputs);
+    lrn.setParameter("N", n);
+    lrn.setParameter("Alpha", alpha);
+    lrn.setParameter("Beta", beta);
+    lrn.setParameter("K", k);
+
+    Tensor<double> inputs({width, height, nbOutputs, batchSize});
+    Tensor<double> diffOutputs({width, height, nbOutputs, batchSize});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-2.0, 2.0);
+
+    lrn.addInput(inputs, diffOutputs);
+    lrn.initialize();
+    lrn.propagate();
+
+    const Tensor<double>& outputs = tensor_cast<double>(lrn.getOutputs());
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int channel = 0; channel < nbOutputs; ++channel) {
+            const unsigned int channelMin = std::max<int>(0, channel - n / 2);
+            const unsigned int channelMax
+                = std::min(nbOutputs - 1, channel + n / 2);
+
+            for (unsigned int y = 0; y < height; ++y) {
+                for (unsigned int x = 0; x < width; ++x) {
+                    double acc = 0.0;
+
+                    for (unsigned int c = channelMin; c <= channelMax; ++c)
+                        acc += inputs(x, y, c, batchPos)
+                            * inputs(x, y, c, batchPos);
+
+                    ASSERT_EQUALS_DELTA(outputs(x, y, channel, batchPos),
+                        inputs(x, y, channel, batchPos)
+                            / std::pow(k + alpha * acc, beta),
+                        1.0e-9);
+                }
+            }
+        }
+    }
+
+    ASSERT_NOTHROW_ANY(lrn.checkGradient(1.0e-5, 1.0e-5));
+}
+
+RUN_TESTS()
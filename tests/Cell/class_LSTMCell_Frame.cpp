@@ -0,0 +1,381 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/LSTMCell_Frame.hpp"
+#include "DeepNet.hpp"
+#include "Filler/UniformFiller.hpp"
+#include "Network.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+template <class T>
+void setFillers(LSTMCell_Frame<T>& lstm)
+{
+    lstm.setWeightsPreviousLayerAllGateFiller_1stLayer(
+        std::make_shared<UniformFiller<T> >(-0.5, 0.5));
+    lstm.setWeightsPreviousLayerAllGateFiller(
+        std::make_shared<UniformFiller<T> >(-0.5, 0.5));
+    lstm.setWeightsRecurrentAllGateFiller(
+        std::make_shared<UniformFiller<T> >(-0.5, 0.5));
+    lstm.setBiasAllGateFiller(
+        std::make_shared<UniformFiller<T> >(-0.5, 0.5));
+}
+
+/// Return the maximum absolute difference between the outputs of @p lstm
+/// (one unidirectional layer) and a reference computed in double precision,
+/// one gate at a time, using the parameter accessors
+template <class T>
+double referenceError(const LSTMCell_Frame<T>& lstm, const Tensor<T>& inputs)
+{
+    const unsigned int inputDim = inputs.dimY();
+    const unsigned int batchSize = inputs.dimZ();
+    const unsigned int seqLength = inputs.dimB();
+    const unsigned int hiddenSize = lstm.getOutputs().dimY();
+
+    const Tensor<T>& outputs = tensor_cast<T>(lstm.getOutputs());
+    Tensor<double> value;
+    double maxError = 0.0;
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        std::vector<double> h(hiddenSize, 0.0);
+        std::vector<double> c(hiddenSize, 0.0);
+
+        for (unsigned int t = 0; t < seqLength; ++t) {
+            std::vector<double> hNext(hiddenSize);
+
+            for (unsigned int j = 0; j < hiddenSize; ++j) {
+                double gates[4];
+
+                for (unsigned int gate = 0; gate < 4; ++gate) {
+                    double acc = 0.0;
+
+                    for (unsigned int i = 0; i < inputDim; ++i) {
+                        // (gate, j, i) is at j * inputDim + i, as cuDNN
+                        const unsigned int pos = j * inputDim + i;
+
+                        if (gate == 0)
+                            lstm.getWeightPLIG_1stLayer(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+                        else if (gate == 1)
+                            lstm.getWeightPLFG_1stLayer(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+                        else if (gate == 2)
+                            lstm.getWeightPLCG_1stLayer(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+                        else
+                            lstm.getWeightPLOG_1stLayer(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+
+                        acc += value(0) * (double)inputs(0, i, batchPos, t);
+                    }
+
+                    for (unsigned int k = 0; k < hiddenSize; ++k) {
+                        const unsigned int pos = j * hiddenSize + k;
+
+                        if (gate == 0)
+                            lstm.getWeightRIG(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+                        else if (gate == 1)
+                            lstm.getWeightRFG(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+                        else if (gate == 2)
+                            lstm.getWeightRCG(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+                        else
+                            lstm.getWeightROG(pos / hiddenSize,
+                                pos % hiddenSize, 0, value);
+
+                        acc += value(0) * h[k];
+                    }
+
+                    Tensor<double> biasR;
+
+                    if (gate == 0) {
+                        lstm.getBiasPLIG(j, 0, value);
+                        lstm.getBiasRIG(j, 0, biasR);
+                    }
+                    else if (gate == 1) {
+                        lstm.getBiasPLFG(j, 0, value);
+                        lstm.getBiasRFG(j, 0, biasR);
+                    }
+                    else if (gate == 2) {
+                        lstm.getBiasPLCG(j, 0, value);
+                        lstm.getBiasRCG(j, 0, biasR);
+                    }
+                    else {
+                        lstm.getBiasPLOG(j, 0, value);
+                        lstm.getBiasROG(j, 0, biasR);
+                    }
+
+                    acc += value(0) + biasR(0);
+                    gates[gate] = (gate == 2) ? std::tanh(acc)
+                                              : 1.0 / (1.0 + std::exp(-acc));
+                }
+
+                c[j] = gates[1] * c[j] + gates[0] * gates[2];
+                hNext[j] = gates[3] * std::tanh(c[j]);
+            }
+
+            h.swap(hNext);
+
+            for (unsigned int j = 0; j < hiddenSize; ++j) {
+                maxError = std::max(maxError,
+                    std::fabs((double)outputs(0, j, batchPos, t) - h[j]));
+            }
+        }
+    }
+
+    return maxError;
+}
+
+TEST_DATASET(LSTMCell_Frame_float,
+             propagate_backPropagate,
+             (unsigned int numberLayers, unsigned int bidirectional),
+             std::make_tuple(1U, 0U),
+             std::make_tuple(1U, 1U),
+             std::make_tuple(2U, 0U),
+             std::make_tuple(2U, 1U),
+             std::make_tuple(3U, 1U))
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int seqLength = 4;
+    const unsigned int batchSize = 3;
+    const unsigned int inputDim = 5;
+    const unsigned int hiddenSize = 6;
+
+    LSTMCell_Frame<float> lstm(dn, "lstm",
+                               seqLength,
+                               batchSize,
+                               inputDim,
+                               numberLayers,
+                               hiddenSize,
+                               0,
+                               batchSize,
+                               bidirectional,
+                               1,
+                               0.0,
+                               false);
+    setFillers(lstm);
+
+    Tensor<float> inputs({1, inputDim, batchSize, seqLength});
+    Tensor<float> diffOutputs({1, inputDim, batchSize, seqLength});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    lstm.addInput(inputs, diffOutputs);
+    lstm.initialize();
+
+    const unsigned int biDirScale = (bidirectional) ? 2 : 1;
+
+    ASSERT_EQUALS(lstm.getOutputs().dimX(), 1U);
+    ASSERT_EQUALS(lstm.getOutputs().dimY(), hiddenSize * biDirScale);
+    ASSERT_EQUALS(lstm.getOutputs().dimZ(), batchSize);
+    ASSERT_EQUALS(lstm.getOutputs().dimB(), seqLength);
+
+    ASSERT_NOTHROW_ANY(lstm.checkGradient(1.0e-3, 1.0e-2));
+}
+
+TEST(LSTMCell_Frame_float, propagate)
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int seqLength = 3;
+    const unsigned int batchSize = 2;
+    const unsigned int inputDim = 4;
+    const unsigned int hiddenSize = 3;
+
+    LSTMCell_Frame<float> lstm(dn, "lstm",
+                               seqLength,
+                               batchSize,
+                               inputDim,
+                               1,
+                               hiddenSize,
+                               0,
+                               batchSize,
+                               0,
+                               1,
+                               0.0,
+                               false);
+    setFillers(lstm);
+
+    Tensor<float> inputs({1, inputDim, batchSize, seqLength});
+    Tensor<float> diffOutputs({1, inputDim, batchSize, seqLength});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    lstm.addInput(inputs, diffOutputs);
+    lstm.initialize();
+    lstm.propagate();
+
+    ASSERT_EQUALS_DELTA(referenceError(lstm, inputs), 0.0, 1.0e-6);
+}
+
+TEST_DATASET(LSTMCell_Frame_double,
+             propagate_backPropagate,
+             (unsigned int numberLayers, unsigned int bidirectional),
+             std::make_tuple(1U, 0U),
+             std::make_tuple(1U, 1U),
+             std::make_tuple(2U, 0U),
+             std::make_tuple(2U, 1U),
+             std::make_tuple(3U, 1U))
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int seqLength = 4;
+    const unsigned int batchSize = 3;
+    const unsigned int inputDim = 5;
+    const unsigned int hiddenSize = 6;
+
+    LSTMCell_Frame<double> lstm(dn, "lstm",
+                                seqLength,
+                                batchSize,
+                                inputDim,
+                                numberLayers,
+                                hiddenSize,
+                                0,
+                                batchSize,
+                                bidirectional,
+                                1,
+                                0.0,
+                                false);
+    setFillers(lstm);
+
+    Tensor<double> inputs({1, inputDim, batchSize, seqLength});
+    Tensor<double> diffOutputs({1, inputDim, batchSize, seqLength});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    lstm.addInput(inputs, diffOutputs);
+    lstm.initialize();
+
+    const unsigned int biDirScale = (bidirectional) ? 2 : 1;
+
+    ASSERT_EQUALS(lstm.getOutputs().dimX(), 1U);
+    ASSERT_EQUALS(lstm.getOutputs().dimY(), hiddenSize * biDirScale);
+    ASSERT_EQUALS(lstm.getOutputs().dimZ(), batchSize);
+    ASSERT_EQUALS(lstm.getOutputs().dimB(), seqLength);
+
+    ASSERT_NOTHROW_ANY(lstm.checkGradient(1.0e-5, 1.0e-5));
+}
+
+TEST(LSTMCell_Frame_double, propagate)
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int seqLength = 3;
+    const unsigned int batchSize = 2;
+    const unsigned int inputDim = 4;
+    const unsigned int hiddenSize = 3;
+
+    LSTMCell_Frame<double> lstm(dn, "lstm",
+                                seqLength,
+                                batchSize,
+                                inputDim,
+                                1,
+                                hiddenSize,
+                                0,
+                                batchSize,
+                                0,
+                                1,
+                                0.0,
+                                false);
+    setFillers(lstm);
+
+    Tensor<double> inputs({1, inputDim, batchSize, seqLength});
+    Tensor<double> diffOutputs({1, inputDim, batchSize, seqLength});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    lstm.addInput(inputs, diffOutputs);
+    lstm.initialize();
+    lstm.propagate();
+
+    ASSERT_EQUALS_DELTA(referenceError(lstm, inputs), 0.0, 1.0e-12);
+}
+
+TEST(LSTMCell_Frame_double, exportFreeParameters)
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int seqLength = 3;
+    const unsigned int batchSize = 2;
+    const unsigned int inputDim = 4;
+    const unsigned int hiddenSize = 3;
+
+    LSTMCell_Frame<double> lstm1(dn, "lstm1",
+        seqLength, batchSize, inputDim, 2, hiddenSize, 0, batchSize,
+        1, 1, 0.0, false);
+    setFillers(lstm1);
+
+    LSTMCell_Frame<double> lstm2(dn, "lstm2",
+        seqLength, batchSize, inputDim, 2, hiddenSize, 0, batchSize,
+        1, 1, 0.0, false);
+
+    Tensor<double> inputs({1, inputDim, batchSize, seqLength});
+    Tensor<double> diffOutputs1({1, inputDim, batchSize, seqLength});
+    Tensor<double> diffOutputs2({1, inputDim, batchSize, seqLength});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    lstm1.addInput(inputs, diffOutputs1);
+    lstm1.initialize();
+    lstm2.addInput(inputs, diffOutputs2);
+    lstm2.initialize();
+
+    Utils::createDirectories("LSTMCell_Frame");
+    lstm1.exportFreeParameters("LSTMCell_Frame/lstm.syntxt");
+    lstm2.importFreeParameters("LSTMCell_Frame/lstm.syntxt", false);
+
+    lstm1.propagate(true);
+    lstm2.propagate(true);
+
+    const Tensor<double>& outputs1 = tensor_cast<double>(lstm1.getOutputs());
+    const Tensor<double>& outputs2 = tensor_cast<double>(lstm2.getOutputs());
+
+    for (unsigned int index = 0; index < outputs1.size(); ++index)
+        ASSERT_EQUALS_DELTA(outputs1(index), outputs2(index), 1.0e-6);
+}
+
+RUN_TESTS()
@@ -28,6 +28,7 @@
 #include "third_party/half.hpp"
 #include "Transformation/ColorSpaceTransformation.hpp"
 #include "Transformation/RescaleTransformation.hpp"
+#include "utils/Random.hpp"
 #include "utils/UnitTest.hpp"
 
 using namespace N2D2;
@@ -1474,4 +1475,141 @@ TEST_DATASET(PoolCell_Frame,
 }
 
 
+TEST_DATASET(PoolCell_Frame,
+             specialized_check,
+             (unsigned int poolDim,
+              unsigned int stride,
+              unsigned int padding,
+              unsigned int width,
+              unsigned int height),
+             std::make_tuple(2U, 2U, 0U, 8U, 8U),
+             std::make_tuple(2U, 2U, 0U, 9U, 7U),
+             std::make_tuple(2U, 2U, 1U, 9U, 7U),
+             std::make_tuple(3U, 2U, 0U, 9U, 9U),
+             std::make_tuple(3U, 2U, 1U, 8U, 11U),
+             std::make_tuple(3U, 2U, 1U, 32U, 17U),
+             // Global pooling
+             std::make_tuple(0U, 1U, 0U, 7U, 7U),
+             std::make_tuple(0U, 1U, 0U, 13U, 5U),
+             std::make_tuple(0U, 1U, 0U, 3U, 2U))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbChannels = 3;
+    const unsigned int batchSize = 2;
+    const unsigned int poolDims[2] = {(poolDim > 0) ? poolDim : width,
+                                      (poolDim > 0) ? poolDim : height};
+    const unsigned int strideDims[2] = {stride, stride};
+    const unsigned int paddingDims[2] = {padding, padding};
+    const PoolCell_Frame_Kernels::Descriptor desc(2, poolDims, strideDims,
+                                                  paddingDims);
+
+    const unsigned int oxSize
+        = (width + 2 * padding - poolDims[0]) / stride + 1;
+    const unsigned int oySize
+        = (height + 2 * padding - poolDims[1]) / stride + 1;
+
+    // Values on a coarse grid, to check that the ties of the max. pooling
+    // are resolved the same way
+    Tensor<float> inputs({width, height, nbChannels, batchSize});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Utils::round(Random::randUniform(-2.0, 2.0) * 4.0)
+                        / 4.0;
+
+    // One-to-one mapping
+    Tensor<bool> maps({nbChannels, nbChannels}, false);
+
+    for (unsigned int channel = 0; channel < nbChannels; ++channel)
+        maps(channel, channel) = true;
+
+    const PoolCell_Frame_Kernels::Specialization specialization
+        = PoolCell_Frame_Kernels::getSpecialization(desc, inputs.dims(),
+                                      {oxSize, oySize, nbChannels, batchSize});
+
+    ASSERT_TRUE(specialization == ((poolDim == 0)
+        ? PoolCell_Frame_Kernels::Global
+        : (poolDim == 2) ? PoolCell_Frame_Kernels::Pool2x2Stride2
+                         : PoolCell_Frame_Kernels::Pool3x3Stride2));
+
+    const float alpha = 1.0f;
+    const float beta = 0.0f;
+
+    // Average pooling
+    for (unsigned int countIncludePadding = 0; countIncludePadding < 2;
+        ++countIncludePadding)
+    {
+        Tensor<float> outputs({oxSize, oySize, nbChannels, batchSize});
+        Tensor<float> outputsRef({oxSize, oySize, nbChannels, batchSize});
+
+        PoolCell_Frame_Kernels::forwardAverage(&alpha, inputs, desc, &beta,
+            outputsRef, (bool)countIncludePadding, maps);
+        PoolCell_Frame_Kernels::forwardAverage(&alpha, inputs, desc, &beta,
+            outputs, (bool)countIncludePadding, maps, specialization);
+
+        for (unsigned int index = 0; index < outputs.size(); ++index) {
+            ASSERT_EQUALS_DELTA(outputs(index), outputsRef(index), 1.0e-6);
+        }
+    }
+
+    // Max pooling
+    Tensor<float> outputs({oxSize, oySize, nbChannels, batchSize});
+    Tensor<float> outputsRef({oxSize, oySize, nbChannels, batchSize});
+    Tensor<PoolCell_Frame_Kernels::ArgMax> argMax(outputs.dims());
+    Tensor<PoolCell_Frame_Kernels::ArgMax> argMaxRef(outputs.dims());
+
+    PoolCell_Frame_Kernels::forwardMax(&alpha, inputs, desc, &beta,
+        outputsRef, argMaxRef, false, maps);
+    PoolCell_Frame_Kernels::forwardMax(&alpha, inputs, desc, &beta,
+        outputs, argMax, false, maps, specialization);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS(outputs(index), outputsRef(index));
+        ASSERT_TRUE(argMax(index) == argMaxRef(index));
+    }
+
+    // Without argMax
+    Tensor<PoolCell_Frame_Kernels::ArgMax> noArgMax;
+    Tensor<float> outputsNoArgMax({oxSize, oySize, nbChannels, batchSize});
+
+    PoolCell_Frame_Kernels::forwardMax(&alpha, inputs, desc, &beta,
+        outputsNoArgMax, noArgMax, false, maps, specialization);
+
+    for (unsigned int index = 0; index < outputs.size(); ++index) {
+        ASSERT_EQUALS(outputsNoArgMax(index), outputsRef(index));
+    }
+
+    // Scatter of the gradient to the max. inputs
+    Tensor<float> diffInputs(outputs.dims());
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    Tensor<double> diffOutputsRef(inputs.dims(), 0.0);
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbChannels; ++output) {
+            for (unsigned int oy = 0; oy < oySize; ++oy) {
+                for (unsigned int ox = 0; ox < oxSize; ++ox) {
+                    const PoolCell_Frame_Kernels::ArgMax& inputMax
+                        = argMaxRef(ox, oy, output, batchPos);
+
+                    diffOutputsRef(inputMax.ix, inputMax.iy,
+                                   inputMax.channel, batchPos)
+                        += diffInputs(ox, oy, output, batchPos);
+                }
+            }
+        }
+    }
+
+    Tensor<float> diffOutputs(inputs.dims());
+    PoolCell_Frame_Kernels::backwardMax(&alpha, diffInputs, desc, &beta,
+        diffOutputs, argMax, maps);
+
+    for (unsigned int index = 0; index < diffOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputs(index), diffOutputsRef(index),
+                            1.0e-6);
+    }
+}
+
 RUN_TESTS()
@@ -379,6 +379,182 @@ TEST(ROIPoolingCell_Frame,
     }
 }
 
+TEST_DATASET(ROIPoolingCell_Frame,
+             propagate_roialign,
+             (unsigned int samplingRatio),
+             std::make_tuple(0U),
+             std::make_tuple(1U),
+             std::make_tuple(2U))
+{
+    const unsigned int outputsWidth = 7;
+    const unsigned int outputsHeight = 5;
+    const unsigned int nbOutputs = 2;
+    const unsigned int channelsWidth = 32;
+    const unsigned int channelsHeight = 24;
+    const unsigned int nbProposals = 3;
+
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {channelsWidth, channelsHeight, 1});
+
+    ROIPoolingCell_Frame_Test pool1(dn, "pool1",
+                                    env,
+                                    outputsWidth,
+                                    outputsHeight,
+                                    nbOutputs,
+                                    ROIPoolingCell::ROIAlign);
+    pool1.setParameter("SamplingRatio", samplingRatio);
+
+    Tensor<Float_T> proposals({1, 1, 4, nbProposals});
+    Tensor<Float_T> proposalsDiff({1, 1, 4, nbProposals});
+    Tensor<Float_T> inputs({channelsWidth, channelsHeight, nbOutputs, 1});
+    Tensor<Float_T> inputsDiff({channelsWidth, channelsHeight, nbOutputs, 1});
+
+    proposals(0, 0) = 3.3;
+    proposals(1, 0) = 2.7;
+    proposals(2, 0) = 15.2;
+    proposals(3, 0) = 9.9;
+    // Partially outside of the image
+    proposals(0, 1) = 20.5;
+    proposals(1, 1) = 14.25;
+    proposals(2, 1) = 20.0;
+    proposals(3, 1) = 15.0;
+    // Smaller than a pixel
+    proposals(0, 2) = -3.0;
+    proposals(1, 2) = 5.5;
+    proposals(2, 2) = 2.0;
+    proposals(3, 2) = 0.5;
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    pool1.addInput(proposals, proposalsDiff);
+    pool1.addInput(inputs, inputsDiff);
+    pool1.initialize();
+
+    pool1.propagate();
+
+    const Tensor<Float_T>& out = tensor_cast<Float_T>(pool1.getOutputs());
+
+    for (unsigned int batch = 0; batch < nbProposals; ++batch) {
+        const double roiWidth = std::max<double>(proposals(2, batch), 1.0);
+        const double roiHeight = std::max<double>(proposals(3, batch), 1.0);
+        const double binWidth = roiWidth / outputsWidth;
+        const double binHeight = roiHeight / outputsHeight;
+        const unsigned int gridX = (samplingRatio > 0) ? samplingRatio
+            : (unsigned int)std::ceil(binWidth);
+        const unsigned int gridY = (samplingRatio > 0) ? samplingRatio
+            : (unsigned int)std::ceil(binHeight);
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+                for (unsigned int ox = 0; ox < outputsWidth; ++ox) {
+                    double poolValue = 0.0;
+
+                    for (unsigned int gy = 0; gy < gridY; ++gy) {
+                        for (unsigned int gx = 0; gx < gridX; ++gx) {
+                            double x = proposals(0, batch) + ox * binWidth
+                                + (gx + 0.5) * binWidth / gridX;
+                            double y = proposals(1, batch) + oy * binHeight
+                                + (gy + 0.5) * binHeight / gridY;
+
+                            if (x < -1.0 || x > channelsWidth
+                                || y < -1.0 || y > channelsHeight)
+                            {
+                                continue;
+                            }
+
+                            x = std::max(x, 0.0);
+                            y = std::max(y, 0.0);
+
+                            const unsigned int x0 = std::min(
+                                (unsigned int)x, channelsWidth - 1);
+                            const unsigned int y0 = std::min(
+                                (unsigned int)y, channelsHeight - 1);
+                            const unsigned int x1 = std::min(
+                                x0 + 1, channelsWidth - 1);
+                            const unsigned int y1 = std::min(
+                                y0 + 1, channelsHeight - 1);
+                            const double dx = (x0 == x1) ? 0.0 : x - x0;
+                            const double dy = (y0 == y1) ? 0.0 : y - y0;
+
+                            poolValue
+                                += (1.0 - dx) * (1.0 - dy)
+                                    * inputs(x0, y0, output, 0)
+                                + dx * (1.0 - dy) * inputs(x1, y0, output, 0)
+                                + (1.0 - dx) * dy * inputs(x0, y1, output, 0)
+                                + dx * dy * inputs(x1, y1, output, 0);
+                        }
+                    }
+
+                    poolValue /= (gridX * gridY);
+
+                    ASSERT_EQUALS_DELTA(
+                        out(ox, oy, output, batch), poolValue, 1e-5);
+                }
+            }
+        }
+    }
+}
+
+TEST_DATASET(ROIPoolingCell_Frame,
+             checkGradient,
+             (ROIPoolingCell::ROIPooling pooling),
+             std::make_tuple(ROIPoolingCell::Max),
+             std::make_tuple(ROIPoolingCell::Average),
+             std::make_tuple(ROIPoolingCell::Bilinear),
+             std::make_tuple(ROIPoolingCell::BilinearTF),
+             std::make_tuple(ROIPoolingCell::ROIAlign))
+{
+    Random::mtSeed(0);
+
+    const unsigned int outputsWidth = 4;
+    const unsigned int outputsHeight = 3;
+    const unsigned int nbOutputs = 3;
+    const unsigned int channelsWidth = 16;
+    const unsigned int channelsHeight = 12;
+    const unsigned int nbProposals = 3;
+
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {channelsWidth, channelsHeight, 1});
+
+    ROIPoolingCell_Frame_Test pool1(dn, "pool1",
+                                    env,
+                                    outputsWidth,
+                                    outputsHeight,
+                                    nbOutputs,
+                                    pooling);
+
+    Tensor<Float_T> proposals({1, 1, 4, nbProposals});
+    Tensor<Float_T> proposalsDiff({1, 1, 4, nbProposals});
+    Tensor<Float_T> inputs({channelsWidth, channelsHeight, nbOutputs, 1});
+    Tensor<Float_T> inputsDiff({channelsWidth, channelsHeight, nbOutputs, 1});
+
+    proposals(0, 0) = 1;
+    proposals(1, 0) = 2;
+    proposals(2, 0) = 8;
+    proposals(3, 0) = 6;
+    // Overlapping ROIs
+    proposals(0, 1) = 5;
+    proposals(1, 1) = 3;
+    proposals(2, 1) = 10;
+    proposals(3, 1) = 9;
+    proposals(0, 2) = 0;
+    proposals(1, 2) = 0;
+    proposals(2, 2) = 16;
+    proposals(3, 2) = 12;
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    pool1.addInput(proposals, proposalsDiff);
+    pool1.addInput(inputs, inputsDiff);
+    pool1.initialize();
+
+    ASSERT_NOTHROW_ANY(pool1.checkGradient(1.0e-3, 1.0e-3));
+}
+
 TEST_DATASET(ROIPoolingCell_Frame,
      propagate_bilinear,
      (unsigned int factorX,
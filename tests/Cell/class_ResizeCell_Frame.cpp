@@ -27,6 +27,7 @@
 #include "utils/UnitTest.hpp"
 #include "utils/Random.hpp"
 
+#include <cmath>
 #include <limits>
 #include <string>
 #include <tuple>
@@ -50,6 +51,7 @@ public:
 
     friend class UnitTest_ResizeCell_Frame_propagate_bilinearTF_aligned_checkGradient;
     friend class UnitTest_ResizeCell_Frame_nearestNeighbor;
+    friend class UnitTest_ResizeCell_Frame_bilinear_backPropagate;
 };
 
 template<typename Iterator>
@@ -169,4 +171,105 @@ TEST_DATASET(ResizeCell_Frame,
     ASSERT_EQUALS(diffOutputTensor, createBatchTensor(outputsBackprop.begin(), outputsBackprop.end()));
 }
 
+TEST_DATASET(ResizeCell_Frame,
+             bilinear_backPropagate,
+            (unsigned int outputWidth,
+             unsigned int outputHeight,
+             unsigned int inputWidth,
+             unsigned int inputHeight,
+             ResizeCell::ResizeMode mode,
+             bool alignCorners),
+            std::make_tuple(24, 17, 12, 9, ResizeCell::BilinearTF, true),
+            std::make_tuple(24, 17, 12, 9, ResizeCell::BilinearTF, false),
+            std::make_tuple(7, 5, 16, 11, ResizeCell::BilinearTF, true),
+            std::make_tuple(24, 17, 12, 9, ResizeCell::Bilinear, false),
+            std::make_tuple(7, 5, 16, 11, ResizeCell::Bilinear, false))
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int nbChannels = 3;
+    const unsigned int batchSize = 2;
+
+    ResizeCell_Frame_Test resize(dn, "r", outputWidth, outputHeight,
+                                 nbChannels, mode);
+    resize.setParameter("AlignCorners", alignCorners);
+
+    Tensor<Float_T> inputs({inputWidth, inputHeight, nbChannels, batchSize});
+    Tensor<Float_T> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    resize.addInput(inputs, diffOutputs);
+    resize.initialize();
+    resize.propagate();
+
+    const Tensor<Float_T>& outputs
+        = tensor_cast<Float_T>(resize.getOutputs());
+
+    // Reference: source coordinates computed for each output pixel
+    const double scaleX = (mode == ResizeCell::BilinearTF && alignCorners)
+        ? (inputWidth - 1) / (double)(outputWidth - 1)
+        : inputWidth / (double)outputWidth;
+    const double scaleY = (mode == ResizeCell::BilinearTF && alignCorners)
+        ? (inputHeight - 1) / (double)(outputHeight - 1)
+        : inputHeight / (double)outputHeight;
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int oy = 0; oy < outputHeight; ++oy) {
+                for (unsigned int ox = 0; ox < outputWidth; ++ox) {
+                    double x = (mode == ResizeCell::BilinearTF)
+                        ? ox * scaleX : (ox + 0.5) * scaleX - 0.5;
+                    double y = (mode == ResizeCell::BilinearTF)
+                        ? oy * scaleY : (oy + 0.5) * scaleY - 0.5;
+                    x = std::max(0.0, std::min(x, inputWidth - 1.0));
+                    y = std::max(0.0, std::min(y, inputHeight - 1.0));
+
+                    const unsigned int x0 = (unsigned int)x;
+                    const unsigned int y0 = (unsigned int)y;
+                    const unsigned int x1 = std::min(x0 + 1, inputWidth - 1);
+                    const unsigned int y1 = std::min(y0 + 1, inputHeight - 1);
+                    const double dx = x - x0;
+                    const double dy = y - y0;
+
+                    const double top = inputs(x0, y0, channel, batchPos)
+                        + (inputs(x1, y0, channel, batchPos)
+                           - inputs(x0, y0, channel, batchPos)) * dx;
+                    const double bottom = inputs(x0, y1, channel, batchPos)
+                        + (inputs(x1, y1, channel, batchPos)
+                           - inputs(x0, y1, channel, batchPos)) * dx;
+
+                    ASSERT_EQUALS_DELTA(outputs(ox, oy, channel, batchPos),
+                                        top + (bottom - top) * dy,
+                                        1.0e-5);
+                }
+            }
+        }
+    }
+
+    // The backward scatter-add must be the transpose of the forward
+    // interpolation: <diffInputs, A.x> == <A^T.diffInputs, x>
+    for (unsigned int index = 0; index < resize.mDiffInputs.size(); ++index)
+        resize.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    resize.mDiffInputs.setValid();
+    resize.mDiffInputs.synchronizeHToD();
+    resize.backPropagate();
+
+    double dotForward = 0.0;
+    double dotBackward = 0.0;
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        dotForward += resize.mDiffInputs(index) * outputs(index);
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        dotBackward += diffOutputs(index) * inputs(index);
+
+    ASSERT_EQUALS_DELTA(dotForward, dotBackward, 1.0e-4);
+}
+
 RUN_TESTS()
@@ -24,6 +24,7 @@
 #include "DeepNet.hpp"
 #include "Network.hpp"
 #include "third_party/half.hpp"
+#include "utils/Random.hpp"
 #include "utils/UnitTest.hpp"
 
 using namespace N2D2;
@@ -32,12 +33,16 @@ template <class T>
 class SoftmaxCell_Frame_Test : public SoftmaxCell_Frame<T> {
 public:
     SoftmaxCell_Frame_Test(const DeepNet& deepNet, const std::string& name, 
-                           unsigned int nbOutputs)
+                           unsigned int nbOutputs,
+                           bool withLoss = false,
+                           unsigned int groupSize = 0)
         : Cell(deepNet, name, nbOutputs),
-          SoftmaxCell(deepNet, name, nbOutputs),
-          SoftmaxCell_Frame<T>(deepNet, name, nbOutputs) {};
+          SoftmaxCell(deepNet, name, nbOutputs, withLoss, groupSize),
+          SoftmaxCell_Frame<T>(deepNet, name, nbOutputs, withLoss,
+                               groupSize) {};
 
     friend class UnitTest_SoftmaxCell_Frame_float_backPropagate;
+    friend class UnitTest_SoftmaxCell_Frame_float_backPropagate_group;
     friend class UnitTest_SoftmaxCell_Frame_double_backPropagate;
     friend class UnitTest_SoftmaxCell_Frame_half_backPropagate;
 };
@@ -163,6 +168,95 @@ TEST_DATASET(SoftmaxCell_Frame_float,
     }
 }
 
+TEST_DATASET(SoftmaxCell_Frame_float,
+             backPropagate_group,
+             (unsigned int nbOutputs, unsigned int groupSize, bool withLoss),
+             std::make_tuple(12U, 0U, false),
+             std::make_tuple(12U, 4U, false),
+             std::make_tuple(12U, 0U, true),
+             std::make_tuple(12U, 3U, true))
+{
+    Network net;
+    DeepNet dn(net);
+
+    Random::mtSeed(0);
+
+    const unsigned int batchSize = 2;
+    const unsigned int groupStride = (groupSize > 0) ? groupSize : nbOutputs;
+
+    SoftmaxCell_Frame_Test<float> softmax1(dn, "softmax1", nbOutputs,
+                                           withLoss, groupSize);
+
+    Tensor<float> inputs({3, 2, nbOutputs, batchSize});
+    Tensor<float> diffOutputs(inputs.dims());
+    softmax1.addInput(inputs, diffOutputs);
+    softmax1.initialize();
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-10.0, 10.0);
+
+    softmax1.propagate();
+
+    for (unsigned int index = 0; index < softmax1.mDiffInputs.size(); ++index)
+        softmax1.mDiffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    softmax1.mDiffInputs.setValid();
+    softmax1.backPropagate();
+
+    const Tensor<float>& outputs = tensor_cast<float>(softmax1.getOutputs());
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int y = 0; y < 2; ++y) {
+            for (unsigned int x = 0; x < 3; ++x) {
+                for (unsigned int stride = 0; stride < nbOutputs;
+                     stride += groupStride)
+                {
+                    double maxVal = inputs(x, y, stride, batchPos);
+
+                    for (unsigned int o = stride; o < stride + groupStride; ++o)
+                        maxVal = std::max(maxVal,
+                                          (double)inputs(x, y, o, batchPos));
+
+                    double sum = 0.0;
+
+                    for (unsigned int o = stride; o < stride + groupStride; ++o)
+                        sum += std::exp(inputs(x, y, o, batchPos) - maxVal);
+
+                    for (unsigned int o = stride; o < stride + groupStride;
+                         ++o)
+                    {
+                        ASSERT_EQUALS_DELTA(outputs(x, y, o, batchPos),
+                            std::exp(inputs(x, y, o, batchPos) - maxVal) / sum,
+                            1.0e-6);
+                    }
+
+                    for (unsigned int c = stride; c < stride + groupStride;
+                         ++c)
+                    {
+                        double gradient = 0.0;
+
+                        if (withLoss)
+                            gradient = softmax1.mDiffInputs(x, y, c, batchPos);
+                        else {
+                            for (unsigned int o = stride;
+                                 o < stride + groupStride; ++o)
+                            {
+                                gradient += ((o == c)
+                                             - outputs(x, y, c, batchPos))
+                                    * outputs(x, y, o, batchPos)
+                                    * softmax1.mDiffInputs(x, y, o, batchPos);
+                            }
+                        }
+
+                        ASSERT_EQUALS_DELTA(diffOutputs(x, y, c, batchPos),
+                                            gradient, 1.0e-6);
+                    }
+                }
+            }
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // double
 ////////////////////////////////////////////////////////////////////////////////
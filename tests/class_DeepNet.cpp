@@ -24,12 +24,15 @@
 #include "Activation/RectifierActivation_Frame.hpp"
 #include "Cell/BatchNormCell_Frame.hpp"
 #include "Cell/ConvCell_Frame.hpp"
+#include "Cell/ElemWiseCell_Frame.hpp"
 #include "Database/DIR_Database.hpp"
 #include "Database/MNIST_IDX_Database.hpp"
 #include "Transformation/RescaleTransformation.hpp"
 #include "DeepNet.hpp"
 #include "Network.hpp"
 #include "Cell/FcCell_Frame.hpp"
+#include "Cell/PaddingCell_Frame.hpp"
+#include "Cell/PoolCell_Frame.hpp"
 #include "utils/UnitTest.hpp"
 
 using namespace N2D2;
@@ -238,4 +241,562 @@ TEST(DeepNet, fuseBatchNormWithConv)
     }
 }
 
+TEST(DeepNet, fuseElemWiseWithConv)
+{
+    const unsigned int nbOutputs = 4;
+    const unsigned int channelsWidth = 12;
+    const unsigned int channelsHeight = 10;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    // conv1 -> conv2 -> ew1 -> conv3, with a residual from conv1 to ew1
+    std::shared_ptr<ConvCell_Frame<float> > conv1(
+        new ConvCell_Frame<float>(deepNet, "conv1",
+        std::vector<unsigned int>({3, 3}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::make_shared<RectifierActivation_Frame<float> >()));
+    std::shared_ptr<ConvCell_Frame<float> > conv2(
+        new ConvCell_Frame<float>(deepNet, "conv2",
+        std::vector<unsigned int>({3, 3}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::make_shared<RectifierActivation_Frame<float> >()));
+    std::shared_ptr<ElemWiseCell_Frame> ew1(
+        new ElemWiseCell_Frame(deepNet, "ew1",
+        nbOutputs,
+        ElemWiseCell::Sum,
+        std::vector<Float_T>({0.5, 2.0}),
+        std::vector<Float_T>({0.25, -0.5}),
+        std::make_shared<RectifierActivation_Frame<float> >()));
+    std::shared_ptr<ConvCell_Frame<float> > conv3(
+        new ConvCell_Frame<float>(deepNet, "conv3",
+        std::vector<unsigned int>({1, 1}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({0, 0}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::shared_ptr<Activation>()));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, 3, batchSize});
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(ew1, std::vector<std::shared_ptr<Cell> >({conv1, conv2}));
+    deepNet.addCell(conv3, std::vector<std::shared_ptr<Cell> >(1, ew1));
+
+    conv1->addInput(inputs, diffOutputs);
+    conv2->addInput(conv1.get());
+    ew1->addInput(conv1.get());
+    ew1->addInput(conv2.get());
+    conv3->addInput(ew1.get());
+
+    conv1->initialize();
+    conv2->initialize();
+    ew1->initialize();
+    conv3->initialize();
+
+    ASSERT_EQUALS(deepNet.getLayers().size(), 5U);
+
+    // Outputs before fuse
+    conv1->propagate(true);
+    conv2->propagate(true);
+    ew1->propagate(true);
+    conv3->propagate(true);
+    const Tensor<float> outputsRef
+        = tensor_cast<float>(conv3->getOutputs()).clone();
+
+    // Fuse!
+    deepNet.fuseElemWiseWithConv();
+
+    ASSERT_EQUALS(deepNet.getLayers().size(), 4U);
+    ASSERT_EQUALS(deepNet.getCells().count("ew1"), 0U);
+    ASSERT_EQUALS(deepNet.getChildCells("conv2").size(), 1U);
+    ASSERT_EQUALS(deepNet.getChildCells("conv2")[0], conv3);
+    ASSERT_EQUALS(deepNet.getParentCells("conv2").size(), 2U);
+
+    // Outputs after fuse
+    conv1->propagate(true);
+    conv2->propagate(true);
+    conv3->propagate(true);
+    const Tensor<float>& outputsFuse
+        = tensor_cast<float>(conv3->getOutputs());
+
+    ASSERT_EQUALS(outputsFuse.size(), outputsRef.size());
+
+    for (unsigned int index = 0; index < outputsRef.size(); ++index)
+        ASSERT_EQUALS_DELTA(outputsRef(index), outputsFuse(index), 1.0e-6);
+
+    // The fused cell is inference only
+    ASSERT_THROW(conv2->backPropagate(), std::runtime_error);
+}
+
+TEST(DeepNet, fusePaddingWithConvPool)
+{
+    const unsigned int nbOutputs = 4;
+    const unsigned int channelsWidth = 12;
+    const unsigned int channelsHeight = 10;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    // conv1 -> pad1 -> conv2
+    //       -> pad2 -> pool1 (asymmetric padding, not fused)
+    //       -> pad3 -> pool2
+    std::shared_ptr<ConvCell_Frame<float> > conv1(
+        new ConvCell_Frame<float>(deepNet, "conv1",
+        std::vector<unsigned int>({3, 3}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({0, 0}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::make_shared<RectifierActivation_Frame<float> >()));
+    std::shared_ptr<PaddingCell_Frame> pad1(
+        new PaddingCell_Frame(deepNet, "pad1", nbOutputs, 1, 1, 1, 1));
+    std::shared_ptr<ConvCell_Frame<float> > conv2(
+        new ConvCell_Frame<float>(deepNet, "conv2",
+        std::vector<unsigned int>({3, 3}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::shared_ptr<Activation>()));
+    std::shared_ptr<PaddingCell_Frame> pad2(
+        new PaddingCell_Frame(deepNet, "pad2", nbOutputs, 0, 1, 0, 1));
+    std::shared_ptr<PoolCell_Frame<float> > pool1(
+        new PoolCell_Frame<float>(deepNet, "pool1",
+        std::vector<unsigned int>({2, 2}),
+        nbOutputs,
+        std::vector<unsigned int>({2, 2}),
+        std::vector<unsigned int>({0, 0}),
+        PoolCell::Average,
+        std::shared_ptr<Activation>()));
+    std::shared_ptr<PaddingCell_Frame> pad3(
+        new PaddingCell_Frame(deepNet, "pad3", nbOutputs, 2, 2, 1, 1));
+    std::shared_ptr<PoolCell_Frame<float> > pool2(
+        new PoolCell_Frame<float>(deepNet, "pool2",
+        std::vector<unsigned int>({3, 3}),
+        nbOutputs,
+        std::vector<unsigned int>({2, 2}),
+        std::vector<unsigned int>({0, 0}),
+        PoolCell::Average,
+        std::shared_ptr<Activation>()));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, 3, batchSize});
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(pad1, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, pad1));
+    deepNet.addCell(pad2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(pool1, std::vector<std::shared_ptr<Cell> >(1, pad2));
+    deepNet.addCell(pad3, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(pool2, std::vector<std::shared_ptr<Cell> >(1, pad3));
+
+    conv1->addInput(inputs, diffOutputs);
+    pad1->addInput(conv1.get());
+    conv2->addInput(pad1.get());
+    pad2->addInput(conv1.get());
+    pool1->addInput(pad2.get());
+    pad3->addInput(conv1.get());
+    pool2->addInput(pad3.get());
+
+    conv1->initialize();
+    pad1->initialize();
+    conv2->initialize();
+    pad2->initialize();
+    pool1->initialize();
+    pad3->initialize();
+    pool2->initialize();
+
+    // Outputs before fuse
+    conv1->propagate(true);
+    pad1->propagate(true);
+    conv2->propagate(true);
+    pad2->propagate(true);
+    pool1->propagate(true);
+    pad3->propagate(true);
+    pool2->propagate(true);
+    const Tensor<float> conv2Ref
+        = tensor_cast<float>(conv2->getOutputs()).clone();
+    const Tensor<float> pool2Ref
+        = tensor_cast<float>(pool2->getOutputs()).clone();
+
+    // Fuse!
+    deepNet.fusePaddingWithConvPool();
+
+    ASSERT_EQUALS(deepNet.getCells().count("pad1"), 0U);
+    ASSERT_EQUALS(deepNet.getCells().count("pad2"), 1U);
+    ASSERT_EQUALS(deepNet.getCells().count("pad3"), 0U);
+    ASSERT_EQUALS(deepNet.getParentCells("conv2").size(), 1U);
+    ASSERT_EQUALS(deepNet.getParentCells("conv2")[0], conv1);
+    ASSERT_EQUALS(deepNet.getParentCells("pool2")[0], conv1);
+    ASSERT_EQUALS(conv2->getPaddingX(), 2);
+    ASSERT_EQUALS(conv2->getPaddingY(), 2);
+    ASSERT_EQUALS(conv2->getChannelsWidth(), conv1->getOutputsWidth());
+    ASSERT_EQUALS(conv2->getChannelsHeight(), conv1->getOutputsHeight());
+    ASSERT_EQUALS(pool2->getPaddingX(), 1);
+    ASSERT_EQUALS(pool2->getPaddingY(), 2);
+
+    // Outputs after fuse
+    conv1->propagate(true);
+    conv2->propagate(true);
+    pool2->propagate(true);
+    const Tensor<float>& conv2Fuse = tensor_cast<float>(conv2->getOutputs());
+    const Tensor<float>& pool2Fuse = tensor_cast<float>(pool2->getOutputs());
+
+    for (unsigned int index = 0; index < conv2Ref.size(); ++index)
+        ASSERT_EQUALS_DELTA(conv2Ref(index), conv2Fuse(index), 1.0e-6);
+
+    for (unsigned int index = 0; index < pool2Ref.size(); ++index)
+        ASSERT_EQUALS_DELTA(pool2Ref(index), pool2Fuse(index), 1.0e-6);
+}
+
+TEST(DeepNet, setElemWiseInPlace)
+{
+    const unsigned int nbOutputs = 4;
+    const unsigned int channelsWidth = 12;
+    const unsigned int channelsHeight = 10;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    // conv1 -> conv2 -> ew1 -> conv3, with a residual from conv1 to ew1
+    std::shared_ptr<ConvCell_Frame<float> > conv1(
+        new ConvCell_Frame<float>(deepNet, "conv1",
+        std::vector<unsigned int>({3, 3}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::make_shared<RectifierActivation_Frame<float> >()));
+    std::shared_ptr<ConvCell_Frame<float> > conv2(
+        new ConvCell_Frame<float>(deepNet, "conv2",
+        std::vector<unsigned int>({3, 3}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::shared_ptr<Activation>()));
+    std::shared_ptr<ElemWiseCell_Frame> ew1(
+        new ElemWiseCell_Frame(deepNet, "ew1",
+        nbOutputs,
+        ElemWiseCell::Sum,
+        std::vector<Float_T>({0.5, 1.0}),
+        std::vector<Float_T>({0.25, -0.5}),
+        std::make_shared<RectifierActivation_Frame<float> >()));
+    std::shared_ptr<ConvCell_Frame<float> > conv3(
+        new ConvCell_Frame<float>(deepNet, "conv3",
+        std::vector<unsigned int>({1, 1}),
+        nbOutputs,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({0, 0}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::shared_ptr<Activation>()));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, 3, batchSize});
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(conv2, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(ew1, std::vector<std::shared_ptr<Cell> >({conv1, conv2}));
+    deepNet.addCell(conv3, std::vector<std::shared_ptr<Cell> >(1, ew1));
+
+    conv1->addInput(inputs, diffOutputs);
+    conv2->addInput(conv1.get());
+    ew1->addInput(conv1.get());
+    ew1->addInput(conv2.get());
+    conv3->addInput(ew1.get());
+
+    conv1->initialize();
+    conv2->initialize();
+    ew1->initialize();
+    conv3->initialize();
+
+    Tensor<float>& diffInputs
+        = dynamic_cast<Tensor<float>&>(conv3->getDiffInputs());
+    Tensor<float> diffInputsRef(diffInputs.dims());
+
+    for (unsigned int index = 0; index < diffInputsRef.size(); ++index)
+        diffInputsRef(index) = Random::randUniform(-1.0, 1.0);
+
+    // Reference forward and backward
+    conv1->propagate();
+    conv2->propagate();
+    ew1->propagate();
+    conv3->propagate();
+
+    diffInputs = diffInputsRef;
+    diffInputs.setValid();
+    diffOutputs.clearValid();
+
+    conv3->backPropagate();
+    ew1->backPropagate();
+    conv2->backPropagate();
+    conv1->backPropagate();
+
+    const Tensor<float> outputsRef
+        = tensor_cast<float>(conv3->getOutputs()).clone();
+    const Tensor<float> diffOutputsRef = diffOutputs.clone();
+
+    // conv1 has two childs: only conv2 outputs can be overwritten
+    deepNet.setElemWiseInPlace();
+
+    ASSERT_TRUE(ew1->isInPlace());
+    ASSERT_TRUE(&ew1->getOutputs() == &conv2->getOutputs());
+    ASSERT_TRUE(&ew1->getDiffInputs() == &conv2->getDiffInputs());
+
+    conv1->propagate();
+    conv2->propagate();
+    ew1->propagate();
+    conv3->propagate();
+
+    diffInputs = diffInputsRef;
+    diffInputs.setValid();
+    diffOutputs.clearValid();
+
+    conv3->backPropagate();
+    ew1->backPropagate();
+    conv2->backPropagate();
+    conv1->backPropagate();
+
+    const Tensor<float>& outputs = tensor_cast<float>(conv3->getOutputs());
+
+    for (unsigned int index = 0; index < outputsRef.size(); ++index)
+        ASSERT_EQUALS_DELTA(outputsRef(index), outputs(index), 1.0e-6);
+
+    for (unsigned int index = 0; index < diffOutputsRef.size(); ++index) {
+        ASSERT_EQUALS_DELTA(diffOutputsRef(index), diffOutputs(index),
+                            1.0e-6);
+    }
+}
+
+TEST(DeepNet, keepConvDataLayouts)
+{
+    const unsigned int nbOutputs = 8;
+    const unsigned int channelsWidth = 12;
+    const unsigned int channelsHeight = 10;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    // conv1 (NCHW8c) -> conv2 (NCHW8c) -> conv3 (NHWC) -> conv4 (NHWC)
+    const TensorLayout::Layout layouts[4] = {TensorLayout::NCHW8c,
+        TensorLayout::NCHW8c, TensorLayout::NHWC, TensorLayout::NHWC};
+    std::vector<std::shared_ptr<ConvCell_Frame<float> > > convs;
+
+    for (unsigned int i = 0; i < 4; ++i) {
+        std::stringstream name;
+        name << "conv" << (i + 1);
+
+        convs.push_back(std::make_shared<ConvCell_Frame<float> >(deepNet,
+            name.str(),
+            std::vector<unsigned int>({3, 3}),
+            (i < 3) ? nbOutputs : 5U,
+            std::vector<unsigned int>({1, 1}),
+            std::vector<unsigned int>({1, 1}),
+            std::vector<int>({1, 1}),
+            std::vector<unsigned int>({1U, 1U}),
+            std::make_shared<RectifierActivation_Frame<float> >()));
+        convs.back()->setParameter("DataLayout", layouts[i]);
+    }
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, 3, batchSize});
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    deepNet.addCell(convs[0], std::vector<std::shared_ptr<Cell> >(1));
+    convs[0]->addInput(inputs, diffOutputs);
+
+    for (unsigned int i = 1; i < 4; ++i) {
+        deepNet.addCell(convs[i],
+                        std::vector<std::shared_ptr<Cell> >(1, convs[i - 1]));
+        convs[i]->addInput(convs[i - 1].get());
+    }
+
+    for (unsigned int i = 0; i < 4; ++i)
+        convs[i]->initialize();
+
+    for (unsigned int i = 0; i < 4; ++i)
+        convs[i]->propagate(true);
+
+    const Tensor<float> outputsRef
+        = tensor_cast<float>(convs[3]->getOutputs()).clone();
+
+    deepNet.keepConvDataLayouts();
+
+    // Only the outputs read by a Conv in the same layout are kept in it
+    for (unsigned int i = 0; i < 4; ++i)
+        convs[i]->propagate(true);
+
+    ASSERT_EQUALS(convs[0]->getOutputs().getLayout(), TensorLayout::NCHW8c);
+    ASSERT_EQUALS(convs[1]->getOutputs().getLayout(), TensorLayout::NCHW);
+    ASSERT_EQUALS(convs[2]->getOutputs().getLayout(), TensorLayout::NHWC);
+    ASSERT_EQUALS(convs[3]->getOutputs().getLayout(), TensorLayout::NCHW);
+
+    const Tensor<float>& outputs = tensor_cast<float>(convs[3]->getOutputs());
+
+    for (unsigned int index = 0; index < outputsRef.size(); ++index)
+        ASSERT_EQUALS_DELTA(outputsRef(index), outputs(index), 1.0e-5);
+
+    // The learning outputs stay in the NCHW layout
+    for (unsigned int i = 0; i < 4; ++i)
+        convs[i]->propagate(false);
+
+    ASSERT_EQUALS(convs[0]->getOutputs().getLayout(), TensorLayout::NCHW);
+    ASSERT_EQUALS(convs[2]->getOutputs().getLayout(), TensorLayout::NCHW);
+
+    for (unsigned int index = 0; index < outputsRef.size(); ++index)
+        ASSERT_EQUALS_DELTA(outputsRef(index), outputs(index), 1.0e-5);
+}
+
+TEST(DeepNet, planInferenceMemory)
+{
+    const unsigned int nbOutputs = 4;
+    const unsigned int channelsWidth = 12;
+    const unsigned int channelsHeight = 10;
+    const unsigned int batchSize = 2;
+
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet deepNet(net);
+
+    // conv1 -> conv2 -> ew1 -> conv3 -> conv4, with a residual from conv1 to
+    // ew1
+    std::vector<std::shared_ptr<ConvCell_Frame<float> > > convs;
+
+    for (unsigned int i = 0; i < 4; ++i) {
+        std::stringstream name;
+        name << "conv" << (i + 1);
+
+        convs.push_back(std::make_shared<ConvCell_Frame<float> >(deepNet,
+            name.str(),
+            std::vector<unsigned int>({3, 3}),
+            nbOutputs,
+            std::vector<unsigned int>({1, 1}),
+            std::vector<unsigned int>({1, 1}),
+            std::vector<int>({1, 1}),
+            std::vector<unsigned int>({1U, 1U}),
+            std::make_shared<RectifierActivation_Frame<float> >()));
+    }
+
+    std::shared_ptr<ElemWiseCell_Frame> ew1(
+        new ElemWiseCell_Frame(deepNet, "ew1",
+        nbOutputs,
+        ElemWiseCell::Sum,
+        std::vector<Float_T>({0.5, 1.0}),
+        std::vector<Float_T>({0.25, -0.5}),
+        std::shared_ptr<Activation>()));
+
+    Tensor<float> inputs({channelsWidth, channelsHeight, 3, batchSize});
+    Tensor<float> diffOutputs(inputs.dims());
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    deepNet.addCell(convs[0], std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(convs[1], std::vector<std::shared_ptr<Cell> >(1, convs[0]));
+    deepNet.addCell(ew1,
+                std::vector<std::shared_ptr<Cell> >({convs[0], convs[1]}));
+    deepNet.addCell(convs[2], std::vector<std::shared_ptr<Cell> >(1, ew1));
+    deepNet.addCell(convs[3], std::vector<std::shared_ptr<Cell> >(1, convs[2]));
+
+    convs[0]->addInput(inputs, diffOutputs);
+    convs[1]->addInput(convs[0].get());
+    ew1->addInput(convs[0].get());
+    ew1->addInput(convs[1].get());
+    convs[2]->addInput(ew1.get());
+    convs[3]->addInput(convs[2].get());
+
+    convs[0]->initialize();
+    convs[1]->initialize();
+    ew1->initialize();
+    convs[2]->initialize();
+    convs[3]->initialize();
+
+    convs[0]->propagate(true);
+    convs[1]->propagate(true);
+    ew1->propagate(true);
+    convs[2]->propagate(true);
+    convs[3]->propagate(true);
+
+    const Tensor<float> outputsRef
+        = tensor_cast<float>(convs[3]->getOutputs()).clone();
+
+    deepNet.planInferenceMemory();
+
+    std::vector<float*> outputsData;
+    std::vector<float*> diffInputsData;
+
+    for (unsigned int i = 0; i < 4; ++i) {
+        outputsData.push_back(&dynamic_cast<Tensor<float>&>(
+            convs[i]->getOutputs())(0));
+        diffInputsData.push_back(&dynamic_cast<Tensor<float>&>(
+            convs[i]->getDiffInputs())(0));
+    }
+
+    float* ewOutputsData
+        = &dynamic_cast<Tensor<float>&>(ew1->getOutputs())(0);
+    const size_t size = outputsRef.size();
+
+    // conv1 and conv2 are dead after ew1
+    ASSERT_TRUE(outputsData[2] == outputsData[0]);
+    ASSERT_TRUE(outputsData[3] == outputsData[1]);
+    ASSERT_TRUE(outputsData[1] == outputsData[0] + size);
+    ASSERT_TRUE(ewOutputsData == outputsData[0] + 2 * size);
+    ASSERT_TRUE(diffInputsData[1] == diffInputsData[0]);
+    ASSERT_TRUE(diffInputsData[3] == diffInputsData[0]);
+    ASSERT_EQUALS(tensor_cast<float>(convs[3]->getOutputs()).dims(),
+                  outputsRef.dims());
+
+    convs[0]->propagate(true);
+    convs[1]->propagate(true);
+    ew1->propagate(true);
+    convs[2]->propagate(true);
+    convs[3]->propagate(true);
+
+    const Tensor<float>& outputs = tensor_cast<float>(convs[3]->getOutputs());
+
+    for (unsigned int index = 0; index < outputsRef.size(); ++index)
+        ASSERT_EQUALS_DELTA(outputsRef(index), outputs(index), 1.0e-6);
+}
+
 RUN_TESTS()
@@ -777,4 +777,35 @@ TEST(Tensor4d, tensor_cast_float_to_int)
     ASSERT_EQUALS(B(1, 1, 1, 1), 4);
 }
 
+TEST(Tensor4d, bindData)
+{
+    Tensor<float> storage({8, 2});
+    Tensor<float> A({2, 1, 2, 1}, 1.0);
+    Tensor<float> B({2, 2, 1, 2}, 2.0);
+
+    for (unsigned int i = 0; i < storage.size(); ++i)
+        storage(i) = i;
+
+    // A and B are references to a shared storage, with a different offset
+    Tensor<float>& refA = A;
+    A.bindData(storage, 2);
+    B.bindData(storage[1], 0);
+
+    ASSERT_EQUALS(A.dims(), std::vector<size_t>({2, 1, 2, 1}));
+    ASSERT_EQUALS(B.dims(), std::vector<size_t>({2, 2, 1, 2}));
+    ASSERT_EQUALS(refA(0, 0, 0, 0), 2.0);
+    ASSERT_EQUALS(refA(1, 0, 1, 0), 5.0);
+    ASSERT_EQUALS(B(0, 0, 0, 0), 8.0);
+    ASSERT_EQUALS(B(1, 1, 0, 1), 15.0);
+
+    A.fill(-1.0);
+
+    ASSERT_EQUALS(storage(1), 1.0);
+    ASSERT_EQUALS(storage(2), -1.0);
+    ASSERT_EQUALS(storage(5), -1.0);
+    ASSERT_EQUALS(storage(6), 6.0);
+
+    ASSERT_THROW(A.bindData(storage, 13), std::runtime_error);
+}
+
 RUN_TESTS()
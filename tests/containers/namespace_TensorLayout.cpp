@@ -0,0 +1,104 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "containers/TensorLayout.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(TensorLayout,
+             toLayout,
+             (TensorLayout::Layout layout, unsigned int nbChannels),
+             std::make_tuple(TensorLayout::NCHW, 3U),
+             std::make_tuple(TensorLayout::NHWC, 3U),
+             std::make_tuple(TensorLayout::NHWC, 20U),
+             std::make_tuple(TensorLayout::NCHW8c, 3U),
+             std::make_tuple(TensorLayout::NCHW8c, 16U),
+             std::make_tuple(TensorLayout::NCHW16c, 20U))
+{
+    Tensor<float> tensor({5, 4, nbChannels, 2});
+
+    for (unsigned int index = 0; index < tensor.size(); ++index)
+        tensor(index) = index + 1.0f;
+
+    Tensor<float> converted;
+    TensorLayout::toLayout(tensor, layout, converted);
+
+    ASSERT_TRUE(converted.dims()
+                == TensorLayout::dims(tensor.dims(), layout));
+
+    const unsigned int c = TensorLayout::blockSize(layout);
+
+    for (unsigned int batchPos = 0; batchPos < tensor.dimB(); ++batchPos) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int y = 0; y < tensor.dimY(); ++y) {
+                for (unsigned int x = 0; x < tensor.dimX(); ++x) {
+                    const float value = tensor(x, y, channel, batchPos);
+
+                    if (layout == TensorLayout::NCHW) {
+                        ASSERT_EQUALS(converted(x, y, channel, batchPos),
+                                      value);
+                    }
+                    else if (layout == TensorLayout::NHWC) {
+                        ASSERT_EQUALS(converted(channel, x, y, batchPos),
+                                      value);
+                    }
+                    else {
+                        ASSERT_EQUALS(converted(channel % c, x, y,
+                                                channel / c, batchPos),
+                                      value);
+                    }
+                }
+            }
+        }
+    }
+
+    if (c > 1) {
+        // Zero-padded channels
+        for (unsigned int batchPos = 0; batchPos < tensor.dimB(); ++batchPos) {
+            for (unsigned int channel = nbChannels;
+                 channel < converted.dims()[3] * c; ++channel)
+            {
+                ASSERT_EQUALS(converted(channel % c, 0, 0, channel / c,
+                                        batchPos), 0.0f);
+            }
+        }
+    }
+
+    Tensor<float> restored(tensor.dims());
+    TensorLayout::fromLayout(converted, layout, restored);
+
+    ASSERT_TRUE(restored == tensor);
+}
+
+TEST(TensorLayout, fromLayout_mismatch)
+{
+    Tensor<float> tensor({5, 4, 3, 2});
+    Tensor<float> converted;
+    TensorLayout::toLayout(tensor, TensorLayout::NCHW8c, converted);
+
+    Tensor<float> restored({5, 4, 9, 2});
+
+    ASSERT_THROW(TensorLayout::fromLayout(converted, TensorLayout::NCHW8c,
+                                          restored),
+                 std::domain_error);
+}
+
+RUN_TESTS()
@@ -282,4 +282,74 @@ TEST(Interface, clear)
     ASSERT_TRUE(interface.empty());
 }
 
+TEST(Interface, replace)
+{
+    Interface<int> interface({true, true, false, true});
+    Tensor<int> A1({2, 3, 4, 2});
+    Tensor<int> A2({2, 3, 5, 2});
+    Tensor<int> A3({2, 3, 1, 2});
+
+    interface.push_back(&A1);
+    interface.push_back(&A2);
+    interface.push_back(&A3);
+
+    // Same stacking size: the data offsets are unchanged
+    Tensor<int> B({2, 3, 5, 2});
+    interface.replace(1, &B);
+
+    ASSERT_TRUE(&interface[1] == &B);
+    ASSERT_EQUALS(interface.dimZ(), 10U);
+    ASSERT_EQUALS(interface.getTensorIndex(4), 1U);
+    ASSERT_EQUALS(interface.getTensorDataOffset(4), 4U);
+    ASSERT_EQUALS(interface.getTensorIndex(9), 2U);
+    ASSERT_EQUALS(interface.getTensorDataOffset(9), 9U);
+
+    // Different stacking size of a non-empty tensor
+    Tensor<int> C({2, 3, 6, 2});
+    ASSERT_THROW_ANY(interface.replace(1, &C));
+
+    // Non-stacking dimension not matching the other tensors
+    Tensor<int> D({4, 3, 5, 2});
+    ASSERT_THROW_ANY(interface.replace(1, &D));
+
+    ASSERT_TRUE(&interface[1] == &B);
+    ASSERT_EQUALS(interface.dimZ(), 10U);
+}
+
+TEST(Interface, replace_empty)
+{
+    Interface<int> interface({true, true, false, true});
+    Tensor<int> A1({2, 3, 4, 2});
+    Tensor<int> E({2, 3, 0, 2});
+    Tensor<int> A3({2, 3, 1, 2});
+
+    for (unsigned int index = 0; index < A3.size(); ++index)
+        A3(index) = index + 1;
+
+    interface.push_back(&A1);
+    interface.push_back(&E);
+    interface.push_back(&A3);
+
+    ASSERT_EQUALS(interface.dimZ(), 5U);
+    ASSERT_EQUALS(interface.getTensorIndex(4), 2U);
+    ASSERT_EQUALS(interface.getTensorDataOffset(4), 4U);
+
+    // An empty tensor may be replaced by a tensor with a different stacking
+    // size: the data offsets of this tensor and the next ones are rebuilt
+    Tensor<int> B({2, 3, 3, 2});
+    interface.replace(1, &B);
+
+    ASSERT_EQUALS(interface.dimZ(), 8U);
+
+    for (unsigned int k = 0; k < 8; ++k) {
+        const unsigned int tensorIndex = (k < 4) ? 0 : (k < 7) ? 1 : 2;
+        const unsigned int dataOffset = (k < 4) ? 0 : (k < 7) ? 4 : 7;
+
+        ASSERT_EQUALS(interface.getTensorIndex(k), tensorIndex);
+        ASSERT_EQUALS(interface.getTensorDataOffset(k), dataOffset);
+    }
+
+    ASSERT_EQUALS(interface(1, 2, 7, 1), A3(1, 2, 0, 1));
+}
+
 RUN_TESTS()
@@ -0,0 +1,177 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/Gemm.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(Gemm,
+             gemm,
+             (bool transA, bool transB, unsigned int M, unsigned int N,
+              unsigned int K, double alpha, double beta),
+             std::make_tuple(false, false, 1U, 1U, 1U, 1.0, 0.0),
+             std::make_tuple(false, false, 5U, 7U, 3U, 1.0, 0.0),
+             std::make_tuple(false, true, 5U, 7U, 3U, 2.0, 1.0),
+             std::make_tuple(true, false, 5U, 7U, 3U, 1.0, 0.5),
+             std::make_tuple(true, true, 5U, 7U, 3U, -1.0, 1.0),
+             std::make_tuple(false, false, 67U, 131U, 300U, 1.0, 0.0),
+             std::make_tuple(false, true, 67U, 131U, 300U, 0.5, 2.0),
+             std::make_tuple(true, false, 131U, 67U, 513U, 1.0, 1.0),
+             std::make_tuple(true, true, 64U, 64U, 256U, 1.0, 0.5),
+             std::make_tuple(false, false, 10U, 10U, 0U, 1.0, 0.5))
+{
+    Random::mtSeed(0);
+
+    const unsigned int lda = (transA) ? M : K;
+    const unsigned int ldb = (transB) ? K : N;
+
+    std::vector<double> A(M * K);
+    std::vector<double> B(K * N);
+    std::vector<double> C(M * N);
+
+    for (unsigned int i = 0; i < A.size(); ++i)
+        A[i] = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int i = 0; i < B.size(); ++i)
+        B[i] = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = Random::randUniform(-1.0, 1.0);
+
+    std::vector<double> ref(C);
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int j = 0; j < N; ++j) {
+            double sum = 0.0;
+
+            for (unsigned int k = 0; k < K; ++k) {
+                const double a = (transA) ? A[k * lda + i] : A[i * lda + k];
+                const double b = (transB) ? B[j * ldb + k] : B[k * ldb + j];
+                sum += a * b;
+            }
+
+            ref[i * N + j] = alpha * sum + beta * ref[i * N + j];
+        }
+    }
+
+    Gemm::gemm<double>((transA) ? Gemm::Trans : Gemm::NoTrans,
+                       (transB) ? Gemm::Trans : Gemm::NoTrans,
+                       M, N, K,
+                       alpha, (A.empty()) ? NULL : &A[0], lda,
+                       (B.empty()) ? NULL : &B[0], ldb,
+                       beta, &C[0], N);
+
+    for (unsigned int i = 0; i < C.size(); ++i) {
+        ASSERT_EQUALS_DELTA(C[i], ref[i], 1.0e-9);
+    }
+}
+
+TEST(Gemm, gemm_beta_zero)
+{
+    // With beta = 0, C must not be read (NaN must not propagate)
+    const unsigned int M = 9;
+    const unsigned int N = 11;
+    const unsigned int K = 4;
+
+    std::vector<float> A(M * K, 1.0f);
+    std::vector<float> B(K * N, 0.5f);
+    std::vector<float> C(M * N, std::numeric_limits<float>::quiet_NaN());
+
+    Gemm::gemm<float>(Gemm::NoTrans, Gemm::NoTrans, M, N, K,
+                      1.0f, &A[0], K, &B[0], N, 0.0f, &C[0], N);
+
+    for (unsigned int i = 0; i < C.size(); ++i) {
+        ASSERT_EQUALS(C[i], 2.0f);
+    }
+}
+
+TEST_DATASET(Gemm,
+             gemmInt8,
+             (bool transA, bool transB, unsigned int M, unsigned int N,
+              unsigned int K, bool accumulate),
+             std::make_tuple(false, false, 1U, 1U, 1U, false),
+             std::make_tuple(false, true, 5U, 7U, 3U, true),
+             std::make_tuple(true, false, 5U, 7U, 3U, false),
+             std::make_tuple(false, false, 67U, 131U, 300U, false),
+             std::make_tuple(true, true, 131U, 67U, 513U, true))
+{
+    Random::mtSeed(0);
+
+    const unsigned int lda = (transA) ? M : K;
+    const unsigned int ldb = (transB) ? K : N;
+
+    // Extreme values, to check the 32 bits accumulation
+    std::vector<std::int8_t> A(M * K);
+    std::vector<std::uint8_t> B(K * N);
+    std::vector<std::int32_t> C(M * N);
+
+    for (unsigned int i = 0; i < A.size(); ++i)
+        A[i] = (i % 7 == 0) ? -128 : Random::randUniform(-128, 127);
+
+    for (unsigned int i = 0; i < B.size(); ++i)
+        B[i] = (i % 5 == 0) ? 255 : Random::randUniform(0, 255);
+
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = Random::randUniform(-1000, 1000);
+
+    std::vector<std::int32_t> ref(C);
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int j = 0; j < N; ++j) {
+            std::int32_t sum = (accumulate) ? ref[i * N + j] : 0;
+
+            for (unsigned int k = 0; k < K; ++k) {
+                const int a = (transA) ? A[k * lda + i] : A[i * lda + k];
+                const int b = (transB) ? B[j * ldb + k] : B[k * ldb + j];
+                sum += a * b;
+            }
+
+            ref[i * N + j] = sum;
+        }
+    }
+
+    Gemm::gemmInt8((transA) ? Gemm::Trans : Gemm::NoTrans,
+                   (transB) ? Gemm::Trans : Gemm::NoTrans,
+                   M, N, K, &A[0], lda, &B[0], ldb, accumulate, &C[0], N);
+
+    for (unsigned int i = 0; i < C.size(); ++i) {
+        ASSERT_EQUALS(C[i], ref[i]);
+    }
+}
+
+TEST(Gemm, toInteger)
+{
+    const float values[] = {0.0f, 255.0f, -1.0f, 127.0f, 1.5f, 256.0f};
+    std::uint8_t u8[6];
+    std::int8_t s8[6];
+
+    ASSERT_TRUE(Gemm::toInteger(2, values, u8));
+    ASSERT_EQUALS((int)u8[1], 255);
+    ASSERT_TRUE(!Gemm::toInteger(3, values, u8));
+    ASSERT_TRUE(!Gemm::toInteger(2, values, s8));
+    ASSERT_TRUE(Gemm::toInteger(2, values + 2, s8));
+    ASSERT_EQUALS((int)s8[0], -1);
+    ASSERT_TRUE(!Gemm::toInteger(1, values + 4, s8));
+    ASSERT_TRUE(!Gemm::toInteger(1, values + 5, u8));
+}
+
+RUN_TESTS()
@@ -0,0 +1,213 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "utils/CpuFeatures.hpp"
+#include "utils/Gemm.hpp"
+#include "utils/HalfConversion.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+namespace {
+    unsigned short halfBits(half_float::half value)
+    {
+        unsigned short bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    half_float::half bitsHalf(unsigned short bits)
+    {
+        half_float::half value;
+        std::memcpy(static_cast<void*>(&value), &bits, sizeof(value));
+        return value;
+    }
+
+    bool isNaN(unsigned short bits)
+    {
+        return ((bits & 0x7c00) == 0x7c00 && (bits & 0x03ff) != 0);
+    }
+}
+
+TEST_DATASET(HalfConversion,
+             toFloat,
+             (CpuFeatures::InstructionSet instructionSet),
+             std::make_tuple(CpuFeatures::Scalar),
+             std::make_tuple(CpuFeatures::AVX2))
+{
+    // Every half, except the signaling NaNs (which raise FE_INVALID with
+    // F16C)
+    std::vector<half_float::half> src;
+
+    for (unsigned int bits = 0; bits < 65536; ++bits) {
+        if (!isNaN(bits) || (bits & 0x0200))
+            src.push_back(bitsHalf(bits));
+    }
+
+    std::vector<float> dst(src.size());
+
+    CpuFeatures::setMaxInstructionSet(instructionSet);
+    HalfConversion::toFloat(&src[0], src.size(), &dst[0]);
+    CpuFeatures::setMaxInstructionSet(CpuFeatures::AVX512);
+
+    for (unsigned int i = 0; i < src.size(); ++i) {
+        if (isNaN(halfBits(src[i]))) {
+            ASSERT_TRUE(dst[i] != dst[i]);
+        }
+        else {
+            ASSERT_EQUALS(dst[i], (float)src[i]);
+        }
+    }
+}
+
+TEST_DATASET(HalfConversion,
+             fromFloat,
+             (CpuFeatures::InstructionSet instructionSet),
+             std::make_tuple(CpuFeatures::Scalar),
+             std::make_tuple(CpuFeatures::AVX2))
+{
+    // Every finite half is converted back exactly
+    std::vector<float> exact;
+
+    for (unsigned int bits = 0; bits < 65536; ++bits) {
+        if ((bits & 0x7c00) != 0x7c00)
+            exact.push_back((float)bitsHalf(bits));
+    }
+
+    std::vector<half_float::half> dst(exact.size());
+
+    CpuFeatures::setMaxInstructionSet(instructionSet);
+    HalfConversion::fromFloat(&exact[0], exact.size(), &dst[0]);
+    CpuFeatures::setMaxInstructionSet(CpuFeatures::AVX512);
+
+    for (unsigned int i = 0; i < exact.size(); ++i) {
+        ASSERT_EQUALS((float)dst[i], exact[i]);
+    }
+
+    // Ties between two consecutive positive halves round to even, other
+    // values to nearest
+    std::vector<float> src;
+    std::vector<unsigned short> ref;
+
+    for (unsigned short bits = 0; bits < 0x7bff; ++bits) {
+        const float lo = (float)bitsHalf(bits);
+        const float hi = (float)bitsHalf(bits + 1);
+        const float mid = (lo + hi) / 2.0f;
+
+        src.push_back(mid);
+        ref.push_back((bits & 1) ? bits + 1 : bits);
+        src.push_back(std::nextafter(mid, lo));
+        ref.push_back(bits);
+        src.push_back(std::nextafter(mid, hi));
+        ref.push_back(bits + 1);
+        src.push_back(-mid);
+        ref.push_back(((bits & 1) ? bits + 1 : bits) | 0x8000);
+    }
+
+    // Overflow to infinity, with the max. half 65504 and its tie 65520
+    src.push_back(65519.0f);
+    ref.push_back(0x7bff);
+    src.push_back(65520.0f);
+    ref.push_back(0x7c00);
+    src.push_back(-1.0e10f);
+    ref.push_back(0xfc00);
+    src.push_back(std::numeric_limits<float>::infinity());
+    ref.push_back(0x7c00);
+    // Underflow to zero
+    src.push_back(1.0e-10f);
+    ref.push_back(0x0000);
+
+    dst.resize(src.size());
+
+    CpuFeatures::setMaxInstructionSet(instructionSet);
+    HalfConversion::fromFloat(&src[0], src.size(), &dst[0]);
+    CpuFeatures::setMaxInstructionSet(CpuFeatures::AVX512);
+
+    for (unsigned int i = 0; i < src.size(); ++i) {
+        ASSERT_EQUALS(halfBits(dst[i]), ref[i]);
+    }
+}
+
+TEST(HalfConversion, block)
+{
+    Random::mtSeed(0);
+
+    const unsigned int rows = 7;
+    const unsigned int cols = 13;
+    const unsigned int ld = 16;
+
+    std::vector<half_float::half> src(rows * ld, half_float::half(-1.0f));
+
+    for (unsigned int i = 0; i < rows; ++i) {
+        for (unsigned int j = 0; j < cols; ++j)
+            src[i * ld + j] = half_float::half(Random::randUniform(-1.0, 1.0));
+    }
+
+    std::vector<float> dst(rows * cols);
+    HalfConversion::toFloat(&src[0], rows, cols, ld, &dst[0]);
+
+    std::vector<half_float::half> back(rows * ld, half_float::half(2.0f));
+    HalfConversion::fromFloat(&dst[0], rows, cols, &back[0], ld);
+
+    for (unsigned int i = 0; i < rows; ++i) {
+        for (unsigned int j = 0; j < ld; ++j) {
+            if (j < cols) {
+                ASSERT_EQUALS(dst[i * cols + j], (float)src[i * ld + j]);
+                ASSERT_EQUALS(halfBits(back[i * ld + j]),
+                              halfBits(src[i * ld + j]));
+            }
+            else {
+                // The padding is left untouched
+                ASSERT_EQUALS((float)back[i * ld + j], 2.0f);
+            }
+        }
+    }
+}
+
+TEST(HalfConversion, gemm)
+{
+    // The half GEMM accumulates in float: the sum of 4096 products of 2^-12
+    // is exact, while an accumulation in half would stall at 0.5 (where
+    // 2^-12 is half an ULP)
+    const unsigned int M = 3;
+    const unsigned int N = 5;
+    const unsigned int K = 4096;
+
+    std::vector<half_float::half> A(M * K, half_float::half(1.0f / 64.0f));
+    std::vector<half_float::half> B(K * N, half_float::half(1.0f / 64.0f));
+    std::vector<half_float::half> C(M * N, half_float::half(1.0f));
+
+    Gemm::gemm<half_float::half>(Gemm::NoTrans, Gemm::Trans, M, N, K,
+                                 half_float::half(1.0f), &A[0], K,
+                                 &B[0], K,
+                                 half_float::half(1.0f), &C[0], N);
+
+    for (unsigned int i = 0; i < C.size(); ++i) {
+        ASSERT_EQUALS((float)C[i], 2.0f);
+    }
+}
+
+RUN_TESTS()
@@ -0,0 +1,255 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/Nms.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+namespace {
+float IoU(const Nms::Boxes& boxes, unsigned int i, unsigned int j)
+{
+    const float interLeft = std::max(boxes.x[i], boxes.x[j]);
+    const float interRight = std::min(boxes.x[i] + boxes.w[i],
+                                      boxes.x[j] + boxes.w[j]);
+    const float interTop = std::max(boxes.y[i], boxes.y[j]);
+    const float interBottom = std::min(boxes.y[i] + boxes.h[i],
+                                       boxes.y[j] + boxes.h[j]);
+
+    if (interLeft < interRight && interTop < interBottom) {
+        const float interArea = (interRight - interLeft)
+                                    * (interBottom - interTop);
+        const float unionArea = boxes.w[i] * boxes.h[i]
+                                + boxes.w[j] * boxes.h[j] - interArea;
+        return interArea / unionArea;
+    }
+    else
+        return 0.0f;
+}
+
+void randomBoxes(Nms::Boxes& boxes, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; ++i) {
+        boxes.push_back(Random::randUniform(0.0, 200.0),
+                        Random::randUniform(0.0, 200.0),
+                        Random::randUniform(1.0, 50.0),
+                        Random::randUniform(1.0, 50.0));
+    }
+}
+}
+
+TEST(Nms, nms)
+{
+    Nms::Boxes boxes;
+    boxes.push_back(0.0, 0.0, 10.0, 10.0);
+    boxes.push_back(1.0, 1.0, 10.0, 10.0);  // IoU = 81 / 119 with box 0
+    boxes.push_back(20.0, 20.0, 10.0, 10.0);
+    boxes.push_back(5.0, 0.0, 10.0, 10.0);  // IoU = 50 / 150 with box 0
+
+    std::vector<unsigned int> kept = Nms::nms(boxes, 0.5);
+
+    ASSERT_EQUALS(kept.size(), 3U);
+    ASSERT_EQUALS(kept[0], 0U);
+    ASSERT_EQUALS(kept[1], 2U);
+    ASSERT_EQUALS(kept[2], 3U);
+
+    kept = Nms::nms(boxes, 0.3);
+
+    ASSERT_EQUALS(kept.size(), 2U);
+    ASSERT_EQUALS(kept[0], 0U);
+    ASSERT_EQUALS(kept[1], 2U);
+
+    kept = Nms::nms(boxes, 0.5, 2);
+
+    ASSERT_EQUALS(kept.size(), 2U);
+    ASSERT_EQUALS(kept[0], 0U);
+    ASSERT_EQUALS(kept[1], 2U);
+
+    kept = Nms::nms(Nms::Boxes(), 0.5);
+
+    ASSERT_TRUE(kept.empty());
+}
+
+TEST_DATASET(Nms,
+             nms_reference,
+             (unsigned int size, double threshold, unsigned int maxKeep),
+             std::make_tuple(1U, 0.5, 0U),
+             std::make_tuple(63U, 0.5, 0U),
+             std::make_tuple(64U, 0.3, 0U),
+             std::make_tuple(65U, 0.7, 0U),
+             std::make_tuple(1000U, 0.5, 0U),
+             std::make_tuple(1000U, 0.1, 0U),
+             std::make_tuple(5000U, 0.7, 100U),
+             std::make_tuple(10000U, 0.5, 0U))
+{
+    Random::mtSeed(0);
+
+    Nms::Boxes boxes;
+    randomBoxes(boxes, size);
+
+    // Reference: greedy suppression with pairwise IoU
+    std::vector<unsigned int> keptRef;
+    std::vector<bool> suppressed(size, false);
+
+    for (unsigned int i = 0; i < size; ++i) {
+        if (suppressed[i])
+            continue;
+
+        keptRef.push_back(i);
+
+        if (maxKeep > 0 && keptRef.size() >= maxKeep)
+            break;
+
+        for (unsigned int j = i + 1; j < size; ++j) {
+            if (IoU(boxes, i, j) > threshold)
+                suppressed[j] = true;
+        }
+    }
+
+    const std::vector<unsigned int> kept = Nms::nms(boxes, threshold,
+                                                    maxKeep);
+
+    ASSERT_EQUALS(kept.size(), keptRef.size());
+
+    for (unsigned int i = 0; i < kept.size(); ++i)
+        ASSERT_EQUALS(kept[i], keptRef[i]);
+}
+
+TEST(Nms, softNms)
+{
+    Nms::Boxes boxes;
+    boxes.push_back(0.0, 0.0, 10.0, 10.0);
+    boxes.push_back(5.0, 0.0, 10.0, 10.0);  // IoU = 1/3 with box 0
+    boxes.push_back(20.0, 20.0, 10.0, 10.0);
+
+    std::vector<float> scores = {0.9f, 0.8f, 0.7f};
+
+    // Linear: 0.8 * (1 - 1/3) = 0.5333 < 0.7
+    std::vector<unsigned int> kept = Nms::softNms(boxes, scores,
+        Nms::Linear, 0.3, 0.5, 0.1);
+
+    ASSERT_EQUALS(kept.size(), 3U);
+    ASSERT_EQUALS(kept[0], 0U);
+    ASSERT_EQUALS(kept[1], 2U);
+    ASSERT_EQUALS(kept[2], 1U);
+    ASSERT_EQUALS_DELTA(scores[0], 0.9, 1.0e-6);
+    ASSERT_EQUALS_DELTA(scores[1], 0.8 * (1.0 - 1.0 / 3.0), 1.0e-6);
+    ASSERT_EQUALS_DELTA(scores[2], 0.7, 1.0e-6);
+
+    // Linear, IoU below the threshold: no decay
+    scores = {0.9f, 0.8f, 0.7f};
+    kept = Nms::softNms(boxes, scores, Nms::Linear, 0.5, 0.5, 0.1);
+
+    ASSERT_EQUALS(kept.size(), 3U);
+    ASSERT_EQUALS(kept[1], 1U);
+    ASSERT_EQUALS_DELTA(scores[1], 0.8, 1.0e-6);
+
+    // Gaussian, with a score threshold discarding box 1
+    scores = {0.9f, 0.8f, 0.7f};
+    kept = Nms::softNms(boxes, scores, Nms::Gaussian, 0.3, 0.01, 0.1);
+
+    ASSERT_EQUALS(kept.size(), 2U);
+    ASSERT_EQUALS(kept[0], 0U);
+    ASSERT_EQUALS(kept[1], 2U);
+    ASSERT_EQUALS_DELTA(scores[1], 0.8 * std::exp(-1.0 / 9.0 / 0.01),
+                        1.0e-6);
+
+    // maxKeep
+    scores = {0.9f, 0.8f, 0.7f};
+    kept = Nms::softNms(boxes, scores, Nms::Gaussian, 0.3, 0.5, 0.0, 1);
+
+    ASSERT_EQUALS(kept.size(), 1U);
+    ASSERT_EQUALS(kept[0], 0U);
+}
+
+TEST_DATASET(Nms,
+             softNms_reference,
+             (unsigned int size, Nms::SoftMethod method),
+             std::make_tuple(100U, Nms::Linear),
+             std::make_tuple(100U, Nms::Gaussian),
+             std::make_tuple(1000U, Nms::Linear),
+             std::make_tuple(1000U, Nms::Gaussian))
+{
+    Random::mtSeed(0);
+
+    const double threshold = 0.3;
+    const double sigma = 0.5;
+    const double scoreThreshold = 0.05;
+
+    Nms::Boxes boxes;
+    randomBoxes(boxes, size);
+
+    std::vector<float> scores(size);
+
+    for (unsigned int i = 0; i < size; ++i)
+        scores[i] = Random::randUniform(0.0, 1.0);
+
+    // Reference: N. Bodla et al. algorithm
+    std::vector<float> scoresRef(scores);
+    std::vector<unsigned int> remaining;
+    std::vector<unsigned int> keptRef;
+
+    for (unsigned int i = 0; i < size; ++i) {
+        if (scoresRef[i] >= scoreThreshold)
+            remaining.push_back(i);
+    }
+
+    while (!remaining.empty()) {
+        unsigned int iMax = 0;
+
+        for (unsigned int k = 1; k < remaining.size(); ++k) {
+            if (scoresRef[remaining[k]] > scoresRef[remaining[iMax]])
+                iMax = k;
+        }
+
+        const unsigned int i = remaining[iMax];
+        keptRef.push_back(i);
+        remaining.erase(remaining.begin() + iMax);
+
+        for (std::vector<unsigned int>::iterator it = remaining.begin();
+            it != remaining.end(); )
+        {
+            const float iou = IoU(boxes, i, *it);
+
+            if (method == Nms::Linear)
+                scoresRef[*it] *= (iou > threshold) ? (1.0f - iou) : 1.0f;
+            else
+                scoresRef[*it] *= std::exp(-iou * iou / sigma);
+
+            if (scoresRef[*it] < scoreThreshold)
+                it = remaining.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    const std::vector<unsigned int> kept = Nms::softNms(boxes, scores,
+        method, threshold, sigma, scoreThreshold);
+
+    ASSERT_EQUALS(kept.size(), keptRef.size());
+
+    for (unsigned int i = 0; i < kept.size(); ++i) {
+        ASSERT_EQUALS(kept[i], keptRef[i]);
+        ASSERT_EQUALS_DELTA(scores[kept[i]], scoresRef[kept[i]], 1.0e-5);
+    }
+}
+
+RUN_TESTS()
@@ -70,4 +70,87 @@ TEST(Random, mtRand)
         ASSERT_EQUALS(Random::mtRand(), mtRand_0xFFFFFFFF[i]);
 }
 
+TEST(Random, philox)
+{
+    // Philox4x32-10 known answer tests from the Random123 library
+    const unsigned int counter_0[4] = {0, 0, 0, 0};
+    const unsigned int key_0[2] = {0, 0};
+    const unsigned int philox_0[4]
+        = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+
+    const unsigned int counter_1[4]
+        = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const unsigned int key_1[2] = {0xffffffff, 0xffffffff};
+    const unsigned int philox_1[4]
+        = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+
+    const unsigned int counter_pi[4]
+        = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const unsigned int key_pi[2] = {0xa4093822, 0x299f31d0};
+    const unsigned int philox_pi[4]
+        = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+
+    unsigned int output[4];
+
+    Random::philox(counter_0, key_0, output);
+
+    for (unsigned int i = 0; i < 4; ++i)
+        ASSERT_EQUALS(output[i], philox_0[i]);
+
+    Random::philox(counter_1, key_1, output);
+
+    for (unsigned int i = 0; i < 4; ++i)
+        ASSERT_EQUALS(output[i], philox_1[i]);
+
+    Random::philox(counter_pi, key_pi, output);
+
+    for (unsigned int i = 0; i < 4; ++i)
+        ASSERT_EQUALS(output[i], philox_pi[i]);
+}
+
+TEST_DATASET(Random,
+             randBernoulliMask,
+             (double p, size_t size),
+             std::make_tuple(0.5, 100000U),
+             std::make_tuple(0.1, 100001U),
+             std::make_tuple(0.9, 99999U),
+             std::make_tuple(0.0, 1000U),
+             std::make_tuple(1.0, 1000U))
+{
+    const unsigned long long seed = 0x123456789ABCDEFULL;
+    const unsigned long long stream = 42;
+
+    std::vector<unsigned int> mask;
+    Random::randBernoulliMask(seed, stream, p, size, mask);
+
+    ASSERT_EQUALS(mask.size(), (size + 31) / 32);
+
+    size_t count = 0;
+
+    for (size_t n = 0; n < 32 * mask.size(); ++n) {
+        const bool bit = (mask[n / 32] >> (n % 32)) & 1U;
+
+        if (n < size) {
+            const bool wordBit = (Random::randBernoulliWord(seed, stream,
+                n / 32, p) >> (n % 32)) & 1U;
+            ASSERT_EQUALS(bit, wordBit);
+
+            if (bit)
+                ++count;
+        }
+        else
+            ASSERT_EQUALS(bit, false);
+    }
+
+    ASSERT_EQUALS_DELTA(count / (double)size, p, 0.01);
+
+    // Different streams give different masks
+    if (p > 0.0 && p < 1.0) {
+        std::vector<unsigned int> otherMask;
+        Random::randBernoulliMask(seed, stream + 1, p, size, otherMask);
+
+        ASSERT_TRUE(mask != otherMask);
+    }
+}
+
 RUN_TESTS()
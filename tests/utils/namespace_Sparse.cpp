@@ -0,0 +1,221 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include "utils/Random.hpp"
+#include "utils/Sparse.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(Sparse,
+             compress,
+             (unsigned int M, unsigned int K, double sparsity),
+             std::make_tuple(1U, 1U, 0.0),
+             std::make_tuple(7U, 13U, 0.5),
+             std::make_tuple(31U, 64U, 0.9),
+             std::make_tuple(5U, 8U, 1.0))
+{
+    Random::mtSeed(0);
+
+    const unsigned int lda = K + 3;
+    std::vector<double> A(M * lda);
+
+    for (unsigned int i = 0; i < A.size(); ++i) {
+        A[i] = (Random::randUniform() < sparsity)
+            ? 0.0 : Random::randUniform(-1.0, 1.0);
+    }
+
+    Sparse::CsrMatrix<double> csr;
+    Sparse::compress<double>(M, K, &A[0], lda, csr);
+
+    ASSERT_EQUALS(csr.rows, M);
+    ASSERT_EQUALS(csr.cols, K);
+    ASSERT_EQUALS(csr.rowPtr.size(), M + 1);
+
+    unsigned int nnz = 0;
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int k = 0; k < K; ++k) {
+            if (A[i * lda + k] != 0.0) {
+                ASSERT_EQUALS(csr.colIndices[nnz], k);
+                ASSERT_EQUALS(csr.values[nnz], A[i * lda + k]);
+                ++nnz;
+            }
+        }
+
+        ASSERT_EQUALS(csr.rowPtr[i + 1], nnz);
+    }
+
+    ASSERT_EQUALS(csr.nnz(), nnz);
+    ASSERT_EQUALS_DELTA(csr.sparsity(), 1.0 - nnz / (double)(M * K), 1.0e-12);
+
+    // Same pattern, new values
+    for (unsigned int i = 0; i < A.size(); ++i)
+        A[i] = Random::randUniform(-1.0, 1.0);
+
+    Sparse::gather<double>(&A[0], lda, csr);
+    Sparse::applyPattern<double>(csr, &A[0], lda);
+
+    ASSERT_EQUALS(csr.nnz(), nnz);
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int idx = csr.rowPtr[i]; idx < csr.rowPtr[i + 1]; ++idx)
+        {
+            ASSERT_EQUALS(csr.values[idx], A[i * lda + csr.colIndices[idx]]);
+        }
+    }
+
+    unsigned int nnzA = 0;
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int k = 0; k < K; ++k) {
+            if (A[i * lda + k] != 0.0)
+                ++nnzA;
+        }
+    }
+
+    ASSERT_EQUALS(nnzA, nnz);
+}
+
+TEST_DATASET(Sparse,
+             products,
+             (unsigned int M, unsigned int N, unsigned int K,
+              double sparsity, double alpha, double beta),
+             std::make_tuple(1U, 1U, 1U, 0.0, 1.0, 0.0),
+             std::make_tuple(5U, 7U, 3U, 0.5, 2.0, 1.0),
+             std::make_tuple(67U, 131U, 300U, 0.9, 1.0, 0.0),
+             std::make_tuple(131U, 67U, 513U, 0.7, 0.5, 2.0),
+             std::make_tuple(64U, 64U, 256U, 0.95, 1.0, 1.0),
+             std::make_tuple(10U, 10U, 10U, 1.0, 1.0, 0.5))
+{
+    Random::mtSeed(0);
+
+    // Sparse A[M x K]
+    std::vector<double> A(M * K);
+
+    for (unsigned int i = 0; i < A.size(); ++i) {
+        A[i] = (Random::randUniform() < sparsity)
+            ? 0.0 : Random::randUniform(-1.0, 1.0);
+    }
+
+    Sparse::CsrMatrix<double> csr;
+    Sparse::compress<double>(M, K, &A[0], K, csr);
+
+    // C[M x N] = alpha * A[M x K] * B[K x N] + beta * C
+    std::vector<double> B(K * N);
+    std::vector<double> C(M * N);
+
+    for (unsigned int i = 0; i < B.size(); ++i)
+        B[i] = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = Random::randUniform(-1.0, 1.0);
+
+    std::vector<double> ref(C);
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int j = 0; j < N; ++j) {
+            double sum = 0.0;
+
+            for (unsigned int k = 0; k < K; ++k)
+                sum += A[i * K + k] * B[k * N + j];
+
+            ref[i * N + j] = alpha * sum + beta * ref[i * N + j];
+        }
+    }
+
+    Sparse::sparseDense<double>(csr, N, alpha, &B[0], N, beta, &C[0], N);
+
+    for (unsigned int i = 0; i < C.size(); ++i) {
+        ASSERT_EQUALS_DELTA(C[i], ref[i], 1.0e-9);
+    }
+
+    // C[N x M] = alpha * B[N x K] * A^T + beta * C
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = Random::randUniform(-1.0, 1.0);
+
+    ref = C;
+
+    for (unsigned int n = 0; n < N; ++n) {
+        for (unsigned int i = 0; i < M; ++i) {
+            double sum = 0.0;
+
+            for (unsigned int k = 0; k < K; ++k)
+                sum += B[n * K + k] * A[i * K + k];
+
+            ref[n * M + i] = alpha * sum + beta * ref[n * M + i];
+        }
+    }
+
+    Sparse::denseSparseTrans<double>(csr, N, alpha, &B[0], K, beta, &C[0],
+                                     M);
+
+    for (unsigned int i = 0; i < C.size(); ++i) {
+        ASSERT_EQUALS_DELTA(C[i], ref[i], 1.0e-9);
+    }
+
+    // D[N x K] = alpha * C[N x M] * A + beta * D
+    std::vector<double> D(N * K);
+
+    for (unsigned int i = 0; i < D.size(); ++i)
+        D[i] = Random::randUniform(-1.0, 1.0);
+
+    ref = D;
+
+    for (unsigned int n = 0; n < N; ++n) {
+        for (unsigned int k = 0; k < K; ++k) {
+            double sum = 0.0;
+
+            for (unsigned int i = 0; i < M; ++i)
+                sum += C[n * M + i] * A[i * K + k];
+
+            ref[n * K + k] = alpha * sum + beta * ref[n * K + k];
+        }
+    }
+
+    Sparse::denseSparse<double>(csr, N, alpha, &C[0], M, beta, &D[0], K);
+
+    for (unsigned int i = 0; i < D.size(); ++i) {
+        ASSERT_EQUALS_DELTA(D[i], ref[i], 1.0e-9);
+    }
+}
+
+TEST(Sparse, beta_zero)
+{
+    // With beta = 0, C must not be read (NaN must not propagate)
+    const unsigned int M = 9;
+    const unsigned int N = 11;
+    const unsigned int K = 4;
+
+    std::vector<float> A(M * K, 1.0f);
+    std::vector<float> B(K * N, 0.5f);
+    std::vector<float> C(M * N, std::numeric_limits<float>::quiet_NaN());
+
+    Sparse::CsrMatrix<float> csr;
+    Sparse::compress<float>(M, K, &A[0], K, csr);
+    Sparse::sparseDense<float>(csr, N, 1.0f, &B[0], N, 0.0f, &C[0], N);
+
+    for (unsigned int i = 0; i < C.size(); ++i) {
+        ASSERT_EQUALS(C[i], 2.0f);
+    }
+}
+
+RUN_TESTS()